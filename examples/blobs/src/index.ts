@@ -6,6 +6,7 @@ import {
   View,
   emit,
   createUnorderedMap,
+  BlobReader,
 } from '@calimero-network/calimero-sdk-js';
 import type { UnorderedMap } from '@calimero-network/calimero-sdk-js/collections';
 import {
@@ -211,6 +212,18 @@ export class FileShareLogic extends FileShareState {
     return this.respond({ blobId: record.blobId });
   }
 
+  @View()
+  checksumBlob(blobId: string): string {
+    // Streams the blob through pooled chunks, hashing as it goes
+    const reader = BlobReader.open(blobIdFromString(blobId), { hash: true });
+    let chunks = 0;
+    for (const _chunk of reader) {
+      chunks += 1;
+    }
+    const sha256 = Array.from(reader.digest(), b => b.toString(16).padStart(2, '0')).join('');
+    return this.respond({ blobId, size: reader.bytesRead, chunks, sha256 });
+  }
+
   @View()
   searchFiles(query: string): string {
     const lowercase = query.toLowerCase();
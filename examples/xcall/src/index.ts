@@ -1,5 +1,5 @@
 import { State, Logic, Init, View } from '@calimero-network/calimero-sdk-js';
-import { contextId, log, xcall } from '@calimero-network/calimero-sdk-js/env';
+import { contextId, log, xcall, xcallMany } from '@calimero-network/calimero-sdk-js/env';
 import bs58 from 'bs58';
 
 const textEncoder = new TextEncoder();
@@ -49,6 +49,19 @@ export class XCallLogic extends XCallState {
     xcall(targetBytes, 'pong', textEncoder.encode(JSON.stringify(payload)));
   }
 
+  pingMany(targetContexts: string[]): number {
+    const targets = targetContexts.map(decodeContextId);
+    const payload: PongPayload = {
+      fromContext: encodeBase58(contextId()),
+    };
+
+    log(`[xcall] fanning out ping to ${targets.length} contexts`);
+
+    // Queued and sent as one batch when this method returns
+    xcallMany(targets, 'pong', textEncoder.encode(JSON.stringify(payload)));
+    return targets.length;
+  }
+
   pong(payload: PongPayload | string): number {
     const fromContext = typeof payload === 'string' ? payload : payload?.fromContext;
 
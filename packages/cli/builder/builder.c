@@ -10,6 +10,8 @@
 #include "libbf.h"
 #include "code.h"
 #include "storage_wasm.h"
+#include "lz4.h"  // Value/root-state compression codec
+#include "murmur3.h"  // BloomSet member hashing
 #include "abi.h"  // ABI manifest embedded as byte array
 
 static void log_c_string(const char *msg);
@@ -109,7 +111,13 @@ extern void context_id(uint64_t register_id);
 extern void executor_id(uint64_t register_id);
 extern void emit(uint64_t event_ptr);
 extern void emit_with_handler(uint64_t event_ptr, uint64_t handler_buffer_ptr);
+#ifdef CALIMERO_EMIT_BATCH
+extern void emit_batch(uint64_t events_buffer_ptr);  // Buffer of CalimeroBatchedEvent, len = count
+#endif
 extern void xcall(uint64_t xcall_ptr);
+#ifdef CALIMERO_XCALL_BATCH
+extern void xcall_batch(uint64_t calls_buffer_ptr);  // Buffer of CalimeroXCall, len = count
+#endif
 // Context Management (PR 1663 & 1686)
 extern void context_add_member(uint64_t public_key_buffer_ptr);
 extern void context_remove_member(uint64_t public_key_buffer_ptr);
@@ -197,6 +205,13 @@ typedef struct {
   uint64_t data_len;
 } CalimeroEvent;
 
+// Batched event descriptor: an event plus its optional handler (has_handler is 0 or 1)
+typedef struct {
+  CalimeroEvent event;
+  uint64_t has_handler;
+  CalimeroBuffer handler;
+} CalimeroBatchedEvent;
+
 // Location struct - MUST match calimero-sys Location<'a>
 // struct with file: Buffer<'a>, line: u32, column: u32
 // Use natural C alignment to match Rust's repr(C)
@@ -230,22 +245,188 @@ static uint8_t* JSValueToUint8Array(JSContext *ctx, JSValue val, size_t *len) {
     return NULL;
   }
   
-  uint8_t *ptr = JS_GetArrayBuffer(ctx, len, buffer);
+  // The view may cover only part of its ArrayBuffer (e.g. a subarray): keep the
+  // view length in *len, not the backing buffer size.
+  size_t buffer_len;
+  uint8_t *ptr = JS_GetArrayBuffer(ctx, &buffer_len, buffer);
   JS_FreeValue(ctx, buffer);
   
   return ptr ? ptr + offset : NULL;
 }
 
-static void log_c_string(const char *msg) {
-  if (!msg) {
+// ===========================
+// Log Ring Buffer
+// ===========================
+
+// Guest logs (C diagnostics and JS `env.log`) are appended to an in-memory ring
+// instead of crossing into the host once per line. The ring is flushed at the end
+// of every exported entry point and right before panicking. Records are
+// length-prefixed; when a record does not fit, the ring is flushed early (one
+// more host call) so no line is lost. Only a single record longer than the ring
+// is cut, and the flush reports the bytes cut ahead of the buffered lines.
+//
+// The flush buffer has the same size as the ring, so keep CALIMERO_LOG_RING_SIZE
+// at or below the host's per-message log limit. Build with
+// -DCALIMERO_LOG_RING_SIZE=0 to send every line to the host directly.
+#ifndef CALIMERO_LOG_RING_SIZE
+#define CALIMERO_LOG_RING_SIZE (16 * 1024)
+#endif
+
+#if CALIMERO_LOG_RING_SIZE > 0
+
+#define CALIMERO_LOG_RECORD_HEADER 4
+
+static uint8_t calimero_log_ring[CALIMERO_LOG_RING_SIZE];
+static uint8_t calimero_log_flush_buf[CALIMERO_LOG_RING_SIZE];
+static size_t calimero_log_head = 0;  // offset of the oldest record
+static size_t calimero_log_used = 0;  // bytes held by records, headers included
+static uint32_t calimero_log_records = 0;
+static uint32_t calimero_log_truncated_records = 0;
+static uint64_t calimero_log_truncated_bytes = 0;
+static size_t calimero_log_flush_len = 0;
+
+static void calimero_log_flush(void);
+
+static void calimero_log_ring_copy_in(size_t offset, const uint8_t *src, size_t len) {
+  size_t first = CALIMERO_LOG_RING_SIZE - offset;
+  if (first > len) {
+    first = len;
+  }
+  memcpy(calimero_log_ring + offset, src, first);
+  if (len > first) {
+    memcpy(calimero_log_ring, src + first, len - first);
+  }
+}
+
+static void calimero_log_ring_copy_out(size_t offset, uint8_t *dst, size_t len) {
+  size_t first = CALIMERO_LOG_RING_SIZE - offset;
+  if (first > len) {
+    first = len;
+  }
+  memcpy(dst, calimero_log_ring + offset, first);
+  if (len > first) {
+    memcpy(dst + first, calimero_log_ring, len - first);
+  }
+}
+
+static uint32_t calimero_log_ring_record_len(size_t offset) {
+  uint8_t header[CALIMERO_LOG_RECORD_HEADER];
+  calimero_log_ring_copy_out(offset, header, sizeof(header));
+  return (uint32_t)header[0] | ((uint32_t)header[1] << 8) | ((uint32_t)header[2] << 16) |
+         ((uint32_t)header[3] << 24);
+}
+
+// Removes the oldest record and returns its payload offset and length.
+static uint32_t calimero_log_ring_pop(size_t *payload_offset) {
+  uint32_t len = calimero_log_ring_record_len(calimero_log_head);
+  size_t total = CALIMERO_LOG_RECORD_HEADER + len;
+  *payload_offset = (calimero_log_head + CALIMERO_LOG_RECORD_HEADER) % CALIMERO_LOG_RING_SIZE;
+  calimero_log_head = (calimero_log_head + total) % CALIMERO_LOG_RING_SIZE;
+  calimero_log_used -= total;
+  calimero_log_records--;
+  return len;
+}
+
+static void calimero_log_append(const uint8_t *msg, size_t len) {
+  size_t max_payload = CALIMERO_LOG_RING_SIZE - CALIMERO_LOG_RECORD_HEADER;
+  size_t kept = len;
+  if (kept > max_payload) {
+    // Keep the start of oversized messages, cut on a UTF-8 boundary.
+    kept = max_payload;
+    while (kept > 0 && (msg[kept] & 0xC0) == 0x80) {
+      kept--;
+    }
+  }
+
+  size_t total = CALIMERO_LOG_RECORD_HEADER + kept;
+  if (calimero_log_used + total > CALIMERO_LOG_RING_SIZE) {
+    calimero_log_flush();
+  }
+  // Counted after the flush above so the note goes out with the cut record
+  if (kept < len) {
+    calimero_log_truncated_records++;
+    calimero_log_truncated_bytes += len - kept;
+    len = kept;
+  }
+
+  size_t tail = (calimero_log_head + calimero_log_used) % CALIMERO_LOG_RING_SIZE;
+  uint8_t header[CALIMERO_LOG_RECORD_HEADER] = {
+    (uint8_t)len, (uint8_t)(len >> 8), (uint8_t)(len >> 16), (uint8_t)(len >> 24)
+  };
+  calimero_log_ring_copy_in(tail, header, sizeof(header));
+  calimero_log_ring_copy_in((tail + CALIMERO_LOG_RECORD_HEADER) % CALIMERO_LOG_RING_SIZE, msg, len);
+  calimero_log_used += total;
+  calimero_log_records++;
+}
+
+static void calimero_log_emit_chunk(void) {
+  if (calimero_log_flush_len == 0) {
     return;
   }
+  CalimeroBuffer buf = make_buffer(calimero_log_flush_buf, calimero_log_flush_len);
+  log_utf8((uint64_t)&buf);
+  calimero_log_flush_len = 0;
+}
+
+// Makes room for `len` bytes (plus a newline separator) in the flush buffer.
+static uint8_t *calimero_log_chunk_reserve(size_t len) {
+  size_t separator = calimero_log_flush_len > 0 ? 1 : 0;
+  if (calimero_log_flush_len + separator + len > sizeof(calimero_log_flush_buf)) {
+    calimero_log_emit_chunk();
+    separator = 0;
+  }
+  if (separator) {
+    calimero_log_flush_buf[calimero_log_flush_len++] = '\n';
+  }
+  uint8_t *dst = calimero_log_flush_buf + calimero_log_flush_len;
+  calimero_log_flush_len += len;
+  return dst;
+}
+
+// Sends every buffered record to the host, newline-joined, in as few `log_utf8`
+// calls as the flush buffer allows (one unless a truncation note needs room too).
+static void calimero_log_flush(void) {
+  if (calimero_log_truncated_records > 0) {
+    char note[128];
+    int note_len = snprintf(note, sizeof(note), "[log] %u records longer than the ring truncated, %llu bytes lost",
+                            calimero_log_truncated_records, (unsigned long long)calimero_log_truncated_bytes);
+    if (note_len > 0) {
+      size_t len = (size_t)note_len < sizeof(note) ? (size_t)note_len : sizeof(note) - 1;
+      memcpy(calimero_log_chunk_reserve(len), note, len);
+    }
+    calimero_log_truncated_records = 0;
+    calimero_log_truncated_bytes = 0;
+  }
+
+  while (calimero_log_records > 0) {
+    size_t offset;
+    uint32_t len = calimero_log_ring_pop(&offset);
+    calimero_log_ring_copy_out(offset, calimero_log_chunk_reserve(len), len);
+  }
+  calimero_log_head = 0;
 
-  size_t len = strlen(msg);
+  calimero_log_emit_chunk();
+}
+
+#else
+
+static void calimero_log_append(const uint8_t *msg, size_t len) {
   CalimeroBuffer buf = make_buffer(msg, len);
   log_utf8((uint64_t)&buf);
 }
 
+static void calimero_log_flush(void) {}
+
+#endif
+
+static void log_c_string(const char *msg) {
+  if (!msg) {
+    return;
+  }
+
+  calimero_log_append((const uint8_t *)msg, strlen(msg));
+}
+
 static void calimero_log_exception(JSContext *ctx, JSValue exception, const char *stage) {
   if (stage) {
     char header[256];
@@ -377,6 +558,7 @@ static void calimero_panic_bytes(const uint8_t *message_ptr, size_t message_len)
     .column = 0
   };
 
+  calimero_log_flush();
   panic_utf8((uint64_t)&message_buf, (uint64_t)&location);
   __builtin_unreachable();
 }
@@ -436,8 +618,7 @@ static JSValue js_panic_utf8(JSContext *ctx, JSValueConst this_val, int argc, JS
   size_t message_len = 0;
   uint8_t *message_ptr = JSValueToUint8Array(ctx, argv[0], &message_len);
   if (message_ptr) {
-    CalimeroBuffer log_buf = make_buffer(message_ptr, message_len);
-    log_utf8((uint64_t)&log_buf);
+    calimero_log_append(message_ptr, message_len);
     calimero_panic_bytes(message_ptr, message_len);
     return JS_EXCEPTION;
   }
@@ -496,8 +677,18 @@ static JSValue js_log_utf8(JSContext *ctx, JSValueConst this_val, int argc, JSVa
   uint8_t *ptr = JSValueToUint8Array(ctx, argv[0], &len);
   if (!ptr) return JS_EXCEPTION;
   
-  CalimeroBuffer buf = make_buffer(ptr, len);
-  log_utf8((uint64_t)&buf);
+  calimero_log_append(ptr, len);
+  return JS_UNDEFINED;
+}
+
+// Wrapper: log_append (JS string straight into the log ring, no TextEncoder round-trip)
+static JSValue js_log_append(JSContext *ctx, JSValueConst this_val, int argc, JSValueConst *argv) {
+  size_t len;
+  const char *msg = JS_ToCStringLen(ctx, &len, argv[0]);
+  if (!msg) return JS_EXCEPTION;
+
+  calimero_log_append((const uint8_t *)msg, len);
+  JS_FreeCString(ctx, msg);
   return JS_UNDEFINED;
 }
 
@@ -628,6 +819,99 @@ static JSValue js_env_crdt_map_insert(JSContext *ctx, JSValueConst this_val, int
   return JS_NewInt32(ctx, status);
 }
 
+static void calimero_free_borrowed_buffer(JSRuntime *rt, void *opaque, void *ptr) {
+  free(ptr);
+}
+
+// Read-merge-write on a map entry in one crossing. The stored value (if any) is read
+// straight from the register into a borrowed ArrayBuffer and handed to
+// `merge(current | null)`; the buffer is detached and freed as soon as the callback
+// returns. The Uint8Array returned by `merge` is inserted. Returns the insert status
+// (previous value left in the register), or the lookup status when the lookup failed.
+static JSValue js_env_crdt_map_merge_insert(JSContext *ctx, JSValueConst this_val, int argc, JSValueConst *argv) {
+  if (argc < 4) {
+    JS_ThrowTypeError(ctx, "js_crdt_map_merge_insert expects mapId, key, merge and register id");
+    return JS_EXCEPTION;
+  }
+  size_t map_id_len;
+  uint8_t *map_id_ptr = JSValueToUint8Array(ctx, argv[0], &map_id_len);
+  if (!map_id_ptr) {
+    JS_ThrowTypeError(ctx, "js_crdt_map_merge_insert: mapId must be Uint8Array");
+    return JS_EXCEPTION;
+  }
+  size_t key_len;
+  uint8_t *key_ptr = JSValueToUint8Array(ctx, argv[1], &key_len);
+  if (!key_ptr) {
+    JS_ThrowTypeError(ctx, "js_crdt_map_merge_insert: key must be Uint8Array");
+    return JS_EXCEPTION;
+  }
+  if (!JS_IsFunction(ctx, argv[2])) {
+    JS_ThrowTypeError(ctx, "js_crdt_map_merge_insert: merge must be a function");
+    return JS_EXCEPTION;
+  }
+  int64_t register_id;
+  if (js_to_i64(ctx, argv[3], &register_id)) {
+    return JS_EXCEPTION;
+  }
+
+  CalimeroBuffer map_id_buf = make_buffer(map_id_ptr, map_id_len);
+  CalimeroBuffer key_buf = make_buffer(key_ptr, key_len);
+  int32_t status = js_crdt_map_get((uint64_t)&map_id_buf, (uint64_t)&key_buf, (uint64_t)register_id);
+  if (status < 0) {
+    return JS_NewInt32(ctx, status);
+  }
+
+  JSValue current_arg = JS_NULL;
+  JSValue current_ab = JS_UNDEFINED;
+  if (status > 0) {
+    uint64_t current_len = register_len((uint64_t)register_id);
+    uint8_t *current = (uint8_t *)malloc(current_len > 0 ? current_len : 1);
+    if (!current) {
+      return JS_ThrowOutOfMemory(ctx);
+    }
+    CalimeroBuffer current_buf = make_buffer(current, current_len);
+    read_register((uint64_t)register_id, (uint64_t)&current_buf);
+
+    current_ab = JS_NewArrayBuffer(ctx, current, current_len, calimero_free_borrowed_buffer, NULL, 0);
+    if (JS_IsException(current_ab)) {
+      free(current);
+      return JS_EXCEPTION;
+    }
+    JSValue global_obj = JS_GetGlobalObject(ctx);
+    JSValue uint8_ctor = JS_GetPropertyStr(ctx, global_obj, "Uint8Array");
+    JS_FreeValue(ctx, global_obj);
+    current_arg = JS_CallConstructor(ctx, uint8_ctor, 1, &current_ab);
+    JS_FreeValue(ctx, uint8_ctor);
+    if (JS_IsException(current_arg)) {
+      JS_DetachArrayBuffer(ctx, current_ab);
+      JS_FreeValue(ctx, current_ab);
+      return JS_EXCEPTION;
+    }
+  }
+
+  JSValue merged = JS_Call(ctx, argv[2], JS_UNDEFINED, 1, &current_arg);
+  JS_FreeValue(ctx, current_arg);
+  if (!JS_IsUndefined(current_ab)) {
+    JS_DetachArrayBuffer(ctx, current_ab);
+    JS_FreeValue(ctx, current_ab);
+  }
+  if (JS_IsException(merged)) {
+    return JS_EXCEPTION;
+  }
+
+  size_t value_len;
+  uint8_t *value_ptr = JSValueToUint8Array(ctx, merged, &value_len);
+  if (!value_ptr) {
+    JS_FreeValue(ctx, merged);
+    JS_ThrowTypeError(ctx, "js_crdt_map_merge_insert: merge must return a Uint8Array");
+    return JS_EXCEPTION;
+  }
+  CalimeroBuffer value_buf = make_buffer(value_ptr, value_len);
+  status = js_crdt_map_insert((uint64_t)&map_id_buf, (uint64_t)&key_buf, (uint64_t)&value_buf, (uint64_t)register_id);
+  JS_FreeValue(ctx, merged);
+  return JS_NewInt32(ctx, status);
+}
+
 static JSValue js_env_crdt_map_remove(JSContext *ctx, JSValueConst this_val, int argc, JSValueConst *argv) {
   if (argc < 3) {
     JS_ThrowTypeError(ctx, "js_crdt_map_remove expects mapId, key and register id");
@@ -1109,6 +1393,49 @@ static JSValue js_env_crdt_counter_get_executor_count(JSContext *ctx, JSValueCon
   return JS_NewInt32(ctx, status);
 }
 
+// Wrapper: invocation_context
+// Fills a 72-byte record [context_id: 32][executor_id: 32][time_now: u64 LE] so the
+// SDK fetches its per-invocation context in one crossing instead of three host calls
+// and two register reads from JS.
+#define CALIMERO_INVOCATION_CONTEXT_SIZE 72
+
+static int calimero_read_id_register(uint64_t register_id, uint8_t *out) {
+  if (register_len(register_id) != 32) {
+    return 0;
+  }
+  CalimeroBuffer buf = make_buffer(out, 32);
+  return read_register(register_id, (uint64_t)&buf) != 0;
+}
+
+static JSValue js_invocation_context(JSContext *ctx, JSValueConst this_val, int argc, JSValueConst *argv) {
+  (void)this_val;
+
+  if (argc < 1) {
+    return JS_ThrowTypeError(ctx, "invocation_context expects an output buffer");
+  }
+
+  size_t buf_len;
+  uint8_t *buf_ptr = JSValueToUint8Array(ctx, argv[0], &buf_len);
+  if (!buf_ptr) {
+    return JS_EXCEPTION;
+  }
+  if (buf_len < CALIMERO_INVOCATION_CONTEXT_SIZE) {
+    return JS_ThrowRangeError(ctx, "invocation_context buffer must be at least 72 bytes");
+  }
+
+  context_id(0);
+  if (!calimero_read_id_register(0, buf_ptr)) {
+    return JS_ThrowRangeError(ctx, "context_id must be 32 bytes");
+  }
+  executor_id(0);
+  if (!calimero_read_id_register(0, buf_ptr + 32)) {
+    return JS_ThrowRangeError(ctx, "executor_id must be 32 bytes");
+  }
+  CalimeroBuffer time_buf = make_buffer(buf_ptr + 64, 8);
+  time_now((uint64_t)&time_buf);
+  return JS_UNDEFINED;
+}
+
 // Wrapper: context_id
 static JSValue js_context_id(JSContext *ctx, JSValueConst this_val, int argc, JSValueConst *argv) {
   int64_t register_id;
@@ -1173,6 +1500,37 @@ static JSValue js_env_context_is_member(JSContext *ctx, JSValueConst this_val, i
   return JS_NewBool(ctx, result != 0);
 }
 
+// Wrapper: context_is_member_many
+// Checks packed 32-byte keys against the host one by one and writes a 0/1 flag per
+// key into `out`: one crossing from JS instead of one per key, and no member list.
+static JSValue js_env_context_is_member_many(JSContext *ctx, JSValueConst this_val, int argc, JSValueConst *argv) {
+  (void)this_val;
+  if (argc < 2) {
+    return JS_ThrowTypeError(ctx, "context_is_member_many expects packed publicKeys and an output buffer");
+  }
+  size_t keys_len, out_len;
+  uint8_t *keys_ptr = JSValueToUint8Array(ctx, argv[0], &keys_len);
+  if (!keys_ptr) {
+    return JS_EXCEPTION;
+  }
+  uint8_t *out_ptr = JSValueToUint8Array(ctx, argv[1], &out_len);
+  if (!out_ptr) {
+    return JS_EXCEPTION;
+  }
+  if (keys_len % 32 != 0) {
+    return JS_ThrowRangeError(ctx, "publicKeys must be a multiple of 32 bytes");
+  }
+  size_t count = keys_len / 32;
+  if (out_len < count) {
+    return JS_ThrowRangeError(ctx, "output buffer needs one byte per publicKey");
+  }
+  for (size_t i = 0; i < count; i++) {
+    CalimeroBuffer public_key_buf = make_buffer(keys_ptr + i * 32, 32);
+    out_ptr[i] = context_is_member((uint64_t)&public_key_buf) ? 1 : 0;
+  }
+  return JS_UNDEFINED;
+}
+
 // Wrapper: context_members
 static JSValue js_env_context_members(JSContext *ctx, JSValueConst this_val, int argc, JSValueConst *argv) {
   (void)this_val;
@@ -1326,6 +1684,124 @@ static JSValue js_emit_with_handler(JSContext *ctx, JSValueConst this_val, int a
   return JS_UNDEFINED;
 }
 
+// Event batches arrive from the SDK as one arena laid out as Borsh
+// Vec<(kind: Vec<u8>, data: Vec<u8>, handler: Option<Vec<u8>>)>. Descriptors point
+// into the arena, so payloads are never copied; the descriptor array is reused
+// across calls. Built with -DCALIMERO_EMIT_BATCH the whole batch crosses to the
+// host in one `emit_batch` call, otherwise each event goes through `emit` /
+// `emit_with_handler` in order.
+static CalimeroBatchedEvent *calimero_event_batch = NULL;
+static size_t calimero_event_batch_capacity = 0;
+
+static int calimero_batch_read_u32(const uint8_t *buf, size_t len, size_t *offset, uint32_t *out) {
+  if (len - *offset < 4) {
+    return 0;
+  }
+  const uint8_t *p = buf + *offset;
+  *out = (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+  *offset += 4;
+  return 1;
+}
+
+static int calimero_batch_read_bytes(const uint8_t *buf, size_t len, size_t *offset, CalimeroBuffer *out) {
+  uint32_t bytes_len;
+  if (!calimero_batch_read_u32(buf, len, offset, &bytes_len) || len - *offset < bytes_len) {
+    return 0;
+  }
+  *out = make_buffer(buf + *offset, bytes_len);
+  *offset += bytes_len;
+  return 1;
+}
+
+// Grows a reusable descriptor array to hold `count` elements. Returns 0 on OOM.
+static int calimero_batch_reserve(void **items, size_t *capacity, size_t count, size_t item_size) {
+  if (count <= *capacity) {
+    return 1;
+  }
+  void *grown = realloc(*items, count * item_size);
+  if (!grown) {
+    return 0;
+  }
+  *items = grown;
+  *capacity = count;
+  return 1;
+}
+
+// Wrapper: emit_batch
+static JSValue js_emit_batch(JSContext *ctx, JSValueConst this_val, int argc, JSValueConst *argv) {
+  (void)this_val;
+
+  if (argc < 1) {
+    return JS_ThrowTypeError(ctx, "emit_batch expects an event batch");
+  }
+
+  size_t batch_len;
+  uint8_t *batch_ptr = JSValueToUint8Array(ctx, argv[0], &batch_len);
+  if (!batch_ptr) {
+    return JS_EXCEPTION;
+  }
+
+  size_t offset = 0;
+  uint32_t count;
+  // Every entry takes at least two length prefixes and the option tag
+  if (!calimero_batch_read_u32(batch_ptr, batch_len, &offset, &count) || count > batch_len / 9) {
+    return JS_ThrowRangeError(ctx, "emit_batch: malformed event batch");
+  }
+
+  if (!calimero_batch_reserve((void **)&calimero_event_batch, &calimero_event_batch_capacity, count,
+                              sizeof(CalimeroBatchedEvent))) {
+    return JS_ThrowOutOfMemory(ctx);
+  }
+
+  for (uint32_t i = 0; i < count; i++) {
+    CalimeroBatchedEvent *entry = &calimero_event_batch[i];
+    CalimeroBuffer kind, data;
+    if (!calimero_batch_read_bytes(batch_ptr, batch_len, &offset, &kind) ||
+        !calimero_batch_read_bytes(batch_ptr, batch_len, &offset, &data) ||
+        offset >= batch_len) {
+      return JS_ThrowRangeError(ctx, "emit_batch: malformed event batch");
+    }
+    entry->event.kind_ptr = kind.ptr;
+    entry->event.kind_len = kind.len;
+    entry->event.data_ptr = data.ptr;
+    entry->event.data_len = data.len;
+
+    uint8_t tag = batch_ptr[offset++];
+    if (tag == 1) {
+      if (!calimero_batch_read_bytes(batch_ptr, batch_len, &offset, &entry->handler)) {
+        return JS_ThrowRangeError(ctx, "emit_batch: malformed event batch");
+      }
+      entry->has_handler = 1;
+    } else if (tag == 0) {
+      entry->handler = make_buffer(NULL, 0);
+      entry->has_handler = 0;
+    } else {
+      return JS_ThrowRangeError(ctx, "emit_batch: malformed event batch");
+    }
+  }
+  if (offset != batch_len) {
+    return JS_ThrowRangeError(ctx, "emit_batch: trailing bytes after event batch");
+  }
+
+#ifdef CALIMERO_EMIT_BATCH
+  if (count > 0) {
+    CalimeroBuffer events = make_buffer(calimero_event_batch, count);
+    emit_batch((uint64_t)&events);
+  }
+#else
+  for (uint32_t i = 0; i < count; i++) {
+    CalimeroBatchedEvent *entry = &calimero_event_batch[i];
+    if (entry->has_handler) {
+      emit_with_handler((uint64_t)&entry->event, (uint64_t)&entry->handler);
+    } else {
+      emit((uint64_t)&entry->event);
+    }
+  }
+#endif
+
+  return JS_NewUint32(ctx, count);
+}
+
 // Wrapper: xcall
 static JSValue js_xcall(JSContext *ctx, JSValueConst this_val, int argc, JSValueConst *argv) {
   (void)this_val;
@@ -1368,6 +1844,94 @@ static JSValue js_xcall(JSContext *ctx, JSValueConst this_val, int argc, JSValue
   return JS_UNDEFINED;
 }
 
+// Cross-context call batches arrive from the SDK packed as Borsh
+//   functions: Vec<Vec<u8>>, params: Vec<Vec<u8>>,
+//   calls: Vec<(context_id: [u8; 32], function: u32, params: u32)>
+// so a fan-out carries one copy of each function name and params payload. The
+// CalimeroXCall descriptors point into the packed buffer and share those copies.
+// Built with -DCALIMERO_XCALL_BATCH the calls reach the host in one `xcall_batch`
+// call, otherwise they go through `xcall` one at a time, in order.
+static CalimeroBuffer *calimero_xcall_tables = NULL;
+static size_t calimero_xcall_tables_capacity = 0;
+static CalimeroXCall *calimero_xcall_batch = NULL;
+static size_t calimero_xcall_batch_capacity = 0;
+
+// Wrapper: xcall_batch
+static JSValue js_xcall_batch(JSContext *ctx, JSValueConst this_val, int argc, JSValueConst *argv) {
+  (void)this_val;
+
+  if (argc < 1) {
+    return JS_ThrowTypeError(ctx, "xcall_batch expects a packed call batch");
+  }
+
+  size_t packed_len;
+  uint8_t *packed_ptr = JSValueToUint8Array(ctx, argv[0], &packed_len);
+  if (!packed_ptr) {
+    return JS_EXCEPTION;
+  }
+
+  // Function and params tables share one descriptor array: functions first, then params
+  size_t offset = 0;
+  uint32_t table_counts[2];
+  size_t table_total = 0;
+  for (int table = 0; table < 2; table++) {
+    uint32_t count;
+    if (!calimero_batch_read_u32(packed_ptr, packed_len, &offset, &count) || count > (packed_len - offset) / 4) {
+      return JS_ThrowRangeError(ctx, "xcall_batch: malformed call batch");
+    }
+    if (!calimero_batch_reserve((void **)&calimero_xcall_tables, &calimero_xcall_tables_capacity,
+                                table_total + count, sizeof(CalimeroBuffer))) {
+      return JS_ThrowOutOfMemory(ctx);
+    }
+    for (uint32_t i = 0; i < count; i++) {
+      if (!calimero_batch_read_bytes(packed_ptr, packed_len, &offset, &calimero_xcall_tables[table_total + i])) {
+        return JS_ThrowRangeError(ctx, "xcall_batch: malformed call batch");
+      }
+    }
+    table_counts[table] = count;
+    table_total += count;
+  }
+  const CalimeroBuffer *functions = calimero_xcall_tables;
+  const CalimeroBuffer *params = calimero_xcall_tables + table_counts[0];
+
+  uint32_t call_count;
+  if (!calimero_batch_read_u32(packed_ptr, packed_len, &offset, &call_count) ||
+      (packed_len - offset) / 40 < call_count || packed_len - offset != (size_t)call_count * 40) {
+    return JS_ThrowRangeError(ctx, "xcall_batch: malformed call batch");
+  }
+  if (!calimero_batch_reserve((void **)&calimero_xcall_batch, &calimero_xcall_batch_capacity, call_count,
+                              sizeof(CalimeroXCall))) {
+    return JS_ThrowOutOfMemory(ctx);
+  }
+
+  for (uint32_t i = 0; i < call_count; i++) {
+    const uint8_t *context_ptr = packed_ptr + offset;
+    offset += 32;
+    uint32_t function_index, params_index;
+    calimero_batch_read_u32(packed_ptr, packed_len, &offset, &function_index);
+    calimero_batch_read_u32(packed_ptr, packed_len, &offset, &params_index);
+    if (function_index >= table_counts[0] || params_index >= table_counts[1]) {
+      return JS_ThrowRangeError(ctx, "xcall_batch: call references a missing table entry");
+    }
+    calimero_xcall_batch[i].context_id = make_buffer(context_ptr, 32);
+    calimero_xcall_batch[i].function = functions[function_index];
+    calimero_xcall_batch[i].params = params[params_index];
+  }
+
+#ifdef CALIMERO_XCALL_BATCH
+  if (call_count > 0) {
+    CalimeroBuffer calls = make_buffer(calimero_xcall_batch, call_count);
+    xcall_batch((uint64_t)&calls);
+  }
+#else
+  for (uint32_t i = 0; i < call_count; i++) {
+    xcall((uint64_t)&calimero_xcall_batch[i]);
+  }
+#endif
+
+  return JS_NewUint32(ctx, call_count);
+}
+
 // Wrapper: commit
 static JSValue js_commit(JSContext *ctx, JSValueConst this_val, int argc, JSValueConst *argv) {
   size_t root_len, artifact_len;
@@ -1461,6 +2025,72 @@ static JSValue js_random_bytes(JSContext *ctx, JSValueConst this_val, int argc,
   return JS_UNDEFINED;
 }
 
+// Wrapper: lz4_compress
+// Compresses src into the caller's dst (sized with the SDK's bound). Returns the compressed
+// length, or 0 when dst is too small.
+static JSValue js_lz4_compress(JSContext *ctx, JSValueConst this_val, int argc, JSValueConst *argv) {
+  (void)this_val;
+  if (argc < 2) {
+    return JS_ThrowTypeError(ctx, "lz4_compress expects src and dst");
+  }
+  size_t src_len, dst_len;
+  uint8_t *src_ptr = JSValueToUint8Array(ctx, argv[0], &src_len);
+  if (!src_ptr) {
+    return JS_EXCEPTION;
+  }
+  uint8_t *dst_ptr = JSValueToUint8Array(ctx, argv[1], &dst_len);
+  if (!dst_ptr) {
+    return JS_EXCEPTION;
+  }
+  return JS_NewInt64(ctx, (int64_t)calimero_lz4_compress(src_ptr, src_len, dst_ptr, dst_len));
+}
+
+// Wrapper: lz4_decompress
+// Decompresses an LZ4 block into dst, which must be exactly the uncompressed length.
+static JSValue js_lz4_decompress(JSContext *ctx, JSValueConst this_val, int argc, JSValueConst *argv) {
+  (void)this_val;
+  if (argc < 2) {
+    return JS_ThrowTypeError(ctx, "lz4_decompress expects src and dst");
+  }
+  size_t src_len, dst_len;
+  uint8_t *src_ptr = JSValueToUint8Array(ctx, argv[0], &src_len);
+  if (!src_ptr) {
+    return JS_EXCEPTION;
+  }
+  uint8_t *dst_ptr = JSValueToUint8Array(ctx, argv[1], &dst_len);
+  if (!dst_ptr) {
+    return JS_EXCEPTION;
+  }
+  int64_t written = calimero_lz4_decompress(src_ptr, src_len, dst_ptr, dst_len);
+  if (written < 0 || (size_t)written != dst_len) {
+    return JS_ThrowRangeError(ctx, "lz4_decompress: malformed or truncated block");
+  }
+  return JS_NewInt64(ctx, written);
+}
+
+// Wrapper: murmur3_128
+// Hashes src (MurmurHash3 x86_128, seed 0) into the first 16 bytes of dst.
+static JSValue js_murmur3_128(JSContext *ctx, JSValueConst this_val, int argc, JSValueConst *argv) {
+  (void)this_val;
+  if (argc < 2) {
+    return JS_ThrowTypeError(ctx, "murmur3_128 expects src and dst");
+  }
+  size_t src_len, dst_len;
+  uint8_t *src_ptr = JSValueToUint8Array(ctx, argv[0], &src_len);
+  if (!src_ptr) {
+    return JS_EXCEPTION;
+  }
+  uint8_t *dst_ptr = JSValueToUint8Array(ctx, argv[1], &dst_len);
+  if (!dst_ptr) {
+    return JS_EXCEPTION;
+  }
+  if (dst_len < 16) {
+    return JS_ThrowRangeError(ctx, "murmur3_128: dst must hold 16 bytes");
+  }
+  calimero_murmur3_x86_128(src_ptr, src_len, 0, dst_ptr);
+  return JS_UNDEFINED;
+}
+
 // Wrapper: blob_create
 static JSValue js_blob_create(JSContext *ctx, JSValueConst this_val, int argc, JSValueConst *argv) {
   uint64_t fd = blob_create();
@@ -1481,7 +2111,7 @@ static JSValue js_blob_open(JSContext *ctx, JSValueConst this_val, int argc, JSV
 // Wrapper: blob_read
 static JSValue js_blob_read(JSContext *ctx, JSValueConst this_val, int argc, JSValueConst *argv) {
   int64_t fd;
-  JS_ToInt64(ctx, &fd, argv[0]);
+  if (js_to_i64(ctx, argv[0], &fd) < 0) return JS_EXCEPTION;
   
   size_t buf_len;
   uint8_t *buf_ptr = JSValueToUint8Array(ctx, argv[1], &buf_len);
@@ -1495,7 +2125,7 @@ static JSValue js_blob_read(JSContext *ctx, JSValueConst this_val, int argc, JSV
 // Wrapper: blob_write
 static JSValue js_blob_write(JSContext *ctx, JSValueConst this_val, int argc, JSValueConst *argv) {
   int64_t fd;
-  JS_ToInt64(ctx, &fd, argv[0]);
+  if (js_to_i64(ctx, argv[0], &fd) < 0) return JS_EXCEPTION;
   
   size_t data_len;
   uint8_t *data_ptr = JSValueToUint8Array(ctx, argv[1], &data_len);
@@ -1509,7 +2139,7 @@ static JSValue js_blob_write(JSContext *ctx, JSValueConst this_val, int argc, JS
 // Wrapper: blob_close
 static JSValue js_blob_close(JSContext *ctx, JSValueConst this_val, int argc, JSValueConst *argv) {
   int64_t fd;
-  JS_ToInt64(ctx, &fd, argv[0]);
+  if (js_to_i64(ctx, argv[0], &fd) < 0) return JS_EXCEPTION;
   
   size_t buf_len;
   uint8_t *buf_ptr = JSValueToUint8Array(ctx, argv[1], &buf_len);
@@ -1551,6 +2181,72 @@ static JSValue js_blob_announce_to_context(JSContext *ctx, JSValueConst this_val
   return JS_NewUint32(ctx, result);
 }
 
+// Wrappers: blob_stream_create / blob_stream_open / blob_stream_read / blob_stream_write
+// Same host imports as the blob_* wrappers above, but fds and byte counts cross as plain JS
+// numbers instead of BigInts, so BlobReader/BlobWriter allocate nothing per chunk.
+static JSValue js_blob_stream_create(JSContext *ctx, JSValueConst this_val, int argc, JSValueConst *argv) {
+  (void)this_val;
+  (void)argc;
+  (void)argv;
+  return JS_NewInt64(ctx, (int64_t)blob_create());
+}
+
+static JSValue js_blob_stream_open(JSContext *ctx, JSValueConst this_val, int argc, JSValueConst *argv) {
+  (void)this_val;
+  if (argc < 1) {
+    return JS_ThrowTypeError(ctx, "blob_stream_open expects blobId");
+  }
+  size_t blob_id_len;
+  uint8_t *blob_id_ptr = JSValueToUint8Array(ctx, argv[0], &blob_id_len);
+  if (!blob_id_ptr) {
+    return JS_EXCEPTION;
+  }
+  if (blob_id_len != 32) {
+    return JS_ThrowRangeError(ctx, "blobId must be 32 bytes");
+  }
+
+  CalimeroBuffer blob_id_buf = make_buffer(blob_id_ptr, blob_id_len);
+  return JS_NewInt64(ctx, (int64_t)blob_open((uint64_t)&blob_id_buf));
+}
+
+static JSValue js_blob_stream_read(JSContext *ctx, JSValueConst this_val, int argc, JSValueConst *argv) {
+  (void)this_val;
+  if (argc < 2) {
+    return JS_ThrowTypeError(ctx, "blob_stream_read expects fd and buffer");
+  }
+  int64_t fd;
+  if (js_to_i64(ctx, argv[0], &fd) < 0) {
+    return JS_EXCEPTION;
+  }
+  size_t buf_len;
+  uint8_t *buf_ptr = JSValueToUint8Array(ctx, argv[1], &buf_len);
+  if (!buf_ptr) {
+    return JS_EXCEPTION;
+  }
+
+  CalimeroBuffer buf = make_buffer(buf_ptr, buf_len);
+  return JS_NewInt64(ctx, (int64_t)blob_read((uint64_t)fd, (uint64_t)&buf));
+}
+
+static JSValue js_blob_stream_write(JSContext *ctx, JSValueConst this_val, int argc, JSValueConst *argv) {
+  (void)this_val;
+  if (argc < 2) {
+    return JS_ThrowTypeError(ctx, "blob_stream_write expects fd and data");
+  }
+  int64_t fd;
+  if (js_to_i64(ctx, argv[0], &fd) < 0) {
+    return JS_EXCEPTION;
+  }
+  size_t data_len;
+  uint8_t *data_ptr = JSValueToUint8Array(ctx, argv[1], &data_len);
+  if (!data_ptr) {
+    return JS_EXCEPTION;
+  }
+
+  CalimeroBuffer data_buf = make_buffer(data_ptr, data_len);
+  return JS_NewInt64(ctx, (int64_t)blob_write((uint64_t)fd, (uint64_t)&data_buf));
+}
+
 // Wrapper: js_user_storage_new
 static JSValue js_env_user_storage_new(JSContext *ctx, JSValueConst this_val, int argc, JSValueConst *argv) {
   (void)this_val;
@@ -1835,6 +2531,7 @@ void js_add_calimero_host_functions(JSContext *ctx) {
 
   // Logging
   JS_SetPropertyStr(ctx, env, "log_utf8", JS_NewCFunction(ctx, js_log_utf8, "log_utf8", 1));
+  JS_SetPropertyStr(ctx, env, "log_append", JS_NewCFunction(ctx, js_log_append, "log_append", 1));
   JS_SetPropertyStr(ctx, env, "value_return", JS_NewCFunction(ctx, js_value_return, "value_return", 1));
   
   // Storage
@@ -1844,6 +2541,7 @@ void js_add_calimero_host_functions(JSContext *ctx) {
   JS_SetPropertyStr(ctx, env, "js_crdt_map_new", JS_NewCFunction(ctx, js_env_crdt_map_new, "js_crdt_map_new", 1));
   JS_SetPropertyStr(ctx, env, "js_crdt_map_get", JS_NewCFunction(ctx, js_env_crdt_map_get, "js_crdt_map_get", 3));
   JS_SetPropertyStr(ctx, env, "js_crdt_map_insert", JS_NewCFunction(ctx, js_env_crdt_map_insert, "js_crdt_map_insert", 4));
+  JS_SetPropertyStr(ctx, env, "js_crdt_map_merge_insert", JS_NewCFunction(ctx, js_env_crdt_map_merge_insert, "js_crdt_map_merge_insert", 4));
   JS_SetPropertyStr(ctx, env, "js_crdt_map_remove", JS_NewCFunction(ctx, js_env_crdt_map_remove, "js_crdt_map_remove", 3));
   JS_SetPropertyStr(ctx, env, "js_crdt_map_contains", JS_NewCFunction(ctx, js_env_crdt_map_contains, "js_crdt_map_contains", 2));
   JS_SetPropertyStr(ctx, env, "js_crdt_map_iter", JS_NewCFunction(ctx, js_env_crdt_map_iter, "js_crdt_map_iter", 2));
@@ -1885,6 +2583,7 @@ void js_add_calimero_host_functions(JSContext *ctx) {
   JS_SetPropertyStr(ctx, env, "context_add_member", JS_NewCFunction(ctx, js_env_context_add_member, "context_add_member", 1));
   JS_SetPropertyStr(ctx, env, "context_remove_member", JS_NewCFunction(ctx, js_env_context_remove_member, "context_remove_member", 1));
   JS_SetPropertyStr(ctx, env, "context_is_member", JS_NewCFunction(ctx, js_env_context_is_member, "context_is_member", 1));
+  JS_SetPropertyStr(ctx, env, "context_is_member_many", JS_NewCFunction(ctx, js_env_context_is_member_many, "context_is_member_many", 2));
   JS_SetPropertyStr(ctx, env, "context_members", JS_NewCFunction(ctx, js_env_context_members, "context_members", 1));
   JS_SetPropertyStr(ctx, env, "context_create", JS_NewCFunction(ctx, js_env_context_create, "context_create", 4));
   JS_SetPropertyStr(ctx, env, "context_delete", JS_NewCFunction(ctx, js_env_context_delete, "context_delete", 1));
@@ -1898,7 +2597,9 @@ void js_add_calimero_host_functions(JSContext *ctx) {
   // Events
   JS_SetPropertyStr(ctx, env, "emit", JS_NewCFunction(ctx, js_emit, "emit", 2));
   JS_SetPropertyStr(ctx, env, "emit_with_handler", JS_NewCFunction(ctx, js_emit_with_handler, "emit_with_handler", 3));
+  JS_SetPropertyStr(ctx, env, "emit_batch", JS_NewCFunction(ctx, js_emit_batch, "emit_batch", 1));
   JS_SetPropertyStr(ctx, env, "xcall", JS_NewCFunction(ctx, js_xcall, "xcall", 3));
+  JS_SetPropertyStr(ctx, env, "xcall_batch", JS_NewCFunction(ctx, js_xcall_batch, "xcall_batch", 1));
   
   // Delta
   JS_SetPropertyStr(ctx, env, "commit", JS_NewCFunction(ctx, js_commit, "commit", 2));
@@ -1909,7 +2610,11 @@ void js_add_calimero_host_functions(JSContext *ctx) {
   
   // Time
   JS_SetPropertyStr(ctx, env, "time_now", JS_NewCFunction(ctx, js_time_now, "time_now", 1));
+  JS_SetPropertyStr(ctx, env, "invocation_context", JS_NewCFunction(ctx, js_invocation_context, "invocation_context", 1));
   JS_SetPropertyStr(ctx, env, "random_bytes", JS_NewCFunction(ctx, js_random_bytes, "random_bytes", 1));
+  JS_SetPropertyStr(ctx, env, "lz4_compress", JS_NewCFunction(ctx, js_lz4_compress, "lz4_compress", 2));
+  JS_SetPropertyStr(ctx, env, "lz4_decompress", JS_NewCFunction(ctx, js_lz4_decompress, "lz4_decompress", 2));
+  JS_SetPropertyStr(ctx, env, "murmur3_128", JS_NewCFunction(ctx, js_murmur3_128, "murmur3_128", 2));
   
   // Blobs
   JS_SetPropertyStr(ctx, env, "blob_create", JS_NewCFunction(ctx, js_blob_create, "blob_create", 0));
@@ -1917,6 +2622,10 @@ void js_add_calimero_host_functions(JSContext *ctx) {
   JS_SetPropertyStr(ctx, env, "blob_read", JS_NewCFunction(ctx, js_blob_read, "blob_read", 2));
   JS_SetPropertyStr(ctx, env, "blob_write", JS_NewCFunction(ctx, js_blob_write, "blob_write", 2));
   JS_SetPropertyStr(ctx, env, "blob_close", JS_NewCFunction(ctx, js_blob_close, "blob_close", 2));
+  JS_SetPropertyStr(ctx, env, "blob_stream_create", JS_NewCFunction(ctx, js_blob_stream_create, "blob_stream_create", 0));
+  JS_SetPropertyStr(ctx, env, "blob_stream_open", JS_NewCFunction(ctx, js_blob_stream_open, "blob_stream_open", 1));
+  JS_SetPropertyStr(ctx, env, "blob_stream_read", JS_NewCFunction(ctx, js_blob_stream_read, "blob_stream_read", 2));
+  JS_SetPropertyStr(ctx, env, "blob_stream_write", JS_NewCFunction(ctx, js_blob_stream_write, "blob_stream_write", 2));
   JS_SetPropertyStr(ctx, env, "blob_announce_to_context", JS_NewCFunction(ctx, js_blob_announce_to_context, "blob_announce_to_context", 2));
   
   // Crypto
@@ -1931,6 +2640,135 @@ void js_add_calimero_host_functions(JSContext *ctx) {
 // This prevents WASI runtime initialization which causes imports
 void _start() {}
 
+// ===========================
+// Runtime Bootstrap & Pre-initialization
+// ===========================
+
+// Creates a runtime/context, wires host functions, injects the storage wasm and
+// ABI globals and evaluates the bundled module. Panics on failure, returns 0 only
+// when the runtime or context could not be allocated.
+static int calimero_bootstrap_runtime(const char *label, JSRuntime **rt_out, JSContext **ctx_out, JSValue *mod_out) {
+  char log_buf[256];
+  JSRuntime *rt = JS_NewRuntime();
+  if (!rt) {
+    snprintf(log_buf, sizeof(log_buf), "[wrapper] %s: JS_NewRuntime failed", label);
+    log_c_string(log_buf);
+    return 0;
+  }
+  JSContext *ctx = JS_NewCustomContext(rt);
+  if (!ctx) {
+    snprintf(log_buf, sizeof(log_buf), "[wrapper] %s: JS_NewCustomContext failed", label);
+    log_c_string(log_buf);
+    JS_FreeRuntime(rt);
+    return 0;
+  }
+
+  js_add_calimero_host_functions(ctx);
+  snprintf(log_buf, sizeof(log_buf), "[wrapper] %s: host functions wired", label);
+  log_c_string(log_buf);
+
+  JSValue storage_bytes = JS_NewArrayBufferCopy(
+      ctx,
+      calimero_sdk_js_packages_sdk_src_wasm_storage_wasm_wasm,
+      calimero_sdk_js_packages_sdk_src_wasm_storage_wasm_wasm_len);
+  if (JS_IsException(storage_bytes)) {
+    snprintf(log_buf, sizeof(log_buf), "[wrapper] %s: JS_NewArrayBufferCopy exception", label);
+    log_c_string(log_buf);
+    JSValue buf_exception = JS_GetException(ctx);
+    calimero_log_exception(ctx, buf_exception, "storage buffer");
+    calimero_panic_with_exception(ctx, buf_exception);
+    __builtin_unreachable();
+  }
+  JSValue global_obj = JS_GetGlobalObject(ctx);
+  JS_SetPropertyStr(ctx, global_obj, "__CALIMERO_STORAGE_WASM__", storage_bytes);
+
+  /* Inject ABI manifest as global variable (required) */
+  /* Inject as string - let JavaScript parse it to avoid memory issues with large JSON */
+  if (calimero_abi_json_len == 0) {
+    snprintf(log_buf, sizeof(log_buf), "[wrapper] %s: ABI manifest is required but not found", label);
+    log_c_string(log_buf);
+    calimero_panic_c_string("ABI manifest is required but not embedded in WASM");
+  }
+  JSValue abi_string = JS_NewStringLen(ctx, (const char *)calimero_abi_json, calimero_abi_json_len);
+  if (JS_IsException(abi_string)) {
+    snprintf(log_buf, sizeof(log_buf), "[wrapper] %s: JS_NewStringLen (ABI) exception", label);
+    log_c_string(log_buf);
+    JSValue abi_exception = JS_GetException(ctx);
+    calimero_log_exception(ctx, abi_exception, "ABI string creation");
+    calimero_panic_with_exception(ctx, abi_exception);
+    __builtin_unreachable();
+  }
+  /* Note: JS_SetPropertyStr consumes the value reference, so we don't free abi_string */
+  JS_SetPropertyStr(ctx, global_obj, "__CALIMERO_ABI_MANIFEST__", abi_string);
+  JS_FreeValue(ctx, global_obj);
+  snprintf(log_buf, sizeof(log_buf), "[wrapper] %s: storage wasm and ABI injected", label);
+  log_c_string(log_buf);
+
+  JSValue mod_obj = js_load_module_binary(ctx, code, code_size);
+  if (JS_IsException(mod_obj)) {
+    snprintf(log_buf, sizeof(log_buf), "[wrapper] %s: js_load_module_binary exception", label);
+    log_c_string(log_buf);
+    JSValue load_exception = JS_GetException(ctx);
+    calimero_log_exception(ctx, load_exception, "module load");
+    calimero_panic_with_exception(ctx, load_exception);
+    __builtin_unreachable();
+  }
+  snprintf(log_buf, sizeof(log_buf), "[wrapper] %s: module loaded", label);
+  log_c_string(log_buf);
+
+  *rt_out = rt;
+  *ctx_out = ctx;
+  *mod_out = mod_obj;
+  return 1;
+}
+
+// Pre-initialized runtime captured by `calimero_preinit`. The build-time snapshot
+// step (see src/compiler/snapshot.ts) calls the initializer once in a local engine
+// and bakes linear memory and globals into the shipped binary, so every instance
+// starts with `calimero_preinit_ready == 1` and a fully evaluated module.
+//
+// The snapshot only ever contains state derived from the binary itself: host
+// functions are reached through the function table (stable across instances),
+// the storage wasm/ABI globals are copies of embedded data and the snapshot step
+// rejects any host import other than logging while the initializer runs, so no
+// register contents or host handles can leak into the image.
+static JSRuntime *calimero_preinit_rt = NULL;
+static JSContext *calimero_preinit_ctx = NULL;
+static JSValue calimero_preinit_module;
+static int calimero_preinit_ready = 0;
+
+__attribute__((used))
+__attribute__((visibility("default")))
+__attribute__((export_name("calimero_preinit")))
+void calimero_preinit(void) {
+  if (calimero_preinit_ready) {
+    return;
+  }
+  if (calimero_bootstrap_runtime("preinit", &calimero_preinit_rt, &calimero_preinit_ctx, &calimero_preinit_module)) {
+    calimero_preinit_ready = 1;
+    log_c_string("[wrapper] preinit: runtime snapshot ready");
+  }
+  calimero_log_flush();
+}
+
+// Returns the runtime for the current invocation. The pre-initialized runtime is
+// handed out once per instance: module-level JS state (state caches, nested
+// trackers, ...) is mutated by the call, so a second invocation on the same
+// instance falls back to a fresh bootstrap instead of observing leftovers.
+static int calimero_acquire_runtime(const char *label, JSRuntime **rt_out, JSContext **ctx_out, JSValue *mod_out) {
+  if (calimero_preinit_ready) {
+    calimero_preinit_ready = 0;
+    *rt_out = calimero_preinit_rt;
+    *ctx_out = calimero_preinit_ctx;
+    *mod_out = calimero_preinit_module;
+    calimero_preinit_rt = NULL;
+    calimero_preinit_ctx = NULL;
+    log_c_string("[wrapper] using pre-initialized runtime");
+    return 1;
+  }
+  return calimero_bootstrap_runtime(label, rt_out, ctx_out, mod_out);
+}
+
 #define DEFINE_CALIMERO_METHOD(name) \
 __attribute__((used)) \
 __attribute__((visibility("default"))) \
@@ -1939,83 +2777,13 @@ void calimero_method_##name() { \
   char log_buf[256]; \
   snprintf(log_buf, sizeof(log_buf), "[wrapper] %s: start", #name); \
   log_c_string(log_buf); \
-  JSRuntime *rt = JS_NewRuntime(); \
-  if (!rt) { \
-    snprintf(log_buf, sizeof(log_buf), "[wrapper] %s: JS_NewRuntime failed", #name); \
-    log_c_string(log_buf); \
-    return; \
-  } \
-  JSContext *ctx = JS_NewCustomContext(rt); \
-  if (!ctx) { \
-    snprintf(log_buf, sizeof(log_buf), "[wrapper] %s: JS_NewCustomContext failed", #name); \
-    log_c_string(log_buf); \
-    JS_FreeRuntime(rt); \
+  JSRuntime *rt = NULL; \
+  JSContext *ctx = NULL; \
+  JSValue mod_obj; \
+  if (!calimero_acquire_runtime(#name, &rt, &ctx, &mod_obj)) { \
+    calimero_log_flush(); \
     return; \
   } \
-\
-  js_add_calimero_host_functions(ctx); \
-  snprintf(log_buf, sizeof(log_buf), "[wrapper] %s: host functions wired", #name); \
-  log_c_string(log_buf); \
- \
-  JSValue storage_bytes = JS_NewArrayBufferCopy( \
-      ctx, \
-      calimero_sdk_js_packages_sdk_src_wasm_storage_wasm_wasm, \
-      calimero_sdk_js_packages_sdk_src_wasm_storage_wasm_wasm_len); \
-  if (JS_IsException(storage_bytes)) { \
-    snprintf(log_buf, sizeof(log_buf), "[wrapper] %s: JS_NewArrayBufferCopy exception", #name); \
-    log_c_string(log_buf); \
-    JSValue buf_exception = JS_GetException(ctx); \
-    calimero_log_exception(ctx, buf_exception, "storage buffer"); \
-    calimero_panic_with_exception(ctx, buf_exception); \
-    JS_FreeValue(ctx, buf_exception); \
-    JS_FreeContext(ctx); \
-    JS_FreeRuntime(rt); \
-    __builtin_unreachable(); \
-  } \
-  JSValue global_obj = JS_GetGlobalObject(ctx); \
-  JS_SetPropertyStr(ctx, global_obj, "__CALIMERO_STORAGE_WASM__", storage_bytes); \
-  \
-  /* Inject ABI manifest as global variable (required) */ \
-  /* Inject as string - let JavaScript parse it to avoid memory issues with large JSON */ \
-  if (calimero_abi_json_len == 0) { \
-    snprintf(log_buf, sizeof(log_buf), "[wrapper] %s: ABI manifest is required but not found", #name); \
-    log_c_string(log_buf); \
-    calimero_panic_c_string("ABI manifest is required but not embedded in WASM"); \
-  } \
-  JSValue abi_string = JS_NewStringLen(ctx, (const char *)calimero_abi_json, calimero_abi_json_len); \
-  if (JS_IsException(abi_string)) { \
-    snprintf(log_buf, sizeof(log_buf), "[wrapper] %s: JS_NewStringLen (ABI) exception", #name); \
-    log_c_string(log_buf); \
-    JSValue abi_exception = JS_GetException(ctx); \
-    calimero_log_exception(ctx, abi_exception, "ABI string creation"); \
-    calimero_panic_with_exception(ctx, abi_exception); \
-    JS_FreeValue(ctx, abi_exception); \
-    JS_FreeContext(ctx); \
-    JS_FreeRuntime(rt); \
-    __builtin_unreachable(); \
-  } \
-  /* Set as string - JavaScript code will parse it if needed */ \
-  /* Note: JS_SetPropertyStr consumes the value reference, so we don't free abi_string */ \
-  JS_SetPropertyStr(ctx, global_obj, "__CALIMERO_ABI_MANIFEST__", abi_string); \
-  JS_FreeValue(ctx, global_obj); \
-  snprintf(log_buf, sizeof(log_buf), "[wrapper] %s: storage wasm and ABI injected", #name); \
-  log_c_string(log_buf); \
-\
-  JSValue mod_obj = js_load_module_binary(ctx, code, code_size); \
-  if (JS_IsException(mod_obj)) { \
-    snprintf(log_buf, sizeof(log_buf), "[wrapper] %s: js_load_module_binary exception", #name); \
-    log_c_string(log_buf); \
-    JSValue load_exception = JS_GetException(ctx); \
-    calimero_log_exception(ctx, load_exception, "module load"); \
-    calimero_panic_with_exception(ctx, load_exception); \
-    JS_FreeValue(ctx, load_exception); \
-    JS_FreeContext(ctx); \
-    JS_FreeRuntime(rt); \
-    __builtin_unreachable(); \
-  } \
-  snprintf(log_buf, sizeof(log_buf), "[wrapper] %s: module loaded", #name); \
-  log_c_string(log_buf); \
-\
   JSAtom method_atom = JS_NewAtom(ctx, #name); \
   JSValue fun_obj = JS_GetProperty(ctx, mod_obj, method_atom); \
   if (JS_IsUndefined(fun_obj)) { \
@@ -2083,6 +2851,7 @@ void calimero_method_##name() { \
   JS_FreeRuntime(rt); \
   snprintf(log_buf, sizeof(log_buf), "[wrapper] %s: done", #name); \
   log_c_string(log_buf); \
+  calimero_log_flush(); \
 }
 
 // ===========================
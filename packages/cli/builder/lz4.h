@@ -0,0 +1,200 @@
+// LZ4 block codec used by builder.c for compressed collection values and root state.
+//
+// Header-only and dependency-free: greedy single-probe matching over a 4096-entry hash table,
+// producing standard LZ4 block format (no frame header; the SDK stores the uncompressed length
+// next to the block). Decompression validates every length and offset against both buffers,
+// so malformed input fails with -1 instead of reading or writing out of bounds.
+
+#ifndef CALIMERO_LZ4_H
+#define CALIMERO_LZ4_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#define CALIMERO_LZ4_HASH_LOG 12
+#define CALIMERO_LZ4_MIN_MATCH 4
+#define CALIMERO_LZ4_MFLIMIT 12        // no match may start in the last 12 bytes
+#define CALIMERO_LZ4_LAST_LITERALS 5   // the last 5 bytes are always literals
+#define CALIMERO_LZ4_MAX_OFFSET 65535
+
+// Positions + 1 of the last occurrence of each hashed 4-byte sequence (0 = empty)
+static uint32_t calimero_lz4_table[1 << CALIMERO_LZ4_HASH_LOG];
+
+// Worst-case compressed size for `len` input bytes
+static inline size_t calimero_lz4_bound(size_t len) {
+  return len + len / 255 + 16;
+}
+
+static inline uint32_t calimero_lz4_read32(const uint8_t *p) {
+  uint32_t value;
+  memcpy(&value, p, sizeof(value));
+  return value;
+}
+
+static inline uint32_t calimero_lz4_hash(uint32_t sequence) {
+  return (sequence * 2654435761u) >> (32 - CALIMERO_LZ4_HASH_LOG);
+}
+
+static inline uint8_t *calimero_lz4_write_length(uint8_t *op, size_t len) {
+  while (len >= 255) {
+    *op++ = 255;
+    len -= 255;
+  }
+  *op++ = (uint8_t)len;
+  return op;
+}
+
+// Writes one sequence (literals, then a match unless match_len == 0).
+// Returns the new output position, or NULL when it would not fit.
+static uint8_t *calimero_lz4_write_sequence(uint8_t *op, uint8_t *op_end, const uint8_t *literals,
+                                            size_t literal_len, size_t offset, size_t match_len) {
+  size_t needed = 1 + literal_len + literal_len / 255 + 1;
+  if (match_len) {
+    needed += 2 + (match_len - CALIMERO_LZ4_MIN_MATCH) / 255 + 1;
+  }
+  if ((size_t)(op_end - op) < needed) {
+    return NULL;
+  }
+
+  uint8_t *token = op++;
+  *token = (uint8_t)((literal_len >= 15 ? 15 : literal_len) << 4);
+  if (literal_len >= 15) {
+    op = calimero_lz4_write_length(op, literal_len - 15);
+  }
+  memcpy(op, literals, literal_len);
+  op += literal_len;
+
+  if (match_len) {
+    size_t extra = match_len - CALIMERO_LZ4_MIN_MATCH;
+    *op++ = (uint8_t)(offset & 0xff);
+    *op++ = (uint8_t)(offset >> 8);
+    *token |= (uint8_t)(extra >= 15 ? 15 : extra);
+    if (extra >= 15) {
+      op = calimero_lz4_write_length(op, extra - 15);
+    }
+  }
+  return op;
+}
+
+// Compresses src into dst. Returns the compressed size, or 0 when dst_cap is too small
+// (a dst of calimero_lz4_bound(src_len) bytes always suffices).
+static size_t calimero_lz4_compress(const uint8_t *src, size_t src_len, uint8_t *dst, size_t dst_cap) {
+  uint8_t *op = dst;
+  uint8_t *op_end = dst + dst_cap;
+  const uint8_t *anchor = src;
+  const uint8_t *end = src + src_len;
+
+  if (src_len > CALIMERO_LZ4_MFLIMIT) {
+    const uint8_t *match_limit = end - CALIMERO_LZ4_MFLIMIT;
+    const uint8_t *match_end_limit = end - CALIMERO_LZ4_LAST_LITERALS;
+    const uint8_t *ip = src;
+    memset(calimero_lz4_table, 0, sizeof(calimero_lz4_table));
+
+    while (ip < match_limit) {
+      uint32_t sequence = calimero_lz4_read32(ip);
+      uint32_t slot = calimero_lz4_hash(sequence);
+      size_t candidate = calimero_lz4_table[slot];
+      size_t pos = (size_t)(ip - src);
+      calimero_lz4_table[slot] = (uint32_t)(pos + 1);
+
+      if (candidate == 0 || pos + 1 - candidate > CALIMERO_LZ4_MAX_OFFSET ||
+          calimero_lz4_read32(src + candidate - 1) != sequence) {
+        ip++;
+        continue;
+      }
+
+      const uint8_t *ref = src + candidate - 1;
+      while (ip > anchor && ref > src && ip[-1] == ref[-1]) {
+        ip--;
+        ref--;
+      }
+      size_t match_len = CALIMERO_LZ4_MIN_MATCH;
+      while (ip + match_len < match_end_limit && ip[match_len] == ref[match_len]) {
+        match_len++;
+      }
+
+      op = calimero_lz4_write_sequence(op, op_end, anchor, (size_t)(ip - anchor),
+                                       (size_t)(ip - ref), match_len);
+      if (!op) {
+        return 0;
+      }
+      ip += match_len;
+      anchor = ip;
+    }
+  }
+
+  op = calimero_lz4_write_sequence(op, op_end, anchor, (size_t)(end - anchor), 0, 0);
+  return op ? (size_t)(op - dst) : 0;
+}
+
+static int calimero_lz4_read_length(const uint8_t **ip, const uint8_t *ip_end, size_t *len) {
+  uint8_t byte;
+  do {
+    if (*ip >= ip_end) {
+      return -1;
+    }
+    byte = *(*ip)++;
+    *len += byte;
+  } while (byte == 255);
+  return 0;
+}
+
+// Decompresses an LZ4 block into dst. Returns the number of bytes written, or -1 when the
+// block is malformed or does not fit dst_len.
+static int64_t calimero_lz4_decompress(const uint8_t *src, size_t src_len, uint8_t *dst, size_t dst_len) {
+  const uint8_t *ip = src;
+  const uint8_t *ip_end = src + src_len;
+  uint8_t *op = dst;
+  uint8_t *op_end = dst + dst_len;
+
+  while (ip < ip_end) {
+    uint8_t token = *ip++;
+
+    size_t literal_len = token >> 4;
+    if (literal_len == 15 && calimero_lz4_read_length(&ip, ip_end, &literal_len) < 0) {
+      return -1;
+    }
+    if ((size_t)(ip_end - ip) < literal_len || (size_t)(op_end - op) < literal_len) {
+      return -1;
+    }
+    memcpy(op, ip, literal_len);
+    op += literal_len;
+    ip += literal_len;
+    if (ip == ip_end) {
+      break; // the last sequence has literals only
+    }
+
+    if (ip_end - ip < 2) {
+      return -1;
+    }
+    size_t offset = (size_t)ip[0] | ((size_t)ip[1] << 8);
+    ip += 2;
+    if (offset == 0 || offset > (size_t)(op - dst)) {
+      return -1;
+    }
+
+    size_t match_len = token & 15;
+    if (match_len == 15 && calimero_lz4_read_length(&ip, ip_end, &match_len) < 0) {
+      return -1;
+    }
+    match_len += CALIMERO_LZ4_MIN_MATCH;
+    if ((size_t)(op_end - op) < match_len) {
+      return -1;
+    }
+
+    const uint8_t *ref = op - offset;
+    if (offset >= match_len) {
+      memcpy(op, ref, match_len);
+    } else {
+      // Overlapping match (a run): copy byte by byte so earlier output feeds later output
+      for (size_t i = 0; i < match_len; i++) {
+        op[i] = ref[i];
+      }
+    }
+    op += match_len;
+  }
+  return (int64_t)(op - dst);
+}
+
+#endif // CALIMERO_LZ4_H
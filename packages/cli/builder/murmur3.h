@@ -0,0 +1,94 @@
+// MurmurHash3 x86_128 used by builder.c to hash BloomSet members.
+//
+// Header-only port of the public-domain reference (SMHasher). Only 32-bit arithmetic, so the
+// SDK's TypeScript fallback computes identical hashes with plain JS numbers. Output is the four
+// 32-bit words h1..h4, each little-endian.
+
+#ifndef CALIMERO_MURMUR3_H
+#define CALIMERO_MURMUR3_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+static inline uint32_t calimero_murmur3_rotl(uint32_t x, int r) {
+  return (x << r) | (x >> (32 - r));
+}
+
+static inline uint32_t calimero_murmur3_fmix(uint32_t h) {
+  h ^= h >> 16;
+  h *= 0x85ebca6bu;
+  h ^= h >> 13;
+  h *= 0xc2b2ae35u;
+  h ^= h >> 16;
+  return h;
+}
+
+static inline void calimero_murmur3_write32(uint8_t *p, uint32_t value) {
+  p[0] = (uint8_t)value;
+  p[1] = (uint8_t)(value >> 8);
+  p[2] = (uint8_t)(value >> 16);
+  p[3] = (uint8_t)(value >> 24);
+}
+
+static void calimero_murmur3_x86_128(const uint8_t *data, size_t len, uint32_t seed,
+                                     uint8_t out[16]) {
+  const uint32_t c1 = 0x239b961bu, c2 = 0xab0e9789u, c3 = 0x38b34ae5u, c4 = 0xa1e38b93u;
+  uint32_t h1 = seed, h2 = seed, h3 = seed, h4 = seed;
+  size_t nblocks = len / 16;
+
+  for (size_t i = 0; i < nblocks; i++) {
+    uint32_t k[4];
+    memcpy(k, data + i * 16, sizeof(k));  // little-endian target
+
+    k[0] *= c1; k[0] = calimero_murmur3_rotl(k[0], 15); k[0] *= c2; h1 ^= k[0];
+    h1 = calimero_murmur3_rotl(h1, 19); h1 += h2; h1 = h1 * 5 + 0x561ccd1bu;
+    k[1] *= c2; k[1] = calimero_murmur3_rotl(k[1], 16); k[1] *= c3; h2 ^= k[1];
+    h2 = calimero_murmur3_rotl(h2, 17); h2 += h3; h2 = h2 * 5 + 0x0bcaa747u;
+    k[2] *= c3; k[2] = calimero_murmur3_rotl(k[2], 17); k[2] *= c4; h3 ^= k[2];
+    h3 = calimero_murmur3_rotl(h3, 15); h3 += h4; h3 = h3 * 5 + 0x96cd1c35u;
+    k[3] *= c4; k[3] = calimero_murmur3_rotl(k[3], 18); k[3] *= c1; h4 ^= k[3];
+    h4 = calimero_murmur3_rotl(h4, 13); h4 += h1; h4 = h4 * 5 + 0x32ac3b17u;
+  }
+
+  const uint8_t *tail = data + nblocks * 16;
+  uint32_t k1 = 0, k2 = 0, k3 = 0, k4 = 0;
+  switch (len & 15) {
+    case 15: k4 ^= (uint32_t)tail[14] << 16;  // fall through
+    case 14: k4 ^= (uint32_t)tail[13] << 8;   // fall through
+    case 13: k4 ^= (uint32_t)tail[12];
+             k4 *= c4; k4 = calimero_murmur3_rotl(k4, 18); k4 *= c1; h4 ^= k4;  // fall through
+    case 12: k3 ^= (uint32_t)tail[11] << 24;  // fall through
+    case 11: k3 ^= (uint32_t)tail[10] << 16;  // fall through
+    case 10: k3 ^= (uint32_t)tail[9] << 8;    // fall through
+    case 9:  k3 ^= (uint32_t)tail[8];
+             k3 *= c3; k3 = calimero_murmur3_rotl(k3, 17); k3 *= c4; h3 ^= k3;  // fall through
+    case 8:  k2 ^= (uint32_t)tail[7] << 24;   // fall through
+    case 7:  k2 ^= (uint32_t)tail[6] << 16;   // fall through
+    case 6:  k2 ^= (uint32_t)tail[5] << 8;    // fall through
+    case 5:  k2 ^= (uint32_t)tail[4];
+             k2 *= c2; k2 = calimero_murmur3_rotl(k2, 16); k2 *= c3; h2 ^= k2;  // fall through
+    case 4:  k1 ^= (uint32_t)tail[3] << 24;   // fall through
+    case 3:  k1 ^= (uint32_t)tail[2] << 16;   // fall through
+    case 2:  k1 ^= (uint32_t)tail[1] << 8;    // fall through
+    case 1:  k1 ^= (uint32_t)tail[0];
+             k1 *= c1; k1 = calimero_murmur3_rotl(k1, 15); k1 *= c2; h1 ^= k1;
+  }
+
+  h1 ^= (uint32_t)len; h2 ^= (uint32_t)len; h3 ^= (uint32_t)len; h4 ^= (uint32_t)len;
+  h1 += h2; h1 += h3; h1 += h4;
+  h2 += h1; h3 += h1; h4 += h1;
+  h1 = calimero_murmur3_fmix(h1);
+  h2 = calimero_murmur3_fmix(h2);
+  h3 = calimero_murmur3_fmix(h3);
+  h4 = calimero_murmur3_fmix(h4);
+  h1 += h2; h1 += h3; h1 += h4;
+  h2 += h1; h3 += h1; h4 += h1;
+
+  calimero_murmur3_write32(out, h1);
+  calimero_murmur3_write32(out + 4, h2);
+  calimero_murmur3_write32(out + 8, h3);
+  calimero_murmur3_write32(out + 12, h4);
+}
+
+#endif  // CALIMERO_MURMUR3_H
@@ -1456,6 +1456,18 @@ export class AbiEmitter {
           };
         }
         break;
+      case 'SortedMap':
+      case 'IndexedMap':
+        if (type.typeParameters?.params?.length >= 2) {
+          return {
+            kind: 'map',
+            key: this.extractTypeFromAnnotation({ typeAnnotation: type.typeParameters.params[0] }),
+            value: this.extractTypeFromAnnotation({
+              typeAnnotation: type.typeParameters.params[1],
+            }),
+          };
+        }
+        break;
       case 'UnorderedSet':
         // Rust schema doesn't support "set", so convert to list
         if (type.typeParameters?.params?.length >= 1) {
@@ -1477,10 +1489,31 @@ export class AbiEmitter {
           } as any;
         }
         break;
+      case 'AppendLog':
+        if (type.typeParameters?.params?.length >= 1) {
+          return {
+            kind: 'vector',
+            inner: this.extractTypeFromAnnotation({
+              typeAnnotation: type.typeParameters.params[0],
+            }),
+          } as any;
+        }
+        break;
+      case 'PackedVector': {
+        // PackedVector<'f64'> is a list of the scalar named by its type argument
+        const element = type.typeParameters?.params?.[0]?.literal?.value;
+        if (typeof element === 'string') {
+          return { kind: 'vector', inner: { kind: 'scalar', scalar: element } } as any;
+        }
+        break;
+      }
       case 'Counter':
         // Counter returns u64 value, but is stored as collection reference (32 bytes)
         // ABI represents the logical type (u64), deserializer handles the storage format
         return { kind: 'u64' } as any;
+      case 'BloomSet':
+        // BloomSet<T> only answers membership queries; its state is the chunked bit array
+        return { kind: 'scalar', scalar: 'bytes' } as any;
       case 'LwwRegister':
         if (type.typeParameters?.params?.length >= 1) {
           return this.extractTypeFromAnnotation({ typeAnnotation: type.typeParameters.params[0] });
@@ -2049,6 +2082,36 @@ export class AbiEmitter {
         }
         break;
       }
+      case 'SortedMap': {
+        if (type.typeParameters?.params?.length >= 2) {
+          return {
+            kind: 'map',
+            key: this.serializeTypeRefWithCrdtMetadata({
+              typeAnnotation: type.typeParameters.params[0],
+            }),
+            value: this.serializeTypeRefWithCrdtMetadata({
+              typeAnnotation: type.typeParameters.params[1],
+            }),
+            crdt_type: 'sorted_map',
+          };
+        }
+        break;
+      }
+      case 'IndexedMap': {
+        if (type.typeParameters?.params?.length >= 2) {
+          return {
+            kind: 'map',
+            key: this.serializeTypeRefWithCrdtMetadata({
+              typeAnnotation: type.typeParameters.params[0],
+            }),
+            value: this.serializeTypeRefWithCrdtMetadata({
+              typeAnnotation: type.typeParameters.params[1],
+            }),
+            crdt_type: 'indexed_map',
+          };
+        }
+        break;
+      }
       case 'UnorderedSet': {
         if (type.typeParameters?.params?.length >= 1) {
           const itemType = this.serializeTypeRefWithCrdtMetadata({
@@ -2075,6 +2138,22 @@ export class AbiEmitter {
         }
         break;
       }
+      case 'AppendLog': {
+        // Stored as per-executor segments, not one entry per element
+        return {
+          kind: 'record',
+          fields: [],
+          crdt_type: 'append_log',
+        };
+      }
+      case 'PackedVector': {
+        // Stored as raw chunks, not one entry per element: opaque like the other chunked types
+        return {
+          kind: 'record',
+          fields: [],
+          crdt_type: 'packed_vector',
+        };
+      }
       case 'Counter': {
         return {
           kind: 'record',
@@ -2082,6 +2161,13 @@ export class AbiEmitter {
           crdt_type: 'counter',
         };
       }
+      case 'BloomSet': {
+        return {
+          kind: 'record',
+          fields: [],
+          crdt_type: 'bloom_set',
+        };
+      }
       case 'LwwRegister': {
         if (type.typeParameters?.params?.length >= 1) {
           const innerType = this.serializeTypeRefWithCrdtMetadata({
@@ -6,9 +6,10 @@
  * Main entry point for the build tools
  */
 
-import { Command } from 'commander';
+import { Command, Option } from 'commander';
 import { buildCommand } from './commands/build.js';
 import { validateCommand } from './commands/validate.js';
+import { LOG_LEVELS } from './compiler/rollup.js';
 
 const program = new Command();
 
@@ -24,6 +25,28 @@ program
   .option('-o, --output <path>', 'Output path for WASM file', 'build/service.wasm')
   .option('--verbose', 'Show detailed build output', false)
   .option('--no-optimize', 'Skip WASM optimization')
+  .option(
+    '--snapshot',
+    'Pre-initialize the QuickJS runtime at build time and snapshot it into the WASM',
+    false
+  )
+  .option('--release', 'Release bundle: aggressive tree-shaking and minification', false)
+  .option(
+    '--batch-events',
+    "Send each invocation's events in one emit_batch host call (host must provide it)",
+    false
+  )
+  .option(
+    '--batch-xcalls',
+    "Send each invocation's xcalls in one xcall_batch host call (host must provide it)",
+    false
+  )
+  .addOption(
+    new Option(
+      '--log-level <level>',
+      'Strip SDK logs below this level (default: debug, warn with --release)'
+    ).choices([...LOG_LEVELS])
+  )
   .action(buildCommand);
 
 program
@@ -3,10 +3,11 @@
  */
 
 import signale from 'signale';
-import { bundleWithRollup } from '../compiler/rollup.js';
+import { bundleWithRollup, LogLevelName } from '../compiler/rollup.js';
 import { compileToC } from '../compiler/quickjs.js';
 import { compileToWasm } from '../compiler/wasm.js';
 import { optimizeWasm } from '../compiler/optimize.js';
+import { snapshotWasm } from '../compiler/snapshot.js';
 import { generateMethodsHeader } from '../compiler/methods.js';
 import {
   generateAbiJson,
@@ -23,6 +24,11 @@ interface BuildOptions {
   output: string;
   verbose: boolean;
   optimize: boolean;
+  snapshot: boolean;
+  release: boolean;
+  logLevel?: LogLevelName;
+  batchEvents: boolean;
+  batchXcalls: boolean;
 }
 
 export async function buildCommand(source: string, options: BuildOptions): Promise<void> {
@@ -61,6 +67,16 @@ export async function buildCommand(source: string, options: BuildOptions): Promi
       }
     }
 
+    // Record the runtime log level in the ABI metadata (env/api.ts falls back to it when the
+    // bundle carries no build-time level)
+    const logLevel = options.logLevel ?? (options.release ? 'warn' : undefined);
+    if (logLevel) {
+      const manifest = JSON.parse(fs.readFileSync(abiJsonPath, 'utf-8'));
+      manifest.metadata = { ...manifest.metadata, log_level: logLevel };
+      fs.writeFileSync(abiJsonPath, JSON.stringify(manifest, null, 2) + '\n');
+      abiManifest.metadata = manifest.metadata;
+    }
+
     // Step 3: Generate ABI header for WASM embedding
     signale.await('Generating ABI header...');
     await generateAbiHeader(abiJsonPath, {
@@ -75,8 +91,10 @@ export async function buildCommand(source: string, options: BuildOptions): Promi
       verbose: options.verbose,
       outputDir,
       abiManifest,
+      release: options.release,
+      logLevel,
     });
-    signale.success('JavaScript bundled');
+    signale.success(options.release ? 'JavaScript bundled (release)' : 'JavaScript bundled');
 
     // Step 5: Generate methods header
     signale.await('Extracting service methods...');
@@ -96,6 +114,8 @@ export async function buildCommand(source: string, options: BuildOptions): Promi
     const wasmPath = await compileToWasm(cCodePath, {
       verbose: options.verbose,
       outputDir,
+      batchEvents: options.batchEvents,
+      batchXCalls: options.batchXcalls,
     });
     signale.success('Compiled to WASM');
 
@@ -126,6 +146,18 @@ export async function buildCommand(source: string, options: BuildOptions): Promi
       fs.copyFileSync(wasmPath, options.output);
     }
 
+    // Step 10: Pre-initialize and snapshot the QuickJS runtime (if enabled)
+    if (options.snapshot) {
+      signale.await('Snapshotting pre-initialized runtime...');
+      const report = await snapshotWasm(options.output, options.output, {
+        verbose: options.verbose,
+      });
+      signale.success(
+        `Runtime snapshot baked in (${report.memoryPages} pages, ` +
+          `${report.dataSegments} data segments, init ${report.initMs} ms)`
+      );
+    }
+
     // Get final size
     const stats = fs.statSync(options.output);
     const sizeKB = (stats.size / 1024).toFixed(2);
@@ -233,6 +233,14 @@ export async function generateAbiSchema(options: AbiOptions): Promise<string> {
         type: 'string',
         description: 'Root state type name',
       },
+      metadata: {
+        type: 'object',
+        description: 'Build/runtime settings',
+        properties: {
+          log_level: { type: 'string', enum: ['debug', 'info', 'warn', 'error', 'silent'] },
+        },
+        additionalProperties: false,
+      },
     },
     additionalProperties: false,
     definitions: {
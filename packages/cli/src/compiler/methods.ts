@@ -27,6 +27,7 @@ export async function generateMethodsHeader(jsFile: string, outputDir: string):
     });
     registrySnapshot.functions.forEach(fn => methodSet.add(fn));
     methodSet.add('__calimero_sync_next');
+    methodSet.add('__calimero_sync_batch');
     methodSet.add('__calimero_register_merge');
     emitHeaders(outputDir, Array.from(methodSet).sort());
     return;
@@ -90,6 +91,7 @@ export async function generateMethodsHeader(jsFile: string, outputDir: string):
   });
 
   methodSet.add('__calimero_sync_next');
+  methodSet.add('__calimero_sync_batch');
   methodSet.add('__calimero_register_merge');
 
   emitHeaders(outputDir, Array.from(methodSet).sort());
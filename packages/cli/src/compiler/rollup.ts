@@ -9,13 +9,196 @@ import { nodeResolve } from '@rollup/plugin-node-resolve';
 import typescript from '@rollup/plugin-typescript';
 import commonjs from '@rollup/plugin-commonjs';
 import { babel } from '@rollup/plugin-babel';
+import { transformAsync, types as t, PluginObj } from '@babel/core';
+import { minify, type MinifyOptions } from 'terser';
+import type { Scope } from '@babel/traverse';
 import * as fs from 'fs';
 import * as path from 'path';
 
+export type LogLevelName = 'debug' | 'info' | 'warn' | 'error' | 'silent';
+
+export const LOG_LEVELS: readonly LogLevelName[] = ['debug', 'info', 'warn', 'error', 'silent'];
+
 interface RollupOptions {
   verbose: boolean;
   outputDir: string;
   abiManifest: any; // Required ABI manifest to inject
+  /** Release mode: aggressive tree-shaking and minification */
+  release?: boolean;
+  /** Lowest log level kept in the bundle and active at runtime (release defaults to 'warn') */
+  logLevel?: LogLevelName;
+}
+
+/**
+ * Prefix of the SDK's private members and decorator markers, which are safe to
+ * mangle: never read by name through strings, JSON or the ABI. Contract code
+ * uses its own names, so a common name such as `mapId` in a contract is never
+ * touched. Names that also appear in the contract's ABI stay reserved (see
+ * collectAbiNames).
+ */
+const SDK_PRIVATE_PREFIX = /^_calimero/;
+
+/**
+ * Collects every identifier-like string of the ABI manifest (type, field,
+ * method, parameter and event names) so they are never mangled.
+ */
+function collectAbiNames(value: unknown, names: Set<string> = new Set()): Set<string> {
+  if (typeof value === 'string') {
+    names.add(value);
+  } else if (Array.isArray(value)) {
+    value.forEach(item => collectAbiNames(item, names));
+  } else if (value && typeof value === 'object') {
+    for (const [key, child] of Object.entries(value)) {
+      names.add(key);
+      collectAbiNames(child, names);
+    }
+  }
+  return names;
+}
+
+/** Leveled SDK logging helpers (env/api.ts) and the level each one logs at */
+const LEVELED_LOG_FUNCTIONS: Record<string, LogLevelName> = {
+  logDebug: 'debug',
+  log: 'info',
+  logInfo: 'info',
+  logWarn: 'warn',
+  logError: 'error',
+};
+
+/** Package specifiers of the SDK env module and of the root package re-exporting it as `env` */
+const SDK_ENV_MODULE = '@calimero-network/calimero-sdk-js/env';
+const SDK_ROOT_MODULE = '@calimero-network/calimero-sdk-js';
+
+interface ImportBinding {
+  specifier: t.Node;
+  source: string;
+}
+
+function importBinding(scope: Scope, name: string): ImportBinding | null {
+  const binding = scope.getBinding(name);
+  if (!binding || binding.kind !== 'module') return null;
+  const declaration = binding.path.parentPath?.node;
+  if (!t.isImportDeclaration(declaration)) return null;
+  return { specifier: binding.path.node, source: declaration.source.value };
+}
+
+/**
+ * Babel plugin removing statements that call a `disabled` log function of the
+ * SDK env module. `envSources` are import sources resolving to the env module,
+ * `rootSources` those resolving to the SDK root (whose `env` export is the module).
+ */
+function stripLogsBabelPlugin(
+  disabled: string[],
+  envSources: Set<string>,
+  rootSources: Set<string>
+): PluginObj {
+  const isEnvNamespace = (scope: Scope, name: string): boolean => {
+    const bound = importBinding(scope, name);
+    if (!bound) return false;
+    if (t.isImportNamespaceSpecifier(bound.specifier)) return envSources.has(bound.source);
+    return (
+      t.isImportSpecifier(bound.specifier) &&
+      t.isIdentifier(bound.specifier.imported, { name: 'env' }) &&
+      rootSources.has(bound.source)
+    );
+  };
+
+  const isDisabledLog = (scope: Scope, callee: t.Node): boolean => {
+    if (t.isIdentifier(callee)) {
+      const bound = importBinding(scope, callee.name);
+      return (
+        !!bound &&
+        t.isImportSpecifier(bound.specifier) &&
+        t.isIdentifier(bound.specifier.imported) &&
+        disabled.includes(bound.specifier.imported.name) &&
+        envSources.has(bound.source)
+      );
+    }
+    return (
+      t.isMemberExpression(callee) &&
+      !callee.computed &&
+      t.isIdentifier(callee.property) &&
+      disabled.includes(callee.property.name) &&
+      t.isIdentifier(callee.object) &&
+      isEnvNamespace(scope, callee.object.name)
+    );
+  };
+
+  return {
+    visitor: {
+      ExpressionStatement(statement) {
+        const expression = statement.node.expression;
+        if (t.isCallExpression(expression) && isDisabledLog(statement.scope, expression.callee)) {
+          statement.remove();
+        }
+      },
+    },
+  };
+}
+
+/**
+ * Removes leveled log calls below the configured level, arguments included, so
+ * disabled messages cost neither bytecode nor evaluation. Only statements whose
+ * callee is bound to the SDK env module are removed: `logDebug(...)` imported
+ * from it (renamed or not), `env.logInfo(...)` on `import * as env` or on the
+ * root package's `env` export. Same-named methods of user objects are kept.
+ * `logAt` calls are left to the runtime level check.
+ */
+function stripLogsPlugin(level: LogLevelName, entryFile: string): Plugin {
+  const threshold = LOG_LEVELS.indexOf(level);
+  const disabled = Object.keys(LEVELED_LOG_FUNCTIONS).filter(
+    name => LOG_LEVELS.indexOf(LEVELED_LOG_FUNCTIONS[name]) < threshold
+  );
+  let envModuleId: string | null = null;
+  let rootModuleId: string | null = null;
+
+  const mentionsDisabled = new RegExp(`\\b(?:${disabled.join('|') || '$^'})\\b`);
+  const importSources = /\bfrom\s*(['"])([^'"]+)\1/g;
+
+  return {
+    name: 'calimero-strip-logs',
+    async buildStart() {
+      if (disabled.length === 0) return;
+      envModuleId = (await this.resolve(SDK_ENV_MODULE, entryFile))?.id ?? null;
+      rootModuleId = (await this.resolve(SDK_ROOT_MODULE, entryFile))?.id ?? null;
+    },
+    async transform(code, id) {
+      if (disabled.length === 0 || !/\.[cm]?[jt]s$/.test(id)) return null;
+      if (!envModuleId || !mentionsDisabled.test(code)) return null;
+
+      // Match import sources by what they resolve to, so relative SDK imports count too
+      const envSources = new Set<string>();
+      const rootSources = new Set<string>();
+      for (const [, , source] of code.matchAll(importSources)) {
+        const resolved = (await this.resolve(source, id))?.id;
+        if (resolved === envModuleId) envSources.add(source);
+        else if (resolved && resolved === rootModuleId) rootSources.add(source);
+      }
+      if (envSources.size === 0 && rootSources.size === 0) return null;
+
+      const result = await transformAsync(code, {
+        filename: id,
+        babelrc: false,
+        configFile: false,
+        sourceMaps: false,
+        plugins: [() => stripLogsBabelPlugin(disabled, envSources, rootSources)],
+      });
+      return result?.code ? { code: result.code, map: null } : null;
+    },
+  };
+}
+
+/**
+ * Minifies each rendered chunk with terser (release builds)
+ */
+function minifyPlugin(options: MinifyOptions): Plugin {
+  return {
+    name: 'calimero-minify',
+    async renderChunk(code) {
+      const result = await minify(code, { ...options, sourceMap: false });
+      return result.code === undefined ? null : { code: result.code, map: null };
+    },
+  };
 }
 
 /**
@@ -27,6 +210,8 @@ interface RollupOptions {
  */
 export async function bundleWithRollup(source: string, options: RollupOptions): Promise<string> {
   const outputFile = path.join(options.outputDir, 'bundle.js');
+  const release = options.release ?? false;
+  const logLevel = options.logLevel ?? (release ? 'warn' : undefined);
   const normalizedSource = path.resolve(source).replace(/\\/g, '/');
   const entryFile = path.join(options.outputDir, '__calimero_entry.ts');
 
@@ -59,7 +244,11 @@ export async function bundleWithRollup(source: string, options: RollupOptions):
       name: 'abi-inject',
       generateBundle(_options, bundle) {
         // Inject ABI manifest as a global variable (required)
-        const abiCode = `\n// Injected ABI manifest\nif (typeof globalThis !== 'undefined') {\n  globalThis.__CALIMERO_ABI_MANIFEST__ = ${JSON.stringify(options.abiManifest)};\n}\n`;
+        let abiCode = `\n// Injected ABI manifest\nif (typeof globalThis !== 'undefined') {\n  globalThis.__CALIMERO_ABI_MANIFEST__ = ${JSON.stringify(options.abiManifest)};\n}\n`;
+        // Build-time log level (read by env/api.ts before ABI metadata)
+        if (logLevel) {
+          abiCode += `globalThis.__CALIMERO_LOG_LEVEL__ = ${JSON.stringify(logLevel)};\n`;
+        }
 
         // Find the main bundle chunk and prepend ABI code
         for (const fileName in bundle) {
@@ -90,6 +279,7 @@ export async function bundleWithRollup(source: string, options: RollupOptions):
       },
     }),
     commonjs(),
+    stripLogsPlugin(logLevel ?? 'debug', entryFile),
     babel({
       babelHelpers: 'bundled',
       presets: ['@babel/preset-env'],
@@ -97,13 +287,38 @@ export async function bundleWithRollup(source: string, options: RollupOptions):
     }),
   ];
 
-  // Add ABI injection plugin (required)
+  if (release) {
+    const reserved = [...collectAbiNames(options.abiManifest)];
+    plugins.push(
+      minifyPlugin({
+        module: true,
+        compress: { passes: 2 },
+        mangle: {
+          properties: { regex: SDK_PRIVATE_PREFIX, reserved },
+        },
+        // Class names identify @State/@Mergeable types and ABI records at runtime
+        keep_classnames: true,
+        format: { comments: false },
+      })
+    );
+  }
+
+  // Add ABI injection plugin (required, after minification so the manifest stays verbatim)
   plugins.push(abiInjectPlugin());
 
   const bundle = await rollup({
     input: entryFile,
     plugins,
     external: [], // Bundle everything
+    // Release builds trust the `sideEffects` annotations of the SDK package and
+    // treat property reads / unknown globals as pure to drop unused SDK code.
+    treeshake: release
+      ? {
+          preset: 'recommended',
+          propertyReadSideEffects: false,
+          unknownGlobalSideEffects: false,
+        }
+      : true,
     onwarn: (warning, warn) => {
       // Suppress certain warnings
       if (warning.code === 'THIS_IS_UNDEFINED') return;
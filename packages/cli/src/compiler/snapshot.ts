@@ -0,0 +1,646 @@
+/**
+ * WASM pre-initialization snapshot
+ *
+ * Instantiates the compiled service in the local (Node.js) Wasm engine, runs the
+ * exported `calimero_preinit` initializer (QuickJS runtime created, module
+ * evaluated, dispatchers registered) and bakes the resulting linear memory and
+ * mutable globals back into the binary, Wizer-style. Every real invocation then
+ * starts from an initialized QuickJS heap instead of re-evaluating the bundle.
+ */
+
+import * as fs from 'fs';
+
+interface SnapshotOptions {
+  verbose: boolean;
+  /** Exported initializer to run before snapshotting */
+  initializer?: string;
+}
+
+export interface SnapshotReport {
+  initMs: number;
+  memoryPages: number;
+  dataSegments: number;
+  dataBytes: number;
+  inputSize: number;
+  outputSize: number;
+}
+
+const DEFAULT_INITIALIZER = 'calimero_preinit';
+const GLOBAL_EXPORT_PREFIX = '__calimero_snapshot_global_';
+const WASM_PAGE_SIZE = 65536;
+/** Zero runs shorter than this are kept inside a segment (a new segment costs ~8 bytes) */
+const SEGMENT_GAP_THRESHOLD = 16;
+
+const SECTION_START = 8;
+const SECTION_IMPORT = 2;
+const SECTION_MEMORY = 5;
+const SECTION_GLOBAL = 6;
+const SECTION_EXPORT = 7;
+const SECTION_DATA = 11;
+const SECTION_DATA_COUNT = 12;
+
+const EXTERNAL_FUNC = 0;
+const EXTERNAL_TABLE = 1;
+const EXTERNAL_MEMORY = 2;
+const EXTERNAL_GLOBAL = 3;
+
+const VALTYPE_I32 = 0x7f;
+const VALTYPE_I64 = 0x7e;
+const VALTYPE_F32 = 0x7d;
+const VALTYPE_F64 = 0x7c;
+
+/* Minimal view of the WebAssembly JS API (the CLI compiles against lib ES2022 only) */
+interface WasmGlobal {
+  value: number | bigint;
+}
+interface WasmMemory {
+  buffer: ArrayBuffer;
+}
+interface WasmInstance {
+  exports: Record<string, unknown>;
+}
+interface WasmApi {
+  Module: new (bytes: Uint8Array) => unknown;
+  Instance: new (module: unknown, imports: Record<string, Record<string, unknown>>) => WasmInstance;
+  validate(bytes: Uint8Array): boolean;
+}
+const wasmApi = (globalThis as unknown as { WebAssembly: WasmApi }).WebAssembly;
+
+interface Section {
+  id: number;
+  /** Offset of the section payload */
+  start: number;
+  /** End offset (exclusive) of the section payload */
+  end: number;
+}
+
+interface GlobalEntry {
+  valtype: number;
+  mutable: boolean;
+  /** Raw init expression bytes (including the trailing `end`) */
+  init: Uint8Array;
+}
+
+interface ExportEntry {
+  name: string;
+  kind: number;
+  index: number;
+}
+
+interface Limits {
+  flags: number;
+  min: number;
+  max?: number;
+}
+
+class Reader {
+  offset: number;
+
+  constructor(
+    private readonly bytes: Uint8Array,
+    offset = 0
+  ) {
+    this.offset = offset;
+  }
+
+  byte(): number {
+    if (this.offset >= this.bytes.length) {
+      throw new Error('Unexpected end of WASM binary');
+    }
+    return this.bytes[this.offset++];
+  }
+
+  u32(): number {
+    let result = 0;
+    let shift = 0;
+    for (;;) {
+      const b = this.byte();
+      result |= (b & 0x7f) << shift;
+      if ((b & 0x80) === 0) {
+        return result >>> 0;
+      }
+      shift += 7;
+    }
+  }
+
+  skipLeb(): void {
+    while (this.byte() & 0x80) {
+      // continuation byte
+    }
+  }
+
+  bytesOf(length: number): Uint8Array {
+    const slice = this.bytes.subarray(this.offset, this.offset + length);
+    this.offset += length;
+    return slice;
+  }
+
+  name(): string {
+    return new TextDecoder().decode(this.bytesOf(this.u32()));
+  }
+
+  limits(): Limits {
+    const flags = this.u32();
+    const min = this.u32();
+    const max = flags & 1 ? this.u32() : undefined;
+    return { flags, min, max };
+  }
+
+  /** Skips a constant expression and returns its raw bytes */
+  constExpr(): Uint8Array {
+    const start = this.offset;
+    for (;;) {
+      const op = this.byte();
+      switch (op) {
+        case 0x0b:
+          return this.bytes.subarray(start, this.offset);
+        case 0x41: // i32.const
+        case 0x42: // i64.const
+        case 0x23: // global.get
+        case 0xd2: // ref.func
+          this.skipLeb();
+          break;
+        case 0x43: // f32.const
+          this.offset += 4;
+          break;
+        case 0x44: // f64.const
+          this.offset += 8;
+          break;
+        case 0xd0: // ref.null
+          this.byte();
+          break;
+        default:
+          // extended-const arithmetic (i32.add, ...) carries no immediates
+          break;
+      }
+    }
+  }
+}
+
+class Writer {
+  private readonly chunks: number[] = [];
+
+  byte(value: number): this {
+    this.chunks.push(value & 0xff);
+    return this;
+  }
+
+  u32(value: number): this {
+    let v = value >>> 0;
+    do {
+      let b = v & 0x7f;
+      v >>>= 7;
+      if (v !== 0) b |= 0x80;
+      this.chunks.push(b);
+    } while (v !== 0);
+    return this;
+  }
+
+  s64(value: bigint): this {
+    let v = value;
+    for (;;) {
+      const b = Number(v & 0x7fn);
+      v >>= 7n;
+      const done = (v === 0n && (b & 0x40) === 0) || (v === -1n && (b & 0x40) !== 0);
+      this.chunks.push(done ? b : b | 0x80);
+      if (done) return this;
+    }
+  }
+
+  bytes(data: ArrayLike<number>): this {
+    for (let i = 0; i < data.length; i++) {
+      this.chunks.push(data[i]);
+    }
+    return this;
+  }
+
+  name(value: string): this {
+    const encoded = new TextEncoder().encode(value);
+    return this.u32(encoded.length).bytes(encoded);
+  }
+
+  limits(limits: Limits): this {
+    this.u32(limits.flags).u32(limits.min);
+    if (limits.max !== undefined) this.u32(limits.max);
+    return this;
+  }
+
+  toBytes(): Uint8Array {
+    return Uint8Array.from(this.chunks);
+  }
+}
+
+function parseSections(bytes: Uint8Array): Section[] {
+  if (
+    bytes.length < 8 ||
+    bytes[0] !== 0x00 ||
+    bytes[1] !== 0x61 ||
+    bytes[2] !== 0x73 ||
+    bytes[3] !== 0x6d
+  ) {
+    throw new Error('Not a WebAssembly binary');
+  }
+  const reader = new Reader(bytes, 8);
+  const sections: Section[] = [];
+  while (reader.offset < bytes.length) {
+    const id = reader.byte();
+    const size = reader.u32();
+    sections.push({ id, start: reader.offset, end: reader.offset + size });
+    reader.offset += size;
+  }
+  return sections;
+}
+
+function findSection(bytes: Uint8Array, sections: Section[], id: number): Reader | null {
+  const section = sections.find(s => s.id === id);
+  return section ? new Reader(bytes.subarray(0, section.end), section.start) : null;
+}
+
+function countImportedGlobals(bytes: Uint8Array, sections: Section[]): number {
+  const reader = findSection(bytes, sections, SECTION_IMPORT);
+  if (!reader) return 0;
+  let globals = 0;
+  const count = reader.u32();
+  for (let i = 0; i < count; i++) {
+    reader.name();
+    reader.name();
+    const kind = reader.byte();
+    switch (kind) {
+      case EXTERNAL_FUNC:
+        reader.u32();
+        break;
+      case EXTERNAL_TABLE:
+        reader.byte();
+        reader.limits();
+        break;
+      case EXTERNAL_MEMORY:
+        throw new Error('Imported memories cannot be snapshotted');
+      case EXTERNAL_GLOBAL:
+        reader.byte();
+        reader.byte();
+        globals++;
+        break;
+      default:
+        throw new Error(`Unknown import kind ${kind}`);
+    }
+  }
+  return globals;
+}
+
+function parseGlobals(bytes: Uint8Array, sections: Section[]): GlobalEntry[] {
+  const reader = findSection(bytes, sections, SECTION_GLOBAL);
+  if (!reader) return [];
+  const count = reader.u32();
+  const globals: GlobalEntry[] = [];
+  for (let i = 0; i < count; i++) {
+    const valtype = reader.byte();
+    const mutable = reader.byte() === 1;
+    globals.push({ valtype, mutable, init: reader.constExpr() });
+  }
+  return globals;
+}
+
+function parseExports(bytes: Uint8Array, sections: Section[]): ExportEntry[] {
+  const reader = findSection(bytes, sections, SECTION_EXPORT);
+  if (!reader) return [];
+  const count = reader.u32();
+  const exports: ExportEntry[] = [];
+  for (let i = 0; i < count; i++) {
+    exports.push({ name: reader.name(), kind: reader.byte(), index: reader.u32() });
+  }
+  return exports;
+}
+
+function parseMemory(bytes: Uint8Array, sections: Section[]): Limits {
+  const reader = findSection(bytes, sections, SECTION_MEMORY);
+  if (!reader || reader.u32() !== 1) {
+    throw new Error('Snapshot requires exactly one defined memory');
+  }
+  const limits = reader.limits();
+  if (limits.flags & ~1) {
+    throw new Error('Shared or 64-bit memories cannot be snapshotted');
+  }
+  return limits;
+}
+
+function assertNoPassiveSegments(bytes: Uint8Array, sections: Section[]): void {
+  const reader = findSection(bytes, sections, SECTION_DATA);
+  if (!reader) return;
+  const count = reader.u32();
+  for (let i = 0; i < count; i++) {
+    const flags = reader.u32();
+    if (flags === 1) {
+      throw new Error('Passive data segments (memory.init) cannot be snapshotted');
+    }
+    if (flags === 2) reader.u32();
+    reader.constExpr();
+    reader.offset += reader.u32();
+  }
+}
+
+function encodeSection(id: number, payload: Uint8Array): Uint8Array {
+  const header = new Writer().byte(id).u32(payload.length).toBytes();
+  const out = new Uint8Array(header.length + payload.length);
+  out.set(header, 0);
+  out.set(payload, header.length);
+  return out;
+}
+
+function encodeExports(exports: ExportEntry[]): Uint8Array {
+  const writer = new Writer().u32(exports.length);
+  for (const entry of exports) {
+    writer.name(entry.name).byte(entry.kind).u32(entry.index);
+  }
+  return writer.toBytes();
+}
+
+function encodeGlobalInit(valtype: number, value: number | bigint): Uint8Array {
+  const writer = new Writer();
+  switch (valtype) {
+    case VALTYPE_I32:
+      writer.byte(0x41).s64(BigInt(Number(value) | 0));
+      break;
+    case VALTYPE_I64:
+      writer.byte(0x42).s64(BigInt.asIntN(64, BigInt(value)));
+      break;
+    case VALTYPE_F32: {
+      const view = new DataView(new ArrayBuffer(4));
+      view.setFloat32(0, Number(value), true);
+      writer.byte(0x43).bytes(new Uint8Array(view.buffer));
+      break;
+    }
+    case VALTYPE_F64: {
+      const view = new DataView(new ArrayBuffer(8));
+      view.setFloat64(0, Number(value), true);
+      writer.byte(0x44).bytes(new Uint8Array(view.buffer));
+      break;
+    }
+    default:
+      throw new Error(`Cannot snapshot mutable global of type 0x${valtype.toString(16)}`);
+  }
+  return writer.byte(0x0b).toBytes();
+}
+
+/**
+ * Splits linear memory into active data segments, skipping long zero runs
+ * (fresh memory is zero-initialized, so they never need to be stored).
+ */
+function encodeDataSegments(memory: Uint8Array): { payload: Uint8Array; count: number; bytes: number } {
+  const segments: Array<[number, number]> = [];
+  let i = 0;
+  while (i < memory.length) {
+    while (i < memory.length && memory[i] === 0) i++;
+    if (i >= memory.length) break;
+    const start = i;
+    let end = i;
+    while (i < memory.length) {
+      if (memory[i] !== 0) {
+        end = ++i;
+        continue;
+      }
+      let zeros = 0;
+      while (i < memory.length && memory[i] === 0 && zeros < SEGMENT_GAP_THRESHOLD) {
+        zeros++;
+        i++;
+      }
+      if (zeros >= SEGMENT_GAP_THRESHOLD || i >= memory.length) break;
+    }
+    segments.push([start, end]);
+  }
+
+  const writer = new Writer().u32(segments.length);
+  let total = 0;
+  for (const [start, end] of segments) {
+    writer
+      .u32(0)
+      .byte(0x41)
+      .s64(BigInt(start | 0))
+      .byte(0x0b)
+      .u32(end - start)
+      .bytes(memory.subarray(start, end));
+    total += end - start;
+  }
+  return { payload: writer.toBytes(), count: segments.length, bytes: total };
+}
+
+function rebuildModule(
+  bytes: Uint8Array,
+  sections: Section[],
+  replacements: Map<number, Uint8Array | null>
+): Uint8Array {
+  const parts: Uint8Array[] = [bytes.subarray(0, 8)];
+  for (const section of sections) {
+    if (replacements.has(section.id) && section.id !== 0) {
+      const payload = replacements.get(section.id);
+      if (payload) parts.push(encodeSection(section.id, payload));
+      continue;
+    }
+    const header = new Writer()
+      .byte(section.id)
+      .u32(section.end - section.start)
+      .toBytes();
+    parts.push(header, bytes.subarray(section.start, section.end));
+  }
+  const total = parts.reduce((sum, part) => sum + part.length, 0);
+  const out = new Uint8Array(total);
+  let offset = 0;
+  for (const part of parts) {
+    out.set(part, offset);
+    offset += part.length;
+  }
+  return out;
+}
+
+/**
+ * Host imports used while the initializer runs. Only logging is allowed: any
+ * other Calimero host call would bake host-specific data (registers, ids, time)
+ * into the snapshot and is rejected.
+ */
+function createInitImports(
+  module: unknown,
+  getMemory: () => WasmMemory,
+  logs: string[]
+): Record<string, Record<string, unknown>> {
+  const imports: Record<string, Record<string, unknown>> = {};
+  const descriptors = (
+    wasmApi as unknown as {
+      Module: { imports(module: unknown): Array<{ module: string; name: string; kind: string }> };
+    }
+  ).Module.imports(module);
+
+  for (const descriptor of descriptors) {
+    if (descriptor.kind !== 'function') {
+      throw new Error(`Unsupported import ${descriptor.module}.${descriptor.name}`);
+    }
+    const namespace = (imports[descriptor.module] ??= {});
+    if (descriptor.module === 'env' && descriptor.name === 'log_utf8') {
+      namespace[descriptor.name] = (bufferPtr: bigint) => {
+        const view = new DataView(getMemory().buffer);
+        const ptr = Number(view.getBigUint64(Number(bufferPtr), true));
+        const len = Number(view.getBigUint64(Number(bufferPtr) + 8, true));
+        logs.push(new TextDecoder().decode(new Uint8Array(getMemory().buffer, ptr, len)));
+      };
+    } else if (descriptor.module === 'wasi_snapshot_preview1') {
+      namespace[descriptor.name] = createWasiStub(descriptor.name, getMemory);
+    } else {
+      namespace[descriptor.name] = () => {
+        throw new Error(
+          `Host function ${descriptor.module}.${descriptor.name} called during pre-initialization`
+        );
+      };
+    }
+  }
+  return imports;
+}
+
+/** WASI stubs mirroring wasi-stub: report success, swallow stdio */
+function createWasiStub(name: string, getMemory: () => WasmMemory): (...args: number[]) => number {
+  if (name === 'fd_write') {
+    return (_fd: number, iovs: number, iovsLen: number, nwritten: number) => {
+      const view = new DataView(getMemory().buffer);
+      let written = 0;
+      for (let i = 0; i < iovsLen; i++) {
+        written += view.getUint32(iovs + i * 8 + 4, true);
+      }
+      view.setUint32(nwritten, written, true);
+      return 0;
+    };
+  }
+  return () => 0;
+}
+
+/**
+ * Pre-initializes a compiled service and writes the snapshotted binary
+ *
+ * @param input - Input WASM file (must export the initializer and its memory)
+ * @param output - Output WASM file (may be the same path as input)
+ * @param options - Snapshot options
+ */
+export async function snapshotWasm(
+  input: string,
+  output: string,
+  options: SnapshotOptions
+): Promise<SnapshotReport> {
+  const initializer = options.initializer ?? DEFAULT_INITIALIZER;
+  const original = new Uint8Array(fs.readFileSync(input));
+  const sections = parseSections(original);
+
+  const exports = parseExports(original, sections);
+  if (!exports.some(e => e.name === initializer && e.kind === EXTERNAL_FUNC)) {
+    throw new Error(`WASM module does not export initializer "${initializer}"`);
+  }
+  const memoryExport = exports.find(e => e.kind === EXTERNAL_MEMORY);
+  if (!memoryExport) {
+    throw new Error('WASM module does not export its memory');
+  }
+  assertNoPassiveSegments(original, sections);
+
+  const importedGlobals = countImportedGlobals(original, sections);
+  const globals = parseGlobals(original, sections);
+  const memoryLimits = parseMemory(original, sections);
+
+  // Instrument: export every mutable global so its post-init value can be read back
+  const instrumentedExports = [...exports];
+  globals.forEach((global, i) => {
+    if (global.mutable) {
+      instrumentedExports.push({
+        name: `${GLOBAL_EXPORT_PREFIX}${i}`,
+        kind: EXTERNAL_GLOBAL,
+        index: importedGlobals + i,
+      });
+    }
+  });
+  const instrumented = rebuildModule(
+    original,
+    sections,
+    new Map([[SECTION_EXPORT, encodeExports(instrumentedExports)]])
+  );
+
+  const logs: string[] = [];
+  const module = new wasmApi.Module(instrumented);
+  let instance: WasmInstance | null = null;
+  const getMemory = () => instance!.exports[memoryExport.name] as WasmMemory;
+  instance = new wasmApi.Instance(module, createInitImports(module, getMemory, logs));
+
+  const started = Date.now();
+  try {
+    const ctors = instance.exports.__wasm_call_ctors;
+    if (typeof ctors === 'function') ctors();
+    (instance.exports[initializer] as () => void)();
+  } catch (error) {
+    if (options.verbose) {
+      logs.forEach(line => console.log(`[preinit] ${line}`));
+    }
+    throw new Error(`Pre-initialization failed: ${error}`);
+  }
+  const initMs = Date.now() - started;
+
+  if (options.verbose) {
+    logs.forEach(line => console.log(`[preinit] ${line}`));
+  }
+
+  // Snapshot memory and globals into the original (un-instrumented) module
+  const memory = new Uint8Array(getMemory().buffer);
+  const memoryPages = memory.length / WASM_PAGE_SIZE;
+  const data = encodeDataSegments(memory);
+
+  const globalsWriter = new Writer().u32(globals.length);
+  globals.forEach((global, i) => {
+    globalsWriter.byte(global.valtype).byte(global.mutable ? 1 : 0);
+    if (global.mutable) {
+      const value = (instance!.exports[`${GLOBAL_EXPORT_PREFIX}${i}`] as WasmGlobal).value;
+      globalsWriter.bytes(encodeGlobalInit(global.valtype, value));
+    } else {
+      globalsWriter.bytes(global.init);
+    }
+  });
+
+  const memoryWriter = new Writer().u32(1).limits({
+    ...memoryLimits,
+    min: Math.max(memoryLimits.min, memoryPages),
+  });
+
+  // The initializer has run; drop its export (and any start function) so hosts cannot re-run it
+  const finalExports = exports.filter(e => e.name !== initializer);
+
+  const replacements = new Map<number, Uint8Array | null>([
+    [SECTION_MEMORY, memoryWriter.toBytes()],
+    [SECTION_GLOBAL, globalsWriter.toBytes()],
+    [SECTION_EXPORT, encodeExports(finalExports)],
+    [SECTION_START, null],
+    [SECTION_DATA, data.payload],
+    [SECTION_DATA_COUNT, new Writer().u32(data.count).toBytes()],
+  ]);
+  let snapshot = rebuildModule(original, sections, replacements);
+  if (!sections.some(s => s.id === SECTION_DATA)) {
+    snapshot = appendDataSection(snapshot, data.payload);
+  }
+
+  if (!wasmApi.validate(snapshot)) {
+    throw new Error('Snapshotted WASM failed validation');
+  }
+
+  fs.writeFileSync(output, snapshot);
+
+  return {
+    initMs,
+    memoryPages,
+    dataSegments: data.count,
+    dataBytes: data.bytes,
+    inputSize: original.length,
+    outputSize: snapshot.length,
+  };
+}
+
+/** Data section goes after the code section; only needed for modules that had no data at all */
+function appendDataSection(bytes: Uint8Array, payload: Uint8Array): Uint8Array {
+  const sections = parseSections(bytes);
+  const code = sections.find(s => s.id === 10);
+  const insertAt = code ? code.end : bytes.length;
+  const section = encodeSection(SECTION_DATA, payload);
+  const out = new Uint8Array(bytes.length + section.length);
+  out.set(bytes.subarray(0, insertAt), 0);
+  out.set(section, insertAt);
+  out.set(bytes.subarray(insertAt), insertAt + section.length);
+  return out;
+}
@@ -16,6 +16,10 @@ const __dirname = path.dirname(__filename);
 interface WasmOptions {
   verbose: boolean;
   outputDir: string;
+  /** Hand queued events to the host through the `emit_batch` import */
+  batchEvents?: boolean;
+  /** Hand queued cross-context calls to the host through the `xcall_batch` import */
+  batchXCalls?: boolean;
 }
 
 /**
@@ -99,6 +103,12 @@ export async function compileToWasm(cCodePath: string, options: WasmOptions): Pr
     '-Wl,--export=__data_end',
     '-Wl,--export=__heap_base',
   ];
+  if (options.batchEvents) {
+    flagsArray.push('-DCALIMERO_EMIT_BATCH');
+  }
+  if (options.batchXCalls) {
+    flagsArray.push('-DCALIMERO_XCALL_BATCH');
+  }
   // Extract method names from methods.h to explicitly export them
   const methodsH = path.join(options.outputDir, 'methods.h');
   const methodExports: string[] = [];
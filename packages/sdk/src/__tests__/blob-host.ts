@@ -0,0 +1,114 @@
+/**
+ * In-memory blob host for tests
+ *
+ * Replaces the `blob_*` stubs of the test setup with a store keyed by blob id (the SHA256 of the
+ * content, like the node). Reads return at most `maxRead` bytes per call, as a real host may.
+ * Announcements are recorded in `announced`.
+ */
+
+import { sha256 } from '../utils/sha256';
+
+export interface BlobHostOptions {
+  /** Install the number-based `blob_stream_*` wrappers as well */
+  numeric?: boolean;
+  maxRead?: number;
+}
+
+interface Handle {
+  parts: Uint8Array[];
+  data?: Uint8Array;
+  offset: number;
+}
+
+const BLOB_FUNCTIONS = [
+  'blob_create',
+  'blob_open',
+  'blob_read',
+  'blob_write',
+  'blob_close',
+  'blob_announce_to_context',
+];
+const STREAM_FUNCTIONS = ['create', 'open', 'read', 'write'].map(name => `blob_stream_${name}`);
+
+export function installBlobHost(options: BlobHostOptions = {}) {
+  const host = (global as any).env;
+  const originals = Object.fromEntries(BLOB_FUNCTIONS.map(name => [name, host[name]]));
+  const maxRead = options.maxRead ?? Infinity;
+  const blobs = new Map<string, Uint8Array>();
+  const handles = new Map<number, Handle>();
+  const announced: { blobId: Uint8Array; contextId: Uint8Array }[] = [];
+  // `uploads` counts closed write handles, i.e. blobs created
+  const calls = { open: 0, read: 0, write: 0, close: 0, uploads: 0 };
+  let nextFd = 1;
+
+  const create = () => {
+    handles.set(nextFd, { parts: [], offset: 0 });
+    return nextFd++;
+  };
+  const open = (blobId: Uint8Array) => {
+    calls.open++;
+    const data = blobs.get(blobId.join(','));
+    if (!data) return 0;
+    handles.set(nextFd, { parts: [], data, offset: 0 });
+    return nextFd++;
+  };
+  const read = (fd: number, buffer: Uint8Array) => {
+    calls.read++;
+    const handle = handles.get(fd)!;
+    const chunk = handle.data!.subarray(
+      handle.offset,
+      handle.offset + Math.min(buffer.length, maxRead)
+    );
+    buffer.set(chunk);
+    handle.offset += chunk.length;
+    return chunk.length;
+  };
+  const write = (fd: number, data: Uint8Array) => {
+    calls.write++;
+    handles.get(fd)!.parts.push(data.slice());
+    return data.length;
+  };
+
+  host.blob_close = (fd: bigint, blobId: Uint8Array) => {
+    calls.close++;
+    const handle = handles.get(Number(fd))!;
+    handles.delete(Number(fd));
+    if (!handle.data) {
+      calls.uploads++;
+      const size = handle.parts.reduce((sum, part) => sum + part.length, 0);
+      const data = new Uint8Array(size);
+      let offset = 0;
+      for (const part of handle.parts) {
+        data.set(part, offset);
+        offset += part.length;
+      }
+      blobId.set(sha256(data));
+      blobs.set(blobId.join(','), data);
+    }
+    return true;
+  };
+  host.blob_announce_to_context = (blobId: Uint8Array, contextId: Uint8Array) => {
+    announced.push({ blobId: blobId.slice(), contextId: contextId.slice() });
+    return 1;
+  };
+  host.blob_create = () => BigInt(create());
+  host.blob_open = (blobId: Uint8Array) => BigInt(open(blobId));
+  host.blob_read = (fd: bigint, buffer: Uint8Array) => BigInt(read(Number(fd), buffer));
+  host.blob_write = (fd: bigint, data: Uint8Array) => BigInt(write(Number(fd), data));
+  if (options.numeric) {
+    host.blob_stream_create = create;
+    host.blob_stream_open = open;
+    host.blob_stream_read = read;
+    host.blob_stream_write = write;
+  }
+
+  /** Puts the setup stubs back */
+  const restore = () => {
+    for (const name of STREAM_FUNCTIONS) {
+      delete host[name];
+    }
+    Object.assign(host, originals);
+  };
+
+  return { host, blobs, handles, calls, announced, restore };
+}
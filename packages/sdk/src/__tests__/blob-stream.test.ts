@@ -0,0 +1,164 @@
+/**
+ * Blob stream tests
+ */
+
+import './setup';
+import { BlobReader, BlobWriter, ChunkPool } from '../blobs';
+import { sha256 } from '../utils/sha256';
+import { installBlobHost } from './blob-host';
+
+const CHUNK = 16;
+
+function pattern(length: number, seed = 0): Uint8Array {
+  return Uint8Array.from({ length }, (_, i) => (i * 31 + seed) & 0xff);
+}
+
+describe('blob streams', () => {
+  let restore: () => void = () => {};
+  const install = (numeric: boolean, maxRead?: number) => {
+    const store = installBlobHost({ numeric, maxRead });
+    restore = store.restore;
+    return store;
+  };
+
+  afterEach(() => {
+    restore();
+  });
+
+  it('round-trips a blob through the writer and reader', () => {
+    const store = install(true);
+    const data = pattern(CHUNK * 5 + 3);
+
+    const writer = BlobWriter.create({ chunkSize: CHUNK, hash: true });
+    for (let offset = 0; offset < data.length; offset += 7) {
+      writer.write(data.subarray(offset, offset + 7));
+    }
+    const blobId = writer.close();
+    expect(writer.bytesWritten).toBe(data.length);
+    expect(writer.digest()).toEqual(sha256(data));
+    expect(store.blobs.get(blobId.join(','))).toEqual(data);
+
+    const reader = BlobReader.open(blobId, { chunkSize: CHUNK });
+    expect(reader.readAll()).toEqual(data);
+    expect(store.handles.size).toBe(0);
+  });
+
+  it('gathers small writes into chunks and sends large ones without buffering', () => {
+    const store = install(true);
+    const writer = BlobWriter.create({ chunkSize: CHUNK });
+    for (let i = 0; i < CHUNK * 2; i++) {
+      writer.write(Uint8Array.of(i));
+    }
+    expect(store.calls.write).toBe(2);
+
+    writer.write(pattern(CHUNK * 4));
+    expect(store.calls.write).toBe(3);
+
+    writer.write(pattern(3));
+    writer.close();
+    expect(store.calls.write).toBe(4);
+  });
+
+  it('iterates chunks with for...of and for await, hashing incrementally', async () => {
+    install(true, 10);
+    const data = pattern(CHUNK * 3 + 1, 7);
+    const writer = BlobWriter.create({ chunkSize: CHUNK });
+    writer.write(data);
+    const blobId = writer.close();
+
+    const sizes: number[] = [];
+    const syncReader = BlobReader.open(blobId, { chunkSize: CHUNK, hash: true });
+    for (const chunk of syncReader) {
+      sizes.push(chunk.length);
+    }
+    expect(sizes).toEqual([10, 10, 10, 10, 9]);
+    expect(syncReader.digest()).toEqual(sha256(data));
+
+    const copies: Uint8Array[] = [];
+    for await (const chunk of BlobReader.open(blobId, { chunkSize: CHUNK })) {
+      copies.push(chunk.slice());
+    }
+    expect(Uint8Array.from(copies.flatMap(chunk => Array.from(chunk)))).toEqual(data);
+  });
+
+  it('closes the reader when iteration stops early and reuses pooled chunks', () => {
+    const store = install(true);
+    const pool = new ChunkPool(CHUNK);
+    const writer = BlobWriter.create({ pool });
+    writer.write(pattern(CHUNK * 4));
+    const blobId = writer.close();
+
+    const reader = BlobReader.open(blobId, { pool });
+    for (const chunk of reader) {
+      expect(chunk.length).toBe(CHUNK);
+      break;
+    }
+    expect(store.handles.size).toBe(0);
+    expect(() => reader.read()).toThrow('closed');
+    expect(pool.idleCount).toBe(1);
+
+    const first = pool.acquire();
+    pool.release(first);
+    expect(pool.acquire()).toBe(first);
+  });
+
+  it('uses the BigInt host functions when the numeric ones are missing', () => {
+    install(false);
+    const data = pattern(CHUNK + 5);
+    const writer = BlobWriter.create({ chunkSize: CHUNK });
+    writer.writeFrom([data.subarray(0, 9), data.subarray(9)]);
+    const blobId = writer.close();
+
+    const reader = BlobReader.open(blobId, { chunkSize: CHUNK });
+    expect(typeof reader.fd).toBe('number');
+    expect(reader.readAll()).toEqual(data);
+  });
+
+  it('keeps the writer open when the final flush fails so close can be retried', () => {
+    const store = install(true);
+    const data = pattern(CHUNK + 5);
+    const writer = BlobWriter.create({ chunkSize: CHUNK });
+    writer.write(data);
+
+    const write = store.host.blob_stream_write;
+    store.host.blob_stream_write = () => {
+      throw new Error('host busy');
+    };
+    expect(() => writer.close()).toThrow('host busy');
+    expect(store.calls.close).toBe(0);
+
+    store.host.blob_stream_write = write;
+    const blobId = writer.close();
+    expect(store.blobs.get(blobId.join(','))).toEqual(data);
+    expect(store.handles.size).toBe(0);
+  });
+
+  it('releases the fd and the pooled chunk on abort', () => {
+    const store = install(true);
+    const pool = new ChunkPool(CHUNK);
+    const writer = BlobWriter.create({ pool });
+    writer.write(pattern(5));
+
+    writer.abort();
+    writer.abort();
+    expect(store.handles.size).toBe(0);
+    expect(store.calls.write).toBe(0);
+    expect(pool.idleCount).toBe(1);
+    expect(() => writer.write(pattern(1))).toThrow('closed');
+    expect(() => writer.close()).toThrow('closed');
+  });
+
+  it('reports missing blobs and misuse', () => {
+    install(true);
+    expect(() => BlobReader.open(new Uint8Array(32))).toThrow('not found');
+    expect(() => BlobReader.open(new Uint8Array(8))).toThrow(RangeError);
+    expect(() => BlobWriter.create({ chunkSize: 8, pool: new ChunkPool(CHUNK) })).toThrow(
+      RangeError
+    );
+
+    const writer = BlobWriter.create({ hash: true });
+    expect(() => writer.digest()).toThrow('after close');
+    writer.close();
+    expect(() => writer.write(pattern(1))).toThrow('closed');
+  });
+});
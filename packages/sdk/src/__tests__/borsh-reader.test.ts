@@ -0,0 +1,81 @@
+/**
+ * BorshReader tests
+ */
+
+import './setup';
+import { BorshReader } from '../borsh/decoder';
+import { BorshWriter } from '../borsh/encoder';
+
+function sample(): Uint8Array {
+  const writer = new BorshWriter();
+  writer.writeBytes(new Uint8Array([1, 2, 3]));
+  writer.writeString('héllo');
+  writer.writeVec([1, 0xffffffff, 7], value => writer.writeU32(value));
+  writer.writeVec([5n, 1n << 63n], value => writer.writeU64(value));
+  writer.writeVec([0.5, -2], value => writer.writeF64(value));
+  writer.writeU8(42);
+  return writer.toBytes();
+}
+
+describe('BorshReader', () => {
+  it('copies byte fields by default and borrows them on request', () => {
+    const source = sample();
+
+    const copied = new BorshReader(source).readBytes();
+    const borrowed = new BorshReader(source, { borrow: true }).readBytes();
+    expect(Array.from(copied)).toEqual([1, 2, 3]);
+    expect(Array.from(borrowed)).toEqual([1, 2, 3]);
+
+    source[4] = 9;
+    expect(copied[0]).toBe(1);
+    expect(borrowed[0]).toBe(9);
+
+    const detached = BorshReader.copy(borrowed);
+    source[4] = 1;
+    expect(detached[0]).toBe(9);
+  });
+
+  it('decodes primitive vectors into typed arrays', () => {
+    const reader = new BorshReader(sample());
+    reader.skipBytes();
+    expect(reader.readString()).toBe('héllo');
+    expect(Array.from(reader.readU32Array())).toEqual([1, 0xffffffff, 7]);
+    expect(Array.from(reader.readU64Array())).toEqual([5n, 1n << 63n]);
+    expect(Array.from(reader.readF64Array())).toEqual([0.5, -2]);
+    expect(reader.readU8()).toBe(42);
+    expect(reader.remaining()).toBe(0);
+  });
+
+  it('skips and seeks over fields', () => {
+    const reader = new BorshReader(sample());
+    reader.skipBytes();
+    const stringAt = reader.position();
+    reader.skipBytes();
+    reader.skip(4 + 3 * 4);
+    reader.skip(4 + 2 * 8);
+    reader.skip(4 + 2 * 8);
+    expect(reader.readU8()).toBe(42);
+
+    reader.seek(stringAt);
+    expect(reader.readString()).toBe('héllo');
+    expect(() => reader.seek(10_000)).toThrow(RangeError);
+  });
+
+  it('bounds-checks every read', () => {
+    const truncated = sample().subarray(0, 5);
+    expect(() => new BorshReader(truncated).readBytes()).toThrow(RangeError);
+    expect(() => new BorshReader(new Uint8Array(3)).readU32()).toThrow(
+      'BorshReader: unexpected end of buffer'
+    );
+    // A borrowed view of a larger buffer must not read past its own end
+    const view = new Uint8Array(16).subarray(0, 6);
+    for (const read of ['readU16', 'readU32', 'readU64', 'readF32', 'readF64'] as const) {
+      const reader = new BorshReader(view);
+      reader.skip(5);
+      expect(() => reader[read]()).toThrow('BorshReader: unexpected end of buffer');
+    }
+    expect(() => new BorshReader(new Uint8Array([0xff, 0xff, 0, 0])).readU32Array()).toThrow(
+      RangeError
+    );
+  });
+});
@@ -0,0 +1,114 @@
+/**
+ * Property tests: the direct encoder must match the normalize/encode path byte for byte
+ */
+
+import './setup';
+import { serializeJsValue, serializeJsValueGeneric, deserializeJsValue } from '../utils/borsh-value';
+
+// Small deterministic PRNG (mulberry32) so failures are reproducible from the seed
+function createRandom(seed: number): () => number {
+  let state = seed >>> 0;
+  return () => {
+    state = (state + 0x6d2b79f5) >>> 0;
+    let t = state;
+    t = Math.imul(t ^ (t >>> 15), t | 1);
+    t ^= t + Math.imul(t ^ (t >>> 7), t | 61);
+    return ((t ^ (t >>> 14)) >>> 0) / 4294967296;
+  };
+}
+
+const SPECIAL_NUMBERS = [0, -0, 1, -1, 0.5, NaN, Infinity, -Infinity, 2 ** 53, Number.MIN_VALUE];
+const SAMPLE_CHARS = ['a', 'Z', '0', ' ', 'é', 'ß', '中', '😀', '\u0000', '"'];
+
+function randomString(random: () => number): string {
+  const length = Math.floor(random() * 12);
+  let out = '';
+  for (let i = 0; i < length; i += 1) {
+    out += SAMPLE_CHARS[Math.floor(random() * SAMPLE_CHARS.length)];
+  }
+  return out;
+}
+
+function randomScalar(random: () => number): unknown {
+  switch (Math.floor(random() * 8)) {
+    case 0:
+      return null;
+    case 1:
+      return undefined;
+    case 2:
+      return random() < 0.5;
+    case 3:
+      return random() < 0.3
+        ? SPECIAL_NUMBERS[Math.floor(random() * SPECIAL_NUMBERS.length)]
+        : (random() - 0.5) * 1e6;
+    case 4:
+      return BigInt(Math.floor((random() - 0.5) * 1e15)) * 1000n;
+    case 5: {
+      const bytes = new Uint8Array(Math.floor(random() * 40));
+      for (let i = 0; i < bytes.length; i += 1) {
+        bytes[i] = Math.floor(random() * 256);
+      }
+      return bytes;
+    }
+    default:
+      return randomString(random);
+  }
+}
+
+function randomKey(random: () => number): string {
+  // Mix integer-like keys in, they change own-key enumeration order
+  return random() < 0.2 ? String(Math.floor(random() * 50)) : randomString(random) || 'k';
+}
+
+function randomFlatRecord(random: () => number): Record<string, unknown> {
+  const record: Record<string, unknown> = random() < 0.2 ? Object.create(null) : {};
+  const size = Math.floor(random() * 8);
+  for (let i = 0; i < size; i += 1) {
+    record[randomKey(random)] = randomScalar(random);
+  }
+  return record;
+}
+
+describe('borsh-value direct encoder', () => {
+  it('matches the generic encoder for random primitives', () => {
+    const random = createRandom(0xc0ffee);
+    for (let i = 0; i < 2000; i += 1) {
+      const value = randomScalar(random);
+      expect(Array.from(serializeJsValue(value))).toEqual(
+        Array.from(serializeJsValueGeneric(value))
+      );
+    }
+  });
+
+  it('matches the generic encoder for random flat records', () => {
+    const random = createRandom(0x5eed);
+    for (let i = 0; i < 1000; i += 1) {
+      const value = randomFlatRecord(random);
+      expect(Array.from(serializeJsValue(value))).toEqual(
+        Array.from(serializeJsValueGeneric(value))
+      );
+    }
+  });
+
+  it('falls back for nested and special values', () => {
+    const values: unknown[] = [
+      { nested: { a: 1 } },
+      [1, 'two', 3n],
+      new Map([['k', 1]]),
+      new Set(['a']),
+      new Date(0),
+      { toJSON: () => 'custom' },
+      new Uint16Array([1, 2, 3]),
+    ];
+    for (const value of values) {
+      expect(Array.from(serializeJsValue(value))).toEqual(
+        Array.from(serializeJsValueGeneric(value))
+      );
+    }
+  });
+
+  it('round-trips flat records', () => {
+    const value = { id: 7, name: 'alice', big: 12345678901234567890n, raw: new Uint8Array([1, 2]) };
+    expect({ ...deserializeJsValue<typeof value>(serializeJsValue(value)) }).toEqual(value);
+  });
+});
@@ -0,0 +1,72 @@
+/**
+ * BorshWriter tests
+ */
+
+import './setup';
+import { BorshWriter } from '../borsh/encoder';
+import { BorshReader } from '../borsh/decoder';
+import { serializeStorageDelta } from '../borsh/storage-delta';
+
+describe('BorshWriter', () => {
+  it('writes little-endian integers and floats', () => {
+    const writer = new BorshWriter(8);
+    writer.writeU8(0x1ff);
+    writer.writeU16(0x0102);
+    writer.writeU32(0xdeadbeef);
+    writer.writeU64(-1n);
+    writer.writeU128((1n << 64n) + 2n);
+    writer.writeF64(1.5);
+
+    const reader = new BorshReader(writer.finish());
+    expect(reader.readU8()).toBe(0xff);
+    expect(reader.readU16()).toBe(0x0102);
+    expect(reader.readU32()).toBe(0xdeadbeef);
+    expect(reader.readU64()).toBe(0xffffffffffffffffn);
+    expect(reader.readU64()).toBe(2n);
+    expect(reader.readU64()).toBe(1n);
+    expect(reader.readF64()).toBe(1.5);
+    expect(reader.remaining()).toBe(0);
+  });
+
+  it('grows past the initial capacity and keeps earlier bytes', () => {
+    const writer = new BorshWriter(8);
+    const chunk = new Uint8Array(100).map((_, i) => i);
+    for (let i = 0; i < 50; i += 1) {
+      writer.writeBytes(chunk);
+    }
+    const bytes = writer.finish();
+    expect(bytes.length).toBe(50 * 104);
+    expect(writer.size()).toBe(bytes.length);
+    expect(Array.from(bytes.subarray(104 * 49 + 4, 104 * 49 + 8))).toEqual([0, 1, 2, 3]);
+  });
+
+  it('length-prefixes strings with their UTF-8 size', () => {
+    const writer = new BorshWriter();
+    writer.writeString('héllo 😀');
+    const bytes = writer.finish();
+    const utf8 = new TextEncoder().encode('héllo 😀');
+    expect(Array.from(bytes)).toEqual([utf8.length, 0, 0, 0, ...Array.from(utf8)]);
+  });
+
+  it('returns a view from finish() and a copy from toBytes()', () => {
+    const writer = new BorshWriter();
+    writer.writeU32(7);
+    const copy = writer.toBytes();
+    const view = writer.finish();
+    expect(Array.from(copy)).toEqual(Array.from(view));
+    expect(copy.buffer).not.toBe(view.buffer);
+  });
+
+  it('encodes storage delta payloads in bulk', () => {
+    const data = new Uint8Array([9, 8, 7]);
+    const id = new Uint8Array(32).fill(1);
+    const bytes = serializeStorageDelta([{ kind: 'Update', id, data, timestamp: 5n }]);
+
+    const reader = new BorshReader(bytes);
+    expect(reader.readU8()).toBe(0);
+    expect(reader.readU32()).toBe(1);
+    expect(reader.readU8()).toBe(3);
+    expect(Array.from(reader.readFixedArray(32))).toEqual(Array.from(id));
+    expect(Array.from(reader.readBytes())).toEqual([9, 8, 7]);
+  });
+});
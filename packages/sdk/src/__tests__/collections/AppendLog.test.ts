@@ -0,0 +1,198 @@
+/**
+ * AppendLog tests
+ */
+
+import '../setup';
+import { AppendLog } from '../../collections/AppendLog';
+import { UnorderedMap } from '../../collections/UnorderedMap';
+import { mapInsert } from '../../runtime/storage-wasm';
+import { serialize } from '../../utils/serialize';
+import { clearStorage, countHostCalls } from '../setup';
+
+const MAP_CALLS = ['js_crdt_map_get', 'js_crdt_map_insert'];
+
+interface Message {
+  author: string;
+  text: string;
+}
+
+function message(i: number): Message {
+  return { author: `user-${i % 3}`, text: `message ${i}` };
+}
+
+// Stores `entries` (sequence number, value) as another executor's first segment and head, the
+// way a merged delta from that node would
+function appendAsExecutor(
+  log: AppendLog<Message>,
+  entries: [number, Message][],
+  other = new Uint8Array(32).fill(7)
+): void {
+  const segment: number[] = [];
+  for (const [seq, value] of entries) {
+    const encoded = serialize(value);
+    const header = new Uint8Array(12);
+    new DataView(header.buffer).setBigUint64(0, BigInt(seq), true);
+    new DataView(header.buffer).setUint32(8, encoded.length, true);
+    segment.push(...header, ...encoded);
+  }
+  const head = new Uint8Array(16);
+  new DataView(head.buffer).setBigUint64(0, BigInt(entries.length), true);
+  new DataView(head.buffer).setBigUint64(8, BigInt(entries[entries.length - 1][0] + 1), true);
+
+  mapInsert(log.idBytes(), Uint8Array.of(0x03, ...other, 0, 0, 0, 0), Uint8Array.from(segment));
+  mapInsert(log.idBytes(), Uint8Array.of(0x01, ...other), head);
+  mapInsert((log as any).writersId, other, Uint8Array.of(0x01));
+}
+
+describe('AppendLog', () => {
+  beforeEach(() => {
+    clearStorage();
+  });
+
+  it('should start empty', () => {
+    const log = new AppendLog<Message>();
+    expect(log.len()).toBe(0);
+    expect(log.latest(10)).toEqual([]);
+    expect(log.get(0)).toBeNull();
+  });
+
+  it('should append and read entries across segments', () => {
+    const log = new AppendLog<Message>({ segmentSize: 4 });
+    expect(log.append(message(0))).toBe(0);
+    expect(log.appendMany([1, 2, 3, 4, 5, 6].map(message))).toBe(1);
+
+    expect(log.len()).toBe(7);
+    expect(log.nextIndex()).toBe(7);
+    expect(log.get(0)).toEqual(message(0));
+    expect(log.get(5)).toEqual(message(5));
+    expect(log.get(7)).toBeNull();
+  });
+
+  it('should page backwards from the newest entry', () => {
+    const log = new AppendLog<Message>({ segmentSize: 8 });
+    log.appendMany(Array.from({ length: 30 }, (_, i) => message(i)));
+
+    const page = log.latest(5);
+    expect(page.map(entry => entry.index)).toEqual([29, 28, 27, 26, 25]);
+    expect(page[0].value).toEqual(message(29));
+
+    const next = log.before(page[page.length - 1].index, 10);
+    expect(next.map(entry => entry.index)).toEqual([24, 23, 22, 21, 20, 19, 18, 17, 16, 15]);
+    expect(log.before(3, 10).map(entry => entry.index)).toEqual([2, 1, 0]);
+    expect(log.before(0, 10)).toEqual([]);
+    expect(log.latest(100)).toHaveLength(30);
+  });
+
+  it('should read the latest page with a constant number of host calls', () => {
+    const small = new AppendLog<Message>();
+    small.appendMany(Array.from({ length: 100 }, (_, i) => message(i)));
+    const large = new AppendLog<Message>();
+    large.appendMany(Array.from({ length: 5000 }, (_, i) => message(i)));
+
+    const fromSmall = countHostCalls(MAP_CALLS, () => small.latest(50));
+    const fromLarge = countHostCalls(MAP_CALLS, () => large.latest(50));
+    expect(fromLarge.result[0].value).toEqual(message(4999));
+    // writer head + at most two segments of 64
+    expect(fromLarge.calls).toBeLessThanOrEqual(3);
+    expect(fromLarge.calls).toBe(fromSmall.calls);
+
+    // writer head read, tail segment read, tail segment write, head write
+    expect(countHostCalls(MAP_CALLS, () => large.append(message(5000))).calls).toBe(4);
+  });
+
+  it('should only read the segments of writers that reach the page', () => {
+    const log = new AppendLog<Message>();
+    // 40 writers with interleaved numbers: writer k holds k, k + 40 and k + 80
+    for (let k = 0; k < 40; k++) {
+      const executor = new Uint8Array(32).fill(k + 10);
+      appendAsExecutor(log, [0, 40, 80].map(offset => [k + offset, message(k + offset)]), executor);
+    }
+
+    const page = countHostCalls(MAP_CALLS, () => log.latest(5));
+    expect(page.result.map(entry => entry.index)).toEqual([119, 118, 117, 116, 115]);
+    // one head per writer + the last segment of the five newest writers
+    expect(page.calls).toBe(40 + 5);
+
+    const next = countHostCalls(MAP_CALLS, () => log.before(115, 3));
+    expect(next.result.map(entry => entry.index)).toEqual([114, 113, 112]);
+    // Writers 34-39 all reach 114 below the cursor, then 33 and 32 are read for 113 and 112
+    expect(next.calls).toBe(40 + 8);
+  });
+
+  it('should compact whole segments only', () => {
+    const log = new AppendLog<Message>({ segmentSize: 4 });
+    log.appendMany(Array.from({ length: 10 }, (_, i) => message(i)));
+
+    expect(log.compact(6)).toBe(4);
+    expect(log.firstIndex()).toBe(4);
+    expect(log.len()).toBe(6);
+    expect(log.get(3)).toBeNull();
+    expect(log.get(4)).toEqual(message(4));
+    expect(log.latest(100).map(entry => entry.index)).toEqual([9, 8, 7, 6, 5, 4]);
+    expect(log.compact(2)).toBe(0);
+
+    log.append(message(10));
+    expect(log.latest(1)[0]).toEqual({ index: 10, value: message(10) });
+  });
+
+  it('should merge entries appended concurrently on another executor', () => {
+    const log = new AppendLog<Message>({ segmentSize: 4 });
+    log.appendMany([0, 1, 2].map(message));
+    // The other node appended twice after seeing only entry 0
+    appendAsExecutor(log, [
+      [1, message(101)],
+      [2, message(102)],
+    ]);
+
+    expect(log.len()).toBe(5);
+    expect(log.nextIndex()).toBe(3);
+    expect(log.firstIndex()).toBe(0);
+    expect(log.get(1)).toEqual(message(1));
+
+    // Shared numbers are ordered by executor id and kept on one page
+    const page = log.latest(1);
+    expect(page).toEqual([
+      { index: 2, value: message(102) },
+      { index: 2, value: message(2) },
+    ]);
+    expect(log.before(2, 10).map(entry => entry.value)).toEqual([
+      message(101),
+      message(1),
+      message(0),
+    ]);
+
+    expect(log.append(message(3))).toBe(3);
+    expect(log.latest(2).map(entry => entry.value)).toEqual([message(3), message(102), message(2)]);
+  });
+
+  it('should compact full segments of every writer', () => {
+    const log = new AppendLog<Message>({ segmentSize: 2 });
+    log.appendMany([0, 1, 2].map(message));
+    appendAsExecutor(log, [
+      [0, message(100)],
+      [1, message(101)],
+    ]);
+
+    // The other writer's only segment is full; this one's last is still open
+    expect(log.compact(10)).toBe(4);
+    expect(log.len()).toBe(1);
+    expect(log.firstIndex()).toBe(2);
+    expect(log.latest(10).map(entry => entry.value)).toEqual([message(2)]);
+  });
+
+  it('should keep options when reloaded', () => {
+    const log = new AppendLog<string>({
+      segmentSize: 2,
+      valueCodec: 'string',
+      compression: 'lz4',
+    });
+    log.appendMany(['a', 'b', 'c'.repeat(200)]);
+
+    const outer = new UnorderedMap<string, AppendLog<string>>();
+    outer.set('history', log);
+    const reloaded = UnorderedMap.fromId<string, AppendLog<string>>(outer.id()).get('history')!;
+
+    reloaded.append('d');
+    expect(reloaded.latest(4).map(entry => entry.value)).toEqual(['d', 'c'.repeat(200), 'b', 'a']);
+  });
+});
@@ -0,0 +1,124 @@
+/**
+ * BloomSet tests
+ */
+
+import '../setup';
+import { BloomSet } from '../../collections/BloomSet';
+import { UnorderedMap } from '../../collections/UnorderedMap';
+import { mapInsert } from '../../runtime/storage-wasm';
+import { murmur3x86128 } from '../../utils/murmur3';
+import { clearStorage, countHostCalls } from '../setup';
+
+// Stores `chunk` as another executor's copy, the way a merged delta from that node would
+function writeAsExecutor(filter: BloomSet<unknown>, chunk: number, bits: Uint8Array): void {
+  const other = new Uint8Array(32).fill(7);
+  const key = new Uint8Array(37);
+  key[0] = 0x01;
+  new DataView(key.buffer).setUint32(1, chunk, false);
+  key.set(other, 5);
+  mapInsert(filter.idBytes(), key, bits);
+  mapInsert((filter as any).writersId, other, Uint8Array.of(0x01));
+}
+
+describe('BloomSet', () => {
+  beforeEach(() => {
+    clearStorage();
+  });
+
+  it('should hash with MurmurHash3 x86_128', () => {
+    const input = new TextEncoder().encode('The quick brown fox jumps over the lazy dog');
+    expect(Array.from(murmur3x86128(input))).toEqual([
+      0x2f1583c3, 0xecee2c67, 0x5d7bf66c, 0xe5e91d2c,
+    ]);
+  });
+
+  it('should size the filter from capacity and false-positive rate', () => {
+    expect(new BloomSet({ capacity: 1000, falsePositiveRate: 0.01 }).parameters()).toEqual({
+      bits: 16384,
+      hashes: 7,
+      chunkSize: 1024,
+    });
+    expect(new BloomSet({ bits: 4096, hashes: 3, chunkSize: 256 }).parameters()).toEqual({
+      bits: 4096,
+      hashes: 3,
+      chunkSize: 256,
+    });
+    expect(() => new BloomSet({ falsePositiveRate: 1 })).toThrow('falsePositiveRate');
+    expect(() => new BloomSet({ bits: 1000 })).toThrow('multiple of the chunk size');
+    expect(() => new BloomSet({ chunkSize: 0 })).toThrow('chunkSize');
+  });
+
+  it('should never miss added values and keep false positives near the target', () => {
+    const filter = new BloomSet<string>({ capacity: 2000, falsePositiveRate: 0.01 });
+    const members = Array.from({ length: 2000 }, (_, i) => `msg-${i}`);
+    expect(filter.addMany(members)).toBe(2000);
+
+    expect(filter.mightContainMany(members).every(Boolean)).toBe(true);
+    expect(filter.add('msg-5')).toBe(false);
+
+    const strangers = Array.from({ length: 5000 }, (_, i) => `other-${i}`);
+    const positives = filter.mightContainMany(strangers).filter(Boolean).length;
+    expect(positives / strangers.length).toBeLessThan(0.03);
+
+    const estimate = filter.approximateSize();
+    expect(estimate).toBeGreaterThan(1800);
+    expect(estimate).toBeLessThan(2200);
+  });
+
+  it('should read each chunk once for batched lookups', () => {
+    const filter = new BloomSet<number>({ capacity: 1000, chunkSize: 64 });
+    filter.addMany([1, 2, 3]);
+    const values = Array.from({ length: 200 }, (_, i) => i);
+    const chunks = new Set(values.map(value => (filter as any).probe(value).chunk));
+
+    const batched = countHostCalls(['js_crdt_map_get'], () => filter.mightContainMany(values));
+    expect(batched.result).toEqual(values.map(value => filter.mightContain(value)));
+    expect(batched.calls).toBe(chunks.size);
+  });
+
+  it('should answer a negative lookup with one chunk read', () => {
+    const filter = new BloomSet<string>();
+    filter.add('nonce-1');
+
+    const lookup = countHostCalls(['js_crdt_map_get'], () => filter.mightContain('nonce-2'));
+    expect(lookup.result).toBe(false);
+    expect(lookup.calls).toBe(1);
+  });
+
+  it('should merge by OR with bits set on other executors', () => {
+    const filter = new BloomSet<string>({ capacity: 100, chunkSize: 32 });
+    filter.add('local');
+
+    // The other node added 'remote' to its own copy of the chunk
+    const { chunk, positions } = (filter as any).probe('remote');
+    const bits = new Uint8Array(32);
+    for (const position of positions) bits[position >> 3] |= 1 << (position & 7);
+    writeAsExecutor(filter, chunk, bits);
+
+    expect(filter.mightContain('remote')).toBe(true);
+    expect(filter.mightContain('local')).toBe(true);
+
+    // Adding locally leaves the other executor's copy untouched
+    expect(filter.add('remote')).toBe(false);
+    expect(filter.addMany(['local-2', 'local-3'])).toBe(2);
+    expect(filter.mightContainMany(['remote', 'local-2', 'local-3'])).toEqual([true, true, true]);
+  });
+
+  it('should keep its parameters when reloaded', () => {
+    const filter = new BloomSet<string>({
+      capacity: 500,
+      falsePositiveRate: 0.001,
+      chunkSize: 128,
+    });
+    filter.add('a');
+
+    const outer = new UnorderedMap<string, BloomSet<string>>();
+    outer.set('seen', filter);
+    const reloaded = UnorderedMap.fromId<string, BloomSet<string>>(outer.id()).get('seen')!;
+
+    expect(reloaded.parameters()).toEqual(filter.parameters());
+    expect(reloaded.mightContain('a')).toBe(true);
+    reloaded.add('b');
+    expect(filter.mightContain('b')).toBe(true);
+  });
+});
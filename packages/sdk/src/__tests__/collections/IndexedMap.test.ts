@@ -0,0 +1,161 @@
+/**
+ * IndexedMap tests
+ */
+
+import '../setup';
+import { IndexedMap } from '../../collections/IndexedMap';
+import { UnorderedMap } from '../../collections/UnorderedMap';
+import { clearStorage, countHostCalls } from '../setup';
+
+interface FileRecord {
+  owner: string;
+  size: number;
+  meta: { mime: string | null };
+  tags: string[];
+  shared: boolean;
+}
+
+function file(owner: string, size: number, mime: string | null, tags: string[] = []): FileRecord {
+  return { owner, size, meta: { mime }, tags, shared: false };
+}
+
+function filesMap(): IndexedMap<string, FileRecord> {
+  return new IndexedMap<string, FileRecord>({
+    indexes: { byOwner: 'owner', byMime: 'meta.mime', bySize: 'size', byTag: 'tags' },
+  });
+}
+
+describe('IndexedMap', () => {
+  beforeEach(() => {
+    clearStorage();
+  });
+
+  it('should require index declarations', () => {
+    expect(() => new IndexedMap({ indexes: {} })).toThrow('declare at least one index');
+    expect(() => new IndexedMap({ indexes: { byOwner: '' } })).toThrow('needs a field path');
+  });
+
+  it('should find keys by indexed fields', () => {
+    const files = filesMap();
+    files.set('a.pdf', file('alice', 300, 'application/pdf'));
+    files.set('b.png', file('bob', 100, 'image/png', ['holiday', 'beach']));
+    files.set('c.png', file('alice', 200, 'image/png', ['holiday']));
+    files.set('d.txt', file('carol', 50, null));
+
+    expect(files.get('b.png')?.owner).toBe('bob');
+    expect(files.findBy('byOwner', 'alice')).toEqual(['a.pdf', 'c.png']);
+    expect(files.findBy('byMime', 'image/png')).toEqual(['b.png', 'c.png']);
+    expect(files.findBy('byMime', 'image/png', 1)).toHaveLength(1);
+    expect(files.findBy('byTag', 'holiday')).toEqual(['b.png', 'c.png']);
+    expect(files.findBy('byTag', 'beach')).toEqual(['b.png']);
+    expect(files.findBy('byOwner', 'dave')).toEqual([]);
+    expect(files.findEntriesBy('byOwner', 'carol')).toEqual([['d.txt', file('carol', 50, null)]]);
+    expect(() => files.findBy('byColor', 'red')).toThrow("unknown index 'byColor'");
+  });
+
+  it('should answer range queries over terms', () => {
+    const files = filesMap();
+    files.set('a', file('alice', 300, 'text/plain'));
+    files.set('b', file('bob', 100, 'text/plain'));
+    files.set('c', file('carol', 200, 'text/plain'));
+
+    expect(files.rangeBy('bySize', 100, 300)).toEqual(['b', 'c']);
+    expect(files.rangeBy('bySize', 150)).toEqual(['c', 'a']);
+    expect(files.rangeBy('bySize', undefined, 200)).toEqual(['b']);
+    expect(files.rangeBy('byOwner', 'b', 'c')).toEqual(['b']);
+    expect(files.rangeBy('byOwner')).toEqual(['a', 'b', 'c']);
+  });
+
+  it('should move index keys when values change and drop them on remove', () => {
+    const files = filesMap();
+    files.set('x', file('alice', 10, 'image/png', ['one', 'two']));
+    files.set('x', file('bob', 10, 'image/png', ['two', 'three']));
+
+    expect(files.findBy('byOwner', 'alice')).toEqual([]);
+    expect(files.findBy('byOwner', 'bob')).toEqual(['x']);
+    expect(files.findBy('byTag', 'one')).toEqual([]);
+    expect(files.findBy('byTag', 'two')).toEqual(['x']);
+    expect(files.findBy('byTag', 'three')).toEqual(['x']);
+
+    expect(files.remove('x')).toBe(true);
+    expect(files.remove('x')).toBe(false);
+    expect(files.has('x')).toBe(false);
+    expect(files.findBy('byOwner', 'bob')).toEqual([]);
+    expect(files.findBy('byMime', 'image/png')).toEqual([]);
+    expect(files.entries()).toEqual([]);
+  });
+
+  it('should index booleans and non-string keys', () => {
+    const tasks = new IndexedMap<number, { done: boolean; owner: string }>({
+      indexes: { byDone: 'done', byOwner: 'owner' },
+    });
+    for (let id = 0; id < 10; id++) {
+      tasks.set(id, { done: id % 3 === 0, owner: `user-${id % 2}` });
+    }
+
+    expect(tasks.findBy('byDone', true).sort((a, b) => a - b)).toEqual([0, 3, 6, 9]);
+    expect(tasks.findBy('byOwner', 'user-1', 2)).toHaveLength(2);
+    expect(tasks.findBy('byOwner', 'user-1').sort((a, b) => a - b)).toEqual([1, 3, 5, 7, 9]);
+    expect(tasks.keys().sort((a, b) => a - b)).toEqual([0, 1, 2, 3, 4, 5, 6, 7, 8, 9]);
+  });
+
+  it('should look up with reads for the index path and the matching entries', () => {
+    const small = new IndexedMap<number, { owner: string }>({ indexes: { byOwner: 'owner' } });
+    const large = new IndexedMap<number, { owner: string }>({ indexes: { byOwner: 'owner' } });
+    for (let i = 0; i < 100; i++) small.set(i, { owner: `user-${i % 10}` });
+    for (let i = 0; i < 3000; i++) large.set(i, { owner: `user-${i % 300}` });
+
+    const fromSmall = countHostCalls(['js_crdt_map_get'], () => small.findBy('byOwner', 'user-7'));
+    const fromLarge = countHostCalls(['js_crdt_map_get'], () => large.findBy('byOwner', 'user-7'));
+    expect(fromLarge.result).toHaveLength(10);
+    // index head + index path (+ one sibling leaf) + one read per matching entry
+    expect(fromLarge.calls).toBeLessThanOrEqual(1 + 4 + 10);
+    expect(fromLarge.calls - fromSmall.calls).toBeLessThanOrEqual(2);
+  });
+
+  it('should skip stale index keys', () => {
+    const files = filesMap();
+    files.set('x', file('alice', 10, 'text/plain'));
+    const pk = (files as any).index.keys()[0][2];
+
+    // A concurrent write of 'x' from another node added its own terms to the index
+    (files as any).index.set(['byOwner', 'bob', pk], null);
+    (files as any).index.set(['bySize', 5, pk], null);
+
+    expect(files.findBy('byOwner', 'bob')).toEqual([]);
+    expect(files.findEntriesBy('byOwner', 'bob')).toEqual([]);
+    expect(files.findEntriesBy('byOwner', 'alice')).toHaveLength(1);
+    expect(files.rangeBy('bySize', 0, 8)).toEqual([]);
+    expect(files.rangeBy('bySize')).toEqual(['x']);
+  });
+
+  it('should apply the limit after skipping stale index keys', () => {
+    const files = filesMap();
+    files.set('a', file('alice', 10, 'text/plain'));
+    files.set('b', file('bob', 20, 'text/plain'));
+    const stalePk = (files as any).index.prefixKeys(['byOwner', 'alice'])[0][2];
+    (files as any).index.set(['byOwner', 'bob', stalePk], null);
+    (files as any).index.set(['bySize', 15, stalePk], null);
+
+    expect(files.findEntriesBy('byOwner', 'bob', 1)).toEqual([
+      ['b', file('bob', 20, 'text/plain')],
+    ]);
+    expect(files.findBy('byOwner', 'bob', 1)).toEqual(['b']);
+    expect(files.rangeBy('bySize', 11, undefined, 1)).toEqual(['b']);
+  });
+
+  it('should keep its indexes when reloaded', () => {
+    const files = filesMap();
+    files.set('a', file('alice', 1, 'text/plain'));
+
+    const outer = new UnorderedMap<string, IndexedMap<string, FileRecord>>();
+    outer.set('files', files);
+    const reloaded = UnorderedMap.fromId<string, IndexedMap<string, FileRecord>>(outer.id()).get(
+      'files'
+    )!;
+
+    reloaded.set('b', file('alice', 2, 'text/plain'));
+    expect(reloaded.indexNames()).toEqual(['byMime', 'byOwner', 'bySize', 'byTag']);
+    expect(reloaded.findBy('byOwner', 'alice')).toEqual(['a', 'b']);
+  });
+});
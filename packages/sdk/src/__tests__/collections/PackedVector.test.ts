@@ -0,0 +1,165 @@
+/**
+ * PackedVector tests
+ */
+
+import '../setup';
+import { PackedVector } from '../../collections/PackedVector';
+import { UnorderedMap } from '../../collections/UnorderedMap';
+import { mapInsert } from '../../runtime/storage-wasm';
+import { clearStorage, countHostCalls } from '../setup';
+
+// Stores `chunks` as another executor's run, the way a merged delta from that node would
+function writeRun(
+  vec: PackedVector<any>,
+  executor: Uint8Array,
+  chunks: number[][],
+  count = chunks.reduce((total, chunk) => total + chunk.length, 0)
+): void {
+  chunks.forEach((values, index) => {
+    const key = new Uint8Array(37);
+    key[0] = 0x02;
+    key.set(executor, 1);
+    new DataView(key.buffer).setUint32(33, index, false);
+    const bytes = new Uint8Array(new (vec as any).ArrayType(values).buffer);
+    mapInsert(vec.idBytes(), key, bytes);
+  });
+  const head = new Uint8Array(33);
+  head[0] = 0x01;
+  head.set(executor, 1);
+  const countBytes = new Uint8Array(8);
+  new DataView(countBytes.buffer).setBigUint64(0, BigInt(count), true);
+  mapInsert(vec.idBytes(), head, countBytes);
+  mapInsert((vec as any).writersId, executor, Uint8Array.of(0x01));
+}
+
+describe('PackedVector', () => {
+  beforeEach(() => {
+    clearStorage();
+  });
+
+  it('should start empty', () => {
+    const vec = new PackedVector({ element: 'f64' });
+    expect(vec.len()).toBe(0);
+    expect(vec.get(0)).toBeNull();
+    expect(vec.toTypedArray()).toEqual(new Float64Array(0));
+    expect(vec.min()).toBeNull();
+    expect(vec.sum()).toBe(0);
+  });
+
+  it('should append across chunk boundaries', () => {
+    const vec = new PackedVector({ element: 'f64', chunkSize: 4 });
+    vec.push(0.5);
+    vec.pushMany([1.5, 2.5, 3.5, 4.5]);
+    vec.pushMany(Float64Array.of(5.5, 6.5, 7.5, 8.5, 9.5));
+
+    expect(vec.len()).toBe(10);
+    expect(vec.get(0)).toBe(0.5);
+    expect(vec.get(4)).toBe(4.5);
+    expect(vec.get(9)).toBe(9.5);
+    expect(vec.get(10)).toBeNull();
+    expect(vec.get(-1)).toBeNull();
+    expect(Array.from(vec.toTypedArray())).toEqual([
+      0.5, 1.5, 2.5, 3.5, 4.5, 5.5, 6.5, 7.5, 8.5, 9.5,
+    ]);
+  });
+
+  it('should return typed ranges and aggregates', () => {
+    const values = Int32Array.from({ length: 2500 }, (_, i) => (i % 2 ? i : -i));
+    const vec = PackedVector.fromArray(values, { element: 'i32' });
+
+    const range = vec.range(1000, 2100);
+    expect(range).toBeInstanceOf(Int32Array);
+    expect(range).toEqual(values.subarray(1000, 2100));
+    expect(vec.range(2400, 9999).length).toBe(100);
+    expect(vec.range(10, 5).length).toBe(0);
+
+    const expected = (from: number, to: number) =>
+      Array.from(values.subarray(from, to)).reduce((a, b) => a + b, 0);
+    expect(vec.sum()).toBe(expected(0, 2500));
+    expect(vec.sum(1000, 1500)).toBe(expected(1000, 1500));
+    expect(vec.min()).toBe(-2498);
+    expect(vec.max()).toBe(2499);
+    expect(vec.max(0, 10)).toBe(9);
+  });
+
+  it('should use bigints for 64-bit integers', () => {
+    const vec = new PackedVector({ element: 'u64', chunkSize: 3 });
+    vec.pushMany([1n, 2n, 2n ** 63n, 4n]);
+
+    expect(vec.get(2)).toBe(2n ** 63n);
+    expect(vec.range(1, 3)).toEqual(BigUint64Array.of(2n, 2n ** 63n));
+    expect(vec.sum()).toBe(7n + 2n ** 63n);
+    expect(vec.min()).toBe(1n);
+    expect(() => vec.push(5 as any)).toThrow(TypeError);
+  });
+
+  it('should store one entry per chunk', () => {
+    const vec = new PackedVector({ element: 'u16', chunkSize: 1024 });
+    vec.pushMany(Uint16Array.from({ length: 5000 }, (_, i) => i));
+
+    const { result, calls } = countHostCalls(['js_crdt_map_get'], () => vec.range(0, 5000));
+    expect(result.length).toBe(5000);
+    // run head + 5 chunks
+    expect(calls).toBe(6);
+  });
+
+  it('should push with a head read and one tail chunk read', () => {
+    const vec = new PackedVector({ element: 'f64', chunkSize: 1024 });
+    vec.pushMany(Float64Array.from({ length: 1500 }, (_, i) => i));
+
+    const { counts } = countHostCalls(['js_crdt_map_get', 'js_crdt_map_insert'], () =>
+      vec.push(1500)
+    );
+    // head + tail chunk, then the tail chunk and the head
+    expect(counts).toEqual({ js_crdt_map_get: 2, js_crdt_map_insert: 2 });
+    expect(vec.get(1500)).toBe(1500);
+  });
+
+  it('should keep values appended concurrently by another executor', () => {
+    const vec = new PackedVector({ element: 'i32', chunkSize: 4 });
+    vec.pushMany([1, 2, 3, 4, 5, 6]);
+
+    // Another node appended to its own run before seeing these values
+    writeRun(vec, new Uint8Array(32).fill(7), [[11, 12, 13, 14], [15]]);
+
+    expect(vec.len()).toBe(11);
+    expect(vec.get(5)).toBe(6);
+    expect(vec.get(6)).toBe(11);
+    expect(vec.get(10)).toBe(15);
+    expect(vec.get(11)).toBeNull();
+    expect(vec.range(4, 9)).toEqual(Int32Array.of(5, 6, 11, 12, 13));
+    expect(vec.sum()).toBe(21 + 65);
+    expect(vec.max(0, 6)).toBe(6);
+
+    // Later appends extend this executor's run, which sorts first
+    vec.pushMany([7, 8]);
+    expect(Array.from(vec.toTypedArray())).toEqual([1, 2, 3, 4, 5, 6, 7, 8, 11, 12, 13, 14, 15]);
+  });
+
+  it('should reject a run whose chunks are missing', () => {
+    const vec = new PackedVector({ element: 'u8', chunkSize: 2 });
+    vec.pushMany([1, 2, 3, 4, 5]);
+    writeRun(vec, new Uint8Array(32).fill(7), [[9, 9]], 3);
+
+    expect(vec.len()).toBe(8);
+    expect(() => vec.range()).toThrow('missing or truncated');
+  });
+
+  it('should keep element type and chunk size when reloaded', () => {
+    const vec = new PackedVector({ element: 'f32', chunkSize: 2 });
+    vec.pushMany([1, 2, 3]);
+
+    const outer = new UnorderedMap<string, PackedVector<'f32'>>();
+    outer.set('series', vec);
+    const reloaded = UnorderedMap.fromId<string, PackedVector<'f32'>>(outer.id()).get('series')!;
+
+    reloaded.push(4);
+    expect(reloaded.range()).toEqual(Float32Array.of(1, 2, 3, 4));
+    expect(vec.len()).toBe(4);
+  });
+
+  it('should reject invalid options', () => {
+    expect(() => new PackedVector({ element: 'f16' as any })).toThrow(RangeError);
+    expect(() => new PackedVector({ element: 'u8', chunkSize: 0 })).toThrow(RangeError);
+  });
+});
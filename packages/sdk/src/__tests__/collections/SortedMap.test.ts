@@ -0,0 +1,231 @@
+/**
+ * SortedMap tests
+ */
+
+import '../setup';
+import { SortedMap } from '../../collections/SortedMap';
+import { UnorderedMap } from '../../collections/UnorderedMap';
+import { mapInsert, mapRemove } from '../../runtime/storage-wasm';
+import { serialize } from '../../utils/serialize';
+import {
+  compareBytes,
+  decodeOrderedKey,
+  encodeOrderedKey,
+  type OrderedKey,
+} from '../../utils/ordered-key';
+import { clearStorage, countHostCalls } from '../setup';
+
+function shuffled(count: number): number[] {
+  const values = Array.from({ length: count }, (_, i) => i);
+  let seed = 17;
+  for (let i = values.length - 1; i > 0; i--) {
+    seed = (seed * 1103515245 + 12345) % 2147483648;
+    const j = seed % (i + 1);
+    [values[i], values[j]] = [values[j], values[i]];
+  }
+  return values;
+}
+
+// Sets `entries` and indexes them as another executor would, the way a merged delta from that
+// node would arrive
+function writeAsExecutor(map: SortedMap<string, number>, entries: Array<[string, number]>): void {
+  const other = new Uint8Array(32).fill(7);
+  const internals = map as any;
+  internals.registerWriter(other);
+  const head = internals.readHead(other) ?? { executor: other, root: 0, nextNode: 1, size: 0 };
+  for (const [key, value] of entries) {
+    mapInsert(map.idBytes(), Uint8Array.of(0x01, ...encodeOrderedKey(key)), serialize(value));
+    if (internals.indexInsert(head, encodeOrderedKey(key))) {
+      head.size++;
+    }
+  }
+  internals.writeHead(head);
+}
+
+describe('ordered key encoding', () => {
+  it('orders encodings like the keys', () => {
+    const groups: OrderedKey[][] = [
+      [-Infinity, -1e300, -2.5, -1, -Number.MIN_VALUE, 0, 1e-9, 1, 2, 1e300, Infinity],
+      [-(2n ** 100n), -1n, 0n, 1n, 2n ** 64n],
+      ['', 'a', 'a\u0000', 'a\u0000b', 'ab', 'b', 'é', '🙂'],
+      [
+        Uint8Array.of(),
+        Uint8Array.of(0),
+        Uint8Array.of(0, 0),
+        Uint8Array.of(1),
+        Uint8Array.of(255),
+      ],
+      [[], [1], [1, 'a'], [1, 'b'], [2], [2, '']],
+    ];
+    for (const keys of groups) {
+      const encoded = keys.map(encodeOrderedKey);
+      for (let i = 1; i < encoded.length; i++) {
+        expect(compareBytes(encoded[i - 1], encoded[i])).toBeLessThan(0);
+      }
+      expect(encoded.map(decodeOrderedKey)).toEqual(keys);
+    }
+    expect(encodeOrderedKey(-0)).toEqual(encodeOrderedKey(0));
+    expect(() => encodeOrderedKey(NaN)).toThrow(RangeError);
+  });
+});
+
+describe('SortedMap', () => {
+  beforeEach(() => {
+    clearStorage();
+  });
+
+  it('should support point operations', () => {
+    const map = new SortedMap<string, number>();
+    expect(map.len()).toBe(0);
+    expect(map.first()).toBeNull();
+
+    map.set('b', 2);
+    map.set('a', 1);
+    map.set('b', 3);
+    expect(map.get('b')).toBe(3);
+    expect(map.has('a')).toBe(true);
+    expect(map.len()).toBe(2);
+
+    expect(map.remove('a')).toBe(true);
+    expect(map.remove('a')).toBe(false);
+    expect(map.get('a')).toBeNull();
+    expect(map.entries()).toEqual([['b', 3]]);
+  });
+
+  it('should keep keys ordered across index splits', () => {
+    const map = new SortedMap<number, string>();
+    for (const value of shuffled(1000)) {
+      map.set(value - 500, `v${value - 500}`);
+    }
+
+    expect(map.len()).toBe(1000);
+    expect(map.keys()).toEqual(Array.from({ length: 1000 }, (_, i) => i - 500));
+    expect(map.first()).toEqual([-500, 'v-500']);
+    expect(map.last()).toEqual([499, 'v499']);
+    expect(map.range(-3, 2)).toEqual([-3, -2, -1, 0, 1].map(key => [key, `v${key}`]));
+    expect(map.range(100, undefined, 3).map(([key]) => key)).toEqual([100, 101, 102]);
+    expect(map.range(undefined, -498).map(([key]) => key)).toEqual([-500, -499]);
+    expect(map.rangeKeys(10, 20, 3)).toEqual([10, 11, 12]);
+
+    const cursor = map.cursor({ to: 10, reverse: true });
+    expect(cursor.take(3).map(([key]) => key)).toEqual([9, 8, 7]);
+    expect(cursor.take(2).map(([key]) => key)).toEqual([6, 5]);
+
+    for (let key = -500; key < 500; key += 2) {
+      map.remove(key);
+    }
+    expect(map.len()).toBe(500);
+    expect(map.range(0, 10).map(([key]) => key)).toEqual([1, 3, 5, 7, 9]);
+    expect(map.cursor({ reverse: true }).take(2).map(([key]) => key)).toEqual([499, 497]);
+  });
+
+  it('should answer prefix queries on strings and tuples', () => {
+    const scores = new SortedMap<[number, string], boolean>();
+    const files = new SortedMap<string, number>();
+    for (const name of ['report.pdf', 'readme.md', 'photo.png', 'recipe.txt', 'notes.md']) {
+      files.set(name, name.length);
+    }
+    scores.set([10, 'carol'], true);
+    scores.set([30, 'alice'], true);
+    scores.set([10, 'bob'], true);
+
+    expect(files.prefix('re').map(([key]) => key)).toEqual([
+      'readme.md',
+      'recipe.txt',
+      'report.pdf',
+    ]);
+    expect(files.prefix('re', 1).map(([key]) => key)).toEqual(['readme.md']);
+    expect(files.prefix('x')).toEqual([]);
+    expect(files.prefixKeys('re', 2)).toEqual(['readme.md', 'recipe.txt']);
+    expect(scores.prefix([10]).map(([key]) => key)).toEqual([
+      [10, 'bob'],
+      [10, 'carol'],
+    ]);
+    expect(scores.last()?.[0]).toEqual([30, 'alice']);
+  });
+
+  it('should read O(log n + k) entries for a range', () => {
+    const small = new SortedMap<number, number>();
+    const large = new SortedMap<number, number>();
+    for (let i = 0; i < 200; i++) small.set(i, i);
+    for (let i = 0; i < 5000; i++) large.set(i, i);
+
+    const fromSmall = countHostCalls(['js_crdt_map_get'], () => small.range(100, 120));
+    const fromLarge = countHostCalls(['js_crdt_map_get'], () => large.range(2500, 2520));
+    expect(fromLarge.result).toHaveLength(20);
+    // head + index path (+ one sibling leaf) + 20 entries
+    expect(fromLarge.calls).toBeLessThanOrEqual(1 + 4 + 20);
+    expect(fromLarge.calls - fromSmall.calls).toBeLessThanOrEqual(2);
+  });
+
+  it('should merge the indexes of concurrent writers', () => {
+    const map = new SortedMap<string, number>();
+    map.set('a', 1);
+    map.set('c', 3);
+    map.set('e', 5);
+
+    // Another node inserted 'b' and 'd' and removed 'c' before seeing this node's writes
+    writeAsExecutor(map, [
+      ['b', 2],
+      ['d', 4],
+    ]);
+    mapRemove(map.idBytes(), Uint8Array.of(0x01, ...encodeOrderedKey('c')));
+
+    expect(map.keys()).toEqual(['a', 'b', 'd', 'e']);
+    expect(map.len()).toBe(4);
+    expect(map.rangeKeys('b', 'e')).toEqual(['b', 'd']);
+    expect(map.cursor({ reverse: true }).take(2)).toEqual([
+      ['e', 5],
+      ['d', 4],
+    ]);
+
+    // Later writes keep going to this node's index; 'b' stays in the other one and is skipped
+    map.set('f', 6);
+    expect(map.remove('b')).toBe(true);
+    expect(map.keys()).toEqual(['a', 'd', 'e', 'f']);
+    expect(map.prefixKeys('')).toEqual(['a', 'd', 'e', 'f']);
+    expect(map.len()).toBe(4);
+  });
+
+  it('should stay O(log n + k) after concurrent writers merge', () => {
+    const map = new SortedMap<string, number>();
+    const key = (i: number) => `k${String(i).padStart(5, '0')}`;
+    for (let i = 0; i < 4000; i += 2) map.set(key(i), i);
+    writeAsExecutor(
+      map,
+      Array.from({ length: 2000 }, (_, i): [string, number] => [key(2 * i + 1), 2 * i + 1])
+    );
+
+    // head + path per writer + 20 entries
+    const { result, calls: reads } = countHostCalls(['js_crdt_map_get'], () =>
+      map.range(key(2000), key(2020))
+    );
+    expect(result.map(([, value]) => value)).toEqual(
+      Array.from({ length: 20 }, (_, i) => 2000 + i)
+    );
+    expect(reads).toBeLessThanOrEqual(2 * (1 + 3) + 20);
+
+    // New keys and removals only touch this node's index: entry + leaf (+ split) + head
+    const writes = (run: () => void) => countHostCalls(['js_crdt_map_insert'], run).calls;
+    expect(writes(() => map.set(key(4001), 4001))).toBeLessThanOrEqual(5);
+    expect(writes(() => map.set(key(4003), 4003))).toBeLessThanOrEqual(5);
+    map.remove(key(2001));
+    expect(map.rangeKeys(key(2000), key(2004))).toEqual([key(2000), key(2002), key(2003)]);
+  });
+
+  it('should keep its value codec when reloaded', () => {
+    const map = new SortedMap<string, string>({ valueCodec: 'string' });
+    map.set('k', 'v');
+
+    const outer = new UnorderedMap<string, SortedMap<string, string>>();
+    outer.set('index', map);
+    const reloaded = UnorderedMap.fromId<string, SortedMap<string, string>>(outer.id()).get(
+      'index'
+    )!;
+    reloaded.set('j', 'w');
+    expect(reloaded.entries()).toEqual([
+      ['j', 'w'],
+      ['k', 'v'],
+    ]);
+  });
+});
@@ -6,6 +6,12 @@ import '../setup';
 import { UnorderedMap } from '../../collections/UnorderedMap';
 import { UnorderedSet } from '../../collections/UnorderedSet';
 import { clearStorage } from '../setup';
+import { mapGet } from '../../runtime/storage-wasm';
+import { LARGE_VALUE_REF_SIZE } from '../../runtime/large-values';
+import { serialize } from '../../utils/serialize';
+import { contextId } from '../../env/api';
+import { beginInvocationContext, endInvocationContext } from '../../runtime/invocation-context';
+import { installBlobHost } from '../blob-host';
 
 describe('UnorderedMap', () => {
   beforeEach(() => {
@@ -141,4 +147,106 @@ describe('UnorderedMap', () => {
       expect(set?.toArray().sort()).toEqual(['alice', 'bob']);
     });
   });
+
+  describe('large values', () => {
+    let store: ReturnType<typeof installBlobHost>;
+
+    beforeEach(() => {
+      store = installBlobHost();
+      beginInvocationContext();
+    });
+
+    afterEach(() => {
+      endInvocationContext();
+      store.restore();
+    });
+
+    const document = (seed: string) => seed.repeat(1000);
+
+    it('stores values above the threshold in a blob and reads them back', () => {
+      const map = new UnorderedMap<string, string>({ largeValues: { threshold: 256 } });
+      map.set('small', 'tiny');
+      map.set('large', document('a'));
+
+      expect(map.get('small')).toBe('tiny');
+      expect(map.get('large')).toBe(document('a'));
+      expect(map.entries()).toEqual([
+        ['small', 'tiny'],
+        ['large', document('a')],
+      ]);
+      expect(store.calls.uploads).toBe(1);
+      expect(store.announced).toEqual([
+        { blobId: mapGet(map.idBytes(), serialize('large'))!.slice(1, 33), contextId: contextId() },
+      ]);
+
+      const stored = mapGet(map.idBytes(), serialize('large'))!;
+      expect(stored.length).toBe(LARGE_VALUE_REF_SIZE);
+      expect(map.has('large')).toBe(true);
+    });
+
+    it('lists keys and checks membership without opening blobs', () => {
+      const map = new UnorderedMap<string, string>({ largeValues: { threshold: 256 } });
+      map.set('first', document('h'));
+      map.set('second', document('i'));
+
+      endInvocationContext();
+      beginInvocationContext();
+      expect(map.keys()).toEqual(['first', 'second']);
+      expect(map.has('first')).toBe(true);
+      expect(map.has('third')).toBe(false);
+      expect(store.calls.open).toBe(0);
+
+      expect(map.values()).toEqual([document('h'), document('i')]);
+      expect(store.calls.open).toBe(2);
+    });
+
+    it('reuses the blob when an unchanged large value is written again', () => {
+      const map = new UnorderedMap<string, string>({ largeValues: { threshold: 256 } });
+      map.set('doc', document('d'));
+      map.set('doc', document('d'));
+      map.set('copy', document('d'));
+      expect(store.calls.uploads).toBe(1);
+
+      map.set('doc', document('e'));
+      expect(store.calls.uploads).toBe(2);
+      expect(map.get('doc')).toBe(document('e'));
+      expect(map.get('copy')).toBe(document('d'));
+    });
+
+    it('only reuses blobs by content hash within one invocation', () => {
+      const map = new UnorderedMap<string, string>({ largeValues: { threshold: 256 } });
+      map.set('first', document('f'));
+
+      endInvocationContext();
+      beginInvocationContext();
+      map.set('second', document('f'));
+      expect(store.calls.uploads).toBe(2);
+      expect(store.announced.length).toBe(2);
+    });
+
+    it('rejects blob contents that do not match the reference hash', () => {
+      const map = new UnorderedMap<string, string>({ largeValues: { threshold: 256 } });
+      map.set('doc', document('g'));
+
+      // Same length, different bytes
+      const blobId = mapGet(map.idBytes(), serialize('doc'))!.slice(1, 33);
+      const data = store.blobs.get(blobId.join(','))!;
+      data[data.length - 1] ^= 0xff;
+      expect(() => map.get('doc')).toThrow('SHA256');
+    });
+
+    it('keeps the policy when the map is reloaded from state', () => {
+      const outer = new UnorderedMap<string, UnorderedMap<string, string>>();
+      const inner = new UnorderedMap<string, string>({ largeValues: { threshold: 128 } });
+      inner.set('doc', document('c'));
+      outer.set('inner', inner);
+
+      const restored = UnorderedMap.fromId<string, UnorderedMap<string, string>>(outer.id());
+      expect(restored.get('inner')?.get('doc')).toBe(document('c'));
+    });
+
+    it('rejects thresholds smaller than a reference', () => {
+      expect(() => new UnorderedMap({ largeValues: { threshold: 16 } })).toThrow(RangeError);
+    });
+  });
 });
@@ -0,0 +1,155 @@
+/**
+ * Buffered event emission tests
+ */
+
+import './setup';
+import {
+  beginEventBatch,
+  discardEventBatch,
+  emit,
+  emitWithHandler,
+  flushEventBatch,
+} from '../events/emitter';
+import { BorshReader } from '../borsh/decoder';
+import { serializeWithAbi } from '../utils/abi-serialize';
+import type { AbiManifest } from '../abi/types';
+
+const abi: AbiManifest = {
+  schema_version: 'wasm-abi/1',
+  types: {
+    MessageSent: {
+      kind: 'record',
+      fields: [
+        { name: 'author', type: { kind: 'string' } },
+        { name: 'seq', type: { kind: 'u32' } },
+      ],
+    },
+  },
+  methods: [],
+  events: [
+    { name: 'MessageSent', payload: { kind: 'reference', name: 'MessageSent' } },
+    { name: 'Cleared' },
+  ],
+};
+
+class MessageSent {
+  constructor(
+    public author: string,
+    public seq: number
+  ) {}
+}
+
+class Cleared {}
+
+type Emitted = { kind: string; data: number[]; handler?: string };
+
+const decoder = new TextDecoder();
+
+function decodeBatch(bytes: Uint8Array): Emitted[] {
+  const reader = new BorshReader(bytes);
+  const out: Emitted[] = [];
+  const count = reader.readU32();
+  for (let i = 0; i < count; i++) {
+    const kind = reader.readString();
+    const data = Array.from(reader.readBytes());
+    const handler = reader.readU8() === 1 ? reader.readString() : undefined;
+    out.push(handler === undefined ? { kind, data } : { kind, data, handler });
+  }
+  return out;
+}
+
+describe('buffered events', () => {
+  const host = (global as any).env;
+  const originals = { emit: host.emit, emit_with_handler: host.emit_with_handler };
+  let sequential: Emitted[];
+  let batches: Uint8Array[];
+
+  beforeEach(() => {
+    (globalThis as any).__CALIMERO_ABI_MANIFEST__ = JSON.stringify(abi);
+    sequential = [];
+    batches = [];
+    host.emit = (kind: Uint8Array, data: Uint8Array) => {
+      sequential.push({ kind: decoder.decode(kind), data: Array.from(data) });
+    };
+    host.emit_with_handler = (kind: Uint8Array, data: Uint8Array, handler: Uint8Array) => {
+      sequential.push({
+        kind: decoder.decode(kind),
+        data: Array.from(data),
+        handler: decoder.decode(handler),
+      });
+    };
+  });
+
+  afterEach(() => {
+    discardEventBatch();
+    delete host.emit_batch;
+    host.emit = originals.emit;
+    host.emit_with_handler = originals.emit_with_handler;
+    delete (globalThis as any).__CALIMERO_ABI_MANIFEST__;
+  });
+
+  const payload = (author: string, seq: number) =>
+    Array.from(serializeWithAbi({ author, seq }, { kind: 'reference', name: 'MessageSent' }, abi));
+
+  it('emits immediately outside a batch', () => {
+    emit(new MessageSent('alice', 1));
+    expect(sequential).toEqual([{ kind: 'MessageSent', data: payload('alice', 1) }]);
+  });
+
+  it('queues events and hands them over in one emit_batch call', () => {
+    host.emit_batch = (bytes: Uint8Array) => batches.push(bytes.slice());
+
+    beginEventBatch();
+    emit(new MessageSent('alice', 1));
+    emitWithHandler(new MessageSent('bob', 2), 'onMessage');
+    emit(new Cleared());
+    expect(batches).toHaveLength(0);
+
+    expect(flushEventBatch()).toBe(3);
+    expect(sequential).toHaveLength(0);
+    expect(batches).toHaveLength(1);
+    expect(decodeBatch(batches[0])).toEqual([
+      { kind: 'MessageSent', data: payload('alice', 1) },
+      { kind: 'MessageSent', data: payload('bob', 2), handler: 'onMessage' },
+      { kind: 'Cleared', data: [] },
+    ]);
+  });
+
+  it('replays the batch in order when emit_batch is unavailable', () => {
+    beginEventBatch();
+    emitWithHandler(new MessageSent('alice', 1), 'onMessage');
+    emit(new Cleared());
+    flushEventBatch();
+
+    expect(sequential).toEqual([
+      { kind: 'MessageSent', data: payload('alice', 1), handler: 'onMessage' },
+      { kind: 'Cleared', data: [] },
+    ]);
+  });
+
+  it('drops discarded events and sends nothing for an empty batch', () => {
+    host.emit_batch = (bytes: Uint8Array) => batches.push(bytes.slice());
+
+    beginEventBatch();
+    emit(new MessageSent('alice', 1));
+    discardEventBatch();
+    beginEventBatch();
+    expect(flushEventBatch()).toBe(0);
+
+    expect(batches).toHaveLength(0);
+    expect(sequential).toHaveLength(0);
+  });
+
+  it('keeps the arena well-formed when a payload fails to serialize', () => {
+    beginEventBatch();
+    emit(new MessageSent('alice', 1));
+    expect(() => emit(new MessageSent('bob', 'not a number' as any))).toThrow();
+    emit(new Cleared());
+    flushEventBatch();
+
+    expect(sequential).toEqual([
+      { kind: 'MessageSent', data: payload('alice', 1) },
+      { kind: 'Cleared', data: [] },
+    ]);
+  });
+});
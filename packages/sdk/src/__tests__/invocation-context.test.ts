@@ -0,0 +1,92 @@
+/**
+ * Per-invocation context record tests
+ */
+
+import './setup';
+import { contextId, executorId, executorIdBase58, executorIdHex, timeNow } from '../env/api';
+import { beginInvocationContext, endInvocationContext } from '../runtime/invocation-context';
+
+describe('invocation context', () => {
+  const host = (global as any).env;
+  const originals = {
+    context_id: host.context_id,
+    executor_id: host.executor_id,
+    time_now: host.time_now,
+  };
+  let hostCalls: string[];
+
+  beforeEach(() => {
+    hostCalls = [];
+    for (const name of Object.keys(originals) as Array<keyof typeof originals>) {
+      host[name] = (...args: unknown[]) => {
+        hostCalls.push(name);
+        return (originals[name] as (...a: unknown[]) => unknown)(...args);
+      };
+    }
+  });
+
+  afterEach(() => {
+    endInvocationContext();
+    Object.assign(host, originals);
+    delete host.invocation_context;
+  });
+
+  it('queries the host on every call outside a dispatch', () => {
+    executorId();
+    executorId();
+    timeNow();
+    expect(hostCalls).toEqual(['executor_id', 'executor_id', 'time_now']);
+  });
+
+  it('fetches the record once per invocation, lazily', () => {
+    beginInvocationContext();
+    expect(hostCalls).toEqual([]);
+
+    const first = executorId();
+    executorId();
+    contextId();
+    const t1 = timeNow();
+    const t2 = timeNow();
+
+    expect(hostCalls).toEqual(['context_id', 'executor_id', 'time_now']);
+    expect(t1).toBe(t2);
+    expect(first).toEqual(new Uint8Array(32).fill(1));
+    expect(contextId()).toEqual(new Uint8Array(32).fill(2));
+  });
+
+  it('hands out copies so callers cannot mutate the record', () => {
+    beginInvocationContext();
+    executorId()[0] = 99;
+    expect(executorId()[0]).toBe(1);
+  });
+
+  it('memoizes derived encodings per invocation', () => {
+    beginInvocationContext();
+    const hex = executorIdHex();
+    expect(hex).toBe('01'.repeat(32));
+    expect(executorIdHex()).toBe(hex);
+    expect(executorIdBase58()).toBe(executorIdBase58());
+    expect(hostCalls).toEqual(['context_id', 'executor_id', 'time_now']);
+
+    // A new invocation starts from a fresh record
+    endInvocationContext();
+    beginInvocationContext();
+    executorIdHex();
+    expect(hostCalls).toHaveLength(6);
+  });
+
+  it('uses the fused invocation_context call when available', () => {
+    host.invocation_context = (buf: Uint8Array) => {
+      hostCalls.push('invocation_context');
+      buf.fill(3, 0, 32);
+      buf.fill(4, 32, 64);
+      new DataView(buf.buffer, buf.byteOffset).setBigUint64(64, 42n, true);
+    };
+
+    beginInvocationContext();
+    expect(contextId()).toEqual(new Uint8Array(32).fill(3));
+    expect(executorId()).toEqual(new Uint8Array(32).fill(4));
+    expect(timeNow()).toBe(42n);
+    expect(hostCalls).toEqual(['invocation_context']);
+  });
+});
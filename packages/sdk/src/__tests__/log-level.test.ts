@@ -0,0 +1,65 @@
+import './setup';
+import * as env from '../env/api';
+
+describe('log levels', () => {
+  const host = (global as any).env;
+  let logged: string[];
+  let originalLog: (msg: Uint8Array) => void;
+
+  beforeEach(() => {
+    logged = [];
+    originalLog = host.log_utf8;
+    host.log_utf8 = (msg: Uint8Array) => {
+      logged.push(new TextDecoder().decode(msg));
+    };
+    env.setLogLevel('debug');
+  });
+
+  afterEach(() => {
+    host.log_utf8 = originalLog;
+  });
+
+  it('emits messages at or above the active level', () => {
+    env.setLogLevel(env.LogLevel.Warn);
+
+    env.logDebug('debug');
+    env.logInfo('info');
+    env.logWarn('warn');
+    env.logError('error');
+
+    expect(logged).toEqual(['warn', 'error']);
+  });
+
+  it('does not evaluate message thunks when disabled', () => {
+    env.setLogLevel('info');
+    const thunk = jest.fn(() => 'expensive');
+
+    env.logDebug(thunk);
+    expect(thunk).not.toHaveBeenCalled();
+
+    env.logInfo(thunk);
+    expect(thunk).toHaveBeenCalledTimes(1);
+    expect(logged).toEqual(['expensive']);
+  });
+
+  it('logs plain messages at info level', () => {
+    env.setLogLevel('info');
+    env.log('shown');
+    env.setLogLevel('warn');
+    env.log('hidden');
+
+    expect(logged).toEqual(['shown']);
+  });
+
+  it('silences everything at silent level', () => {
+    env.setLogLevel('silent');
+    env.logError('error');
+
+    expect(logged).toEqual([]);
+    expect(env.isLogEnabled(env.LogLevel.Error)).toBe(false);
+  });
+
+  it('rejects unknown level names', () => {
+    expect(() => env.setLogLevel('verbose' as env.LogLevelName)).toThrow('Unknown log level');
+  });
+});
@@ -0,0 +1,124 @@
+/**
+ * Context membership cache tests
+ */
+
+import './setup';
+import { contextIsMember, contextIsMemberMany, contextMembers } from '../env/api';
+import { beginInvocationContext, endInvocationContext } from '../runtime/invocation-context';
+
+const key = (byte: number) => new Uint8Array(32).fill(byte);
+
+function encodeMembers(members: Uint8Array[]): Uint8Array {
+  const out = new Uint8Array(4 + members.length * 32);
+  new DataView(out.buffer).setUint32(0, members.length, true);
+  members.forEach((member, i) => out.set(member, 4 + i * 32));
+  return out;
+}
+
+describe('context membership', () => {
+  const host = (global as any).env;
+  const originals = {
+    context_members: host.context_members,
+    context_is_member: host.context_is_member,
+    register_len: host.register_len,
+    read_register: host.read_register,
+  };
+  const members = [key(1), key(2), key(3)];
+  let calls: Record<string, number>;
+
+  beforeEach(() => {
+    calls = { context_members: 0, context_is_member: 0, context_is_member_many: 0 };
+    let register = new Uint8Array(0);
+    const isMember = (publicKey: Uint8Array) =>
+      members.some(member => member.every((byte, i) => byte === publicKey[i]));
+
+    host.context_members = () => {
+      calls.context_members++;
+      register = encodeMembers(members);
+    };
+    host.register_len = () => BigInt(register.length);
+    host.read_register = (_register: bigint, buf: Uint8Array) => {
+      buf.set(register);
+      return true;
+    };
+    host.context_is_member = (publicKey: Uint8Array) => {
+      calls.context_is_member++;
+      return isMember(publicKey) ? 1 : 0;
+    };
+  });
+
+  afterEach(() => {
+    endInvocationContext();
+    delete host.context_is_member_many;
+    Object.assign(host, originals);
+  });
+
+  it('queries the host on every call outside a dispatch', () => {
+    expect(contextIsMember(key(1))).toBe(true);
+    expect(contextIsMember(key(1))).toBe(true);
+    expect(contextIsMember(key(9))).toBe(false);
+    expect(calls.context_is_member).toBe(3);
+  });
+
+  it('remembers single checks for the rest of the invocation', () => {
+    beginInvocationContext();
+    expect(contextIsMember(key(1))).toBe(true);
+    expect(contextIsMember(key(9))).toBe(false);
+    expect(contextIsMember(key(1))).toBe(true);
+    expect(contextIsMember(key(9))).toBe(false);
+    expect(calls.context_is_member).toBe(2);
+
+    // A new invocation starts with an empty cache
+    beginInvocationContext();
+    contextIsMember(key(1));
+    expect(calls.context_is_member).toBe(3);
+  });
+
+  it('loads the member list once after a few distinct checks', () => {
+    beginInvocationContext();
+    for (let byte = 1; byte <= 10; byte++) {
+      expect(contextIsMember(key(byte))).toBe(byte <= 3);
+    }
+    expect(calls.context_is_member).toBe(4);
+    expect(calls.context_members).toBe(1);
+
+    contextMembers();
+    expect(calls.context_members).toBe(1);
+  });
+
+  it('hands out copies of the cached member keys', () => {
+    beginInvocationContext();
+    const first = contextMembers();
+    first[0].fill(0xff);
+    expect(contextMembers()[0]).toEqual(key(1));
+    expect(contextIsMember(key(1))).toBe(true);
+    expect(calls.context_members).toBe(1);
+    expect(calls.context_is_member).toBe(0);
+  });
+
+  it('answers bulk checks with one native call for the keys not yet known', () => {
+    const batches: number[] = [];
+    host.context_is_member_many = (packed: Uint8Array, out: Uint8Array) => {
+      calls.context_is_member_many++;
+      batches.push(packed.length / 32);
+      for (let i = 0; i < out.length; i++) {
+        out[i] = host.context_is_member(packed.subarray(i * 32, (i + 1) * 32));
+      }
+    };
+
+    beginInvocationContext();
+    contextIsMember(key(2));
+    const keys = [key(1), key(2), key(7), key(3)];
+    expect(contextIsMemberMany(keys)).toEqual([true, true, false, true]);
+    expect(batches).toEqual([3]);
+
+    expect(contextIsMemberMany(keys)).toEqual([true, true, false, true]);
+    expect(calls.context_is_member_many).toBe(1);
+  });
+
+  it('falls back to single checks without the native bulk call', () => {
+    expect(contextIsMemberMany([key(1), key(8)])).toEqual([true, false]);
+    expect(calls.context_is_member).toBe(2);
+    expect(() => contextIsMemberMany([new Uint8Array(31)])).toThrow(RangeError);
+  });
+});
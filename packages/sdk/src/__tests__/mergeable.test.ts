@@ -3,6 +3,7 @@ import { Mergeable } from '../decorators/mergeable';
 import { serialize, deserialize } from '../utils/serialize';
 import { getMergeableDescriptor, getMergeableType } from '../runtime/mergeable-registry';
 import { UnorderedMap } from '../collections/UnorderedMap';
+import { mergeMergeableValues } from '../runtime/mergeable';
 
 @Mergeable()
 class SimpleRecord {
@@ -22,6 +23,13 @@ class StatsRecord {
   losses = 0;
 }
 
+@Mergeable({ fields: ['title', 'views', 'stats'] })
+class ArticleRecord {
+  title = 'draft';
+  views = 0;
+  stats = new StatsRecord();
+}
+
 describe('Mergeable decorator', () => {
   it('registers descriptors and annotates instances', () => {
     const descriptor = getMergeableDescriptor('SimpleRecord');
@@ -78,4 +86,81 @@ describe('Mergeable decorator', () => {
     expect(resolved?.wins).toBe(4);
     expect(resolved?.losses).toBe(3);
   });
+
+  it('merges through a single js_crdt_map_merge_insert call per set', () => {
+    const env = (global as any).env;
+    const native = env.js_crdt_map_merge_insert;
+    let nativeCalls = 0;
+    env.js_crdt_map_merge_insert = (...args: any[]) => {
+      nativeCalls += 1;
+      return native(...args);
+    };
+
+    try {
+      const map = new UnorderedMap<string, StatsRecord>();
+      const valueA = new StatsRecord();
+      valueA.wins = 1;
+      valueA.losses = 4;
+      const valueB = new StatsRecord();
+      valueB.wins = 6;
+      valueB.losses = 9;
+
+      map.set('beta', valueA);
+      map.set('beta', valueB);
+
+      expect(nativeCalls).toBe(2);
+      expect(map.get('beta')).toMatchObject({ wins: 6, losses: 4 });
+      expect(valueB.losses).toBe(9);
+    } finally {
+      env.js_crdt_map_merge_insert = native;
+    }
+  });
+
+  it('merges owned values in place and copies borrowed ones on first change', () => {
+    const local = deserialize<any>(serialize(new ArticleRecord()));
+    const remote = new ArticleRecord();
+    remote.title = 'published';
+    remote.stats.wins = 3;
+
+    const merged = mergeMergeableValues(local, remote, { ownsLocal: true });
+    expect(merged).toBe(local);
+    expect(merged).toMatchObject({ title: 'published', views: 0, stats: { wins: 3 } });
+    expect(getMergeableType(merged)).toBe('ArticleRecord');
+
+    const borrowed = new ArticleRecord();
+    const copy = mergeMergeableValues(borrowed, remote);
+    expect(copy).not.toBe(borrowed);
+    expect(borrowed.title).toBe('draft');
+    expect(copy.title).toBe('published');
+  });
+
+  it('returns the local value when nothing differs', () => {
+    const local = new SimpleRecord();
+    const remote = new SimpleRecord();
+
+    expect(mergeMergeableValues(local, remote)).toBe(local);
+  });
+
+  it('falls back to read-merge-write when the runtime lacks merge insert', () => {
+    const env = (global as any).env;
+    const native = env.js_crdt_map_merge_insert;
+    delete env.js_crdt_map_merge_insert;
+
+    try {
+      const map = new UnorderedMap<string, StatsRecord>();
+      const valueA = new StatsRecord();
+      valueA.wins = 3;
+      valueA.losses = 1;
+      const valueB = new StatsRecord();
+      valueB.wins = 2;
+      valueB.losses = 2;
+
+      map.set('gamma', valueA);
+      map.set('gamma', valueB);
+
+      expect(map.get('gamma')).toMatchObject({ wins: 3, losses: 1 });
+    } finally {
+      env.js_crdt_map_merge_insert = native;
+    }
+  });
 });
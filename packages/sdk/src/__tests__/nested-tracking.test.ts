@@ -0,0 +1,92 @@
+/**
+ * Nested collection tracking tests
+ */
+
+import './setup';
+import { UnorderedMap } from '../collections/UnorderedMap';
+import { Counter } from '../collections/Counter';
+import {
+  COLLECTION_HANDLE,
+  hasRegisteredCollection,
+  snapshotCollection,
+} from '../runtime/collections';
+import { clearStorage } from './setup';
+
+function countParentRefreshes(parent: UnorderedMap<any, any>, run: () => void): number {
+  const proto = UnorderedMap.prototype as any;
+  const originalSet = proto.set;
+  let refreshes = 0;
+  proto.set = function (this: UnorderedMap<any, any>, key: any, value: any) {
+    if (this.id() === parent.id()) {
+      refreshes += 1;
+    }
+    return originalSet.call(this, key, value);
+  };
+  try {
+    run();
+  } finally {
+    proto.set = originalSet;
+  }
+  return refreshes;
+}
+
+describe('nested collection tracking', () => {
+  beforeEach(() => {
+    clearStorage();
+  });
+
+  it('brands collections with a handle shared by instances of the same id', () => {
+    const map = new UnorderedMap<string, string>();
+    const again = UnorderedMap.fromId<string, string>(map.id());
+    const counter = new Counter();
+
+    expect(typeof (map as any)[COLLECTION_HANDLE]).toBe('number');
+    expect((again as any)[COLLECTION_HANDLE]).toBe((map as any)[COLLECTION_HANDLE]);
+    expect((counter as any)[COLLECTION_HANDLE]).not.toBe((map as any)[COLLECTION_HANDLE]);
+    expect(hasRegisteredCollection(counter)).toBe(true);
+    expect(snapshotCollection(map)).toEqual({ type: 'UnorderedMap', id: map.id() });
+    expect(Object.getOwnPropertyDescriptor(map, COLLECTION_HANDLE)?.enumerable).toBe(false);
+  });
+
+  it('refreshes the parent entry once per nested modification', () => {
+    const outer = new UnorderedMap<string, UnorderedMap<string, number>>();
+    const inner = new UnorderedMap<string, number>();
+    outer.set('inner', inner);
+
+    const refreshes = countParentRefreshes(outer, () => {
+      for (let i = 0; i < 50; i += 1) {
+        inner.set(`k${i}`, i);
+        // Re-registering the same child must not add parent edges
+        outer.set('inner', inner);
+      }
+    });
+
+    // 50 explicit sets plus one refresh per inner insert
+    expect(refreshes).toBe(100);
+    expect(outer.get('inner')?.get('k49')).toBe(49);
+  });
+
+  it('propagates through every level of the parent chain', () => {
+    const root = new UnorderedMap<string, UnorderedMap<string, any>>();
+    const middle = new UnorderedMap<string, UnorderedMap<string, number>>();
+    const leaf = new UnorderedMap<string, number>();
+    middle.set('leaf', leaf);
+    root.set('middle', middle);
+
+    const rootRefreshes = countParentRefreshes(root, () => {
+      leaf.set('value', 1);
+    });
+
+    expect(rootRefreshes).toBe(1);
+  });
+
+  it('terminates on cyclic parent edges', () => {
+    const a = new UnorderedMap<string, any>();
+    const b = new UnorderedMap<string, any>();
+    a.set('b', b);
+    b.set('a', a);
+
+    expect(() => a.set('x', 1)).not.toThrow();
+    expect(a.get('x')).toBe(1);
+  });
+});
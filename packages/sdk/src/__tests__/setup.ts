@@ -190,6 +190,7 @@ function getExecutorKey(executor?: Uint8Array): string {
   blob_read: (_fd: bigint, _buffer: Uint8Array): bigint => 0n,
   blob_write: (_fd: bigint, data: Uint8Array): bigint => BigInt(data.length),
   blob_close: (_fd: bigint, _blob_id_buf: Uint8Array): boolean => true,
+  blob_announce_to_context: (_blob_id: Uint8Array, _context_id: Uint8Array): number => 1,
 
   js_crdt_map_new: (_register_id: bigint): number => {
     const id = generateId();
@@ -233,6 +234,24 @@ function getExecutorKey(executor?: Uint8Array): string {
     return 0;
   },
 
+  js_crdt_map_merge_insert: (
+    mapId: Uint8Array,
+    key: Uint8Array,
+    merge: (current: Uint8Array | null) => Uint8Array,
+    register_id: bigint
+  ): number => {
+    const env = (global as any).env;
+    const status = env.js_crdt_map_get(mapId, key, register_id);
+    if (status < 0) {
+      return status;
+    }
+    const current = status > 0 && currentRegister ? new Uint8Array(currentRegister) : null;
+    const merged = merge(current);
+    // Mirror the native binding: the borrowed buffer does not outlive the callback
+    current?.fill(0);
+    return env.js_crdt_map_insert(mapId, key, merged, register_id);
+  },
+
   js_crdt_map_remove: (mapId: Uint8Array, key: Uint8Array, _register_id: bigint): number => {
     const store = maps.get(idToKey(mapId));
     if (!store) {
@@ -504,3 +523,28 @@ export function clearStorage() {
 export function getStorage() {
   return storage;
 }
+
+// Counts the host calls `run` makes to the named imports, e.g. `['js_crdt_map_get']`
+export function countHostCalls<R>(
+  names: string[],
+  run: () => R
+): { result: R; calls: number; counts: Record<string, number> } {
+  const host = (global as any).env;
+  const originals = names.map(name => host[name]);
+  const counts: Record<string, number> = Object.fromEntries(names.map(name => [name, 0]));
+  names.forEach((name, i) => {
+    host[name] = (...args: unknown[]) => {
+      counts[name]++;
+      return originals[i](...args);
+    };
+  });
+  try {
+    const result = run();
+    const calls = names.reduce((sum, name) => sum + counts[name], 0);
+    return { result, calls, counts };
+  } finally {
+    names.forEach((name, i) => {
+      host[name] = originals[i];
+    });
+  }
+}
@@ -0,0 +1,86 @@
+/**
+ * Batched sync tests
+ */
+
+import './setup';
+import { BorshWriter } from '../borsh/encoder';
+import { applyDeltaBatch, decodeDeltaBatch } from '../runtime/sync';
+
+function encodeBatch(deltas: Uint8Array[]): Uint8Array {
+  const writer = new BorshWriter();
+  writer.writeVec(deltas, delta => writer.writeBytes(delta));
+  return writer.finish();
+}
+
+describe('batched sync', () => {
+  const host = (global as any).env;
+  let applied: number[][];
+  let flushes: number;
+
+  beforeEach(() => {
+    applied = [];
+    flushes = 0;
+    host.apply_storage_delta = (delta: Uint8Array) => {
+      if (delta[0] === 0xff) {
+        throw new Error('rejected');
+      }
+      applied.push(Array.from(delta));
+    };
+    host.flush_delta = () => {
+      flushes += 1;
+      return 1;
+    };
+  });
+
+  afterEach(() => {
+    delete host.apply_storage_delta;
+    delete host.flush_delta;
+  });
+
+  it('splits a length-prefixed stream into deltas', () => {
+    const deltas = [new Uint8Array([1, 2]), new Uint8Array(0), new Uint8Array([3])];
+    expect(decodeDeltaBatch(encodeBatch(deltas)).map(delta => Array.from(delta))).toEqual([
+      [1, 2],
+      [],
+      [3],
+    ]);
+    expect(decodeDeltaBatch(new Uint8Array(0))).toEqual([]);
+  });
+
+  it('rejects truncated or padded streams', () => {
+    const batch = encodeBatch([new Uint8Array([1, 2, 3])]);
+    expect(() => decodeDeltaBatch(batch.subarray(0, batch.length - 1))).toThrow();
+
+    const padded = new Uint8Array(batch.length + 1);
+    padded.set(batch);
+    expect(() => decodeDeltaBatch(padded)).toThrow('trailing bytes');
+  });
+
+  it('applies deltas in order and flushes once', () => {
+    const report = applyDeltaBatch([new Uint8Array([1]), new Uint8Array([2])]);
+
+    expect(applied).toEqual([[1], [2]]);
+    expect(report).toEqual({ applied: 2, failed: null, notApplied: [] });
+    expect(flushes).toBe(1);
+  });
+
+  it('stops at the first failing delta and reports the rest as not applied', () => {
+    const report = applyDeltaBatch([
+      new Uint8Array([1]),
+      new Uint8Array([0xff]),
+      new Uint8Array([2]),
+      new Uint8Array([3]),
+    ]);
+
+    expect(applied).toEqual([[1]]);
+    expect(report.applied).toBe(1);
+    expect(report.failed).toEqual({ index: 1, error: 'Error: rejected' });
+    expect(report.notApplied).toEqual([1, 2, 3]);
+    expect(flushes).toBe(1);
+  });
+
+  it('does not flush when nothing was applied', () => {
+    expect(applyDeltaBatch([]).applied).toBe(0);
+    expect(flushes).toBe(0);
+  });
+});
@@ -0,0 +1,133 @@
+/**
+ * Typed collection codec tests
+ */
+
+import '../setup';
+import { codecFor, abiCollectionCodecs } from '../../utils/abi-codec';
+import { serializeWithAbi } from '../../utils/abi-serialize';
+import { serialize, deserialize } from '../../utils/serialize';
+import { UnorderedMap } from '../../collections/UnorderedMap';
+import { UnorderedSet } from '../../collections/UnorderedSet';
+import { Vector } from '../../collections/Vector';
+import { mapGet } from '../../runtime/storage-wasm';
+import { snapshotCollection } from '../../runtime/collections';
+import type { AbiManifest, TypeRef } from '../../abi/types';
+import { clearStorage } from '../setup';
+
+const abi: AbiManifest = {
+  schema_version: 'wasm-abi/1',
+  types: {
+    Profile: {
+      kind: 'record',
+      fields: [
+        { name: 'name', type: { kind: 'string' } },
+        { name: 'age', type: { kind: 'u32' } },
+      ],
+    },
+    AppState: {
+      kind: 'record',
+      fields: [
+        {
+          name: 'balances',
+          type: { kind: 'map', key: { kind: 'string' }, value: { kind: 'u64' } },
+        },
+        { name: 'tags', type: { kind: 'list', items: { kind: 'string' } } },
+        { name: 'title', type: { kind: 'string' } },
+      ],
+    },
+  },
+  methods: [],
+  events: [],
+};
+
+describe('abi codecs', () => {
+  beforeEach(() => {
+    clearStorage();
+  });
+
+  it('matches serializeWithAbi byte for byte', () => {
+    const cases: Array<[TypeRef, unknown]> = [
+      [{ kind: 'string' }, 'héllo 😀'],
+      [{ kind: 'u32' }, 4000000000],
+      [{ kind: 'u64' }, 18446744073709551615n],
+      [{ kind: 'bool' }, true],
+      [{ kind: 'bytes' }, new Uint8Array([1, 2, 3])],
+      [{ kind: 'i32' }, -5],
+      [{ kind: 'option', inner: { kind: 'string' } }, null],
+      [{ kind: 'list', items: { kind: 'u32' } }, [1, 2, 3]],
+      [{ $ref: 'Profile' } as TypeRef, { name: 'ada', age: 36 }],
+    ];
+    for (const [type, value] of cases) {
+      const codec = codecFor(type, abi);
+      const bytes = codec.encode(value);
+      expect(Array.from(bytes)).toEqual(Array.from(serializeWithAbi(value, type, abi)));
+      expect(codec.decode(bytes)).toEqual(value);
+    }
+  });
+
+  it('caches codecs per type and accepts scalar names', () => {
+    expect(codecFor('string')).toBe(codecFor({ kind: 'string' }));
+    expect(Array.from(codecFor('string').encode('ab'))).toEqual([2, 0, 0, 0, 97, 98]);
+  });
+
+  it('rejects trailing bytes', () => {
+    expect(() => codecFor('u32').decode(new Uint8Array(5))).toThrow();
+    expect(() => codecFor('string').decode(new Uint8Array([1, 0, 0, 0]))).toThrow();
+  });
+
+  it('rejects integers outside the encoded range instead of wrapping them', () => {
+    expect(() => codecFor('u32').encode(-1)).toThrow(RangeError);
+    expect(() => codecFor('u32').encode(1.5)).toThrow(RangeError);
+    expect(() => codecFor('u32').encode(2 ** 32)).toThrow(RangeError);
+    expect(() => codecFor('u64').encode(-1n)).toThrow(RangeError);
+    expect(() => codecFor('u64').encode(2n ** 64n)).toThrow(RangeError);
+    expect(() => codecFor('u64').encode(0.5)).toThrow(RangeError);
+    expect(() => codecFor('u64').encode(2 ** 60)).toThrow(RangeError);
+    expect(Array.from(codecFor('u64').encode(2 ** 40))).toEqual([0, 0, 0, 0, 0, 1, 0, 0]);
+  });
+
+  it('stores map keys and values with plain Borsh', () => {
+    const map = new UnorderedMap<string, bigint>({ keyCodec: 'string', valueCodec: 'u64' });
+    map.set('alice', 10n);
+
+    const raw = mapGet(map.idBytes(), codecFor('string').encode('alice'));
+    expect(Array.from(raw!)).toEqual([10, 0, 0, 0, 0, 0, 0, 0]);
+    expect(map.get('alice')).toBe(10n);
+    expect(map.entries()).toEqual([['alice', 10n]]);
+  });
+
+  it('keeps codecs when collections are reloaded from a snapshot', () => {
+    const map = new UnorderedMap<string, bigint>({ keyCodec: 'string', valueCodec: 'u64' });
+    map.set('bob', 7n);
+    const vector = new Vector<string>({ valueCodec: 'string' });
+    vector.push('first');
+    const set = new UnorderedSet<string>({ valueCodec: 'string' });
+    set.add('x');
+
+    const restored = deserialize<{
+      map: UnorderedMap<string, bigint>;
+      vector: Vector<string>;
+      set: UnorderedSet<string>;
+    }>(serialize({ map, vector, set }));
+
+    expect(restored.map.get('bob')).toBe(7n);
+    expect(restored.vector.get(0)).toBe('first');
+    expect(restored.set.has('x')).toBe(true);
+  });
+
+  it('keeps codecs per instance when several instances share an id', () => {
+    const typed = new UnorderedMap<string, bigint>({ keyCodec: 'string', valueCodec: 'u64' });
+    const plain = new UnorderedMap<string, bigint>({ id: typed.id() });
+
+    expect(snapshotCollection(plain)).toEqual({ type: 'UnorderedMap', id: typed.id() });
+    expect(snapshotCollection(typed)?.codecs?.value).toEqual({ kind: 'u64' });
+  });
+
+  it('infers codecs from ABI collection fields', () => {
+    const map = new UnorderedMap<string, bigint>(abiCollectionCodecs('AppState', 'balances', abi));
+    map.set('carol', 3n);
+    expect(map.get('carol')).toBe(3n);
+    expect(abiCollectionCodecs('AppState', 'tags', abi).valueCodec).toBe(codecFor('string'));
+    expect(() => abiCollectionCodecs('AppState', 'title', abi)).toThrow();
+  });
+});
@@ -0,0 +1,182 @@
+/**
+ * Value compression tests
+ */
+
+import '../setup';
+import { clearStorage } from '../setup';
+import { lz4Bound, lz4Compress, lz4Decompress } from '../../utils/lz4';
+import { compressValue, decompressValue } from '../../utils/compression';
+import { UnorderedMap } from '../../collections/UnorderedMap';
+import { Vector } from '../../collections/Vector';
+import { loadRootState, saveRootState } from '../../runtime/root';
+import type { AbiManifest } from '../../abi/types';
+
+const encoder = new TextEncoder();
+
+function records(count: number): Uint8Array {
+  const rows = Array.from({ length: count }, (_, i) => ({
+    id: i,
+    owner: `user-${i % 17}`,
+    status: i % 3 === 0 ? 'active' : 'pending',
+    tags: ['alpha', 'beta'],
+  }));
+  return encoder.encode(JSON.stringify(rows));
+}
+
+function roundTrip(src: Uint8Array): Uint8Array {
+  const block = new Uint8Array(lz4Bound(src.length));
+  const size = lz4Compress(src, block);
+  const out = new Uint8Array(src.length);
+  lz4Decompress(block.subarray(0, size), out);
+  return out;
+}
+
+describe('lz4 codec', () => {
+  it('round-trips repetitive, random and edge-case inputs', () => {
+    const random = Uint8Array.from({ length: 5000 }, (_, i) => (i * 2654435761) >>> 24);
+    const run = new Uint8Array(70000).fill(7);
+    for (const input of [records(200), random, run, new Uint8Array(0), encoder.encode('short')]) {
+      expect(roundTrip(input)).toEqual(input);
+    }
+  });
+
+  it('shrinks JSON-like records several times over', () => {
+    const input = records(500);
+    const block = new Uint8Array(lz4Bound(input.length));
+    expect(lz4Compress(input, block)).toBeLessThan(input.length / 4);
+  });
+
+  it('rejects malformed blocks', () => {
+    const input = records(20);
+    const block = new Uint8Array(lz4Bound(input.length));
+    const size = lz4Compress(input, block);
+
+    expect(() => lz4Decompress(block.subarray(0, size - 3), new Uint8Array(input.length))).toThrow(
+      RangeError
+    );
+    expect(() => lz4Decompress(block.subarray(0, size), new Uint8Array(10))).toThrow(RangeError);
+    expect(() => lz4Decompress(Uint8Array.of(0x0f, 0, 0), new Uint8Array(8))).toThrow(RangeError);
+  });
+});
+
+describe('compressValue', () => {
+  const host = (global as any).env;
+
+  afterEach(() => {
+    delete host.lz4_compress;
+    delete host.lz4_decompress;
+  });
+
+  it('tags compressed and stored-as-is frames', () => {
+    const large = records(100);
+    const framed = compressValue(large, 'lz4');
+    expect(framed[0]).toBe(1);
+    expect(framed.length).toBeLessThan(large.length);
+    expect(decompressValue(framed)).toEqual(large);
+
+    const small = encoder.encode('tiny');
+    expect(Array.from(compressValue(small, 'lz4'))).toEqual([0, ...small]);
+    expect(Array.from(compressValue(large, 'none').subarray(0, 1))).toEqual([0]);
+    expect(() => decompressValue(Uint8Array.of(9, 1, 2))).toThrow('Unknown compression tag');
+  });
+
+  it('uses the native wrappers when builder.c provides them', () => {
+    const calls = { compress: 0, decompress: 0 };
+    host.lz4_compress = (src: Uint8Array, dst: Uint8Array) => {
+      calls.compress++;
+      return lz4Compress(src, dst);
+    };
+    host.lz4_decompress = (src: Uint8Array, dst: Uint8Array) => {
+      calls.decompress++;
+      return lz4Decompress(src, dst);
+    };
+
+    const input = records(50);
+    expect(decompressValue(compressValue(input, 'lz4'))).toEqual(input);
+    expect(calls).toEqual({ compress: 1, decompress: 1 });
+  });
+});
+
+describe('compressed storage', () => {
+  beforeEach(() => {
+    clearStorage();
+  });
+
+  it('compresses collection values and keeps the codec when reloaded', () => {
+    const rows = JSON.parse(new TextDecoder().decode(records(40)));
+    const map = new UnorderedMap<string, unknown>({ compression: 'lz4' });
+    map.set('rows', rows);
+    map.set('small', 1);
+    expect(map.get('rows')).toEqual(rows);
+    expect(map.get('small')).toBe(1);
+
+    const vector = new Vector<unknown>({ compression: 'lz4' });
+    vector.push(rows);
+    expect(vector.get(0)).toEqual(rows);
+
+    const outer = new UnorderedMap<string, UnorderedMap<string, unknown>>();
+    outer.set('inner', map);
+    expect(UnorderedMap.fromId<string, any>(outer.id()).get('inner')?.get('rows')).toEqual(rows);
+  });
+
+  describe('root document', () => {
+    const host = (global as any).env;
+    const originals = {
+      persist_root_state: host.persist_root_state,
+      read_root_state: host.read_root_state,
+      register_len: host.register_len,
+      read_register: host.read_register,
+    };
+    const abi: AbiManifest = {
+      schema_version: 'wasm-abi/1',
+      types: {
+        AppState: {
+          kind: 'record',
+          fields: [{ name: 'notes', type: { kind: 'list', items: { kind: 'string' } } }],
+        },
+      },
+      methods: [],
+      events: [],
+      state_root: 'AppState',
+    };
+
+    class AppState {
+      notes: string[] = [];
+    }
+
+    let stored: Uint8Array | null;
+
+    beforeEach(() => {
+      (globalThis as any).__CALIMERO_ABI_MANIFEST__ = JSON.stringify(abi);
+      stored = null;
+      host.persist_root_state = (doc: Uint8Array) => {
+        stored = doc.slice();
+      };
+      host.read_root_state = () => (stored ? 1 : 0);
+      host.register_len = () => BigInt(stored?.length ?? 0);
+      host.read_register = (_register: bigint, buf: Uint8Array) => {
+        buf.set(stored!);
+        return true;
+      };
+    });
+
+    afterEach(() => {
+      Object.assign(host, originals);
+      delete (globalThis as any).__CALIMERO_ABI_MANIFEST__;
+    });
+
+    it('writes a compressed document and still reads uncompressed ones', () => {
+      const state = new AppState();
+      state.notes = Array.from({ length: 50 }, (_, i) => `note ${i % 5}: remember the milk`);
+
+      const plain = saveRootState(state);
+      expect(plain[0]).toBe(1);
+      expect(loadRootState(AppState)?.notes).toEqual(state.notes);
+
+      const compressed = saveRootState(state, 'lz4');
+      expect(compressed[0]).toBe(2);
+      expect(compressed.length).toBeLessThan(plain.length / 2);
+      expect(loadRootState(AppState)?.notes).toEqual(state.notes);
+    });
+  });
+});
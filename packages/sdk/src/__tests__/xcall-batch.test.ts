@@ -0,0 +1,127 @@
+/**
+ * Batched cross-context call tests
+ */
+
+import './setup';
+import { xcall, xcallMany } from '../env/api';
+import {
+  beginXCallBatch,
+  discardXCallBatch,
+  encodeXCallBatch,
+  flushXCallBatch,
+} from '../runtime/xcall-batch';
+import { BorshReader } from '../borsh/decoder';
+
+type Call = { context: number; fn: string; params: number[] };
+
+const decoder = new TextDecoder();
+const encoder = new TextEncoder();
+
+function contextId(fill: number): Uint8Array {
+  return new Uint8Array(32).fill(fill);
+}
+
+function decodePacked(bytes: Uint8Array) {
+  const reader = new BorshReader(bytes);
+  const table = () => Array.from({ length: reader.readU32() }, () => reader.readBytes());
+  const functions = table().map(name => decoder.decode(name));
+  const params = table().map(payload => Array.from(payload));
+  const calls = Array.from({ length: reader.readU32() }, () => ({
+    context: reader.readFixedArray(32)[0],
+    fn: reader.readU32(),
+    params: reader.readU32(),
+  }));
+  expect(reader.remaining()).toBe(0);
+  return { functions, params, calls };
+}
+
+describe('batched xcall', () => {
+  const host = (global as any).env;
+  let sent: Call[];
+  let batches: Uint8Array[];
+
+  beforeEach(() => {
+    sent = [];
+    batches = [];
+    host.xcall = (context: Uint8Array, fn: Uint8Array, params: Uint8Array) => {
+      sent.push({ context: context[0], fn: decoder.decode(fn), params: Array.from(params) });
+    };
+  });
+
+  afterEach(() => {
+    discardXCallBatch();
+    delete host.xcall;
+    delete host.xcall_batch;
+  });
+
+  it('calls the host immediately outside a batch', () => {
+    xcall(contextId(1), 'pong', new Uint8Array([7]));
+    expect(sent).toEqual([{ context: 1, fn: 'pong', params: [7] }]);
+  });
+
+  it('packs a fan-out with one copy of the name and params', () => {
+    host.xcall_batch = (bytes: Uint8Array) => batches.push(bytes.slice());
+    const targets = Array.from({ length: 100 }, (_, i) => contextId(i));
+
+    beginXCallBatch();
+    xcallMany(targets, 'pong', encoder.encode('{"fromContext":"a"}'));
+    xcall(contextId(200), 'reset');
+    // Same content in a fresh buffer is still deduplicated
+    xcall(contextId(201), 'pong', encoder.encode('{"fromContext":"a"}'));
+    expect(batches).toHaveLength(0);
+
+    expect(flushXCallBatch()).toBe(102);
+    expect(sent).toHaveLength(0);
+    expect(batches).toHaveLength(1);
+
+    const packed = decodePacked(batches[0]);
+    expect(packed.functions).toEqual(['pong', 'reset']);
+    expect(packed.params).toEqual([Array.from(encoder.encode('{"fromContext":"a"}')), []]);
+    expect(packed.calls).toHaveLength(102);
+    expect(packed.calls[99]).toEqual({ context: 99, fn: 0, params: 0 });
+    expect(packed.calls[100]).toEqual({ context: 200, fn: 1, params: 1 });
+    expect(packed.calls[101]).toEqual({ context: 201, fn: 0, params: 0 });
+  });
+
+  it('interns large fan-out params once for all targets', () => {
+    host.xcall_batch = (bytes: Uint8Array) => batches.push(bytes.slice());
+    const params = new Uint8Array(4096).fill(9);
+    const targets = Array.from({ length: 50 }, (_, i) => contextId(i));
+
+    beginXCallBatch();
+    xcallMany(targets, 'sync', params);
+    flushXCallBatch();
+
+    const packed = decodePacked(batches[0]);
+    expect(packed.params).toHaveLength(1);
+    expect(packed.calls.map(call => call.params)).toEqual(new Array(50).fill(0));
+  });
+
+  it('does not alias a params buffer refilled between calls', () => {
+    const params = new Uint8Array([1]);
+    beginXCallBatch();
+    xcall(contextId(1), 'pong', params);
+    params[0] = 2;
+    xcall(contextId(2), 'pong', params);
+    flushXCallBatch();
+
+    expect(sent).toEqual([
+      { context: 1, fn: 'pong', params: [1] },
+      { context: 2, fn: 'pong', params: [2] },
+    ]);
+  });
+
+  it('drops discarded calls and validates context ids up front', () => {
+    beginXCallBatch();
+    xcall(contextId(1), 'pong');
+    expect(() => xcallMany([contextId(2), new Uint8Array(31)], 'pong')).toThrow('32 bytes');
+    discardXCallBatch();
+
+    expect(flushXCallBatch()).toBe(0);
+    expect(sent).toHaveLength(0);
+  });
+
+  it('encodes an empty batch as three empty tables', () => {
+    expect(Array.from(encodeXCallBatch([], [], []))).toEqual(new Array(12).fill(0));
+  });
+});
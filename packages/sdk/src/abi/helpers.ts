@@ -6,6 +6,13 @@
 
 import type { AbiManifest, TypeRef, TypeDef, Method, Event } from './types.js';
 
+// The C-injected manifest is a string; parse it once per distinct source
+let parsedSource: string | null = null;
+let parsedManifest: AbiManifest | null = null;
+
+// Event lookups by name, built once per manifest object
+const eventIndexes = /* @__PURE__ */ new WeakMap<AbiManifest, Map<string, Event>>();
+
 /**
  * Gets the ABI manifest from the global scope
  * Supports both parsed object (from Rollup) and string (from C injection)
@@ -22,11 +29,15 @@ export function getAbiManifest(): AbiManifest | null {
 
   // If it's a string (from C injection), parse it
   if (typeof manifest === 'string') {
-    try {
-      return JSON.parse(manifest) as AbiManifest;
-    } catch {
-      return null;
+    if (manifest !== parsedSource) {
+      try {
+        parsedManifest = JSON.parse(manifest) as AbiManifest;
+      } catch {
+        parsedManifest = null;
+      }
+      parsedSource = manifest;
     }
+    return parsedManifest;
   }
 
   // If it's already an object (from Rollup), return it
@@ -56,7 +67,17 @@ export function getMethod(abi: AbiManifest, methodName: string): Method | null {
  * Gets an event definition by name
  */
 export function getEvent(abi: AbiManifest, eventName: string): Event | null {
-  return abi.events.find(e => e.name === eventName) || null;
+  let index = eventIndexes.get(abi);
+  if (!index) {
+    index = new Map();
+    for (const event of abi.events ?? []) {
+      if (!index.has(event.name)) {
+        index.set(event.name, event);
+      }
+    }
+    eventIndexes.set(abi, index);
+  }
+  return index.get(eventName) || null;
 }
 
 /**
@@ -11,6 +11,15 @@ export interface AbiManifest {
   methods: Method[];
   events: Event[];
   state_root?: string;
+  metadata?: AbiMetadata;
+}
+
+/**
+ * Optional build/runtime settings carried alongside the ABI
+ */
+export interface AbiMetadata {
+  /** Initial SDK log level: 'debug' | 'info' | 'warn' | 'error' | 'silent' */
+  log_level?: string;
 }
 
 export interface TypeDef {
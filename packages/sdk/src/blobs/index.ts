@@ -0,0 +1,8 @@
+/**
+ * Blob streams
+ *
+ * @packageDocumentation
+ */
+
+export { BlobReader, BlobWriter, type BlobStreamOptions } from './stream';
+export { ChunkPool, DEFAULT_CHUNK_SIZE } from './pool';
@@ -0,0 +1,62 @@
+/**
+ * Reusable chunk buffers for blob streams
+ *
+ * Reading or writing a large blob moves it through fixed-size chunks. Streams take a chunk from
+ * a pool when they open and hand it back when they close, so repeated streams (or a reader piped
+ * into a writer) reuse the same few buffers instead of allocating one per stream.
+ */
+
+export const DEFAULT_CHUNK_SIZE = 64 * 1024;
+
+// Idle buffers kept per pool; extras are left to the GC
+const DEFAULT_MAX_IDLE = 4;
+
+export class ChunkPool {
+  private static readonly shared = new Map<number, ChunkPool>();
+
+  private readonly idle: Uint8Array[] = [];
+
+  constructor(
+    readonly chunkSize: number = DEFAULT_CHUNK_SIZE,
+    private readonly maxIdle: number = DEFAULT_MAX_IDLE
+  ) {
+    if (!Number.isInteger(chunkSize) || chunkSize <= 0) {
+      throw new RangeError('ChunkPool: chunkSize must be a positive integer');
+    }
+  }
+
+  /**
+   * Process-wide pool for the given chunk size.
+   */
+  static forSize(chunkSize: number = DEFAULT_CHUNK_SIZE): ChunkPool {
+    let pool = ChunkPool.shared.get(chunkSize);
+    if (!pool) {
+      pool = new ChunkPool(chunkSize);
+      ChunkPool.shared.set(chunkSize, pool);
+    }
+    return pool;
+  }
+
+  /**
+   * Takes an idle chunk, or allocates one. Contents are unspecified.
+   */
+  acquire(): Uint8Array {
+    return this.idle.pop() ?? new Uint8Array(this.chunkSize);
+  }
+
+  /**
+   * Returns a chunk obtained from {@link acquire}. The caller must not use it afterwards.
+   */
+  release(chunk: Uint8Array): void {
+    if (chunk.byteLength === this.chunkSize && this.idle.length < this.maxIdle) {
+      this.idle.push(chunk);
+    }
+  }
+
+  /**
+   * Number of chunks waiting to be reused.
+   */
+  get idleCount(): number {
+    return this.idle.length;
+  }
+}
@@ -0,0 +1,410 @@
+/**
+ * Streaming blob I/O
+ *
+ * `BlobReader` and `BlobWriter` wrap the `blob_*` host functions. They move data in fixed-size
+ * chunks taken from a {@link ChunkPool}, can hash the bytes as they pass, and use plain number
+ * fds and byte counts through the `blob_stream_*` wrappers in `builder.c` (falling back to the
+ * BigInt `blob_*` ones on older builds).
+ */
+
+import type { HostEnv } from '../env/bindings';
+import { createSha256, type Sha256Hasher } from '../utils/sha256';
+import { ChunkPool, DEFAULT_CHUNK_SIZE } from './pool';
+
+declare const env: HostEnv;
+
+const BLOB_ID_SIZE = 32;
+
+export interface BlobStreamOptions {
+  /** Bytes moved per host call (default 64 KiB) */
+  chunkSize?: number;
+  /** Pool to take the chunk buffer from (default: the shared pool for `chunkSize`) */
+  pool?: ChunkPool;
+  /** Hash the bytes as they stream; read the result with `digest()` */
+  hash?: boolean;
+}
+
+function hostOpen(blobId: Uint8Array): number {
+  if (typeof env.blob_stream_open === 'function') {
+    return env.blob_stream_open(blobId);
+  }
+  return Number(env.blob_open(blobId));
+}
+
+function hostCreate(): number {
+  if (typeof env.blob_stream_create === 'function') {
+    return env.blob_stream_create();
+  }
+  return Number(env.blob_create());
+}
+
+function hostRead(fd: number, buffer: Uint8Array): number {
+  if (typeof env.blob_stream_read === 'function') {
+    return env.blob_stream_read(fd, buffer);
+  }
+  return Number(env.blob_read(BigInt(fd), buffer));
+}
+
+function hostWrite(fd: number, data: Uint8Array): number {
+  if (typeof env.blob_stream_write === 'function') {
+    return env.blob_stream_write(fd, data);
+  }
+  return Number(env.blob_write(BigInt(fd), data));
+}
+
+function hostClose(fd: number, blobId: Uint8Array): boolean {
+  return Boolean(env.blob_close(BigInt(fd), blobId));
+}
+
+function resolvePool(options: BlobStreamOptions): ChunkPool {
+  if (options.pool) {
+    if (options.chunkSize !== undefined && options.chunkSize !== options.pool.chunkSize) {
+      throw new RangeError('chunkSize does not match the chunk size of the given pool');
+    }
+    return options.pool;
+  }
+  return ChunkPool.forSize(options.chunkSize ?? DEFAULT_CHUNK_SIZE);
+}
+
+/**
+ * Reads a blob chunk by chunk.
+ *
+ * Chunks returned by {@link read} or produced by iteration are views into the reader's pooled
+ * buffer: they stay valid until the next read, so copy them (`chunk.slice()`) to keep them.
+ * Iterating (`for...of` or `for await...of`) closes the reader when the loop ends.
+ *
+ * @example
+ * ```typescript
+ * const reader = BlobReader.open(blobId, { hash: true });
+ * for await (const chunk of reader) {
+ *   processChunk(chunk);
+ * }
+ * const checksum = reader.digest();
+ * ```
+ */
+export class BlobReader implements Iterable<Uint8Array>, AsyncIterable<Uint8Array> {
+  private readonly pool: ChunkPool;
+  private readonly hasher: Sha256Hasher | null;
+  private chunk: Uint8Array | null = null;
+  private hashDigest: Uint8Array | null = null;
+  private ended = false;
+  private closed = false;
+  private total = 0;
+
+  private constructor(
+    readonly fd: number,
+    options: BlobStreamOptions
+  ) {
+    this.pool = resolvePool(options);
+    this.hasher = options.hash ? createSha256() : null;
+  }
+
+  /**
+   * Opens a blob for reading.
+   *
+   * @param blobId - 32-byte blob ID
+   * @throws Error if the blob does not exist
+   */
+  static open(blobId: Uint8Array, options: BlobStreamOptions = {}): BlobReader {
+    if (!(blobId instanceof Uint8Array) || blobId.length !== BLOB_ID_SIZE) {
+      throw new RangeError('BlobReader.open: blobId must be exactly 32 bytes');
+    }
+    const fd = hostOpen(blobId);
+    if (fd === 0) {
+      throw new Error('BlobReader.open: blob not found');
+    }
+    return new BlobReader(fd, options);
+  }
+
+  /** Bytes read so far */
+  get bytesRead(): number {
+    return this.total;
+  }
+
+  /**
+   * Reads the next chunk, or returns null at the end of the blob.
+   * The view is only valid until the next read or {@link close}.
+   */
+  read(): Uint8Array | null {
+    this.assertOpen();
+    if (this.ended) {
+      return null;
+    }
+    this.chunk ??= this.pool.acquire();
+    const count = this.readHost(this.chunk);
+    return count === 0 ? null : this.chunk.subarray(0, count);
+  }
+
+  /**
+   * Reads directly into `target`, bypassing the pooled chunk.
+   *
+   * @returns Number of bytes read; 0 at the end of the blob
+   */
+  readInto(target: Uint8Array): number {
+    this.assertOpen();
+    return this.ended ? 0 : this.readHost(target);
+  }
+
+  /**
+   * Reads the rest of the blob into one buffer and closes the reader.
+   */
+  readAll(): Uint8Array {
+    let out = new Uint8Array(this.pool.chunkSize);
+    let length = 0;
+    try {
+      for (;;) {
+        if (length === out.length) {
+          const grown = new Uint8Array(out.length * 2);
+          grown.set(out);
+          out = grown;
+        }
+        const count = this.readInto(out.subarray(length));
+        if (count === 0) {
+          break;
+        }
+        length += count;
+      }
+    } finally {
+      this.close();
+    }
+    return length === out.length ? out : out.slice(0, length);
+  }
+
+  /**
+   * SHA256 of the whole blob. Requires `{ hash: true }` and a reader that reached the end.
+   */
+  digest(): Uint8Array {
+    if (!this.hasher) {
+      throw new Error('BlobReader: digest() requires the { hash: true } option');
+    }
+    if (!this.ended) {
+      throw new Error('BlobReader: digest() is only available after the last chunk');
+    }
+    this.hashDigest ??= this.hasher.digest();
+    return this.hashDigest.slice();
+  }
+
+  /**
+   * Releases the file descriptor and returns the chunk buffer to the pool. Idempotent.
+   */
+  close(): void {
+    if (this.closed) {
+      return;
+    }
+    this.closed = true;
+    if (this.chunk) {
+      this.pool.release(this.chunk);
+      this.chunk = null;
+    }
+    hostClose(this.fd, new Uint8Array(BLOB_ID_SIZE));
+  }
+
+  *[Symbol.iterator](): Iterator<Uint8Array> {
+    try {
+      for (let chunk = this.read(); chunk !== null; chunk = this.read()) {
+        yield chunk;
+      }
+    } finally {
+      this.close();
+    }
+  }
+
+  async *[Symbol.asyncIterator](): AsyncIterator<Uint8Array> {
+    yield* this[Symbol.iterator]();
+  }
+
+  private readHost(target: Uint8Array): number {
+    const count = hostRead(this.fd, target);
+    if (count === 0) {
+      this.ended = true;
+      return 0;
+    }
+    this.total += count;
+    this.hasher?.update(target.subarray(0, count));
+    return count;
+  }
+
+  private assertOpen(): void {
+    if (this.closed) {
+      throw new Error('BlobReader: stream is closed');
+    }
+  }
+}
+
+/**
+ * Writes a blob chunk by chunk.
+ *
+ * Small writes are gathered in a pooled chunk and sent to the host once it is full; writes of a
+ * chunk or more go straight to the host without a copy. {@link close} flushes the tail and
+ * returns the new blob's ID; if the flush throws, the writer stays open and `close()` can be
+ * retried. {@link abort} gives up on the blob and releases its fd.
+ *
+ * @example
+ * ```typescript
+ * const writer = BlobWriter.create();
+ * for (const part of parts) {
+ *   writer.write(part);
+ * }
+ * const blobId = writer.close();
+ * ```
+ */
+export class BlobWriter {
+  private readonly pool: ChunkPool;
+  private readonly hasher: Sha256Hasher | null;
+  private chunk: Uint8Array | null = null;
+  private filled = 0;
+  private hashDigest: Uint8Array | null = null;
+  private closed = false;
+  private total = 0;
+
+  private constructor(
+    readonly fd: number,
+    options: BlobStreamOptions
+  ) {
+    this.pool = resolvePool(options);
+    this.hasher = options.hash ? createSha256() : null;
+  }
+
+  /**
+   * Creates a new blob for writing.
+   */
+  static create(options: BlobStreamOptions = {}): BlobWriter {
+    return new BlobWriter(hostCreate(), options);
+  }
+
+  /** Bytes accepted so far (including bytes still buffered) */
+  get bytesWritten(): number {
+    return this.total;
+  }
+
+  /**
+   * Appends `data` to the blob. `data` may be reused by the caller once this returns.
+   */
+  write(data: Uint8Array): void {
+    this.assertOpen();
+    if (data.length === 0) {
+      return;
+    }
+    this.total += data.length;
+    this.hasher?.update(data);
+
+    const chunkSize = this.pool.chunkSize;
+    let offset = 0;
+    if (this.filled > 0) {
+      offset = Math.min(data.length, chunkSize - this.filled);
+      this.chunk!.set(data.subarray(0, offset), this.filled);
+      this.filled += offset;
+      if (this.filled === chunkSize) {
+        this.flushChunk();
+      }
+    }
+
+    // Whole chunks skip the buffer: one host call for all of them
+    const direct = Math.floor((data.length - offset) / chunkSize) * chunkSize;
+    if (direct > 0) {
+      this.writeHost(data.subarray(offset, offset + direct));
+      offset += direct;
+    }
+
+    if (offset < data.length) {
+      this.chunk ??= this.pool.acquire();
+      this.chunk.set(data.subarray(offset), 0);
+      this.filled = data.length - offset;
+    }
+  }
+
+  /**
+   * Writes every chunk from `source` (e.g. a {@link BlobReader}) and returns the bytes copied.
+   */
+  writeFrom(source: Iterable<Uint8Array>): number {
+    const start = this.total;
+    for (const chunk of source) {
+      this.write(chunk);
+    }
+    return this.total - start;
+  }
+
+  /**
+   * SHA256 of everything written. Requires `{ hash: true }` and a closed writer.
+   */
+  digest(): Uint8Array {
+    if (!this.hasher) {
+      throw new Error('BlobWriter: digest() requires the { hash: true } option');
+    }
+    if (!this.closed) {
+      throw new Error('BlobWriter: digest() is only available after close()');
+    }
+    this.hashDigest ??= this.hasher.digest();
+    return this.hashDigest.slice();
+  }
+
+  /**
+   * Flushes buffered bytes, closes the blob and returns its 32-byte ID.
+   */
+  close(): Uint8Array {
+    this.assertOpen();
+    if (this.filled > 0) {
+      this.flushChunk();
+    }
+    this.releaseChunk();
+    this.closed = true;
+
+    const blobId = new Uint8Array(BLOB_ID_SIZE);
+    if (!hostClose(this.fd, blobId)) {
+      throw new Error('Failed to close blob');
+    }
+    return blobId;
+  }
+
+  /**
+   * Drops buffered bytes and releases the fd without flushing. No-op once closed.
+   */
+  abort(): void {
+    if (this.closed) {
+      return;
+    }
+    this.releaseChunk();
+    this.filled = 0;
+    this.closed = true;
+    // The host has no abort call: closing the fd is how it is released, the partial blob is left
+    // unreferenced
+    hostClose(this.fd, new Uint8Array(BLOB_ID_SIZE));
+  }
+
+  // Drops bytes only once the host took them, so a failed flush can be retried
+  private flushChunk(): void {
+    const chunk = this.chunk!;
+    while (this.filled > 0) {
+      const written = hostWrite(this.fd, chunk.subarray(0, this.filled));
+      if (written <= 0) {
+        throw new Error('BlobWriter: blob_write made no progress');
+      }
+      chunk.copyWithin(0, written, this.filled);
+      this.filled -= written;
+    }
+  }
+
+  private releaseChunk(): void {
+    if (this.chunk) {
+      this.pool.release(this.chunk);
+      this.chunk = null;
+    }
+  }
+
+  private writeHost(data: Uint8Array): void {
+    let offset = 0;
+    while (offset < data.length) {
+      const written = hostWrite(this.fd, offset === 0 ? data : data.subarray(offset));
+      if (written <= 0) {
+        throw new Error('BlobWriter: blob_write made no progress');
+      }
+      offset += written;
+    }
+  }
+
+  private assertOpen(): void {
+    if (this.closed) {
+      throw new Error('BlobWriter: stream is closed');
+    }
+  }
+}
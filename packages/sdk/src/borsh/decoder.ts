@@ -4,63 +4,86 @@
  * Mirrors the writer to parse primitive types from byte slices.
  */
 
+const textDecoder = /* @__PURE__ */ new TextDecoder();
+
+export interface BorshReaderOptions {
+  /**
+   * Return byte fields as views into the source buffer instead of copies. Only safe while the
+   * source is neither reused nor detached; call `BorshReader.copy()` on views that escape.
+   */
+  borrow?: boolean;
+}
+
 export class BorshReader {
   private readonly view: DataView;
+  private readonly borrow: boolean;
   private offset = 0;
 
-  constructor(private readonly bytes: Uint8Array) {
+  constructor(private readonly bytes: Uint8Array, options: BorshReaderOptions = {}) {
     this.view = new DataView(bytes.buffer, bytes.byteOffset, bytes.byteLength);
+    this.borrow = options.borrow === true;
+  }
+
+  /**
+   * Detach a borrowed view from its source buffer.
+   */
+  static copy(view: Uint8Array): Uint8Array {
+    return view.slice();
   }
 
   readU8(): number {
-    this.ensureAvailable(1);
-    const value = this.bytes[this.offset];
-    this.offset += 1;
-    return value;
+    this._calimeroEnsureAvailable(1);
+    return this.bytes[this.offset++];
   }
 
   readU16(): number {
-    this.ensureAvailable(2);
+    this._calimeroEnsureAvailable(2);
     const value = this.view.getUint16(this.offset, true);
     this.offset += 2;
     return value;
   }
 
   readU32(): number {
-    this.ensureAvailable(4);
+    this._calimeroEnsureAvailable(4);
     const value = this.view.getUint32(this.offset, true);
     this.offset += 4;
     return value;
   }
 
   readU64(): bigint {
-    this.ensureAvailable(8);
+    this._calimeroEnsureAvailable(8);
     const value = this.view.getBigUint64(this.offset, true);
     this.offset += 8;
     return value;
   }
 
   readF32(): number {
-    this.ensureAvailable(4);
+    this._calimeroEnsureAvailable(4);
     const value = this.view.getFloat32(this.offset, true);
     this.offset += 4;
     return value;
   }
 
   readF64(): number {
-    this.ensureAvailable(8);
+    this._calimeroEnsureAvailable(8);
     const value = this.view.getFloat64(this.offset, true);
     this.offset += 8;
     return value;
   }
 
-  readFixedArray(length: number): Uint8Array {
-    this.ensureAvailable(length);
+  /**
+   * Read `length` bytes as a view into the source buffer, regardless of the borrow option.
+   */
+  readFixedArrayView(length: number): Uint8Array {
+    this._calimeroEnsureAvailable(length);
     const start = this.offset;
-    const end = start + length;
-    const slice = this.bytes.subarray(start, end);
-    this.offset = end;
-    return new Uint8Array(slice);
+    this.offset = start + length;
+    return this.bytes.subarray(start, this.offset);
+  }
+
+  readFixedArray(length: number): Uint8Array {
+    const slice = this.readFixedArrayView(length);
+    return this.borrow ? slice : new Uint8Array(slice);
   }
 
   readBytes(): Uint8Array {
@@ -69,8 +92,83 @@ export class BorshReader {
   }
 
   readString(): string {
-    const bytes = this.readBytes();
-    return new TextDecoder().decode(bytes);
+    const length = this.readU32();
+    return textDecoder.decode(this.readFixedArrayView(length));
+  }
+
+  /**
+   * Read a `Vec<u32>` (u32 count + little-endian items) into a typed array in one pass.
+   */
+  readU32Array(): Uint32Array {
+    const count = this.readU32();
+    const bytes = this.readFixedArrayView(count * 4);
+    const out = new Uint32Array(count);
+    for (let i = 0, at = 0; i < count; i += 1, at += 4) {
+      out[i] = bytes[at] | (bytes[at + 1] << 8) | (bytes[at + 2] << 16) | (bytes[at + 3] << 24);
+    }
+    return out;
+  }
+
+  /**
+   * Read a `Vec<u64>` (u32 count + little-endian items) into a typed array in one pass.
+   */
+  readU64Array(): BigUint64Array {
+    const count = this.readU32();
+    const start = this.offset;
+    this._calimeroEnsureAvailable(count * 8);
+    const out = new BigUint64Array(count);
+    for (let i = 0; i < count; i += 1) {
+      out[i] = this.view.getBigUint64(start + i * 8, true);
+    }
+    this.offset = start + count * 8;
+    return out;
+  }
+
+  /**
+   * Read a `Vec<f64>` (u32 count + little-endian items) into a typed array in one pass.
+   */
+  readF64Array(): Float64Array {
+    const count = this.readU32();
+    const start = this.offset;
+    this._calimeroEnsureAvailable(count * 8);
+    const out = new Float64Array(count);
+    for (let i = 0; i < count; i += 1) {
+      out[i] = this.view.getFloat64(start + i * 8, true);
+    }
+    this.offset = start + count * 8;
+    return out;
+  }
+
+  /**
+   * Advance past `length` bytes without decoding them.
+   */
+  skip(length: number): void {
+    this._calimeroEnsureAvailable(length);
+    this.offset += length;
+  }
+
+  /**
+   * Advance past a length-prefixed field (`Vec<u8>`, `String`) without decoding it.
+   */
+  skipBytes(): void {
+    this.skip(this.readU32());
+  }
+
+  /**
+   * Current read position, usable with `seek()`.
+   */
+  position(): number {
+    return this.offset;
+  }
+
+  /**
+   * Move the read position to an absolute offset within the source.
+   */
+  seek(offset: number): void {
+    if (offset < 0 || offset > this.bytes.length) {
+      throw new RangeError('BorshReader: seek out of bounds');
+    }
+    this.offset = offset;
   }
 
   /**
@@ -80,7 +178,7 @@ export class BorshReader {
     return this.bytes.length - this.offset;
   }
 
-  private ensureAvailable(length: number): void {
+  private _calimeroEnsureAvailable(length: number): void {
     if (this.offset + length > this.bytes.length) {
       throw new RangeError('BorshReader: unexpected end of buffer');
     }
@@ -5,73 +5,122 @@
  * https://borsh.io/
  */
 
+const INITIAL_CAPACITY = 64;
+
+const textEncoder = /* @__PURE__ */ new TextEncoder();
+// Native encoders write UTF-8 straight into our buffer; the QuickJS polyfill has no encodeInto
+const canEncodeInto = typeof (textEncoder as any).encodeInto === 'function';
+
 export class BorshWriter {
-  private buffer: number[] = [];
+  private buffer: Uint8Array;
+  private view: DataView;
+  private length = 0;
+
+  constructor(initialCapacity: number = INITIAL_CAPACITY) {
+    this.buffer = new Uint8Array(Math.max(initialCapacity, 8));
+    this.view = new DataView(this.buffer.buffer);
+  }
+
+  /**
+   * Ensure room for `extra` more bytes, growing geometrically
+   */
+  private reserve(extra: number): void {
+    const required = this.length + extra;
+    if (required <= this.buffer.length) {
+      return;
+    }
+    let capacity = this.buffer.length * 2;
+    while (capacity < required) {
+      capacity *= 2;
+    }
+    const next = new Uint8Array(capacity);
+    next.set(this.buffer.subarray(0, this.length));
+    this.buffer = next;
+    this.view = new DataView(next.buffer);
+  }
 
   /**
    * Write a single byte (u8)
    */
   writeU8(value: number): void {
-    this.buffer.push(value & 0xff);
+    this.reserve(1);
+    this.buffer[this.length++] = value & 0xff;
   }
 
   /**
    * Write a 16-bit unsigned integer (u16) in little-endian
    */
   writeU16(value: number): void {
-    this.buffer.push(value & 0xff);
-    this.buffer.push((value >> 8) & 0xff);
+    this.reserve(2);
+    this.view.setUint16(this.length, value & 0xffff, true);
+    this.length += 2;
   }
 
   /**
    * Write a 32-bit unsigned integer (u32) in little-endian
    */
   writeU32(value: number): void {
-    this.buffer.push(value & 0xff);
-    this.buffer.push((value >> 8) & 0xff);
-    this.buffer.push((value >> 16) & 0xff);
-    this.buffer.push((value >> 24) & 0xff);
+    this.reserve(4);
+    this.view.setUint32(this.length, value >>> 0, true);
+    this.length += 4;
   }
 
   /**
-   * Write a 64-bit unsigned integer (u64) in little-endian
+   * Overwrite a u32 written earlier at `offset`, e.g. a length prefix known only afterwards
    */
-  writeU64(value: bigint): void {
-    const num = BigInt(value);
-    for (let i = 0; i < 8; i++) {
-      this.buffer.push(Number((num >> BigInt(i * 8)) & BigInt(0xff)));
+  patchU32(offset: number, value: number): void {
+    if (offset < 0 || offset + 4 > this.length) {
+      throw new RangeError(`patchU32 offset ${offset} outside written range`);
     }
+    this.view.setUint32(offset, value >>> 0, true);
+  }
+
+  /**
+   * Write a 64-bit unsigned integer (u64) in little-endian.
+   * Values outside the u64 range wrap (two's complement for negative i64 values).
+   */
+  writeU64(value: bigint): void {
+    this.reserve(8);
+    this.view.setBigUint64(this.length, BigInt.asUintN(64, BigInt(value)), true);
+    this.length += 8;
+  }
+
+  /**
+   * Write a 128-bit unsigned integer (u128) in little-endian: low 64 bits, then high 64 bits
+   */
+  writeU128(value: bigint): void {
+    const num = BigInt.asUintN(128, BigInt(value));
+    this.reserve(16);
+    this.view.setBigUint64(this.length, BigInt.asUintN(64, num), true);
+    this.view.setBigUint64(this.length + 8, num >> 64n, true);
+    this.length += 16;
   }
 
   /**
    * Write a 32-bit floating point number (f32) in little-endian
    */
   writeF32(value: number): void {
-    const view = new DataView(new ArrayBuffer(4));
-    view.setFloat32(0, value, true);
-    for (let i = 0; i < 4; i++) {
-      this.buffer.push(view.getUint8(i));
-    }
+    this.reserve(4);
+    this.view.setFloat32(this.length, value, true);
+    this.length += 4;
   }
 
   /**
    * Write a 64-bit floating point number (f64) in little-endian
    */
   writeF64(value: number): void {
-    const view = new DataView(new ArrayBuffer(8));
-    view.setFloat64(0, value, true);
-    for (let i = 0; i < 8; i++) {
-      this.buffer.push(view.getUint8(i));
-    }
+    this.reserve(8);
+    this.view.setFloat64(this.length, value, true);
+    this.length += 8;
   }
 
   /**
    * Write a fixed-size byte array
    */
   writeFixedArray(bytes: Uint8Array): void {
-    for (let i = 0; i < bytes.length; i++) {
-      this.buffer.push(bytes[i]);
-    }
+    this.reserve(bytes.length);
+    this.buffer.set(bytes, this.length);
+    this.length += bytes.length;
   }
 
   /**
@@ -94,17 +143,19 @@ export class BorshWriter {
 
   /**
    * Write a string (u32 length + UTF-8 bytes)
-   * Uses TextEncoder to properly handle all Unicode characters including emojis
    */
   writeString(str: string): void {
-    // Use TextEncoder to properly encode UTF-8, handling all Unicode characters
-    // including emojis and surrogate pairs correctly
-    const encoder = new TextEncoder();
-    const bytes = encoder.encode(str);
-    this.writeU32(bytes.length);
-    for (let i = 0; i < bytes.length; i++) {
-      this.buffer.push(bytes[i]);
+    if (!canEncodeInto) {
+      this.writeBytes(textEncoder.encode(str));
+      return;
     }
+
+    // Reserve the worst case (3 bytes per UTF-16 unit) and encode in place after the prefix
+    this.reserve(4 + str.length * 3);
+    const start = this.length + 4;
+    const { written } = (textEncoder as any).encodeInto(str, this.buffer.subarray(start));
+    this.view.setUint32(this.length, written, true);
+    this.length = start + written;
   }
 
   /**
@@ -120,16 +171,34 @@ export class BorshWriter {
   }
 
   /**
-   * Get the serialized bytes
+   * Get the serialized bytes as a view over the internal buffer (no copy).
+   * The writer must not be used after calling this.
+   */
+  finish(): Uint8Array {
+    return this.buffer.subarray(0, this.length);
+  }
+
+  /**
+   * Get a copy of the serialized bytes
    */
   toBytes(): Uint8Array {
-    return new Uint8Array(this.buffer);
+    return this.buffer.slice(0, this.length);
+  }
+
+  /**
+   * Drop everything written after `length`, keeping the capacity
+   */
+  truncate(length: number): void {
+    if (length < 0 || length > this.length) {
+      throw new RangeError(`Cannot truncate ${this.length} bytes to ${length}`);
+    }
+    this.length = length;
   }
 
   /**
    * Get current buffer size
    */
   size(): number {
-    return this.buffer.length;
+    return this.length;
   }
 }
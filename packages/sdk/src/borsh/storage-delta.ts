@@ -26,7 +26,7 @@ function serializeUpdate(
   // Action::Update variant = 3
   writer.writeU8(3);
   writer.writeFixedArray(action.id);
-  writer.writeVec(Array.from(action.data), byte => writer.writeU8(byte));
+  writer.writeBytes(action.data);
   // ancestors: Vec<ChildInfo> (empty)
   writer.writeU32(0);
   // metadata::Metadata { created_at, updated_at }
@@ -64,7 +64,7 @@ export function serializeStorageDelta(actions: BorshAction[]): Uint8Array {
   // StorageDelta::Actions = 0
   writer.writeU8(0);
   writer.writeVec(actions, action => serializeAction(writer, action));
-  return writer.toBytes();
+  return writer.finish();
 }
 
 /**
@@ -0,0 +1,610 @@
+/**
+ * AppendLog - Append-only log stored in fixed-size segments, for message histories and feeds.
+ *
+ * Each executor appends to its own run of segments, `segmentSize` entries per map entry, so
+ * appends made concurrently on different nodes never write the same key and all survive a merge
+ * (the same partitioning `BloomSet` uses). Every entry gets a sequence number one above the
+ * highest the appending node has seen; entries are ordered by sequence number, then executor id.
+ * Concurrent appends can share a sequence number and are then ordered by executor id. However
+ * long the history is, appending costs one head read per executor that ever appended plus the
+ * tail segment, and reading a page costs those head reads plus the segments of the writers whose
+ * entries reach the page.
+ *
+ * Layout of the backing map:
+ *   [0x00]                                        id of the writers map (executor id -> 0x01)
+ *   [0x01] ++ executor id                         head: entries appended (u64 LE) ++ next
+ *                                                 sequence number (u64 LE)
+ *   [0x02] ++ executor id                         first retained segment (u32 LE), a hint
+ *   [0x03] ++ executor id ++ segment (u32 BE)     (sequence number (u64 LE) ++ length (u32 LE)
+ *                                                 ++ encoded entry)*, optionally compressed
+ * A head is only written by its executor. `compact` also removes other executors' full segments,
+ * which their owners never write again.
+ */
+
+import { serialize, deserialize } from '../utils/serialize';
+import { codecFor, type Codec, type CodecSpec } from '../utils/abi-codec';
+import { bytesToHex, normalizeCollectionId } from '../utils/hex';
+import {
+  compressValue,
+  decompressValue,
+  validateCompressionCodec,
+  type CompressionCodec,
+} from '../utils/compression';
+import {
+  mapNew,
+  mapGet,
+  mapInsert,
+  mapRemove,
+  mapContains,
+  mapEntries,
+} from '../runtime/storage-wasm';
+import { invocationGeneration } from '../runtime/invocation-context';
+import {
+  registerCollectionType,
+  CollectionSnapshot,
+  type CollectionCodecSpecs,
+  hasRegisteredCollection,
+  brandCollection,
+} from '../runtime/collections';
+import { nestedTracker } from '../runtime/nested-tracking';
+import * as env from '../env/api';
+
+const HEAD_KEY = /* @__PURE__ */ Uint8Array.of(0x00);
+const WRITER_HEAD_PREFIX = 0x01;
+const FIRST_SEGMENT_PREFIX = 0x02;
+const SEGMENT_PREFIX = 0x03;
+const WRITER_MARK = /* @__PURE__ */ Uint8Array.of(0x01);
+const EXECUTOR_ID_LENGTH = 32;
+const ENTRY_HEADER_SIZE = 12;
+
+const DEFAULT_SEGMENT_SIZE = 64;
+const MAX_SEGMENT_SIZE = 4096;
+const EMPTY = /* @__PURE__ */ new Uint8Array(0);
+
+export interface AppendLogOptions {
+  id?: Uint8Array | string;
+  /** Entries per stored segment (default 64). Must stay the same for the lifetime of the log. */
+  segmentSize?: number;
+  /**
+   * Encodes entries with plain ABI Borsh instead of the SDK value encoding.
+   * Must stay the same for the lifetime of the log.
+   */
+  valueCodec?: CodecSpec;
+  /** Compresses whole segments (`'lz4'`). Must stay the same for the lifetime of the log. */
+  compression?: CompressionCodec;
+}
+
+export interface AppendLogEntry<T> {
+  /** Sequence number; pass it to `before` to page further back */
+  index: number;
+  value: T;
+}
+
+interface Writer {
+  executor: Uint8Array;
+  hex: string;
+  /** Entries this executor appended, compacted ones included */
+  count: number;
+  nextSeq: number;
+}
+
+interface Segment {
+  bytes: Uint8Array;
+  /** Sequence number and start offset of each entry */
+  entries: { seq: number; offset: number }[];
+}
+
+// Position of the next entry to return from one writer, reading backwards
+interface Cursor {
+  writer: Writer;
+  segment: number;
+  data: Segment;
+  position: number;
+}
+
+function writerKey(prefix: number, executor: Uint8Array): Uint8Array {
+  const key = new Uint8Array(1 + EXECUTOR_ID_LENGTH);
+  key[0] = prefix;
+  key.set(executor, 1);
+  return key;
+}
+
+function segmentKey(executor: Uint8Array, segment: number): Uint8Array {
+  const key = new Uint8Array(5 + EXECUTOR_ID_LENGTH);
+  key[0] = SEGMENT_PREFIX;
+  key.set(executor, 1);
+  new DataView(key.buffer).setUint32(1 + EXECUTOR_ID_LENGTH, segment, false);
+  return key;
+}
+
+function parseSegment(bytes: Uint8Array): Segment {
+  const view = new DataView(bytes.buffer, bytes.byteOffset, bytes.byteLength);
+  const entries: Segment['entries'] = [];
+  let pos = 0;
+  while (pos < bytes.length) {
+    if (bytes.length - pos < ENTRY_HEADER_SIZE) {
+      throw new Error('AppendLog: corrupted segment');
+    }
+    entries.push({ seq: Number(view.getBigUint64(pos, true)), offset: pos });
+    pos += ENTRY_HEADER_SIZE + view.getUint32(pos + 8, true);
+  }
+  if (pos !== bytes.length || entries.length === 0) {
+    throw new Error('AppendLog: corrupted segment');
+  }
+  return { bytes, entries };
+}
+
+// Newest first: higher sequence number, then higher executor id
+function isNewer(a: Cursor, b: Cursor): boolean {
+  const seqA = a.data.entries[a.position].seq;
+  const seqB = b.data.entries[b.position].seq;
+  return seqA !== seqB ? seqA > seqB : a.writer.hex > b.writer.hex;
+}
+
+export class AppendLog<T> {
+  private readonly logId: Uint8Array;
+  private readonly writersId: Uint8Array;
+  private readonly segmentSize: number;
+  private readonly valueCodec?: Codec<T>;
+  private readonly compression?: CompressionCodec;
+  private writers: { generation: number; ids: Uint8Array[] } | null = null;
+
+  constructor(options: AppendLogOptions = {}) {
+    const segmentSize = options.segmentSize ?? DEFAULT_SEGMENT_SIZE;
+    if (!Number.isInteger(segmentSize) || segmentSize < 1 || segmentSize > MAX_SEGMENT_SIZE) {
+      throw new RangeError(`AppendLog: segmentSize must be an integer in 1..${MAX_SEGMENT_SIZE}`);
+    }
+
+    if (options.id) {
+      this.logId = normalizeCollectionId(options.id, 'AppendLog');
+      const head = mapGet(this.logId, HEAD_KEY);
+      if (!head) {
+        throw new Error('AppendLog: missing head');
+      }
+      this.writersId = head;
+    } else {
+      this.logId = mapNew();
+      this.writersId = mapNew();
+      mapInsert(this.logId, HEAD_KEY, this.writersId);
+    }
+    this.segmentSize = segmentSize;
+    if (options.valueCodec) {
+      this.valueCodec = codecFor(options.valueCodec as CodecSpec<T>);
+    }
+    if (options.compression) {
+      this.compression = validateCompressionCodec(options.compression);
+    }
+
+    const codecs: CollectionCodecSpecs = { segmentSize: this.segmentSize };
+    if (this.valueCodec) {
+      codecs.value = this.valueCodec.spec;
+    }
+    if (this.compression) {
+      codecs.compression = this.compression;
+    }
+    brandCollection(this, 'AppendLog', this.logId, codecs);
+
+    nestedTracker.registerCollection(this);
+  }
+
+  /**
+   * Returns the identifier of this log as a hex string.
+   */
+  id(): string {
+    return bytesToHex(this.logId);
+  }
+
+  /**
+   * Returns a copy of the identifier bytes.
+   */
+  idBytes(): Uint8Array {
+    return new Uint8Array(this.logId);
+  }
+
+  /**
+   * Number of retained entries (appended minus compacted), across all writers.
+   */
+  len(): number {
+    let total = 0;
+    for (const writer of this.readWriters()) {
+      if (writer.count > 0) {
+        total += writer.count - this.firstSegment(writer) * this.segmentSize;
+      }
+    }
+    return total;
+  }
+
+  /**
+   * Sequence number the next entry appended here will get, one above the highest seen.
+   */
+  nextIndex(): number {
+    let next = 0;
+    for (const writer of this.readWriters()) {
+      next = Math.max(next, writer.nextSeq);
+    }
+    return next;
+  }
+
+  /**
+   * Sequence number of the oldest retained entry (`nextIndex()` when there is none).
+   */
+  firstIndex(): number {
+    let first: number | null = null;
+    let next = 0;
+    for (const writer of this.readWriters()) {
+      next = Math.max(next, writer.nextSeq);
+      if (writer.count === 0) {
+        continue;
+      }
+      const data = this.readSegment(writer.executor, this.firstSegment(writer));
+      if (data && (first === null || data.entries[0].seq < first)) {
+        first = data.entries[0].seq;
+      }
+    }
+    return first ?? next;
+  }
+
+  /**
+   * Appends a value and returns its sequence number. Rewrites only this executor's last segment.
+   */
+  append(value: T): number {
+    return this.appendMany([value]);
+  }
+
+  /**
+   * Appends values in order, writing each touched segment once. Returns the first new sequence
+   * number; the others follow it.
+   */
+  appendMany(values: T[]): number {
+    const executor = env.executorId();
+    const hex = bytesToHex(executor);
+    let first = 0;
+    let count = 0;
+    for (const writer of this.readWriters()) {
+      first = Math.max(first, writer.nextSeq);
+      if (writer.hex === hex) {
+        count = writer.count;
+      }
+    }
+    if (values.length === 0) {
+      return first;
+    }
+
+    let offset = 0;
+    while (offset < values.length) {
+      const segment = Math.floor(count / this.segmentSize);
+      const used = count % this.segmentSize;
+      const take = Math.min(this.segmentSize - used, values.length - offset);
+
+      const tail = used > 0 ? this.readSegmentBytes(executor, segment) : EMPTY;
+      if (!tail) {
+        throw new Error(`AppendLog: segment ${segment} is missing`);
+      }
+      const parts: Uint8Array[] = [tail];
+      let size = tail.length;
+      for (let i = 0; i < take; i++) {
+        const value = values[offset + i];
+        const seq = first + offset + i;
+        if (hasRegisteredCollection(value)) {
+          nestedTracker.registerCollection(value, this, seq);
+        }
+        const encoded = this.valueCodec ? this.valueCodec.encode(value) : serialize(value);
+        const header = new Uint8Array(ENTRY_HEADER_SIZE);
+        const view = new DataView(header.buffer);
+        view.setBigUint64(0, BigInt(seq), true);
+        view.setUint32(8, encoded.length, true);
+        parts.push(header, encoded);
+        size += ENTRY_HEADER_SIZE + encoded.length;
+      }
+
+      const bytes = new Uint8Array(size);
+      let pos = 0;
+      for (const part of parts) {
+        bytes.set(part, pos);
+        pos += part.length;
+      }
+      this.writeSegment(executor, segment, bytes);
+      count += take;
+      offset += take;
+    }
+
+    this.writeHead(executor, count, first + values.length);
+    this.registerWriter(executor);
+    nestedTracker.notifyCollectionModified(this);
+    return first;
+  }
+
+  /**
+   * Gets the entry with sequence number `index`, or null when there is none or it has been
+   * compacted. Of concurrent appends sharing the number, returns the lowest executor id's.
+   */
+  get(index: number): T | null {
+    if (!Number.isInteger(index) || index < 0) {
+      return null;
+    }
+    let found: Cursor | null = null;
+    for (const writer of this.readWriters()) {
+      const cursor = this.seek(writer, index + 1);
+      if (cursor && cursor.data.entries[cursor.position].seq === index) {
+        if (!found || writer.hex < found.writer.hex) {
+          found = cursor;
+        }
+      }
+    }
+    return found ? this.decodeAt(found.data, found.position) : null;
+  }
+
+  /**
+   * The newest `count` entries, newest first.
+   */
+  latest(count: number): AppendLogEntry<T>[] {
+    return this.readBackwards(Infinity, count);
+  }
+
+  /**
+   * Up to `count` entries with a sequence number below `cursor`, newest first. Pass the index
+   * of the last entry of a page to get the page before it.
+   */
+  before(cursor: number, count: number): AppendLogEntry<T>[] {
+    return this.readBackwards(cursor, count);
+  }
+
+  /**
+   * Drops every whole segment whose entries all have a sequence number below `index`. Entries
+   * sharing a segment with a retained entry, or in a writer's unfilled last segment, are kept.
+   * Returns the number of entries dropped.
+   */
+  compact(index: number): number {
+    let dropped = 0;
+    for (const writer of this.readWriters()) {
+      const start = this.firstSegment(writer);
+      // Only full segments: the owner may still append to a partial one
+      const full = Math.floor(writer.count / this.segmentSize);
+      let segment = start;
+      for (; segment < full; segment++) {
+        const data = this.readSegment(writer.executor, segment);
+        if (!data) {
+          continue;
+        }
+        if (data.entries[data.entries.length - 1].seq >= index) {
+          break;
+        }
+        mapRemove(this.logId, segmentKey(writer.executor, segment));
+        dropped += data.entries.length;
+      }
+      if (segment > start) {
+        const raw = new Uint8Array(4);
+        new DataView(raw.buffer).setUint32(0, segment, true);
+        mapInsert(this.logId, writerKey(FIRST_SEGMENT_PREFIX, writer.executor), raw);
+      }
+    }
+    if (dropped > 0) {
+      nestedTracker.notifyCollectionModified(this);
+    }
+    return dropped;
+  }
+
+  toJSON(): Record<string, unknown> {
+    return {
+      __calimeroCollection: 'AppendLog',
+      id: this.id(),
+    };
+  }
+
+  // Merges the writers' entries below `end`, newest first. Every head is read, but a writer's
+  // segments only once the page gets down to the last sequence number its head records.
+  private readBackwards(end: number, count: number): AppendLogEntry<T>[] {
+    const limit = Math.max(0, Math.floor(count));
+    const entries: AppendLogEntry<T>[] = [];
+    if (limit === 0) {
+      return entries;
+    }
+
+    const writers = this.readWriters()
+      .filter(writer => writer.count > 0)
+      .sort((a, b) => b.nextSeq - a.nextSeq);
+    let sought = 0;
+    const cursors: Cursor[] = [];
+    let last = -1;
+    for (;;) {
+      let newest = -1;
+      for (let i = 0; i < cursors.length; i++) {
+        if (newest < 0 || isNewer(cursors[i], cursors[newest])) {
+          newest = i;
+        }
+      }
+      // A full page still takes entries sharing its last number, so `before` skips none
+      const floor = Math.max(
+        newest < 0 ? -1 : cursors[newest].data.entries[cursors[newest].position].seq,
+        entries.length >= limit ? last : -1
+      );
+      if (sought < writers.length && Math.min(writers[sought].nextSeq, end) - 1 >= floor) {
+        const cursor = this.seek(writers[sought++], end);
+        if (cursor) {
+          cursors.push(cursor);
+        }
+        continue;
+      }
+      if (newest < 0) {
+        break;
+      }
+
+      const cursor = cursors[newest];
+      const seq = cursor.data.entries[cursor.position].seq;
+      if (entries.length >= limit && seq !== last) {
+        break;
+      }
+      entries.push({ index: seq, value: this.decodeAt(cursor.data, cursor.position) });
+      last = seq;
+      // A writer's earlier entries have lower numbers: once the page is full it is done
+      if (entries.length >= limit || !this.stepBack(cursor)) {
+        cursors.splice(newest, 1);
+      }
+    }
+    return entries;
+  }
+
+  // Cursor at `writer`'s last entry with a sequence number below `end`, or null
+  private seek(writer: Writer, end: number): Cursor | null {
+    if (writer.count === 0 || end <= 0) {
+      return null;
+    }
+    let segment = this.lastSegment(writer);
+    let data = this.readSegment(writer.executor, segment);
+    if (!data) {
+      return null;
+    }
+    if (data.entries[0].seq >= end) {
+      // Binary search the older segments by their first sequence number
+      let low = this.firstSegment(writer);
+      let high = segment - 1;
+      let found: { segment: number; data: Segment } | null = null;
+      while (low <= high) {
+        const middle = (low + high) >>> 1;
+        const probe = this.readSegment(writer.executor, middle);
+        if (probe && probe.entries[0].seq >= end) {
+          high = middle - 1;
+        } else {
+          if (probe) {
+            found = { segment: middle, data: probe };
+          }
+          low = middle + 1;
+        }
+      }
+      if (!found) {
+        return null;
+      }
+      ({ segment, data } = found);
+    }
+
+    let position = data.entries.length - 1;
+    while (data.entries[position].seq >= end) {
+      position--;
+    }
+    return { writer, segment, data, position };
+  }
+
+  // Moves `cursor` to the writer's previous entry; false when there is none left
+  private stepBack(cursor: Cursor): boolean {
+    if (cursor.position > 0) {
+      cursor.position--;
+      return true;
+    }
+    const data =
+      cursor.segment > 0 ? this.readSegment(cursor.writer.executor, cursor.segment - 1) : null;
+    if (!data) {
+      return false;
+    }
+    cursor.segment--;
+    cursor.data = data;
+    cursor.position = data.entries.length - 1;
+    return true;
+  }
+
+  private lastSegment(writer: Writer): number {
+    return writer.count === 0 ? 0 : Math.floor((writer.count - 1) / this.segmentSize);
+  }
+
+  // The stored hint can trail a concurrent compaction, so skip segments that are already gone
+  private firstSegment(writer: Writer): number {
+    const raw = mapGet(this.logId, writerKey(FIRST_SEGMENT_PREFIX, writer.executor));
+    let segment = 0;
+    if (raw) {
+      if (raw.length !== 4) {
+        throw new Error('AppendLog: corrupted first segment');
+      }
+      segment = new DataView(raw.buffer, raw.byteOffset, 4).getUint32(0, true);
+    }
+    const last = this.lastSegment(writer);
+    while (segment < last && !mapContains(this.logId, segmentKey(writer.executor, segment))) {
+      segment++;
+    }
+    return segment;
+  }
+
+  private decodeAt(segment: Segment, position: number): T {
+    const offset = segment.entries[position].offset;
+    const view = new DataView(segment.bytes.buffer, segment.bytes.byteOffset + offset + 8, 4);
+    const start = offset + ENTRY_HEADER_SIZE;
+    const bytes = segment.bytes.subarray(start, start + view.getUint32(0, true));
+    return this.valueCodec ? this.valueCodec.decode(bytes) : deserialize<T>(bytes);
+  }
+
+  private readSegment(executor: Uint8Array, segment: number): Segment | null {
+    const bytes = this.readSegmentBytes(executor, segment);
+    return bytes ? parseSegment(bytes) : null;
+  }
+
+  private readSegmentBytes(executor: Uint8Array, segment: number): Uint8Array | null {
+    const stored = mapGet(this.logId, segmentKey(executor, segment));
+    if (!stored) {
+      return null;
+    }
+    return this.compression ? decompressValue(stored) : stored;
+  }
+
+  private writeSegment(executor: Uint8Array, segment: number, bytes: Uint8Array): void {
+    const stored = this.compression ? compressValue(bytes, this.compression) : bytes;
+    mapInsert(this.logId, segmentKey(executor, segment), stored);
+  }
+
+  private readWriters(): Writer[] {
+    const writers: Writer[] = [];
+    for (const executor of this.writerIds()) {
+      const raw = mapGet(this.logId, writerKey(WRITER_HEAD_PREFIX, executor));
+      if (!raw) {
+        continue;
+      }
+      if (raw.length !== 16) {
+        throw new Error('AppendLog: corrupted head');
+      }
+      const view = new DataView(raw.buffer, raw.byteOffset, 16);
+      writers.push({
+        executor,
+        hex: bytesToHex(executor),
+        count: Number(view.getBigUint64(0, true)),
+        nextSeq: Number(view.getBigUint64(8, true)),
+      });
+    }
+    return writers;
+  }
+
+  private writeHead(executor: Uint8Array, count: number, nextSeq: number): void {
+    const raw = new Uint8Array(16);
+    const view = new DataView(raw.buffer);
+    view.setBigUint64(0, BigInt(count), true);
+    view.setBigUint64(8, BigInt(nextSeq), true);
+    mapInsert(this.logId, writerKey(WRITER_HEAD_PREFIX, executor), raw);
+  }
+
+  // Writers only change through this invocation's own appends, so the list is read once
+  private writerIds(): Uint8Array[] {
+    const generation = invocationGeneration();
+    if (generation !== null && this.writers?.generation === generation) {
+      return this.writers.ids;
+    }
+    const ids = mapEntries(this.writersId).map(([executor]) => executor);
+    this.writers = generation === null ? null : { generation, ids };
+    return ids;
+  }
+
+  private registerWriter(executor: Uint8Array): void {
+    const ids = this.writerIds();
+    const hex = bytesToHex(executor);
+    if (!ids.some(id => bytesToHex(id) === hex)) {
+      mapInsert(this.writersId, executor, WRITER_MARK);
+      ids.push(executor);
+    }
+  }
+}
+
+registerCollectionType(
+  'AppendLog',
+  (snapshot: CollectionSnapshot) =>
+    new AppendLog({
+      id: snapshot.id,
+      segmentSize: snapshot.codecs?.segmentSize,
+      valueCodec: snapshot.codecs?.value,
+      compression: snapshot.codecs?.compression,
+    })
+);
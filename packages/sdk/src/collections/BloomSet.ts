@@ -0,0 +1,369 @@
+/**
+ * BloomSet - Probabilistic membership filter for deduplication (seen message ids, nonces).
+ *
+ * A fixed-size bit array sized from the expected capacity and false-positive rate, so it never
+ * grows: `mightContain` never misses an added value and wrongly reports a non-member with
+ * about the configured probability. The filter is blocked: all of a value's bits fall in one
+ * chunk, so a lookup costs one chunk read per writer and then a local bit test.
+ *
+ * Filters merge by bitwise OR. Each executor sets bits only in its own copy of a chunk, and a
+ * lookup ORs the copies, so concurrent additions on different nodes all survive a merge (the
+ * same way `Counter` keeps a total per executor). Bits are never cleared.
+ *
+ * Layout of the backing map:
+ *   [0x00]                                     id of the writers map (executor id -> 0x01)
+ *   [0x01] ++ chunk (u32 BE) ++ executor id    that executor's bits of the chunk
+ * Members are hashed with MurmurHash3 x86_128, natively through `builder.c` when available.
+ */
+
+import { serialize } from '../utils/serialize';
+import { codecFor, type Codec, type CodecSpec } from '../utils/abi-codec';
+import { bytesToHex, normalizeCollectionId } from '../utils/hex';
+import { murmur3 } from '../utils/murmur3';
+import { mapNew, mapGet, mapInsert, mapEntries } from '../runtime/storage-wasm';
+import { invocationGeneration } from '../runtime/invocation-context';
+import {
+  registerCollectionType,
+  CollectionSnapshot,
+  type CollectionCodecSpecs,
+  brandCollection,
+} from '../runtime/collections';
+import { nestedTracker } from '../runtime/nested-tracking';
+import * as env from '../env/api';
+
+const HEAD_KEY = /* @__PURE__ */ Uint8Array.of(0x00);
+const CHUNK_PREFIX = 0x01;
+const WRITER_MARK = /* @__PURE__ */ Uint8Array.of(0x01);
+const EXECUTOR_ID_LENGTH = 32;
+
+const DEFAULT_CAPACITY = 10_000;
+const DEFAULT_FALSE_POSITIVE_RATE = 0.01;
+const DEFAULT_CHUNK_SIZE = 1024;
+const MAX_CHUNK_SIZE = 65536;
+const MAX_HASHES = 32;
+
+export interface BloomSetOptions {
+  id?: Uint8Array | string;
+  /** Number of distinct values the filter is sized for (default 10 000) */
+  capacity?: number;
+  /** Target false-positive rate at capacity (default 0.01) */
+  falsePositiveRate?: number;
+  /** Bytes per stored chunk (default 1024). Must stay the same for the lifetime of the filter. */
+  chunkSize?: number;
+  /** Total bits, overriding the size derived from capacity and false-positive rate */
+  bits?: number;
+  /** Bits set per value, overriding the count derived from capacity and false-positive rate */
+  hashes?: number;
+  /**
+   * Encodes values with plain ABI Borsh instead of the SDK value encoding before hashing.
+   * Must stay the same for the lifetime of the filter.
+   */
+  valueCodec?: CodecSpec;
+}
+
+export interface BloomSetParameters {
+  bits: number;
+  hashes: number;
+  chunkSize: number;
+}
+
+interface Probe {
+  chunk: number;
+  positions: number[];
+}
+
+function chunkKey(chunk: number, executor: Uint8Array): Uint8Array {
+  const key = new Uint8Array(5 + EXECUTOR_ID_LENGTH);
+  key[0] = CHUNK_PREFIX;
+  new DataView(key.buffer).setUint32(1, chunk, false);
+  key.set(executor, 5);
+  return key;
+}
+
+function testBits(bits: Uint8Array, positions: number[]): boolean {
+  for (const position of positions) {
+    if ((bits[position >> 3] & (1 << (position & 7))) === 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+function popCount(bits: Uint8Array): number {
+  let count = 0;
+  for (let i = 0; i < bits.length; i++) {
+    let byte = bits[i];
+    while (byte) {
+      byte &= byte - 1;
+      count++;
+    }
+  }
+  return count;
+}
+
+export class BloomSet<T> {
+  private readonly _calimeroSetId: Uint8Array;
+  private readonly writersId: Uint8Array;
+  private readonly bits: number;
+  private readonly hashes: number;
+  private readonly chunkSize: number;
+  private readonly chunks: number;
+  private readonly valueCodec?: Codec<T>;
+  private writers: { generation: number; ids: Uint8Array[] } | null = null;
+
+  constructor(options: BloomSetOptions = {}) {
+    const chunkSize = options.chunkSize ?? DEFAULT_CHUNK_SIZE;
+    if (!Number.isInteger(chunkSize) || chunkSize < 1 || chunkSize > MAX_CHUNK_SIZE) {
+      throw new RangeError(`BloomSet: chunkSize must be an integer in 1..${MAX_CHUNK_SIZE}`);
+    }
+    const capacity = options.capacity ?? DEFAULT_CAPACITY;
+    const rate = options.falsePositiveRate ?? DEFAULT_FALSE_POSITIVE_RATE;
+    if (!(capacity >= 1) || !(rate > 0 && rate < 1)) {
+      throw new RangeError('BloomSet: capacity must be >= 1 and falsePositiveRate in (0, 1)');
+    }
+
+    // m = -n ln p / (ln 2)^2 and k = (m / n) ln 2, with m rounded up to whole chunks
+    const optimalBits = Math.ceil((-capacity * Math.log(rate)) / (Math.LN2 * Math.LN2));
+    const chunkBits = chunkSize * 8;
+    const bits = options.bits ?? Math.ceil(optimalBits / chunkBits) * chunkBits;
+    const hashes = options.hashes ?? Math.round((optimalBits / capacity) * Math.LN2);
+    if (!Number.isInteger(bits) || bits < chunkBits || bits % chunkBits !== 0 || bits >= 2 ** 40) {
+      throw new RangeError('BloomSet: bits must be a positive multiple of the chunk size in bits');
+    }
+    this.bits = bits;
+    this.hashes = Math.min(MAX_HASHES, Math.max(1, hashes));
+    this.chunkSize = chunkSize;
+    this.chunks = bits / chunkBits;
+
+    if (options.id) {
+      this._calimeroSetId = normalizeCollectionId(options.id, 'BloomSet');
+      const head = mapGet(this._calimeroSetId, HEAD_KEY);
+      if (!head) {
+        throw new Error('BloomSet: missing head');
+      }
+      this.writersId = head;
+    } else {
+      this._calimeroSetId = mapNew();
+      this.writersId = mapNew();
+      mapInsert(this._calimeroSetId, HEAD_KEY, this.writersId);
+    }
+
+    if (options.valueCodec) {
+      this.valueCodec = codecFor(options.valueCodec as CodecSpec<T>);
+    }
+
+    const codecs: CollectionCodecSpecs = {
+      bits: this.bits,
+      hashes: this.hashes,
+      chunkSize: this.chunkSize,
+    };
+    if (this.valueCodec) {
+      codecs.value = this.valueCodec.spec;
+    }
+    brandCollection(this, 'BloomSet', this._calimeroSetId, codecs);
+
+    nestedTracker.registerCollection(this);
+  }
+
+  /**
+   * Returns the identifier of this filter as a hex string.
+   */
+  id(): string {
+    return bytesToHex(this._calimeroSetId);
+  }
+
+  /**
+   * Returns a copy of the identifier bytes.
+   */
+  idBytes(): Uint8Array {
+    return new Uint8Array(this._calimeroSetId);
+  }
+
+  /**
+   * Size of the bit array, bits set per value and bytes per chunk.
+   */
+  parameters(): BloomSetParameters {
+    return { bits: this.bits, hashes: this.hashes, chunkSize: this.chunkSize };
+  }
+
+  /**
+   * Adds `value`. Returns false when it was already (probably) present, in which case nothing
+   * is written.
+   */
+  add(value: T): boolean {
+    return this.addMany([value]) === 1;
+  }
+
+  /**
+   * Adds values, writing each touched chunk once. Returns how many were not already (probably)
+   * present.
+   */
+  addMany(values: T[]): number {
+    const byChunk = this.probesByChunk(values);
+    const executor = env.executorId();
+    let added = 0;
+
+    for (const [chunk, probes] of byChunk) {
+      const { merged, own: stored } = this.readChunk(chunk, executor);
+      let own: Uint8Array | null = null;
+      for (const probe of probes) {
+        if (testBits(merged, probe.positions)) {
+          continue;
+        }
+        own ??= stored ?? new Uint8Array(this.chunkSize);
+        for (const position of probe.positions) {
+          const mask = 1 << (position & 7);
+          merged[position >> 3] |= mask;
+          own[position >> 3] |= mask;
+        }
+        added++;
+      }
+      if (own) {
+        mapInsert(this._calimeroSetId, chunkKey(chunk, executor), own);
+      }
+    }
+
+    if (added > 0) {
+      this.registerWriter(executor);
+      nestedTracker.notifyCollectionModified(this);
+    }
+    return added;
+  }
+
+  /**
+   * False when `value` was never added; true when it was, or for a false positive.
+   */
+  mightContain(value: T): boolean {
+    return this.mightContainMany([value])[0];
+  }
+
+  /**
+   * `mightContain` for each value, reading each touched chunk once.
+   */
+  mightContainMany(values: T[]): boolean[] {
+    const probes = values.map(value => this.probe(value));
+    const chunks = new Map<number, Uint8Array>();
+    return probes.map(probe => {
+      let bits = chunks.get(probe.chunk);
+      if (!bits) {
+        bits = this.readChunk(probe.chunk).merged;
+        chunks.set(probe.chunk, bits);
+      }
+      return testBits(bits, probe.positions);
+    });
+  }
+
+  /**
+   * Estimated number of distinct values added, from the share of set bits. Reads every chunk.
+   */
+  approximateSize(): number {
+    const chunks = new Map<number, Uint8Array>();
+    for (const [key, bits] of mapEntries(this._calimeroSetId)) {
+      if (key[0] !== CHUNK_PREFIX) {
+        continue;
+      }
+      const chunk = new DataView(key.buffer, key.byteOffset + 1, 4).getUint32(0, false);
+      const merged = chunks.get(chunk);
+      if (merged) {
+        for (let i = 0; i < merged.length; i++) merged[i] |= bits[i];
+      } else {
+        chunks.set(chunk, Uint8Array.from(bits));
+      }
+    }
+    let set = 0;
+    for (const bits of chunks.values()) {
+      set += popCount(bits);
+    }
+    if (set >= this.bits) {
+      return Infinity;
+    }
+    return Math.round((-this.bits / this.hashes) * Math.log(1 - set / this.bits));
+  }
+
+  toJSON(): Record<string, unknown> {
+    return {
+      __calimeroCollection: 'BloomSet',
+      id: this.id(),
+    };
+  }
+
+  // Chunk and bit positions within it: Kirsch-Mitzenmacher double hashing over the chunk bits
+  private probe(value: T): Probe {
+    const encoded = this.valueCodec ? this.valueCodec.encode(value) : serialize(value);
+    const [h1, h2, h3] = murmur3(encoded);
+    const chunkBits = this.chunkSize * 8;
+    const step = (h3 | 1) >>> 0;
+    const positions: number[] = [];
+    for (let i = 0; i < this.hashes; i++) {
+      positions.push((h2 + i * step) % chunkBits);
+    }
+    return { chunk: h1 % this.chunks, positions };
+  }
+
+  private probesByChunk(values: T[]): Map<number, Probe[]> {
+    const byChunk = new Map<number, Probe[]>();
+    for (const value of values) {
+      const probe = this.probe(value);
+      const probes = byChunk.get(probe.chunk);
+      if (probes) {
+        probes.push(probe);
+      } else {
+        byChunk.set(probe.chunk, [probe]);
+      }
+    }
+    return byChunk;
+  }
+
+  // OR of every writer's copy of `chunk`, plus `owner`'s own copy when it has one
+  private readChunk(
+    chunk: number,
+    owner?: Uint8Array
+  ): { merged: Uint8Array; own: Uint8Array | null } {
+    const merged = new Uint8Array(this.chunkSize);
+    const ownerHex = owner ? bytesToHex(owner) : null;
+    let own: Uint8Array | null = null;
+    for (const writer of this.writerIds()) {
+      const bits = mapGet(this._calimeroSetId, chunkKey(chunk, writer));
+      if (!bits) {
+        continue;
+      }
+      for (let i = 0; i < merged.length; i++) merged[i] |= bits[i];
+      if (ownerHex !== null && bytesToHex(writer) === ownerHex) {
+        own = bits;
+      }
+    }
+    return { merged, own };
+  }
+
+  // Writers only change through this invocation's own additions, so the list is read once
+  private writerIds(): Uint8Array[] {
+    const generation = invocationGeneration();
+    if (generation !== null && this.writers?.generation === generation) {
+      return this.writers.ids;
+    }
+    const ids = mapEntries(this.writersId).map(([executor]) => executor);
+    this.writers = generation === null ? null : { generation, ids };
+    return ids;
+  }
+
+  private registerWriter(executor: Uint8Array): void {
+    const ids = this.writerIds();
+    const hex = bytesToHex(executor);
+    if (!ids.some(id => bytesToHex(id) === hex)) {
+      mapInsert(this.writersId, executor, WRITER_MARK);
+      ids.push(executor);
+    }
+  }
+}
+
+registerCollectionType(
+  'BloomSet',
+  (snapshot: CollectionSnapshot) =>
+    new BloomSet({
+      id: snapshot.id,
+      bits: snapshot.codecs?.bits,
+      hashes: snapshot.codecs?.hashes,
+      chunkSize: snapshot.codecs?.chunkSize,
+      valueCodec: snapshot.codecs?.value,
+    })
+);
@@ -9,36 +9,41 @@ import {
   counterValue,
   counterGetExecutorCount,
 } from '../runtime/storage-wasm';
-import { registerCollectionType, CollectionSnapshot } from '../runtime/collections';
+import {
+  registerCollectionType,
+  CollectionSnapshot,
+  brandCollection,
+} from '../runtime/collections';
 
 export interface CounterOptions {
   id?: Uint8Array | string;
 }
 
 export class Counter {
-  private readonly counterId: Uint8Array;
+  private readonly _calimeroCounterId: Uint8Array;
 
   constructor(options: CounterOptions = {}) {
     if (options.id) {
-      this.counterId = normalizeCollectionId(options.id, 'Counter');
+      this._calimeroCounterId = normalizeCollectionId(options.id, 'Counter');
     } else {
-      this.counterId = counterNew();
+      this._calimeroCounterId = counterNew();
     }
+    brandCollection(this, 'Counter', this._calimeroCounterId);
   }
 
   id(): string {
-    return bytesToHex(this.counterId);
+    return bytesToHex(this._calimeroCounterId);
   }
 
   idBytes(): Uint8Array {
-    return new Uint8Array(this.counterId);
+    return new Uint8Array(this._calimeroCounterId);
   }
 
   /**
    * Increments the counter for the current executor.
    */
   increment(): void {
-    counterIncrement(this.counterId);
+    counterIncrement(this._calimeroCounterId);
   }
 
   /**
@@ -49,7 +54,7 @@ export class Counter {
   incrementBy(amount: number | bigint): void {
     const steps = normalizeAmount(amount);
     for (let i = 0; i < steps; i++) {
-      counterIncrement(this.counterId);
+      counterIncrement(this._calimeroCounterId);
     }
   }
 
@@ -57,7 +62,7 @@ export class Counter {
    * Gets the total count across all executors.
    */
   value(): bigint {
-    return counterValue(this.counterId);
+    return counterValue(this._calimeroCounterId);
   }
 
   /**
@@ -66,7 +71,7 @@ export class Counter {
    */
   getExecutorCount(executorId?: string): number {
     const executorIdBytes = executorId ? normalizeCollectionId(executorId, 'Executor') : undefined;
-    const value = counterGetExecutorCount(this.counterId, executorIdBytes);
+    const value = counterGetExecutorCount(this._calimeroCounterId, executorIdBytes);
     return Number(value);
   }
 
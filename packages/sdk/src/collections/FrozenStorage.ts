@@ -24,6 +24,7 @@ import {
   registerCollectionType,
   CollectionSnapshot,
   hasRegisteredCollection,
+  brandCollection,
 } from '../runtime/collections';
 import { nestedTracker } from '../runtime/nested-tracking';
 
@@ -92,17 +93,18 @@ export class FrozenValue<T> {
  * ```
  */
 export class FrozenStorage<T> {
-  private readonly mapId: Uint8Array;
+  private readonly _calimeroMapId: Uint8Array;
 
   constructor(options: FrozenStorageOptions = {}) {
     if (options.id) {
-      this.mapId = normalizeCollectionId(options.id, 'Storage');
+      this._calimeroMapId = normalizeCollectionId(options.id, 'Storage');
     } else {
       // frozenStorageNew() will throw an error if it fails (via decodeError)
       // No need for try-catch - let the error propagate naturally
-      this.mapId = frozenStorageNew();
+      this._calimeroMapId = frozenStorageNew();
     }
 
+    brandCollection(this, 'FrozenStorage', this._calimeroMapId);
     nestedTracker.registerCollection(this);
   }
 
@@ -114,14 +116,14 @@ export class FrozenStorage<T> {
    * Returns the underlying storage identifier as a hex string.
    */
   id(): string {
-    return bytesToHex(this.mapId);
+    return bytesToHex(this._calimeroMapId);
   }
 
   /**
    * Returns a copy of the storage identifier bytes.
    */
   idBytes(): Uint8Array {
-    return new Uint8Array(this.mapId);
+    return new Uint8Array(this._calimeroMapId);
   }
 
   /**
@@ -138,7 +140,7 @@ export class FrozenStorage<T> {
   add(value: T): Hash {
     const valueBytes = serializeBorshForHash(value);
 
-    const hash = frozenStorageAdd(this.mapId, valueBytes);
+    const hash = frozenStorageAdd(this._calimeroMapId, valueBytes);
 
     if (hasRegisteredCollection(value)) {
       nestedTracker.registerCollection(value, this, hash);
@@ -159,7 +161,7 @@ export class FrozenStorage<T> {
       throw new TypeError('FrozenStorage hash must be a 32-byte Uint8Array');
     }
 
-    const raw = frozenStorageGet(this.mapId, hash);
+    const raw = frozenStorageGet(this._calimeroMapId, hash);
     if (!raw) {
       return null;
     }
@@ -178,7 +180,7 @@ export class FrozenStorage<T> {
       throw new TypeError('FrozenStorage hash must be a 32-byte Uint8Array');
     }
 
-    return frozenStorageContains(this.mapId, hash);
+    return frozenStorageContains(this._calimeroMapId, hash);
   }
 
   /**
@@ -197,7 +199,7 @@ export class FrozenStorage<T> {
    * @returns Array of [hash, value] pairs
    */
   entries(): Array<[Hash, T]> {
-    const serializedEntries = mapEntries(this.mapId);
+    const serializedEntries = mapEntries(this._calimeroMapId);
     return serializedEntries.map(([hashBytes, valueBytes]) => {
       const value = deserializeBorshWithFallback<T>(valueBytes);
       return [new Uint8Array(hashBytes), value];
@@ -229,13 +231,9 @@ export class FrozenStorage<T> {
    */
   static computeHash<T>(value: T): Hash {
     const valueBytes = serializeBorshForHash(value);
-    const writer = new BorshWriter();
-    writer.writeU32(valueBytes.length);
-    const lengthPrefix = new Uint8Array(writer.toBytes());
-    const combined = new Uint8Array(lengthPrefix.length + valueBytes.length);
-    combined.set(lengthPrefix, 0);
-    combined.set(valueBytes, lengthPrefix.length);
-    return sha256(combined);
+    const writer = new BorshWriter(4 + valueBytes.length);
+    writer.writeBytes(valueBytes);
+    return sha256(writer.finish());
   }
 
   toJSON(): Record<string, unknown> {
@@ -265,13 +263,13 @@ function serializeBorshForHash<T>(value: T): Uint8Array {
   if (typeof value === 'number') {
     const writer = new BorshWriter();
     writer.writeF64(value);
-    return writer.toBytes();
+    return writer.finish();
   }
   // For booleans, serialize as Borsh u8 (1 byte)
   if (typeof value === 'boolean') {
     const writer = new BorshWriter();
     writer.writeU8(value ? 1 : 0);
-    return writer.toBytes();
+    return writer.finish();
   }
   if (value === null || value === undefined) {
     throw new Error('Cannot serialize null/undefined for hash computation');
@@ -0,0 +1,365 @@
+/**
+ * IndexedMap - Map with declarative secondary indexes over its values.
+ *
+ * Each index is declared by name with the dotted path of the value field it covers, e.g.
+ * `{ byAuthor: 'author', byMime: 'file.mime' }`. `set` and `remove` keep the indexes in step
+ * with the entries, and `findBy(index, term)` answers from the index plus the k matching
+ * entries, in O(log n + k) host reads, instead of scanning every entry.
+ *
+ * Index terms are strings, numbers, bigints, byte arrays or booleans (indexed as 0 and 1).
+ * An array field is indexed under each of its elements; a missing or null field is not indexed.
+ *
+ * Layout of the backing map:
+ *   [0x00]                      id of the index `SortedMap`
+ *   [0x01] ++ serialized key    terms length (u32 LE) ++ ordered-key encoding of the entry's
+ *                               [index, term] pairs ++ encoded value
+ * The index holds one `[index, term, serialized key]` key per indexed term. Storing the terms
+ * next to the value lets `set` and `remove` diff them against the previous entry returned by
+ * the same host write, without decoding the previous value.
+ *
+ * Index keys are ordinary `SortedMap` entries, whose ordering index is kept per executor, so
+ * concurrent updates merge like the entries themselves and stay ordered without a rebuild. When
+ * two nodes write the same key concurrently, the entry resolves last-writer-wins but the index
+ * keeps the terms of both values. Lookups therefore check every hit against the terms stored
+ * with the entry and skip stale ones before applying `limit`.
+ */
+
+import { serialize, deserialize } from '../utils/serialize';
+import { codecFor, type Codec, type CodecSpec } from '../utils/abi-codec';
+import { bytesToHex, normalizeCollectionId } from '../utils/hex';
+import { decodeOrderedKey, encodeOrderedKey, type OrderedKey } from '../utils/ordered-key';
+import { mapNew, mapGet, mapInsert, mapRemove, mapEntries } from '../runtime/storage-wasm';
+import {
+  registerCollectionType,
+  CollectionSnapshot,
+  type CollectionCodecSpecs,
+  hasRegisteredCollection,
+  brandCollection,
+} from '../runtime/collections';
+import { nestedTracker } from '../runtime/nested-tracking';
+import { SortedMap } from './SortedMap';
+
+const META_KEY = /* @__PURE__ */ Uint8Array.of(0x00);
+const ENTRY_PREFIX = 0x01;
+
+export type IndexTerm = string | number | bigint | boolean | Uint8Array;
+
+export interface IndexedMapOptions {
+  id?: Uint8Array | string;
+  /**
+   * Index name -> dotted path of the indexed value field. Entries written before an index was
+   * declared are not in it.
+   */
+  indexes: Record<string, string>;
+  /**
+   * Encodes values with plain ABI Borsh instead of the SDK value encoding.
+   * Must stay the same for the lifetime of the map.
+   */
+  valueCodec?: CodecSpec;
+}
+
+function termKey(term: IndexTerm): OrderedKey {
+  if (typeof term === 'boolean') {
+    return term ? 1 : 0;
+  }
+  if (
+    typeof term === 'string' ||
+    typeof term === 'number' ||
+    typeof term === 'bigint' ||
+    term instanceof Uint8Array
+  ) {
+    return term;
+  }
+  throw new TypeError(`IndexedMap: unsupported index term: ${String(term)}`);
+}
+
+function entryKey(pk: Uint8Array): Uint8Array {
+  const out = new Uint8Array(pk.length + 1);
+  out[0] = ENTRY_PREFIX;
+  out.set(pk, 1);
+  return out;
+}
+
+// Splits a stored entry into its encoded [index, term] pairs and value bytes
+function splitRecord(record: Uint8Array): { terms: Uint8Array; value: Uint8Array } {
+  if (record.length < 4) {
+    throw new Error('IndexedMap: corrupted entry');
+  }
+  const length = new DataView(record.buffer, record.byteOffset, 4).getUint32(0, true);
+  return { terms: record.subarray(4, 4 + length), value: record.subarray(4 + length) };
+}
+
+export class IndexedMap<K, V> {
+  private readonly _calimeroMapId: Uint8Array;
+  private readonly index: SortedMap<OrderedKey[], null>;
+  private readonly paths: Array<[string, string[]]>;
+  private readonly indexes: Record<string, string>;
+  private readonly valueCodec?: Codec<V>;
+
+  constructor(options: IndexedMapOptions) {
+    const names = Object.keys(options.indexes ?? {}).sort();
+    if (names.length === 0) {
+      throw new Error('IndexedMap: declare at least one index');
+    }
+    this.indexes = {};
+    this.paths = names.map(name => {
+      const path = options.indexes[name];
+      if (typeof path !== 'string' || path.length === 0) {
+        throw new TypeError(`IndexedMap: index '${name}' needs a field path`);
+      }
+      this.indexes[name] = path;
+      return [name, path.split('.')];
+    });
+
+    if (options.id) {
+      this._calimeroMapId = normalizeCollectionId(options.id, 'IndexedMap');
+      const meta = mapGet(this._calimeroMapId, META_KEY);
+      if (!meta) {
+        throw new Error('IndexedMap: missing index metadata');
+      }
+      this.index = new SortedMap({ id: meta });
+    } else {
+      this._calimeroMapId = mapNew();
+      this.index = new SortedMap();
+      mapInsert(this._calimeroMapId, META_KEY, this.index.idBytes());
+    }
+
+    if (options.valueCodec) {
+      this.valueCodec = codecFor(options.valueCodec as CodecSpec<V>);
+    }
+
+    const codecs: CollectionCodecSpecs = { indexes: this.indexes };
+    if (this.valueCodec) {
+      codecs.value = this.valueCodec.spec;
+    }
+    brandCollection(this, 'IndexedMap', this._calimeroMapId, codecs);
+
+    nestedTracker.registerCollection(this);
+  }
+
+  /**
+   * Returns the identifier of this map as a hex string.
+   */
+  id(): string {
+    return bytesToHex(this._calimeroMapId);
+  }
+
+  /**
+   * Returns a copy of the identifier bytes.
+   */
+  idBytes(): Uint8Array {
+    return new Uint8Array(this._calimeroMapId);
+  }
+
+  /**
+   * Names of the declared indexes.
+   */
+  indexNames(): string[] {
+    return this.paths.map(([name]) => name);
+  }
+
+  get(key: K): V | null {
+    const record = mapGet(this._calimeroMapId, entryKey(serialize(key)));
+    return record ? this.decodeValue(splitRecord(record).value) : null;
+  }
+
+  has(key: K): boolean {
+    return mapGet(this._calimeroMapId, entryKey(serialize(key))) !== null;
+  }
+
+  /**
+   * Inserts or replaces the value for `key` and moves its index keys from the previous value's
+   * terms to the new ones. Terms shared by both values are not rewritten.
+   */
+  set(key: K, value: V): void {
+    if (hasRegisteredCollection(value)) {
+      nestedTracker.registerCollection(value, this, key);
+    }
+
+    const pk = serialize(key);
+    const pairs = this.extractPairs(value);
+    const terms = encodeOrderedKey(pairs);
+    const encoded = this.encodeValue(value);
+    const record = new Uint8Array(4 + terms.length + encoded.length);
+    new DataView(record.buffer).setUint32(0, terms.length, true);
+    record.set(terms, 4);
+    record.set(encoded, 4 + terms.length);
+
+    const previous = mapInsert(this._calimeroMapId, entryKey(pk), record);
+    const stale = previous ? this.decodePairs(splitRecord(previous).terms) : [];
+    this.updateIndex(pk, stale, pairs);
+
+    nestedTracker.notifyCollectionModified(this);
+  }
+
+  /**
+   * Removes `key` and its index keys. Returns whether it was present.
+   */
+  remove(key: K): boolean {
+    const pk = serialize(key);
+    const previous = mapRemove(this._calimeroMapId, entryKey(pk));
+    if (previous === null) {
+      return false;
+    }
+    this.updateIndex(pk, this.decodePairs(splitRecord(previous).terms), []);
+
+    nestedTracker.notifyCollectionModified(this);
+    return true;
+  }
+
+  /**
+   * Keys whose indexed field equals (or, for array fields, contains) `term`, ordered by their
+   * serialized form, at most `limit` of them. Reads the index and the matching entries.
+   */
+  findBy(index: string, term: IndexTerm, limit = Infinity): K[] {
+    return this.findEntriesBy(index, term, limit).map(([key]) => key);
+  }
+
+  /**
+   * Like `findBy`, with the values.
+   */
+  findEntriesBy(index: string, term: IndexTerm, limit = Infinity): Array<[K, V]> {
+    this.checkIndex(index);
+    return this.matches(this.index.iteratePrefixKeys([index, termKey(term)]), limit);
+  }
+
+  /**
+   * Keys whose indexed term is in `[from, to)`, ordered by term, at most `limit` of them.
+   * Terms of different kinds order by kind first (numbers before bigints before strings).
+   */
+  rangeBy(index: string, from?: IndexTerm, to?: IndexTerm, limit = Infinity): K[] {
+    this.checkIndex(index);
+    const lower = from === undefined ? [index] : [index, termKey(from)];
+    // Every key of this index sorts below the name extended with a NUL character
+    const upper = to === undefined ? [`${index}\u0000`] : [index, termKey(to)];
+    return this.matches(this.index.iterateRangeKeys(lower, upper), limit).map(([key]) => key);
+  }
+
+  /**
+   * All entries, read with a full scan.
+   */
+  entries(): Array<[K, V]> {
+    const entries: Array<[K, V]> = [];
+    for (const [key, record] of mapEntries(this._calimeroMapId)) {
+      if (key[0] === ENTRY_PREFIX) {
+        const { value } = splitRecord(record);
+        entries.push([deserialize<K>(key.subarray(1)), this.decodeValue(value)]);
+      }
+    }
+    return entries;
+  }
+
+  keys(): K[] {
+    return this.entries().map(([key]) => key);
+  }
+
+  values(): V[] {
+    return this.entries().map(([, value]) => value);
+  }
+
+  toJSON(): Record<string, unknown> {
+    return {
+      __calimeroCollection: 'IndexedMap',
+      id: this.id(),
+    };
+  }
+
+  // Entries behind the index keys whose stored terms still include the key's [index, term]
+  // pair, at most `limit` of them; keys left behind by a concurrent write are skipped
+  private matches(keys: Iterable<OrderedKey[]>, limit: number): Array<[K, V]> {
+    const entries: Array<[K, V]> = [];
+    if (limit <= 0) {
+      return entries;
+    }
+    for (const [name, term, pk] of keys) {
+      const record = mapGet(this._calimeroMapId, entryKey(pk as Uint8Array));
+      if (!record) {
+        continue;
+      }
+      const { terms, value } = splitRecord(record);
+      const wanted = bytesToHex(encodeOrderedKey([name, term]));
+      const current = this.decodePairs(terms).some(
+        pair => bytesToHex(encodeOrderedKey(pair)) === wanted
+      );
+      if (current) {
+        entries.push([deserialize<K>(pk as Uint8Array), this.decodeValue(value)]);
+        if (entries.length >= limit) {
+          break;
+        }
+      }
+    }
+    return entries;
+  }
+
+  // Distinct [index, term] pairs of a value, in declaration order
+  private extractPairs(value: V): Array<[string, OrderedKey]> {
+    const pairs: Array<[string, OrderedKey]> = [];
+    const seen = new Set<string>();
+    for (const [name, path] of this.paths) {
+      let field: unknown = value;
+      for (const segment of path) {
+        field = field === null || field === undefined ? undefined : (field as any)[segment];
+      }
+      const terms = Array.isArray(field) ? field : [field];
+      for (const term of terms) {
+        if (term === null || term === undefined) {
+          continue;
+        }
+        const pair: [string, OrderedKey] = [name, termKey(term as IndexTerm)];
+        const id = bytesToHex(encodeOrderedKey(pair));
+        if (!seen.has(id)) {
+          seen.add(id);
+          pairs.push(pair);
+        }
+      }
+    }
+    return pairs;
+  }
+
+  private decodePairs(terms: Uint8Array): Array<[string, OrderedKey]> {
+    return decodeOrderedKey(terms) as Array<[string, OrderedKey]>;
+  }
+
+  private updateIndex(
+    pk: Uint8Array,
+    previous: Array<[string, OrderedKey]>,
+    next: Array<[string, OrderedKey]>
+  ): void {
+    const before = new Map(previous.map(pair => [bytesToHex(encodeOrderedKey(pair)), pair]));
+    const after = new Map(next.map(pair => [bytesToHex(encodeOrderedKey(pair)), pair]));
+    for (const [id, [name, term]] of before) {
+      if (!after.has(id)) {
+        this.index.remove([name, term, pk]);
+      }
+    }
+    for (const [id, [name, term]] of after) {
+      if (!before.has(id)) {
+        this.index.set([name, term, pk], null);
+      }
+    }
+  }
+
+  private checkIndex(index: string): void {
+    if (!Object.prototype.hasOwnProperty.call(this.indexes, index)) {
+      throw new Error(`IndexedMap: unknown index '${index}'`);
+    }
+  }
+
+  private encodeValue(value: V): Uint8Array {
+    return this.valueCodec ? this.valueCodec.encode(value) : serialize(value);
+  }
+
+  private decodeValue(raw: Uint8Array): V {
+    return this.valueCodec ? this.valueCodec.decode(raw) : deserialize<V>(raw);
+  }
+}
+
+registerCollectionType(
+  'IndexedMap',
+  (snapshot: CollectionSnapshot) =>
+    new IndexedMap({
+      id: snapshot.id,
+      indexes: snapshot.codecs?.indexes ?? {},
+      valueCodec: snapshot.codecs?.value,
+    })
+);
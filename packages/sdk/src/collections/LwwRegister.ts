@@ -5,7 +5,11 @@
 import { serialize, deserialize } from '../utils/serialize';
 import { bytesToHex, normalizeCollectionId } from '../utils/hex';
 import { lwwNew, lwwSet, lwwGet, lwwTimestamp } from '../runtime/storage-wasm';
-import { registerCollectionType, CollectionSnapshot } from '../runtime/collections';
+import {
+  registerCollectionType,
+  CollectionSnapshot,
+  brandCollection,
+} from '../runtime/collections';
 
 export interface LwwRegisterOptions<T> {
   id?: Uint8Array | string;
@@ -13,14 +17,15 @@ export interface LwwRegisterOptions<T> {
 }
 
 export class LwwRegister<T> {
-  private readonly registerId: Uint8Array;
+  private readonly _calimeroRegisterId: Uint8Array;
 
   constructor(options: LwwRegisterOptions<T> = {}) {
     if (options.id) {
-      this.registerId = normalizeCollectionId(options.id, 'LwwRegister');
+      this._calimeroRegisterId = normalizeCollectionId(options.id, 'LwwRegister');
     } else {
-      this.registerId = lwwNew();
+      this._calimeroRegisterId = lwwNew();
     }
+    brandCollection(this, 'LwwRegister', this._calimeroRegisterId);
 
     if (options.initialValue !== undefined) {
       if (options.initialValue === null) {
@@ -32,23 +37,23 @@ export class LwwRegister<T> {
   }
 
   id(): string {
-    return bytesToHex(this.registerId);
+    return bytesToHex(this._calimeroRegisterId);
   }
 
   idBytes(): Uint8Array {
-    return new Uint8Array(this.registerId);
+    return new Uint8Array(this._calimeroRegisterId);
   }
 
   set(value: T): void {
-    lwwSet(this.registerId, serialize(value));
+    lwwSet(this._calimeroRegisterId, serialize(value));
   }
 
   clear(): void {
-    lwwSet(this.registerId, null);
+    lwwSet(this._calimeroRegisterId, null);
   }
 
   get(): T | null {
-    const raw = lwwGet(this.registerId);
+    const raw = lwwGet(this._calimeroRegisterId);
     return raw ? deserialize<T>(raw) : null;
   }
 
@@ -56,7 +61,7 @@ export class LwwRegister<T> {
    * Returns the timestamp of the current value as a number representing the physical time.
    */
   timestamp(): number | null {
-    const payload = lwwTimestamp(this.registerId);
+    const payload = lwwTimestamp(this._calimeroRegisterId);
     return payload ? Number(payload.time) : null;
   }
 
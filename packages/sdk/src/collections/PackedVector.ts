@@ -0,0 +1,435 @@
+/**
+ * PackedVector - Append-only vector of fixed-width numbers stored in chunks.
+ *
+ * Elements are kept as raw little-endian arrays of `chunkSize` values per map entry, so 100k
+ * floats take ~100 entries instead of 100k and ranged reads come back as typed arrays without
+ * decoding each element.
+ *
+ * Each executor appends to its own run of chunks (the partitioning `AppendLog` uses), so appends
+ * made concurrently on different nodes never write the same key and all survive a merge. The
+ * vector lists each executor's run in append order, runs ordered by executor id; a value's
+ * index can therefore grow when a merged run sorts before it.
+ *
+ * Layout of the backing map:
+ *   [0x00]                                     id of the writers map (executor id -> 0x01)
+ *   [0x01] ++ executor id                      values in the run (u64 LE)
+ *   [0x02] ++ executor id ++ chunk (u32 BE)    chunk values, raw; only a run's last chunk may
+ *                                              be partial
+ * A run is only written by its executor.
+ */
+
+import { bytesToHex, normalizeCollectionId } from '../utils/hex';
+import { mapNew, mapGet, mapInsert, mapEntries } from '../runtime/storage-wasm';
+import { invocationGeneration } from '../runtime/invocation-context';
+import {
+  registerCollectionType,
+  CollectionSnapshot,
+  brandCollection,
+} from '../runtime/collections';
+import { nestedTracker } from '../runtime/nested-tracking';
+import * as env from '../env/api';
+
+interface PackedArrays {
+  u8: Uint8Array;
+  i8: Int8Array;
+  u16: Uint16Array;
+  i16: Int16Array;
+  u32: Uint32Array;
+  i32: Int32Array;
+  f32: Float32Array;
+  f64: Float64Array;
+  u64: BigUint64Array;
+  i64: BigInt64Array;
+}
+
+export type PackedElementType = keyof PackedArrays;
+export type PackedArray<E extends PackedElementType> = PackedArrays[E];
+export type PackedValue<E extends PackedElementType> = E extends 'u64' | 'i64' ? bigint : number;
+
+const ARRAY_TYPES: Record<PackedElementType, any> = {
+  u8: Uint8Array,
+  i8: Int8Array,
+  u16: Uint16Array,
+  i16: Int16Array,
+  u32: Uint32Array,
+  i32: Int32Array,
+  f32: Float32Array,
+  f64: Float64Array,
+  u64: BigUint64Array,
+  i64: BigInt64Array,
+};
+
+const DEFAULT_CHUNK_SIZE = 1024;
+const MAX_CHUNK_SIZE = 65536;
+const HEAD_KEY = /* @__PURE__ */ Uint8Array.of(0x00);
+const RUN_HEAD_PREFIX = 0x01;
+const CHUNK_PREFIX = 0x02;
+const WRITER_MARK = /* @__PURE__ */ Uint8Array.of(0x01);
+const EXECUTOR_ID_LENGTH = 32;
+
+export interface PackedVectorOptions<E extends PackedElementType> {
+  id?: Uint8Array | string;
+  /** Element type. Must stay the same for the lifetime of the vector. */
+  element: E;
+  /** Values per stored chunk (default 1024). Must stay the same for the lifetime of the vector. */
+  chunkSize?: number;
+}
+
+interface Run {
+  executor: Uint8Array;
+  /** Index of the run's first value in the vector */
+  start: number;
+  count: number;
+}
+
+function runHeadKey(executor: Uint8Array): Uint8Array {
+  const key = new Uint8Array(1 + EXECUTOR_ID_LENGTH);
+  key[0] = RUN_HEAD_PREFIX;
+  key.set(executor, 1);
+  return key;
+}
+
+function chunkKey(executor: Uint8Array, index: number): Uint8Array {
+  const key = new Uint8Array(5 + EXECUTOR_ID_LENGTH);
+  key[0] = CHUNK_PREFIX;
+  key.set(executor, 1);
+  new DataView(key.buffer).setUint32(1 + EXECUTOR_ID_LENGTH, index, false);
+  return key;
+}
+
+function bytesOf(values: ArrayBufferView): Uint8Array {
+  return new Uint8Array(values.buffer, values.byteOffset, values.byteLength);
+}
+
+export class PackedVector<E extends PackedElementType> {
+  private readonly _calimeroVectorId: Uint8Array;
+  private readonly writersId: Uint8Array;
+  private readonly element: E;
+  private readonly chunkSize: number;
+  private readonly ArrayType: any;
+  private writers: { generation: number; ids: Uint8Array[] } | null = null;
+
+  constructor(options: PackedVectorOptions<E>) {
+    if (!options || !(options.element in ARRAY_TYPES)) {
+      throw new RangeError(`PackedVector: unsupported element type ${String(options?.element)}`);
+    }
+    const chunkSize = options.chunkSize ?? DEFAULT_CHUNK_SIZE;
+    if (!Number.isInteger(chunkSize) || chunkSize < 1 || chunkSize > MAX_CHUNK_SIZE) {
+      throw new RangeError(`PackedVector: chunkSize must be an integer in 1..${MAX_CHUNK_SIZE}`);
+    }
+
+    if (options.id) {
+      this._calimeroVectorId = normalizeCollectionId(options.id, 'PackedVector');
+      const head = mapGet(this._calimeroVectorId, HEAD_KEY);
+      if (!head) {
+        throw new Error('PackedVector: missing head');
+      }
+      this.writersId = head;
+    } else {
+      this._calimeroVectorId = mapNew();
+      this.writersId = mapNew();
+      mapInsert(this._calimeroVectorId, HEAD_KEY, this.writersId);
+    }
+    this.element = options.element;
+    this.chunkSize = chunkSize;
+    this.ArrayType = ARRAY_TYPES[options.element];
+
+    brandCollection(this, 'PackedVector', this._calimeroVectorId, {
+      element: this.element,
+      chunkSize: this.chunkSize,
+    });
+
+    nestedTracker.registerCollection(this);
+  }
+
+  /**
+   * Create a packed vector holding the provided values.
+   */
+  static fromArray<E extends PackedElementType>(
+    values: ArrayLike<PackedValue<E>>,
+    options: PackedVectorOptions<E>
+  ): PackedVector<E> {
+    const vector = new PackedVector<E>(options);
+    vector.pushMany(values);
+    return vector;
+  }
+
+  /**
+   * Returns the identifier of this vector as a hex string.
+   */
+  id(): string {
+    return bytesToHex(this._calimeroVectorId);
+  }
+
+  /**
+   * Returns a copy of the identifier bytes.
+   */
+  idBytes(): Uint8Array {
+    return new Uint8Array(this._calimeroVectorId);
+  }
+
+  /**
+   * Gets the number of elements: one read per executor that has appended.
+   */
+  len(): number {
+    const runs = this.readRuns();
+    return runs.length === 0 ? 0 : runs[runs.length - 1].start + runs[runs.length - 1].count;
+  }
+
+  /**
+   * Appends a value. Numbers are converted like typed array stores (e.g. wrapped for `u8`).
+   */
+  push(value: PackedValue<E>): void {
+    this.pushMany([value]);
+  }
+
+  /**
+   * Appends values to this executor's run, writing each touched chunk once. Accepts arrays and
+   * typed arrays. Reads the run's head and, when it is partial, its last chunk.
+   */
+  pushMany(values: ArrayLike<PackedValue<E>>): void {
+    if (values.length === 0) {
+      return;
+    }
+
+    const executor = env.executorId();
+    let count = this.readCount(executor);
+    if (count === null) {
+      this.registerWriter(executor);
+      count = 0;
+    }
+    let offset = 0;
+    while (offset < values.length) {
+      const index = Math.floor(count / this.chunkSize);
+      const used = count % this.chunkSize;
+      const take = Math.min(this.chunkSize - used, values.length - offset);
+
+      const chunk = new this.ArrayType(used + take);
+      if (used > 0) {
+        const tail = this.readChunk(executor, index);
+        if (!tail || tail.length < used) {
+          throw new Error(`PackedVector: chunk ${index} is missing or truncated`);
+        }
+        chunk.set(tail.subarray(0, used));
+      }
+      if (ArrayBuffer.isView(values)) {
+        chunk.set((values as any).subarray(offset, offset + take), used);
+      } else {
+        for (let i = 0; i < take; i++) {
+          chunk[used + i] = values[offset + i];
+        }
+      }
+
+      mapInsert(this._calimeroVectorId, chunkKey(executor, index), bytesOf(chunk));
+      count += take;
+      offset += take;
+    }
+
+    const countBytes = new Uint8Array(8);
+    new DataView(countBytes.buffer).setBigUint64(0, BigInt(count), true);
+    mapInsert(this._calimeroVectorId, runHeadKey(executor), countBytes);
+
+    nestedTracker.notifyCollectionModified(this);
+  }
+
+  /**
+   * Gets the value at the given index, reading the run heads and its chunk.
+   */
+  get(index: number): PackedValue<E> | null {
+    if (!Number.isInteger(index) || index < 0) {
+      return null;
+    }
+    const run = this.readRuns().find(run => index < run.start + run.count);
+    if (!run) {
+      return null;
+    }
+    const position = index - run.start;
+    const chunk = this.readChunk(run.executor, Math.floor(position / this.chunkSize));
+    const offset = position % this.chunkSize;
+    return chunk && offset < chunk.length ? chunk[offset] : null;
+  }
+
+  /**
+   * Returns the values in `[start, end)` (clamped to the length) as a typed array.
+   */
+  range(start = 0, end?: number): PackedArray<E> {
+    const runs = this.readRuns();
+    const [from, to] = this.clampRange(runs, start, end);
+    const out = new this.ArrayType(to - from);
+    let pos = 0;
+    this.scan(runs, from, to, values => {
+      out.set(values, pos);
+      pos += values.length;
+    });
+    return out;
+  }
+
+  /**
+   * Reads the entire vector into a typed array.
+   */
+  toTypedArray(): PackedArray<E> {
+    return this.range();
+  }
+
+  /**
+   * Sum of the values in `[start, end)`; a bigint for 64-bit integer vectors.
+   */
+  sum(start = 0, end?: number): PackedValue<E> {
+    const runs = this.readRuns();
+    const [from, to] = this.clampRange(runs, start, end);
+    let total: any = this.isBigInt() ? 0n : 0;
+    this.scan(runs, from, to, values => {
+      for (let i = 0; i < values.length; i++) {
+        total += values[i];
+      }
+    });
+    return total;
+  }
+
+  /**
+   * Smallest value in `[start, end)`, or null when the range is empty.
+   */
+  min(start = 0, end?: number): PackedValue<E> | null {
+    return this.extreme(start, end, (a, b) => a < b);
+  }
+
+  /**
+   * Largest value in `[start, end)`, or null when the range is empty.
+   */
+  max(start = 0, end?: number): PackedValue<E> | null {
+    return this.extreme(start, end, (a, b) => a > b);
+  }
+
+  toJSON(): Record<string, unknown> {
+    return {
+      __calimeroCollection: 'PackedVector',
+      id: this.id(),
+    };
+  }
+
+  private isBigInt(): boolean {
+    return this.element === 'u64' || this.element === 'i64';
+  }
+
+  // Runs of the writers in executor id order, one head read each
+  private readRuns(): Run[] {
+    const executors = this.writerIds()
+      .map(executor => ({ executor, hex: bytesToHex(executor) }))
+      .sort((a, b) => (a.hex < b.hex ? -1 : a.hex > b.hex ? 1 : 0));
+    const runs: Run[] = [];
+    let start = 0;
+    for (const { executor } of executors) {
+      const count = this.readCount(executor);
+      if (count) {
+        runs.push({ executor, start, count });
+        start += count;
+      }
+    }
+    return runs;
+  }
+
+  private readCount(executor: Uint8Array): number | null {
+    const raw = mapGet(this._calimeroVectorId, runHeadKey(executor));
+    if (!raw) {
+      return null;
+    }
+    if (raw.length !== 8) {
+      throw new Error('PackedVector: corrupted run head');
+    }
+    return Number(new DataView(raw.buffer, raw.byteOffset, 8).getBigUint64(0, true));
+  }
+
+  private readChunk(executor: Uint8Array, index: number): PackedArray<E> | null {
+    let raw = mapGet(this._calimeroVectorId, chunkKey(executor, index));
+    if (!raw) {
+      return null;
+    }
+    const width: number = this.ArrayType.BYTES_PER_ELEMENT;
+    if (raw.byteLength % width !== 0) {
+      throw new Error(`PackedVector: chunk ${index} has a partial element`);
+    }
+    if (raw.byteOffset % width !== 0) {
+      raw = raw.slice();
+    }
+    return new this.ArrayType(raw.buffer, raw.byteOffset, raw.byteLength / width);
+  }
+
+  private clampRange(runs: Run[], start: number, end: number | undefined): [number, number] {
+    const last = runs[runs.length - 1];
+    const length = last ? last.start + last.count : 0;
+    const to = Math.min(end ?? length, length);
+    const from = Math.max(0, Math.min(start, to));
+    return [from, to];
+  }
+
+  // Calls `visit` with the slice of each chunk overlapping [from, to), in order
+  private scan(
+    runs: Run[],
+    from: number,
+    to: number,
+    visit: (values: PackedArray<E>) => void
+  ): void {
+    for (const run of runs) {
+      const runEnd = run.start + run.count;
+      for (let position = Math.max(from, run.start); position < Math.min(to, runEnd); ) {
+        const index = Math.floor((position - run.start) / this.chunkSize);
+        const chunkStart = run.start + index * this.chunkSize;
+        const sliceEnd = Math.min(to, runEnd, chunkStart + this.chunkSize);
+        const chunk = this.readChunk(run.executor, index);
+        if (!chunk || chunk.length < sliceEnd - chunkStart) {
+          throw new Error(`PackedVector: chunk ${index} is missing or truncated`);
+        }
+        visit(chunk.subarray(position - chunkStart, sliceEnd - chunkStart) as PackedArray<E>);
+        position = sliceEnd;
+      }
+    }
+  }
+
+  private extreme(
+    start: number,
+    end: number | undefined,
+    better: (a: any, b: any) => boolean
+  ): PackedValue<E> | null {
+    const runs = this.readRuns();
+    const [from, to] = this.clampRange(runs, start, end);
+    let best: any = null;
+    this.scan(runs, from, to, values => {
+      for (let i = 0; i < values.length; i++) {
+        if (best === null || better(values[i], best)) {
+          best = values[i];
+        }
+      }
+    });
+    return best;
+  }
+
+  // Writers only change through this invocation's own appends, so the list is read once
+  private writerIds(): Uint8Array[] {
+    const generation = invocationGeneration();
+    if (generation !== null && this.writers?.generation === generation) {
+      return this.writers.ids;
+    }
+    const ids = mapEntries(this.writersId).map(([executor]) => executor);
+    this.writers = generation === null ? null : { generation, ids };
+    return ids;
+  }
+
+  private registerWriter(executor: Uint8Array): void {
+    const ids = this.writerIds();
+    const hex = bytesToHex(executor);
+    if (!ids.some(id => bytesToHex(id) === hex)) {
+      mapInsert(this.writersId, executor, WRITER_MARK);
+      ids.push(executor);
+    }
+  }
+}
+
+registerCollectionType(
+  'PackedVector',
+  (snapshot: CollectionSnapshot) =>
+    new PackedVector({
+      id: snapshot.id,
+      element: snapshot.codecs?.element as PackedElementType,
+      chunkSize: snapshot.codecs?.chunkSize,
+    })
+);
@@ -0,0 +1,777 @@
+/**
+ * SortedMap - Ordered map with range, prefix and cursor queries.
+ *
+ * Every entry is stored under its own key, so entries merge exactly like `UnorderedMap`
+ * entries: concurrent inserts of different keys all survive and concurrent writes to one key
+ * resolve last-writer-wins. Key order comes from B+tree indexes over order-preserving key
+ * encodings (see `utils/ordered-key`) stored next to the entries, so a range query reads
+ * O(log n) index nodes per writer plus the k entries it returns.
+ *
+ * Each executor indexes the keys it inserts in its own tree (the partitioning `AppendLog` and
+ * `BloomSet` use), so writes made concurrently on different nodes never touch the same index
+ * node and every tree is still valid after a merge. Reads merge the writers' trees in key order.
+ * A key removed by another executor than the one that indexed it stays in that tree; once more
+ * than one executor has written, key reads check that the entry still exists.
+ *
+ * Layout of the backing map:
+ *   [0x00]                                   id of the writers map (executor id -> 0x01)
+ *   [0x01] ++ encoded key                    entry value
+ *   [0x02] ++ executor id                    index head: root (u32) ++ next node (u32) ++
+ *                                            keys (u64), all LE
+ *   [0x03] ++ executor id ++ node (u32 BE)   index node
+ * An index head and its nodes are only written by their executor.
+ */
+
+import { serialize, deserialize } from '../utils/serialize';
+import { codecFor, type Codec, type CodecSpec } from '../utils/abi-codec';
+import { bytesToHex, normalizeCollectionId } from '../utils/hex';
+import {
+  compareBytes,
+  decodeOrderedKey,
+  encodeOrderedKey,
+  encodeOrderedPrefix,
+  prefixUpperBound,
+  type OrderedKey,
+} from '../utils/ordered-key';
+import {
+  mapNew,
+  mapGet,
+  mapInsert,
+  mapRemove,
+  mapContains,
+  mapEntries,
+} from '../runtime/storage-wasm';
+import { invocationGeneration } from '../runtime/invocation-context';
+import {
+  registerCollectionType,
+  CollectionSnapshot,
+  hasRegisteredCollection,
+  brandCollection,
+} from '../runtime/collections';
+import { nestedTracker } from '../runtime/nested-tracking';
+import * as env from '../env/api';
+
+const HEAD_KEY = /* @__PURE__ */ Uint8Array.of(0x00);
+const ENTRY_PREFIX = 0x01;
+const INDEX_HEAD_PREFIX = 0x02;
+const NODE_PREFIX = 0x03;
+const WRITER_MARK = /* @__PURE__ */ Uint8Array.of(0x01);
+const EXECUTOR_ID_LENGTH = 32;
+const INDEX_HEAD_SIZE = 4 + 4 + 8;
+
+// Keys per index node before it splits
+const MAX_KEYS = 64;
+const MAX_KEY_LENGTH = 4096;
+
+export interface SortedMapOptions {
+  id?: Uint8Array | string;
+  /**
+   * Encodes values with plain ABI Borsh instead of the SDK value encoding.
+   * Must stay the same for the lifetime of the map.
+   */
+  valueCodec?: CodecSpec;
+}
+
+export interface SortedMapRange<K> {
+  /** Inclusive lower bound */
+  from?: K;
+  /** Exclusive upper bound */
+  to?: K;
+  /** Iterate from the largest key down */
+  reverse?: boolean;
+}
+
+interface Head {
+  executor: Uint8Array;
+  root: number;
+  nextNode: number;
+  size: number;
+}
+
+interface IndexNode {
+  leaf: boolean;
+  keys: Uint8Array[];
+  children: number[];
+}
+
+interface PathStep {
+  id: number;
+  node: IndexNode;
+  child: number;
+}
+
+function prefixed(prefix: number, bytes: Uint8Array): Uint8Array {
+  const out = new Uint8Array(bytes.length + 1);
+  out[0] = prefix;
+  out.set(bytes, 1);
+  return out;
+}
+
+function headKey(executor: Uint8Array): Uint8Array {
+  const key = new Uint8Array(1 + EXECUTOR_ID_LENGTH);
+  key[0] = INDEX_HEAD_PREFIX;
+  key.set(executor, 1);
+  return key;
+}
+
+function nodeKey(executor: Uint8Array, id: number): Uint8Array {
+  const key = new Uint8Array(5 + EXECUTOR_ID_LENGTH);
+  key[0] = NODE_PREFIX;
+  key.set(executor, 1);
+  new DataView(key.buffer).setUint32(1 + EXECUTOR_ID_LENGTH, id, false);
+  return key;
+}
+
+function encodeNode(node: IndexNode): Uint8Array {
+  let size = 3 + node.children.length * 4;
+  for (const key of node.keys) {
+    size += 2 + key.length;
+  }
+  const out = new Uint8Array(size);
+  const view = new DataView(out.buffer);
+  out[0] = node.leaf ? 0 : 1;
+  view.setUint16(1, node.keys.length, true);
+  let pos = 3;
+  for (const key of node.keys) {
+    view.setUint16(pos, key.length, true);
+    out.set(key, pos + 2);
+    pos += 2 + key.length;
+  }
+  for (const child of node.children) {
+    view.setUint32(pos, child, true);
+    pos += 4;
+  }
+  return out;
+}
+
+function decodeNode(bytes: Uint8Array): IndexNode {
+  const view = new DataView(bytes.buffer, bytes.byteOffset, bytes.byteLength);
+  const leaf = bytes[0] === 0;
+  const count = view.getUint16(1, true);
+  const keys: Uint8Array[] = [];
+  let pos = 3;
+  for (let i = 0; i < count; i++) {
+    const length = view.getUint16(pos, true);
+    keys.push(bytes.slice(pos + 2, pos + 2 + length));
+    pos += 2 + length;
+  }
+  const children: number[] = [];
+  if (!leaf) {
+    for (let i = 0; i <= count; i++) {
+      children.push(view.getUint32(pos, true));
+      pos += 4;
+    }
+  }
+  return { leaf, keys, children };
+}
+
+// Number of keys < target (strict) or <= target
+function bound(keys: Uint8Array[], target: Uint8Array, inclusive: boolean): number {
+  let low = 0;
+  let high = keys.length;
+  while (low < high) {
+    const mid = (low + high) >> 1;
+    const cmp = compareBytes(keys[mid], target);
+    if (cmp < 0 || (inclusive && cmp === 0)) {
+      low = mid + 1;
+    } else {
+      high = mid;
+    }
+  }
+  return low;
+}
+
+/**
+ * Lazy iterator over a key range. Each `next()` reads at most one index node plus the entry.
+ */
+export class SortedMapCursor<K, V> implements IterableIterator<[K, V]> {
+  constructor(private readonly source: Iterator<[K, V]>) {}
+
+  next(): IteratorResult<[K, V]> {
+    return this.source.next();
+  }
+
+  /**
+   * Reads up to `count` more entries.
+   */
+  take(count: number): Array<[K, V]> {
+    const out: Array<[K, V]> = [];
+    while (out.length < count) {
+      const step = this.source.next();
+      if (step.done) {
+        break;
+      }
+      out.push(step.value);
+    }
+    return out;
+  }
+
+  [Symbol.iterator](): IterableIterator<[K, V]> {
+    return this;
+  }
+}
+
+export class SortedMap<K extends OrderedKey, V> {
+  private readonly _calimeroMapId: Uint8Array;
+  private readonly writersId: Uint8Array;
+  private readonly valueCodec?: Codec<V>;
+  private writers: { generation: number; ids: Uint8Array[] } | null = null;
+
+  constructor(options: SortedMapOptions = {}) {
+    if (options.id) {
+      this._calimeroMapId = normalizeCollectionId(options.id, 'SortedMap');
+      const head = mapGet(this._calimeroMapId, HEAD_KEY);
+      if (!head) {
+        throw new Error('SortedMap: missing head');
+      }
+      this.writersId = head;
+    } else {
+      this._calimeroMapId = mapNew();
+      this.writersId = mapNew();
+      mapInsert(this._calimeroMapId, HEAD_KEY, this.writersId);
+    }
+
+    if (options.valueCodec) {
+      this.valueCodec = codecFor(options.valueCodec as CodecSpec<V>);
+    }
+
+    brandCollection(
+      this,
+      'SortedMap',
+      this._calimeroMapId,
+      this.valueCodec ? { value: this.valueCodec.spec } : undefined
+    );
+
+    nestedTracker.registerCollection(this);
+  }
+
+  /**
+   * Returns the identifier of this map as a hex string.
+   */
+  id(): string {
+    return bytesToHex(this._calimeroMapId);
+  }
+
+  /**
+   * Returns a copy of the identifier bytes.
+   */
+  idBytes(): Uint8Array {
+    return new Uint8Array(this._calimeroMapId);
+  }
+
+  /**
+   * Gets the value for `key` with a single host read.
+   */
+  get(key: K): V | null {
+    const raw = mapGet(this._calimeroMapId, this.entryKey(encodeOrderedKey(key)));
+    return raw ? this.decodeValue(raw) : null;
+  }
+
+  has(key: K): boolean {
+    return mapGet(this._calimeroMapId, this.entryKey(encodeOrderedKey(key))) !== null;
+  }
+
+  /**
+   * Number of entries. Reads the index head while a single executor has written; after that,
+   * counts the live keys of the merged indexes.
+   */
+  len(): number {
+    if (this.writerIds().length > 1) {
+      let count = 0;
+      const keys = this.walkKeys(null, null, false);
+      while (!keys.next().done) {
+        count++;
+      }
+      return count;
+    }
+    return this.readHeads()[0]?.size ?? 0;
+  }
+
+  /**
+   * Inserts or replaces the value for `key`. New keys are added to this executor's index.
+   */
+  set(key: K, value: V): void {
+    const encoded = this.checkedKey(key);
+    if (hasRegisteredCollection(value)) {
+      nestedTracker.registerCollection(value, this, key);
+    }
+
+    const previous = mapInsert(
+      this._calimeroMapId,
+      this.entryKey(encoded),
+      this.encodeValue(value)
+    );
+    if (previous === null) {
+      const head = this.ownHead();
+      if (this.indexInsert(head, encoded)) {
+        head.size++;
+        this.writeHead(head);
+      }
+    }
+
+    nestedTracker.notifyCollectionModified(this);
+  }
+
+  /**
+   * Removes `key`. Returns whether it was present. The key leaves this executor's index; reads
+   * skip it in the indexes of other executors that inserted it.
+   */
+  remove(key: K): boolean {
+    const encoded = encodeOrderedKey(key);
+    if (mapRemove(this._calimeroMapId, this.entryKey(encoded)) === null) {
+      return false;
+    }
+
+    const head = this.ownHead();
+    if (this.indexRemove(head, encoded)) {
+      head.size--;
+      this.writeHead(head);
+    }
+
+    nestedTracker.notifyCollectionModified(this);
+    return true;
+  }
+
+  /**
+   * Entry with the smallest key, or null when empty.
+   */
+  first(): [K, V] | null {
+    const step = this.cursor().next();
+    return step.done ? null : step.value;
+  }
+
+  /**
+   * Entry with the largest key, or null when empty.
+   */
+  last(): [K, V] | null {
+    const step = this.cursor({ reverse: true }).next();
+    return step.done ? null : step.value;
+  }
+
+  /**
+   * Entries with `from <= key < to` in key order, at most `limit` of them.
+   */
+  range(from?: K, to?: K, limit = Infinity): Array<[K, V]> {
+    return this.cursor({ from, to }).take(limit);
+  }
+
+  /**
+   * Entries whose key starts with `prefix` in key order, at most `limit` of them: string keys
+   * starting with a string, byte keys starting with bytes, or tuples starting with the given
+   * elements.
+   */
+  prefix(prefix: string | Uint8Array | OrderedKey[], limit = Infinity): Array<[K, V]> {
+    const lower = encodeOrderedPrefix(prefix);
+    return new SortedMapCursor(this.walk(lower, prefixUpperBound(lower), false)).take(limit);
+  }
+
+  /**
+   * Keys with `from <= key < to` in key order, at most `limit` of them. Reads only the index
+   * while a single executor has written, and also checks each key's entry after that.
+   */
+  rangeKeys(from?: K, to?: K, limit = Infinity): K[] {
+    const lower = from === undefined ? null : encodeOrderedKey(from);
+    const upper = to === undefined ? null : encodeOrderedKey(to);
+    return this.decodeKeys(this.walkKeys(lower, upper, false), limit);
+  }
+
+  /**
+   * Keys starting with `prefix` (see `prefix`), at most `limit` of them, read like `rangeKeys`.
+   */
+  prefixKeys(prefix: string | Uint8Array | OrderedKey[], limit = Infinity): K[] {
+    const lower = encodeOrderedPrefix(prefix);
+    return this.decodeKeys(this.walkKeys(lower, prefixUpperBound(lower), false), limit);
+  }
+
+  /**
+   * Lazily yields the keys with `from <= key < to` in key order, reading index nodes only as
+   * the iteration reaches them.
+   */
+  *iterateRangeKeys(from?: K, to?: K): Generator<K> {
+    const lower = from === undefined ? null : encodeOrderedKey(from);
+    const upper = to === undefined ? null : encodeOrderedKey(to);
+    for (const encoded of this.walkKeys(lower, upper, false)) {
+      yield decodeOrderedKey(encoded) as K;
+    }
+  }
+
+  /**
+   * Lazily yields the keys starting with `prefix` (see `prefix`), like `iterateRangeKeys`.
+   */
+  *iteratePrefixKeys(prefix: string | Uint8Array | OrderedKey[]): Generator<K> {
+    const lower = encodeOrderedPrefix(prefix);
+    for (const encoded of this.walkKeys(lower, prefixUpperBound(lower), false)) {
+      yield decodeOrderedKey(encoded) as K;
+    }
+  }
+
+  /**
+   * Lazy cursor over a key range, ascending unless `reverse` is set.
+   */
+  cursor(range: SortedMapRange<K> = {}): SortedMapCursor<K, V> {
+    const lower = range.from === undefined ? null : encodeOrderedKey(range.from);
+    const upper = range.to === undefined ? null : encodeOrderedKey(range.to);
+    return new SortedMapCursor(this.walk(lower, upper, range.reverse === true));
+  }
+
+  /**
+   * All entries in key order.
+   */
+  entries(): Array<[K, V]> {
+    return this.range();
+  }
+
+  keys(): K[] {
+    return this.entries().map(([key]) => key);
+  }
+
+  toJSON(): Record<string, unknown> {
+    return {
+      __calimeroCollection: 'SortedMap',
+      id: this.id(),
+    };
+  }
+
+  // Entries in [lower, upper); keys whose entry was removed elsewhere have no value and are skipped
+  private *walk(
+    lower: Uint8Array | null,
+    upper: Uint8Array | null,
+    reverse: boolean
+  ): Generator<[K, V]> {
+    for (const encoded of this.indexKeys(lower, upper, reverse)) {
+      const raw = mapGet(this._calimeroMapId, this.entryKey(encoded));
+      if (raw) {
+        yield [decodeOrderedKey(encoded) as K, this.decodeValue(raw)];
+      }
+    }
+  }
+
+  // Live keys in [lower, upper). A single writer's index is exact; merged indexes are checked.
+  private *walkKeys(
+    lower: Uint8Array | null,
+    upper: Uint8Array | null,
+    reverse: boolean
+  ): Generator<Uint8Array> {
+    const verify = this.writerIds().length > 1;
+    for (const encoded of this.indexKeys(lower, upper, reverse)) {
+      if (!verify || mapContains(this._calimeroMapId, this.entryKey(encoded))) {
+        yield encoded;
+      }
+    }
+  }
+
+  // Keys of all writers' indexes in [lower, upper), in order and each once
+  private *indexKeys(
+    lower: Uint8Array | null,
+    upper: Uint8Array | null,
+    reverse: boolean
+  ): Generator<Uint8Array> {
+    const streams = this.readHeads().map(head => this.treeKeys(head, lower, upper, reverse));
+    if (streams.length === 1) {
+      yield* streams[0];
+      return;
+    }
+
+    const current = streams.map(stream => stream.next());
+    for (;;) {
+      let best: Uint8Array | null = null;
+      for (const step of current) {
+        if (step.done) {
+          continue;
+        }
+        const cmp = best === null ? 0 : compareBytes(step.value, best);
+        if (best === null || (reverse ? cmp > 0 : cmp < 0)) {
+          best = step.value;
+        }
+      }
+      if (best === null) {
+        return;
+      }
+      yield best;
+      for (let i = 0; i < streams.length; i++) {
+        const step = current[i];
+        if (!step.done && compareBytes(step.value, best) === 0) {
+          current[i] = streams[i].next();
+        }
+      }
+    }
+  }
+
+  private decodeKeys(keys: Iterable<Uint8Array>, limit: number): K[] {
+    const out: K[] = [];
+    if (limit <= 0) {
+      return out;
+    }
+    for (const encoded of keys) {
+      out.push(decodeOrderedKey(encoded) as K);
+      if (out.length >= limit) {
+        break;
+      }
+    }
+    return out;
+  }
+
+  // Keys of one writer's index in [lower, upper), reading one node at a time
+  private *treeKeys(
+    head: Head,
+    lower: Uint8Array | null,
+    upper: Uint8Array | null,
+    reverse: boolean
+  ): Generator<Uint8Array> {
+    if (head.root === 0) {
+      return;
+    }
+
+    const stack: PathStep[] = [];
+    let id = head.root;
+    let node = this.readNode(head.executor, id);
+    while (!node.leaf) {
+      let child: number;
+      if (reverse) {
+        child = upper ? bound(node.keys, upper, false) : node.keys.length;
+      } else {
+        child = lower ? bound(node.keys, lower, true) : 0;
+      }
+      stack.push({ id, node, child });
+      id = node.children[child];
+      node = this.readNode(head.executor, id);
+    }
+
+    let position: number;
+    if (reverse) {
+      position = (upper ? bound(node.keys, upper, false) : node.keys.length) - 1;
+    } else {
+      position = lower ? bound(node.keys, lower, false) : 0;
+    }
+
+    for (;;) {
+      if (reverse) {
+        for (; position >= 0; position--) {
+          const key = node.keys[position];
+          if (lower && compareBytes(key, lower) < 0) {
+            return;
+          }
+          yield key;
+        }
+      } else {
+        for (; position < node.keys.length; position++) {
+          const key = node.keys[position];
+          if (upper && compareBytes(key, upper) >= 0) {
+            return;
+          }
+          yield key;
+        }
+      }
+
+      // Move to the next leaf: climb to the nearest ancestor with another child, then descend
+      let step: PathStep | undefined;
+      while ((step = stack.pop())) {
+        step.child += reverse ? -1 : 1;
+        if (step.child >= 0 && step.child < step.node.children.length) {
+          stack.push(step);
+          break;
+        }
+      }
+      if (!step) {
+        return;
+      }
+      node = this.readNode(head.executor, step.node.children[step.child]);
+      while (!node.leaf) {
+        const child = reverse ? node.children.length - 1 : 0;
+        stack.push({ id: 0, node, child });
+        node = this.readNode(head.executor, node.children[child]);
+      }
+      position = reverse ? node.keys.length - 1 : 0;
+    }
+  }
+
+  // Adds a key to a writer's index; returns false when it is already there
+  private indexInsert(head: Head, key: Uint8Array): boolean {
+    if (head.root === 0) {
+      head.root = head.nextNode++;
+      this.writeNode(head.executor, head.root, { leaf: true, keys: [key], children: [] });
+      return true;
+    }
+
+    const path: PathStep[] = [];
+    let id = head.root;
+    let node = this.readNode(head.executor, id);
+    while (!node.leaf) {
+      const child = bound(node.keys, key, true);
+      path.push({ id, node, child });
+      id = node.children[child];
+      node = this.readNode(head.executor, id);
+    }
+
+    const position = bound(node.keys, key, false);
+    if (position < node.keys.length && compareBytes(node.keys[position], key) === 0) {
+      return false;
+    }
+    node.keys.splice(position, 0, key);
+
+    // Split upwards while nodes overflow
+    while (node.keys.length > MAX_KEYS) {
+      const mid = node.keys.length >> 1;
+      const rightId = head.nextNode++;
+      let separator: Uint8Array;
+      let right: IndexNode;
+      if (node.leaf) {
+        right = { leaf: true, keys: node.keys.slice(mid), children: [] };
+        separator = right.keys[0];
+        node.keys = node.keys.slice(0, mid);
+      } else {
+        right = {
+          leaf: false,
+          keys: node.keys.slice(mid + 1),
+          children: node.children.slice(mid + 1),
+        };
+        separator = node.keys[mid];
+        node.keys = node.keys.slice(0, mid);
+        node.children = node.children.slice(0, mid + 1);
+      }
+      this.writeNode(head.executor, id, node);
+      this.writeNode(head.executor, rightId, right);
+
+      const parent = path.pop();
+      if (!parent) {
+        head.root = head.nextNode++;
+        this.writeNode(head.executor, head.root, {
+          leaf: false,
+          keys: [separator],
+          children: [id, rightId],
+        });
+        return true;
+      }
+      parent.node.keys.splice(parent.child, 0, separator);
+      parent.node.children.splice(parent.child + 1, 0, rightId);
+      id = parent.id;
+      node = parent.node;
+    }
+    this.writeNode(head.executor, id, node);
+    return true;
+  }
+
+  // Removes a key from its leaf in a writer's index; returns false when it is not there.
+  // Leaves are not merged: reads step over empty ones.
+  private indexRemove(head: Head, key: Uint8Array): boolean {
+    if (head.root === 0) {
+      return false;
+    }
+    let id = head.root;
+    let node = this.readNode(head.executor, id);
+    while (!node.leaf) {
+      id = node.children[bound(node.keys, key, true)];
+      node = this.readNode(head.executor, id);
+    }
+    const position = bound(node.keys, key, false);
+    if (position < node.keys.length && compareBytes(node.keys[position], key) === 0) {
+      node.keys.splice(position, 1);
+      this.writeNode(head.executor, id, node);
+      return true;
+    }
+    return false;
+  }
+
+  private checkedKey(key: K): Uint8Array {
+    const encoded = encodeOrderedKey(key);
+    if (encoded.length > MAX_KEY_LENGTH) {
+      throw new RangeError(`SortedMap keys must encode to at most ${MAX_KEY_LENGTH} bytes`);
+    }
+    return encoded;
+  }
+
+  private entryKey(encoded: Uint8Array): Uint8Array {
+    return prefixed(ENTRY_PREFIX, encoded);
+  }
+
+  private encodeValue(value: V): Uint8Array {
+    return this.valueCodec ? this.valueCodec.encode(value) : serialize(value);
+  }
+
+  private decodeValue(raw: Uint8Array): V {
+    return this.valueCodec ? this.valueCodec.decode(raw) : deserialize<V>(raw);
+  }
+
+  private readNode(executor: Uint8Array, id: number): IndexNode {
+    const raw = mapGet(this._calimeroMapId, nodeKey(executor, id));
+    if (!raw) {
+      throw new Error(`SortedMap: index node ${id} is missing`);
+    }
+    return decodeNode(raw);
+  }
+
+  private writeNode(executor: Uint8Array, id: number, node: IndexNode): void {
+    mapInsert(this._calimeroMapId, nodeKey(executor, id), encodeNode(node));
+  }
+
+  // Index heads of the writers, one read each
+  private readHeads(): Head[] {
+    const heads: Head[] = [];
+    for (const executor of this.writerIds()) {
+      const head = this.readHead(executor);
+      if (head) {
+        heads.push(head);
+      }
+    }
+    return heads;
+  }
+
+  private readHead(executor: Uint8Array): Head | null {
+    const raw = mapGet(this._calimeroMapId, headKey(executor));
+    if (!raw) {
+      return null;
+    }
+    if (raw.length !== INDEX_HEAD_SIZE) {
+      throw new Error('SortedMap: corrupted index head');
+    }
+    const view = new DataView(raw.buffer, raw.byteOffset, INDEX_HEAD_SIZE);
+    return {
+      executor,
+      root: view.getUint32(0, true),
+      nextNode: view.getUint32(4, true),
+      size: Number(view.getBigUint64(8, true)),
+    };
+  }
+
+  // This executor's index head, registering it as a writer
+  private ownHead(): Head {
+    const executor = env.executorId();
+    this.registerWriter(executor);
+    return this.readHead(executor) ?? { executor, root: 0, nextNode: 1, size: 0 };
+  }
+
+  private writeHead(head: Head): void {
+    const raw = new Uint8Array(INDEX_HEAD_SIZE);
+    const view = new DataView(raw.buffer);
+    view.setUint32(0, head.root, true);
+    view.setUint32(4, head.nextNode, true);
+    view.setBigUint64(8, BigInt(head.size), true);
+    mapInsert(this._calimeroMapId, headKey(head.executor), raw);
+  }
+
+  // Writers only change through this invocation's own writes, so the list is read once
+  private writerIds(): Uint8Array[] {
+    const generation = invocationGeneration();
+    if (generation !== null && this.writers?.generation === generation) {
+      return this.writers.ids;
+    }
+    const ids = mapEntries(this.writersId).map(([executor]) => executor);
+    this.writers = generation === null ? null : { generation, ids };
+    return ids;
+  }
+
+  private registerWriter(executor: Uint8Array): void {
+    const ids = this.writerIds();
+    const hex = bytesToHex(executor);
+    if (!ids.some(id => bytesToHex(id) === hex)) {
+      mapInsert(this.writersId, executor, WRITER_MARK);
+      ids.push(executor);
+    }
+  }
+}
+
+registerCollectionType(
+  'SortedMap',
+  (snapshot: CollectionSnapshot) =>
+    new SortedMap({ id: snapshot.id, valueCodec: snapshot.codecs?.value })
+);
@@ -1,15 +1,25 @@
 /**
  * UnorderedMap - backed by the Rust `JsUnorderedMap` CRDT via storage-wasm.
- * Keys and values are serialized using the SDK's JSON-based serialization.
+ * Keys and values are serialized using the SDK's JSON-based serialization, or with plain ABI
+ * Borsh when typed codecs are declared. Values can be compressed, and with a `largeValues` policy
+ * values above the threshold live in blobs and the map stores a reference to them.
  */
 
 import { serialize, deserialize } from '../utils/serialize';
+import { codecFor, type Codec, type CodecSpec } from '../utils/abi-codec';
 import { bytesToHex, normalizeCollectionId } from '../utils/hex';
+import {
+  compressValue,
+  decompressValue,
+  validateCompressionCodec,
+  type CompressionCodec,
+} from '../utils/compression';
 import * as env from '../env/api';
 import {
   mapNew,
   mapGet,
   mapInsert,
+  mapMergeInsert,
   mapRemove,
   mapContains,
   mapEntries,
@@ -18,10 +28,17 @@ import {
   registerCollectionType,
   CollectionSnapshot,
   hasRegisteredCollection,
+  brandCollection,
 } from '../runtime/collections';
 import { mergeMergeableValues } from '../runtime/mergeable';
 import { getMergeableType } from '../runtime/mergeable-registry';
 import { nestedTracker } from '../runtime/nested-tracking';
+import {
+  packLargeValue,
+  unpackLargeValue,
+  validateLargeValueThreshold,
+  type LargeValuePolicy,
+} from '../runtime/large-values';
 
 const SENTINEL_KEY = '__calimeroCollection';
 
@@ -30,21 +47,46 @@ export interface UnorderedMapOptions {
    * Existing map identifier as a 32-byte Uint8Array or 64-character hex string.
    */
   id?: Uint8Array | string;
+  /**
+   * Encodes keys with plain ABI Borsh (e.g. `'string'`, `{ kind: 'u64' }`) instead of the
+   * SDK value encoding. Must stay the same for the lifetime of the map.
+   */
+  keyCodec?: CodecSpec;
+  /**
+   * Encodes values with plain ABI Borsh; see `keyCodec`.
+   */
+  valueCodec?: CodecSpec;
+  /**
+   * Compresses encoded values (`'lz4'`); values that do not shrink are stored as is. Part of the
+   * stored format: must stay the same for the lifetime of the map.
+   */
+  compression?: CompressionCodec;
+  /**
+   * Stores encoded values longer than `threshold` bytes in blobs, keeping a 69-byte reference
+   * in the map; they are fetched when read. Like codecs, this is part of the stored format and
+   * must stay the same for the lifetime of the map. `remove()` and overwrites only drop the
+   * reference: the host has no blob deletion, so the blob itself stays in the node's blob store.
+   */
+  largeValues?: LargeValuePolicy;
 }
 
 export class UnorderedMap<K, V> {
-  private readonly mapId: Uint8Array;
+  private readonly _calimeroMapId: Uint8Array;
+  private readonly keyCodec?: Codec<K>;
+  private readonly valueCodec?: Codec<V>;
+  private readonly compression?: CompressionCodec;
+  private readonly largeValueThreshold?: number;
 
   constructor(options: UnorderedMapOptions = {}) {
     if (options.id) {
-      this.mapId = normalizeCollectionId(options.id, 'Map');
+      this._calimeroMapId = normalizeCollectionId(options.id, 'Map');
     } else {
       try {
-        this.mapId = mapNew();
+        this._calimeroMapId = mapNew();
       } catch (error) {
         const message = `[collections::UnorderedMap] mapNew failed: ${error instanceof Error ? error.message : String(error)}`;
         try {
-          env.log(message);
+          env.logError(message);
         } catch {
           if (typeof console !== 'undefined' && typeof console.error === 'function') {
             console.error(message);
@@ -54,43 +96,119 @@ export class UnorderedMap<K, V> {
       }
     }
 
+    if (options.keyCodec) {
+      this.keyCodec = codecFor(options.keyCodec as CodecSpec<K>);
+    }
+    if (options.valueCodec) {
+      this.valueCodec = codecFor(options.valueCodec as CodecSpec<V>);
+    }
+    if (options.compression) {
+      this.compression = validateCompressionCodec(options.compression);
+    }
+    if (options.largeValues) {
+      this.largeValueThreshold = validateLargeValueThreshold(options.largeValues.threshold);
+    }
+
+    brandCollection(
+      this,
+      'UnorderedMap',
+      this._calimeroMapId,
+      this.keyCodec || this.valueCodec || this.compression || this.largeValueThreshold !== undefined
+        ? {
+            key: this.keyCodec?.spec,
+            value: this.valueCodec?.spec,
+            compression: this.compression,
+            largeValues: this.largeValueThreshold,
+          }
+        : undefined
+    );
+
     // Register with nested tracker for automatic change propagation
     nestedTracker.registerCollection(this);
   }
 
-  static fromId<K, V>(id: Uint8Array | string): UnorderedMap<K, V> {
-    return new UnorderedMap<K, V>({ id });
+  static fromId<K, V>(
+    id: Uint8Array | string,
+    options: Omit<UnorderedMapOptions, 'id'> = {}
+  ): UnorderedMap<K, V> {
+    return new UnorderedMap<K, V>({ ...options, id });
   }
 
   /**
    * Returns the underlying map identifier as a hex string.
    */
   id(): string {
-    return bytesToHex(this.mapId);
+    return bytesToHex(this._calimeroMapId);
   }
 
   /**
    * Returns a copy of the map identifier bytes.
    */
   idBytes(): Uint8Array {
-    return new Uint8Array(this.mapId);
+    return new Uint8Array(this._calimeroMapId);
+  }
+
+  private encodeKey(key: K): Uint8Array {
+    return this.keyCodec ? this.keyCodec.encode(key) : serialize(key);
+  }
+
+  private decodeKey(bytes: Uint8Array): K {
+    return this.keyCodec ? this.keyCodec.decode(bytes) : deserialize<K>(bytes);
+  }
+
+  private encodeValue(value: V): Uint8Array {
+    return this.valueCodec ? this.valueCodec.encode(value) : serialize(value);
+  }
+
+  private decodeValue(bytes: Uint8Array): V {
+    return this.valueCodec ? this.valueCodec.decode(bytes) : deserialize<V>(bytes);
+  }
+
+  /**
+   * Bytes to store for `value`; `current` is the entry's stored bytes when known.
+   */
+  private storeValue(value: V, current: Uint8Array | null = null): Uint8Array {
+    let bytes = this.encodeValue(value);
+    if (this.compression) {
+      bytes = compressValue(bytes, this.compression);
+    }
+    return this.largeValueThreshold === undefined
+      ? bytes
+      : packLargeValue(bytes, this.largeValueThreshold, current);
+  }
+
+  private loadValue(stored: Uint8Array): V {
+    let bytes = this.largeValueThreshold === undefined ? stored : unpackLargeValue(stored);
+    if (this.compression) {
+      bytes = decompressValue(bytes);
+    }
+    return this.decodeValue(bytes);
   }
 
   set(key: K, value: V): void {
-    const keyBytes = serialize(key);
+    const keyBytes = this.encodeKey(key);
     let nextValue = value;
 
-    const mergeableType = getMergeableType(value);
-    if (mergeableType) {
-      const current = this.get(key);
-      if (current) {
-        nextValue = mergeMergeableValues(current, value);
-      }
+    if (getMergeableType(value)) {
+      // Merge against the stored bytes in the same crossing as the write; the decoded
+      // current value is owned by us, so the merge does not need to clone it.
+      mapMergeInsert(this._calimeroMapId, keyBytes, currentBytes => {
+        const current = currentBytes ? this.loadValue(currentBytes) : null;
+        if (current) {
+          nextValue = mergeMergeableValues(current, value, { ownsLocal: true });
+        }
+        return this.storeValue(nextValue, currentBytes);
+      });
+    } else if (this.largeValueThreshold !== undefined) {
+      // The current reference comes back in the same crossing, so an unchanged large value
+      // reuses its blob instead of being uploaded again
+      mapMergeInsert(this._calimeroMapId, keyBytes, currentBytes =>
+        this.storeValue(value, currentBytes)
+      );
+    } else {
+      mapInsert(this._calimeroMapId, keyBytes, this.storeValue(nextValue));
     }
 
-    const valueBytes = serialize(nextValue);
-    mapInsert(this.mapId, keyBytes, valueBytes);
-
     // Register nested collections for automatic tracking after storage
     if (hasRegisteredCollection(nextValue)) {
       nestedTracker.registerCollection(nextValue, this, key);
@@ -101,34 +219,32 @@ export class UnorderedMap<K, V> {
   }
 
   get(key: K): V | null {
-    const keyBytes = serialize(key);
-    const raw = mapGet(this.mapId, keyBytes);
-    return raw ? deserialize<V>(raw) : null;
+    const raw = mapGet(this._calimeroMapId, this.encodeKey(key));
+    return raw ? this.loadValue(raw) : null;
   }
 
   has(key: K): boolean {
-    const keyBytes = serialize(key);
-    return mapContains(this.mapId, keyBytes);
+    return mapContains(this._calimeroMapId, this.encodeKey(key));
   }
 
   remove(key: K): void {
-    const keyBytes = serialize(key);
-    mapRemove(this.mapId, keyBytes);
+    mapRemove(this._calimeroMapId, this.encodeKey(key));
 
     // Notify tracker of modification
     nestedTracker.notifyCollectionModified(this);
   }
 
   entries(): Array<[K, V]> {
-    const serializedEntries = mapEntries(this.mapId);
+    const serializedEntries = mapEntries(this._calimeroMapId);
     return serializedEntries.map(([keyBytes, valueBytes]) => [
-      deserialize<K>(keyBytes),
-      deserialize<V>(valueBytes),
+      this.decodeKey(keyBytes),
+      this.loadValue(valueBytes),
     ]);
   }
 
   keys(): K[] {
-    return this.entries().map(([key]) => key);
+    // Only the keys are decoded, so large values are not fetched
+    return mapEntries(this._calimeroMapId).map(([keyBytes]) => this.decodeKey(keyBytes));
   }
 
   values(): V[] {
@@ -144,5 +260,13 @@ export class UnorderedMap<K, V> {
 }
 
 registerCollectionType('UnorderedMap', (snapshot: CollectionSnapshot) =>
-  UnorderedMap.fromId(snapshot.id)
+  UnorderedMap.fromId(snapshot.id, {
+    keyCodec: snapshot.codecs?.key,
+    valueCodec: snapshot.codecs?.value,
+    compression: snapshot.codecs?.compression,
+    largeValues:
+      snapshot.codecs?.largeValues !== undefined
+        ? { threshold: snapshot.codecs.largeValues }
+        : undefined,
+  })
 );
@@ -3,11 +3,13 @@
  */
 
 import { serialize, deserialize } from '../utils/serialize';
+import { codecFor, type Codec, type CodecSpec } from '../utils/abi-codec';
 import { bytesToHex, normalizeCollectionId } from '../utils/hex';
 import {
   registerCollectionType,
   CollectionSnapshot,
   hasRegisteredCollection,
+  brandCollection,
 } from '../runtime/collections';
 import {
   setNew,
@@ -23,18 +25,35 @@ import { nestedTracker } from '../runtime/nested-tracking';
 export interface UnorderedSetOptions<T> {
   id?: Uint8Array | string;
   initialValues?: T[];
+  /**
+   * Encodes members with plain ABI Borsh (e.g. `'string'`) instead of the SDK value encoding.
+   * Must stay the same for the lifetime of the set.
+   */
+  valueCodec?: CodecSpec;
 }
 
 export class UnorderedSet<T> {
-  private readonly setId: Uint8Array;
+  private readonly _calimeroSetId: Uint8Array;
+  private readonly valueCodec?: Codec<T>;
 
   constructor(options: UnorderedSetOptions<T> = {}) {
     if (options.id) {
-      this.setId = normalizeCollectionId(options.id, 'UnorderedSet');
+      this._calimeroSetId = normalizeCollectionId(options.id, 'UnorderedSet');
     } else {
-      this.setId = setNew();
+      this._calimeroSetId = setNew();
     }
 
+    if (options.valueCodec) {
+      this.valueCodec = codecFor(options.valueCodec as CodecSpec<T>);
+    }
+
+    brandCollection(
+      this,
+      'UnorderedSet',
+      this._calimeroSetId,
+      this.valueCodec ? { value: this.valueCodec.spec } : undefined
+    );
+
     // Register with nested tracker for automatic change propagation
     nestedTracker.registerCollection(this);
 
@@ -46,11 +65,15 @@ export class UnorderedSet<T> {
   }
 
   id(): string {
-    return bytesToHex(this.setId);
+    return bytesToHex(this._calimeroSetId);
   }
 
   idBytes(): Uint8Array {
-    return new Uint8Array(this.setId);
+    return new Uint8Array(this._calimeroSetId);
+  }
+
+  private encodeValue(value: T): Uint8Array {
+    return this.valueCodec ? this.valueCodec.encode(value) : serialize(value);
   }
 
   add(value: T): boolean {
@@ -59,7 +82,7 @@ export class UnorderedSet<T> {
       nestedTracker.registerCollection(value, this, value);
     }
 
-    const result = setInsert(this.setId, serialize(value));
+    const result = setInsert(this._calimeroSetId, this.encodeValue(value));
 
     // Notify tracker of modification
     nestedTracker.notifyCollectionModified(this);
@@ -68,11 +91,11 @@ export class UnorderedSet<T> {
   }
 
   has(value: T): boolean {
-    return setContains(this.setId, serialize(value));
+    return setContains(this._calimeroSetId, this.encodeValue(value));
   }
 
   delete(value: T): boolean {
-    const result = setRemove(this.setId, serialize(value));
+    const result = setRemove(this._calimeroSetId, this.encodeValue(value));
 
     // Notify tracker of modification
     nestedTracker.notifyCollectionModified(this);
@@ -81,19 +104,21 @@ export class UnorderedSet<T> {
   }
 
   clear(): void {
-    setClear(this.setId);
+    setClear(this._calimeroSetId);
 
     // Notify tracker of modification
     nestedTracker.notifyCollectionModified(this);
   }
 
   size(): number {
-    return setLen(this.setId);
+    return setLen(this._calimeroSetId);
   }
 
   toArray(): T[] {
-    const rawValues = setValues(this.setId);
-    return rawValues.map(bytes => deserialize<T>(bytes));
+    const rawValues = setValues(this._calimeroSetId);
+    return rawValues.map(bytes =>
+      this.valueCodec ? this.valueCodec.decode(bytes) : deserialize<T>(bytes)
+    );
   }
 
   toJSON(): Record<string, unknown> {
@@ -106,5 +131,6 @@ export class UnorderedSet<T> {
 
 registerCollectionType(
   'UnorderedSet',
-  (snapshot: CollectionSnapshot) => new UnorderedSet({ id: snapshot.id })
+  (snapshot: CollectionSnapshot) =>
+    new UnorderedSet({ id: snapshot.id, valueCodec: snapshot.codecs?.value })
 );
@@ -33,6 +33,7 @@ import {
   registerCollectionType,
   CollectionSnapshot,
   hasRegisteredCollection,
+  brandCollection,
 } from '../runtime/collections';
 import { mergeMergeableValues } from '../runtime/mergeable';
 import { getMergeableType } from '../runtime/mergeable-registry';
@@ -82,17 +83,19 @@ export interface UserStorageOptions {
  * ```
  */
 export class UserStorage<V> {
-  private readonly mapId: Uint8Array;
+  private readonly _calimeroMapId: Uint8Array;
 
   constructor(options: UserStorageOptions = {}) {
     if (options.id) {
-      this.mapId = normalizeCollectionId(options.id, 'UserStorage');
+      this._calimeroMapId = normalizeCollectionId(options.id, 'UserStorage');
     } else {
       // userStorageNew() will throw an error if it fails (via decodeError)
       // No need for try-catch - let the error propagate naturally
-      this.mapId = userStorageNew();
+      this._calimeroMapId = userStorageNew();
     }
 
+    brandCollection(this, 'UserStorage', this._calimeroMapId);
+
     // Register with nested tracker for automatic change propagation
     nestedTracker.registerCollection(this);
   }
@@ -105,14 +108,14 @@ export class UserStorage<V> {
    * Returns the underlying storage identifier as a hex string.
    */
   id(): string {
-    return bytesToHex(this.mapId);
+    return bytesToHex(this._calimeroMapId);
   }
 
   /**
    * Returns a copy of the storage identifier bytes.
    */
   idBytes(): Uint8Array {
-    return new Uint8Array(this.mapId);
+    return new Uint8Array(this._calimeroMapId);
   }
 
   /**
@@ -126,7 +129,7 @@ export class UserStorage<V> {
    */
   insert(value: V): V | null {
     const executorKey = env.executorId();
-    return this.setInternal(executorKey, value);
+    return this._calimeroSetInternal(executorKey, value);
   }
 
   /**
@@ -135,7 +138,7 @@ export class UserStorage<V> {
    * @returns The current user's stored value, or null if not found
    */
   get(): V | null {
-    const raw = userStorageGet(this.mapId);
+    const raw = userStorageGet(this._calimeroMapId);
     if (!raw) return null;
 
     const executorKey = env.executorId();
@@ -157,7 +160,7 @@ export class UserStorage<V> {
    */
   getForUser(userKey: PublicKey): V | null {
     validatePublicKey(userKey, 'getForUser');
-    const raw = userStorageGetForUser(this.mapId, userKey);
+    const raw = userStorageGetForUser(this._calimeroMapId, userKey);
     if (!raw) return null;
 
     const value = deserialize<V>(raw);
@@ -178,7 +181,7 @@ export class UserStorage<V> {
    * @returns true if the current user has stored data
    */
   containsCurrentUser(): boolean {
-    return userStorageContains(this.mapId);
+    return userStorageContains(this._calimeroMapId);
   }
 
   /**
@@ -189,7 +192,7 @@ export class UserStorage<V> {
    */
   containsUser(userKey: PublicKey): boolean {
     validatePublicKey(userKey, 'containsUser');
-    return userStorageContainsUser(this.mapId, userKey);
+    return userStorageContainsUser(this._calimeroMapId, userKey);
   }
 
   /**
@@ -206,7 +209,7 @@ export class UserStorage<V> {
    * @throws Error if userKey does not match the current executor
    */
   setForUser(userKey: PublicKey, value: V): V | null {
-    return this.setInternal(userKey, value);
+    return this._calimeroSetInternal(userKey, value);
   }
 
   /**
@@ -215,7 +218,7 @@ export class UserStorage<V> {
    * @returns The previous value if it existed, null otherwise
    */
   remove(): V | null {
-    const raw = userStorageRemove(this.mapId);
+    const raw = userStorageRemove(this._calimeroMapId);
     nestedTracker.notifyCollectionModified(this);
     return raw ? deserialize<V>(raw) : null;
   }
@@ -224,7 +227,7 @@ export class UserStorage<V> {
    * Returns all entries as an array of [PublicKey, Value] tuples.
    */
   entries(): Array<[PublicKey, V]> {
-    const serializedEntries = mapEntries(this.mapId);
+    const serializedEntries = mapEntries(this._calimeroMapId);
     return serializedEntries.map(([keyBytes, valueBytes]) => [
       deserialize<PublicKey>(keyBytes),
       deserialize<V>(valueBytes),
@@ -259,7 +262,7 @@ export class UserStorage<V> {
     };
   }
 
-  private setInternal(key: PublicKey, value: V): V | null {
+  private _calimeroSetInternal(key: PublicKey, value: V): V | null {
     validatePublicKey(key, 'insert');
     const executorKey = env.executorId();
 
@@ -280,7 +283,7 @@ export class UserStorage<V> {
     }
 
     const valueBytes = serialize(nextValue);
-    const previous = userStorageInsert(this.mapId, valueBytes);
+    const previous = userStorageInsert(this._calimeroMapId, valueBytes);
 
     // Register nested collections for automatic tracking after storage
     if (hasRegisteredCollection(nextValue)) {
@@ -3,29 +3,64 @@
  */
 
 import { serialize, deserialize } from '../utils/serialize';
+import { codecFor, type Codec, type CodecSpec } from '../utils/abi-codec';
 import { bytesToHex, normalizeCollectionId } from '../utils/hex';
+import {
+  compressValue,
+  decompressValue,
+  validateCompressionCodec,
+  type CompressionCodec,
+} from '../utils/compression';
 import { vectorNew, vectorLen, vectorPush, vectorGet, vectorPop } from '../runtime/storage-wasm';
 import {
   registerCollectionType,
   CollectionSnapshot,
   hasRegisteredCollection,
+  brandCollection,
 } from '../runtime/collections';
 import { nestedTracker } from '../runtime/nested-tracking';
 
 export interface VectorOptions {
   id?: Uint8Array | string;
+  /**
+   * Encodes elements with plain ABI Borsh (e.g. `'string'`) instead of the SDK value encoding.
+   * Must stay the same for the lifetime of the vector.
+   */
+  valueCodec?: CodecSpec;
+  /**
+   * Compresses encoded elements (`'lz4'`). Must stay the same for the lifetime of the vector.
+   */
+  compression?: CompressionCodec;
 }
 
 export class Vector<T> {
-  private readonly vectorId: Uint8Array;
+  private readonly _calimeroVectorId: Uint8Array;
+  private readonly valueCodec?: Codec<T>;
+  private readonly compression?: CompressionCodec;
 
   constructor(options: VectorOptions = {}) {
     if (options.id) {
-      this.vectorId = normalizeCollectionId(options.id, 'Vector');
+      this._calimeroVectorId = normalizeCollectionId(options.id, 'Vector');
     } else {
-      this.vectorId = vectorNew();
+      this._calimeroVectorId = vectorNew();
     }
 
+    if (options.valueCodec) {
+      this.valueCodec = codecFor(options.valueCodec as CodecSpec<T>);
+    }
+    if (options.compression) {
+      this.compression = validateCompressionCodec(options.compression);
+    }
+
+    brandCollection(
+      this,
+      'Vector',
+      this._calimeroVectorId,
+      this.valueCodec || this.compression
+        ? { value: this.valueCodec?.spec, compression: this.compression }
+        : undefined
+    );
+
     // Register with nested tracker for automatic change propagation
     nestedTracker.registerCollection(this);
   }
@@ -45,14 +80,24 @@ export class Vector<T> {
    * Returns the identifier of this vector as a hex string.
    */
   id(): string {
-    return bytesToHex(this.vectorId);
+    return bytesToHex(this._calimeroVectorId);
   }
 
   /**
    * Returns a copy of the identifier bytes.
    */
   idBytes(): Uint8Array {
-    return new Uint8Array(this.vectorId);
+    return new Uint8Array(this._calimeroVectorId);
+  }
+
+  private encodeValue(value: T): Uint8Array {
+    const bytes = this.valueCodec ? this.valueCodec.encode(value) : serialize(value);
+    return this.compression ? compressValue(bytes, this.compression) : bytes;
+  }
+
+  private decodeValue(stored: Uint8Array): T {
+    const bytes = this.compression ? decompressValue(stored) : stored;
+    return this.valueCodec ? this.valueCodec.decode(bytes) : deserialize<T>(bytes);
   }
 
   /**
@@ -64,7 +109,7 @@ export class Vector<T> {
       nestedTracker.registerCollection(value, this, this.len());
     }
 
-    vectorPush(this.vectorId, serialize(value));
+    vectorPush(this._calimeroVectorId, this.encodeValue(value));
 
     // Notify tracker of modification
     nestedTracker.notifyCollectionModified(this);
@@ -74,39 +119,39 @@ export class Vector<T> {
    * Gets the value at the given index.
    */
   get(index: number): T | null {
-    const raw = vectorGet(this.vectorId, index, 0n);
-    return raw ? deserialize<T>(raw) : null;
+    const raw = vectorGet(this._calimeroVectorId, index, 0n);
+    return raw ? this.decodeValue(raw) : null;
   }
 
   /**
    * Gets the length of the vector.
    */
   len(): number {
-    return vectorLen(this.vectorId);
+    return vectorLen(this._calimeroVectorId);
   }
 
   /**
    * Removes and returns the last element.
    */
   pop(): T | null {
-    const raw = vectorPop(this.vectorId);
+    const raw = vectorPop(this._calimeroVectorId);
 
     // Notify tracker of modification
     nestedTracker.notifyCollectionModified(this);
 
-    return raw ? deserialize<T>(raw) : null;
+    return raw ? this.decodeValue(raw) : null;
   }
 
   /**
    * Reads the entire vector into a JavaScript array.
    */
   toArray(): T[] {
-    const length = vectorLen(this.vectorId);
+    const length = vectorLen(this._calimeroVectorId);
     const values: T[] = [];
     for (let index = 0; index < length; index++) {
-      const raw = vectorGet(this.vectorId, index, 0n);
+      const raw = vectorGet(this._calimeroVectorId, index, 0n);
       if (raw) {
-        values.push(deserialize<T>(raw));
+        values.push(this.decodeValue(raw));
       }
     }
     return values;
@@ -120,4 +165,12 @@ export class Vector<T> {
   }
 }
 
-registerCollectionType('Vector', (snapshot: CollectionSnapshot) => new Vector({ id: snapshot.id }));
+registerCollectionType(
+  'Vector',
+  (snapshot: CollectionSnapshot) =>
+    new Vector({
+      id: snapshot.id,
+      valueCodec: snapshot.codecs?.value,
+      compression: snapshot.codecs?.compression,
+    })
+);
@@ -4,9 +4,31 @@
  * Conflict-free Replicated Data Types for distributed state management
  */
 
-export { UnorderedMap } from './UnorderedMap';
+export { UnorderedMap, type UnorderedMapOptions } from './UnorderedMap';
+export type { LargeValuePolicy } from '../runtime/large-values';
 export { UnorderedSet } from './UnorderedSet';
+export { BloomSet, type BloomSetOptions, type BloomSetParameters } from './BloomSet';
 export { Vector } from './Vector';
+export {
+  PackedVector,
+  type PackedVectorOptions,
+  type PackedElementType,
+  type PackedArray,
+  type PackedValue,
+} from './PackedVector';
+export { AppendLog, type AppendLogOptions, type AppendLogEntry } from './AppendLog';
+export {
+  SortedMap,
+  SortedMapCursor,
+  type SortedMapOptions,
+  type SortedMapRange,
+} from './SortedMap';
+export type { OrderedKey } from '../utils/ordered-key';
+export {
+  IndexedMap,
+  type IndexedMapOptions,
+  type IndexTerm,
+} from './IndexedMap';
 export { Counter } from './Counter';
 export { LwwRegister } from './LwwRegister';
 
@@ -10,6 +10,11 @@ export interface MergeableOptions {
    * Override the type identifier recorded for this class. Defaults to the constructor name.
    */
   type?: string;
+  /**
+   * Fields merged by the default field-wise merge. Defaults to the record fields the build
+   * emitted into the ABI for this class; undeclared keys are still merged, just after these.
+   */
+  fields?: string[];
 }
 
 /**
@@ -28,6 +33,8 @@ export function Mergeable(options: MergeableOptions = {}) {
     registerMergeableType(ctor as any, {
       type: typeName,
       merge: options.merge,
+      fields: options.fields,
+      className: ctor.name,
     });
   };
 }
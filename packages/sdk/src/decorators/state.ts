@@ -11,14 +11,41 @@
  * export class MyApp {
  *   items: UnorderedMap<string, string> = new UnorderedMap();
  * }
+ *
+ * // Compress the persisted root document
+ * @State({ compression: 'lz4' })
+ * export class LargeApp {}
  * ```
  */
 import { StateManager } from '../runtime/state-manager';
+import { validateCompressionCodec, type CompressionCodec } from '../utils/compression';
+
+export interface StateOptions {
+  /**
+   * Compresses the persisted root document. Previously stored uncompressed state still loads,
+   * and is rewritten compressed on the next save.
+   */
+  compression?: CompressionCodec;
+}
 
-export function State<T extends new (...args: any[]) => any>(target: T): T {
+type StateClass = new (...args: any[]) => any;
+
+function markState<T extends StateClass>(target: T, options: StateOptions): T {
   // Mark as state class
   (target as any)._calimeroState = true;
-  StateManager.setStateClass(target);
+  StateManager.setStateClass(target, {
+    compression: options.compression ? validateCompressionCodec(options.compression) : 'none',
+  });
 
   return target;
 }
+
+export function State<T extends StateClass>(target: T): T;
+export function State(options: StateOptions): <T extends StateClass>(target: T) => T;
+export function State(targetOrOptions: StateClass | StateOptions): any {
+  if (typeof targetOrOptions === 'function') {
+    return markState(targetOrOptions, {});
+  }
+  const options = targetOrOptions ?? {};
+  return <T extends StateClass>(target: T): T => markState(target, options);
+}
@@ -11,14 +11,22 @@ import { bytesToHex } from '../utils/hex';
 import type { HostEnv } from './bindings';
 import { getAbiManifest, getMethod } from '../abi/helpers';
 import type { TypeRef, AbiManifest, ScalarType, Variant } from '../abi/types';
-import { BorshReader } from '../borsh/decoder';
 import { safeJsonStringify } from '../utils/safe-json';
+import { enqueueXCall, enqueueXCalls } from '../runtime/xcall-batch';
+import {
+  currentInvocationContext,
+  fetchContextId,
+  fetchExecutorId,
+  fetchTimeNow,
+  memoizedEncoding,
+} from '../runtime/invocation-context';
+import { areMembers, cachedMembers, isMember } from '../runtime/membership';
 
 // This will be provided by QuickJS runtime via builder.c
 declare const env: HostEnv;
 
 const REGISTER_ID = 0n;
-const textEncoder = new TextEncoder();
+const textEncoder = /* @__PURE__ */ new TextEncoder();
 
 export function registerLen(register: bigint = REGISTER_ID): bigint {
   return env.register_len(register);
@@ -328,7 +336,18 @@ export function valueReturn(value: unknown, methodName?: string): void {
 }
 
 /**
- * Logs a message to the runtime
+ * Returns raw bytes to the caller, bypassing the ABI-driven JSON conversion of `valueReturn`.
+ * Used by SDK-internal entry points that have no ABI method (e.g. sync).
+ */
+export function valueReturnBytes(value: Uint8Array): void {
+  env.value_return(value);
+}
+
+/**
+ * Logs a message to the runtime at info level
+ *
+ * Like `logInfo`: dropped below the active level, and removed from the bundle when the build's
+ * `--log-level` is above info.
  *
  * @param message - Message to log
  *
@@ -339,33 +358,156 @@ export function valueReturn(value: unknown, methodName?: string): void {
  * ```
  */
 export function log(message: string): void {
+  logAt(LogLevel.Info, message);
+}
+
+function writeLog(message: string): void {
+  if (typeof env.log_append === 'function') {
+    env.log_append(message);
+    return;
+  }
   env.log_utf8(textEncoder.encode(message));
 }
 
+/**
+ * Log levels, lowest first. Messages below the active level are dropped.
+ */
+export enum LogLevel {
+  Debug = 0,
+  Info = 1,
+  Warn = 2,
+  Error = 3,
+  Silent = 4,
+}
+
+export type LogLevelName = 'debug' | 'info' | 'warn' | 'error' | 'silent';
+
+/**
+ * A log message, or a thunk producing it. Thunks are only invoked when the
+ * level is enabled, so expensive templates cost nothing when disabled.
+ */
+export type LogMessage = string | (() => string);
+
+const LOG_LEVEL_NAMES: Record<LogLevelName, LogLevel> = {
+  debug: LogLevel.Debug,
+  info: LogLevel.Info,
+  warn: LogLevel.Warn,
+  error: LogLevel.Error,
+  silent: LogLevel.Silent,
+};
+
+let activeLogLevel: LogLevel | null = null;
+
+function parseLogLevel(value: unknown): LogLevel | null {
+  if (typeof value === 'number' && value >= LogLevel.Debug && value <= LogLevel.Silent) {
+    return value as LogLevel;
+  }
+  if (typeof value === 'string') {
+    return LOG_LEVEL_NAMES[value.toLowerCase() as LogLevelName] ?? null;
+  }
+  return null;
+}
+
+/**
+ * Resolves the initial level once: build option (`--log-level`, injected as
+ * `__CALIMERO_LOG_LEVEL__`), then ABI `metadata.log_level`, then debug.
+ */
+function resolveLogLevel(): LogLevel {
+  if (activeLogLevel === null) {
+    activeLogLevel =
+      parseLogLevel((globalThis as any).__CALIMERO_LOG_LEVEL__) ??
+      parseLogLevel(getAbiManifest()?.metadata?.log_level) ??
+      LogLevel.Debug;
+  }
+  return activeLogLevel;
+}
+
+/**
+ * Overrides the active log level for the rest of the invocation
+ *
+ * @example
+ * ```typescript
+ * env.setLogLevel('warn');
+ * ```
+ */
+export function setLogLevel(level: LogLevel | LogLevelName): void {
+  const parsed = parseLogLevel(level);
+  if (parsed === null) {
+    throw new Error(`Unknown log level: ${String(level)}`);
+  }
+  activeLogLevel = parsed;
+}
+
+export function getLogLevel(): LogLevel {
+  return resolveLogLevel();
+}
+
+export function isLogEnabled(level: LogLevel): boolean {
+  return level < LogLevel.Silent && level >= resolveLogLevel();
+}
+
+/**
+ * Logs a message at the given level
+ *
+ * @example
+ * ```typescript
+ * env.logAt(env.LogLevel.Info, () => `Processed ${items.length} items`);
+ * ```
+ */
+export function logAt(level: LogLevel, message: LogMessage): void {
+  if (!isLogEnabled(level)) {
+    return;
+  }
+  writeLog(typeof message === 'function' ? message() : message);
+}
+
+/**
+ * Leveled logging helpers. Pass a thunk for messages that are costly to build;
+ * calls below the build's `--log-level` are removed from the bundle entirely.
+ *
+ * @example
+ * ```typescript
+ * env.logDebug(() => `state: ${JSON.stringify(state)}`);
+ * ```
+ */
+export function logDebug(message: LogMessage): void {
+  logAt(LogLevel.Debug, message);
+}
+
+export function logInfo(message: LogMessage): void {
+  logAt(LogLevel.Info, message);
+}
+
+export function logWarn(message: LogMessage): void {
+  logAt(LogLevel.Warn, message);
+}
+
+export function logError(message: LogMessage): void {
+  logAt(LogLevel.Error, message);
+}
+
 /**
  * Gets the current context ID
  *
- * @returns 32-byte context ID
+ * Within a method this reads the per-invocation context record instead of the host.
+ *
+ * @returns 32-byte context ID (a fresh copy)
  */
 export function contextId(): Uint8Array {
-  env.context_id(REGISTER_ID);
-  const len = Number(env.register_len(REGISTER_ID));
-  const buf = new Uint8Array(len);
-  env.read_register(REGISTER_ID, buf);
-  return buf;
+  const ctx = currentInvocationContext();
+  return ctx ? ctx.contextId.slice() : fetchContextId();
 }
 
 /**
  * Gets the current executor ID
  *
- * @returns 32-byte executor ID
+ * Within a method this reads the per-invocation context record instead of the host.
+ *
+ * @returns 32-byte executor ID (a fresh copy)
  */
 export function executorId(): Uint8Array {
-  env.executor_id(REGISTER_ID);
-  const len = Number(env.register_len(REGISTER_ID));
-  const buf = new Uint8Array(len);
-  env.read_register(REGISTER_ID, buf);
-  return buf;
+  const ctx = currentInvocationContext();
+  return ctx ? ctx.executorId.slice() : fetchExecutorId();
 }
 
 /**
@@ -420,7 +562,8 @@ export function contextRemoveMember(publicKey: Uint8Array): void {
 
 /**
  * Checks if a public key is a member of the current context.
- * This is a synchronous read operation that queries the committed local state.
+ * This is a synchronous read operation that queries the committed local state; within a method
+ * results are cached, and after a few distinct checks the member list is loaded once.
  *
  * @param publicKey - 32-byte Ed25519 public key to check
  * @returns true if the public key is a member, false otherwise
@@ -444,12 +587,13 @@ export function contextIsMember(publicKey: Uint8Array): boolean {
   if (publicKey.length !== 32) {
     throw new RangeError('contextIsMember: publicKey must be exactly 32 bytes');
   }
-  return Boolean(env.context_is_member(publicKey));
+  return isMember(publicKey);
 }
 
 /**
  * Gets all members of the current context.
- * This is a synchronous read operation that queries the committed local state.
+ * This is a synchronous read operation that queries the committed local state; within a method
+ * the list is read from the host once.
  *
  * @returns Array of 32-byte public keys representing context members
  *
@@ -465,29 +609,36 @@ export function contextIsMember(publicKey: Uint8Array): boolean {
  * ```
  */
 export function contextMembers(): Uint8Array[] {
-  env.context_members(REGISTER_ID);
-  const len = Number(env.register_len(REGISTER_ID));
-  if (len === 0) {
-    return [];
-  }
-
-  // Read the serialized array of public keys
-  const buf = new Uint8Array(len);
-  env.read_register(REGISTER_ID, buf);
-
-  // Deserialize: Rust returns Vec<PublicKey> as Borsh-serialized
-  // Format: u32 length + [32 bytes] for each PublicKey (fixed-size array, no length prefix)
-  const reader = new BorshReader(buf);
-  const count = reader.readU32();
-  const members: Uint8Array[] = [];
+  return cachedMembers();
+}
 
-  for (let i = 0; i < count; i++) {
-    // PublicKey is [u8; 32] in Rust, which is serialized as 32 bytes directly (no length prefix)
-    const keyBytes = reader.readFixedArray(32);
-    members.push(keyBytes);
+/**
+ * Checks which of many public keys are members of the current context.
+ * Keys the per-invocation cache cannot answer are checked in one native call, without
+ * reading the full member list, which suits large contexts.
+ *
+ * @param publicKeys - 32-byte Ed25519 public keys to check
+ * @returns One flag per key, in order
+ * @throws RangeError if any key is not 32 bytes
+ *
+ * @example
+ * ```typescript
+ * import { contextIsMemberMany } from '@calimero-network/calimero-sdk-js/env';
+ *
+ * const flags = contextIsMemberMany(participants);
+ * const outsiders = participants.filter((_, i) => !flags[i]);
+ * ```
+ */
+export function contextIsMemberMany(publicKeys: Uint8Array[]): boolean[] {
+  for (const publicKey of publicKeys) {
+    if (!(publicKey instanceof Uint8Array)) {
+      throw new TypeError('contextIsMemberMany: every publicKey must be a Uint8Array');
+    }
+    if (publicKey.length !== 32) {
+      throw new RangeError('contextIsMemberMany: every publicKey must be exactly 32 bytes');
+    }
   }
-
-  return members;
+  return areMembers(publicKeys);
 }
 
 /**
@@ -610,8 +761,9 @@ export function contextResolveAlias(alias: Uint8Array): Uint8Array | null {
  * @returns Hex representation of the executor ID
  */
 export function executorIdHex(): string {
-  const id = executorId();
-  return bytesToHex(id);
+  return (
+    memoizedEncoding('executorHex', ctx => bytesToHex(ctx.executorId)) ?? bytesToHex(executorId())
+  );
 }
 
 /**
@@ -620,8 +772,10 @@ export function executorIdHex(): string {
  * @returns Base58 representation of the executor ID
  */
 export function executorIdBase58(): string {
-  const id = executorId();
-  return bytesToBase58(id);
+  return (
+    memoizedEncoding('executorBase58', ctx => bytesToBase58(ctx.executorId)) ??
+    bytesToBase58(executorId())
+  );
 }
 
 function bytesToBase58(bytes: Uint8Array): string {
@@ -684,6 +838,7 @@ export function storageWrite(key: Uint8Array, value: Uint8Array): void {
 
 /**
  * Schedule a cross-context call to run once the current execution finishes.
+ * Within a method the call is queued and sent with the rest of the batch when it returns.
  *
  * @param contextId - Target context identifier (32 bytes)
  * @param functionName - Function name to invoke in the target context
@@ -698,8 +853,30 @@ export function xcall(
     throw new Error('contextId must be exactly 32 bytes');
   }
 
-  const fnBytes = textEncoder.encode(functionName);
-  env.xcall(contextId, fnBytes, params);
+  enqueueXCall(contextId, functionName, params);
+}
+
+/**
+ * Schedule the same cross-context call on many contexts (team or channel fan-out).
+ *
+ * Within a method, calls are queued and handed to the host in one batch when the method
+ * returns; the function name and params are sent once for the whole fan-out.
+ *
+ * @param contextIds - Target context identifiers (32 bytes each)
+ * @param functionName - Function name to invoke in every target context
+ * @param params - Serialized parameters shared by all calls (defaults to empty payload)
+ */
+export function xcallMany(
+  contextIds: Uint8Array[],
+  functionName: string,
+  params: Uint8Array = new Uint8Array()
+): void {
+  for (const contextId of contextIds) {
+    if (contextId.length !== 32) {
+      throw new Error('contextId must be exactly 32 bytes');
+    }
+  }
+  enqueueXCalls(contextIds, functionName, params);
 }
 
 /**
@@ -785,6 +962,24 @@ export function jsCrdtMapInsert(
   return env.js_crdt_map_insert(mapId, key, value, register);
 }
 
+/**
+ * Merges into a map entry host-side: `merge` receives the stored bytes (or `null`) and
+ * returns the bytes to insert. The `current` buffer is only valid during the callback.
+ *
+ * Returns `null` when the runtime does not provide `js_crdt_map_merge_insert`.
+ */
+export function jsCrdtMapMergeInsert(
+  mapId: Uint8Array,
+  key: Uint8Array,
+  merge: (current: Uint8Array | null) => Uint8Array,
+  register: bigint
+): number | null {
+  if (typeof env.js_crdt_map_merge_insert !== 'function') {
+    return null;
+  }
+  return env.js_crdt_map_merge_insert(mapId, key, merge, register);
+}
+
 export function jsCrdtMapRemove(mapId: Uint8Array, key: Uint8Array, register: bigint): number {
   return env.js_crdt_map_remove(mapId, key, register);
 }
@@ -961,12 +1156,13 @@ export function flushDelta(): boolean {
 /**
  * Gets the current timestamp
  *
+ * Within a method this is the invocation timestamp, read once when the method first asks for
+ * context; outside a dispatch it queries the host on every call.
+ *
  * @returns Current timestamp in nanoseconds
  */
 export function timeNow(): bigint {
-  const buf = new Uint8Array(8);
-  env.time_now(buf);
-  return new DataView(buf.buffer).getBigUint64(0, true);
+  return currentInvocationContext()?.time ?? fetchTimeNow();
 }
 
 /**
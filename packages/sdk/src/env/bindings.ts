@@ -12,6 +12,8 @@ export interface HostEnv {
   panic_utf8(message: Uint8Array): never;
   // Logging
   log_utf8(msg: Uint8Array): void;
+  /** Appends a string to the in-Wasm log ring (flushed at the end of the call or on panic). */
+  log_append?(message: string): void;
   value_return(value: Uint8Array): void;
 
   // Storage
@@ -19,6 +21,7 @@ export interface HostEnv {
   storage_write(key: Uint8Array, value: Uint8Array, register_id: bigint): bigint;
   storage_remove(key: Uint8Array, register_id: bigint): bigint;
   xcall(context_id: Uint8Array, function_name: Uint8Array, params: Uint8Array): void;
+  xcall_batch?(calls: Uint8Array): void; // packed layout, see runtime/xcall-batch.ts
   js_crdt_map_new(register_id: bigint): number;
   js_crdt_map_get(mapId: Uint8Array, key: Uint8Array, register_id: bigint): number;
   js_crdt_map_insert(
@@ -27,6 +30,13 @@ export interface HostEnv {
     value: Uint8Array,
     register_id: bigint
   ): number;
+  /** Read-merge-write in one crossing; `current` is borrowed for the duration of `merge`. */
+  js_crdt_map_merge_insert?(
+    mapId: Uint8Array,
+    key: Uint8Array,
+    merge: (current: Uint8Array | null) => Uint8Array,
+    register_id: bigint
+  ): number;
   js_crdt_map_remove(mapId: Uint8Array, key: Uint8Array, register_id: bigint): number;
   js_crdt_map_contains(mapId: Uint8Array, key: Uint8Array): number;
   js_crdt_map_iter(mapId: Uint8Array, register_id: bigint): number;
@@ -73,10 +83,12 @@ export interface HostEnv {
   // Context
   context_id(register_id: bigint): void;
   executor_id(register_id: bigint): void;
+  invocation_context?(buf: Uint8Array): void; // [context_id: 32][executor_id: 32][time_now: u64]
   // Context Management (PR 1663 & 1686)
   context_add_member(publicKey: Uint8Array): void;
   context_remove_member(publicKey: Uint8Array): void;
   context_is_member(publicKey: Uint8Array): number; // Returns Bool (u32)
+  context_is_member_many?(publicKeys: Uint8Array, out: Uint8Array): void; // 32-byte keys, 1 flag each
   context_members(register_id: bigint): void;
   context_create(
     protocol: Uint8Array,
@@ -90,6 +102,7 @@ export interface HostEnv {
   // Events
   emit(kind: Uint8Array, data: Uint8Array): void;
   emit_with_handler(kind: Uint8Array, data: Uint8Array, handler: Uint8Array): void;
+  emit_batch?(events: Uint8Array): void; // Borsh Vec<(kind, data, Option<handler>)>
 
   // Registers
   input(register_id: bigint): void;
@@ -113,8 +126,19 @@ export interface HostEnv {
   blob_write(fd: bigint, data: Uint8Array): bigint;
   blob_close(fd: bigint, blob_id_buf: Uint8Array): boolean;
   blob_announce_to_context(blob_id: Uint8Array, context_id: Uint8Array): number;
+  // Same as blob_create/open/read/write, with plain number fds and byte counts
+  blob_stream_create?(): number;
+  blob_stream_open?(blob_id: Uint8Array): number;
+  blob_stream_read?(fd: number, buffer: Uint8Array): number;
+  blob_stream_write?(fd: number, data: Uint8Array): number;
   random_bytes(buffer: Uint8Array): void;
 
+  // Compression (builder.c lz4.h); both return the number of bytes written to dst
+  lz4_compress?(src: Uint8Array, dst: Uint8Array): number; // 0 when dst is too small
+  lz4_decompress?(src: Uint8Array, dst: Uint8Array): number; // dst = exact uncompressed size
+  // Hashing (builder.c murmur3.h): MurmurHash3 x86_128 of src into dst[0..16]
+  murmur3_128?(src: Uint8Array, dst: Uint8Array): void;
+
   // Crypto
   ed25519_verify(signature: Uint8Array, publicKey: Uint8Array, message: Uint8Array): number;
 }
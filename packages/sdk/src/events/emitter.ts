@@ -1,35 +1,133 @@
 /**
  * Event emission functions
+ *
+ * Inside a dispatched method, events are queued: payloads are serialized into one shared arena
+ * and handed to the host in a single `emit_batch` call when the method returns. Outside a
+ * dispatch (tests, sync callbacks) each event goes to the host immediately.
  */
 
 import type { AppEvent } from './types';
+import type { AbiManifest, TypeRef } from '../abi/types';
 import { getAbiManifest, getEventPayloadType } from '../abi/helpers';
-import { serializeWithAbi } from '../utils/abi-serialize';
+import { serializeWithAbiInto } from '../utils/abi-serialize';
+import { BorshWriter } from '../borsh/encoder';
+import { BorshReader } from '../borsh/decoder';
 
 // This will be provided by QuickJS runtime
 declare const env: {
   emit(kind: Uint8Array, data: Uint8Array): void;
   emit_with_handler(kind: Uint8Array, data: Uint8Array, handler: Uint8Array): void;
+  emit_batch?(events: Uint8Array): void;
 };
 
-const encoder = new TextEncoder();
+const encoder = /* @__PURE__ */ new TextEncoder();
+
+/**
+ * Per-invocation event arena, laid out as Borsh
+ * `Vec<(kind: Vec<u8>, data: Vec<u8>, handler: Option<Vec<u8>>)>`.
+ * The count prefix at offset 0 is patched on flush.
+ */
+let arena: BorshWriter | null = null;
+let queued = 0;
 
 export function emit(event: unknown): void {
-  const kind = encoder.encode(eventConstructorName(event));
-  const payload = extractPayload(event);
-  env.emit(kind, payload);
+  enqueue(event, null);
 }
 
 export function emitWithHandler(event: unknown, handlerName: string): void {
-  const kind = encoder.encode(eventConstructorName(event));
-  const payload = extractPayload(event);
-  const handler = encoder.encode(handlerName);
-  env.emit_with_handler(kind, payload, handler);
+  enqueue(event, handlerName);
+}
+
+/**
+ * Starts queueing events for the current invocation. Called by the dispatcher.
+ */
+export function beginEventBatch(): void {
+  arena = new BorshWriter(256);
+  arena.writeU32(0);
+  queued = 0;
+}
+
+/**
+ * Hands every queued event to the host and stops queueing. Returns the number of events sent.
+ */
+export function flushEventBatch(): number {
+  const batch = arena;
+  const count = queued;
+  arena = null;
+  queued = 0;
+  if (!batch || count === 0) {
+    return 0;
+  }
+
+  batch.patchU32(0, count);
+  const bytes = batch.finish();
+  if (typeof env.emit_batch === 'function') {
+    env.emit_batch(bytes);
+  } else {
+    emitSequentially(bytes);
+  }
+  return count;
+}
+
+/**
+ * Drops queued events (the invocation failed) and stops queueing.
+ */
+export function discardEventBatch(): void {
+  arena = null;
+  queued = 0;
 }
 
-function extractPayload(event: unknown): Uint8Array {
-  const eventName = eventConstructorName(event);
+function enqueue(event: unknown, handlerName: string | null): void {
+  const kindName = eventConstructorName(event);
 
+  if (!arena) {
+    const kind = encoder.encode(kindName);
+    const writer = new BorshWriter();
+    writePayload(writer, event, kindName);
+    // Skip the u32 length prefix written by writePayload
+    const payload = writer.finish().subarray(4);
+    if (handlerName === null) {
+      env.emit(kind, payload);
+    } else {
+      env.emit_with_handler(kind, payload, encoder.encode(handlerName));
+    }
+    return;
+  }
+
+  const start = arena.size();
+  try {
+    arena.writeString(kindName);
+    writePayload(arena, event, kindName);
+    arena.writeOption(handlerName, name => arena!.writeString(name));
+  } catch (error) {
+    // Keep the arena well-formed if the caller catches and carries on
+    arena.truncate(start);
+    throw error;
+  }
+  queued += 1;
+}
+
+/**
+ * Fallback for runtimes without `emit_batch`: replays the arena one event at a time.
+ */
+function emitSequentially(bytes: Uint8Array): void {
+  const reader = new BorshReader(bytes, { borrow: true });
+  const count = reader.readU32();
+  for (let i = 0; i < count; i++) {
+    const kind = reader.readBytes();
+    const data = reader.readBytes();
+    if (reader.readU8() === 0) {
+      env.emit(kind, data);
+    } else {
+      env.emit_with_handler(kind, data, reader.readBytes());
+    }
+  }
+}
+
+/**
+ * Writes the event payload as a length-prefixed byte string
+ */
+function writePayload(writer: BorshWriter, event: unknown, eventName: string): void {
   // ABI-aware serialization is required
   const abi = getAbiManifest();
   if (!abi) {
@@ -38,8 +136,9 @@ function extractPayload(event: unknown): Uint8Array {
 
   const payloadType = getEventPayloadType(abi, eventName);
   if (!payloadType) {
-    // Event has no payload type, return empty payload
-    return new Uint8Array(0);
+    // Event has no payload type, emit an empty payload
+    writer.writeU32(0);
+    return;
   }
 
   // Extract the actual payload value from the event
@@ -50,10 +149,12 @@ function extractPayload(event: unknown): Uint8Array {
   if (maybeEvent && typeof maybeEvent.serialize === 'function') {
     const serialized = maybeEvent.serialize();
     if (serialized instanceof Uint8Array) {
-      return serialized;
+      writer.writeBytes(serialized);
+      return;
     }
     if (typeof serialized === 'string') {
-      return encoder.encode(serialized);
+      writer.writeString(serialized);
+      return;
     }
     payloadValue = serialized;
   } else if (typeof event === 'object' && event !== null) {
@@ -67,8 +168,20 @@ function extractPayload(event: unknown): Uint8Array {
     }
   }
 
-  // Serialize event payload according to ABI
-  return serializeWithAbi(payloadValue, payloadType, abi);
+  // Serialize event payload according to ABI, straight into the writer
+  serializeSized(writer, payloadValue, payloadType, abi);
+}
+
+function serializeSized(
+  writer: BorshWriter,
+  value: unknown,
+  payloadType: TypeRef,
+  abi: AbiManifest
+): void {
+  const prefix = writer.size();
+  writer.writeU32(0);
+  serializeWithAbiInto(writer, value, payloadType, abi);
+  writer.patchU32(prefix, writer.size() - prefix - 4);
 }
 
 function eventConstructorName(event: unknown): string {
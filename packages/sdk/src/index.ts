@@ -5,7 +5,7 @@
  */
 
 // Decorators
-export { State } from './decorators/state';
+export { State, type StateOptions } from './decorators/state';
 export { Logic } from './decorators/logic';
 export { Init } from './decorators/init';
 export { Event } from './decorators/event';
@@ -19,6 +19,9 @@ export * as env from './env/api';
 export { emit, emitWithHandler } from './events/emitter';
 export type { AppEvent } from './events/types';
 
+// Blob streams
+export { BlobReader, BlobWriter, ChunkPool, type BlobStreamOptions } from './blobs';
+
 // Runtime
 export { StateManager } from './runtime/state-manager';
 
@@ -29,5 +32,11 @@ export { StateManager } from './runtime/state-manager';
 export * from './state/helpers';
 export { createPrivateEntry, PrivateEntryHandle } from './state/private';
 
+// Value compression
+export type { CompressionCodec } from './utils/compression';
+
+// Typed collection codecs
+export { codecFor, abiCollectionCodecs, type Codec, type CodecSpec } from './utils/abi-codec';
+
 // Types
 export type { SerializeOptions, DeserializeOptions } from './utils/types';
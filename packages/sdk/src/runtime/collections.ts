@@ -1,11 +1,36 @@
+import { bytesToHex } from '../utils/hex';
+import type { TypeRef } from '../abi/types';
+import type { CompressionCodec } from '../utils/compression';
+import type { PackedElementType } from '../collections/PackedVector';
+
+/**
+ * ABI types of the typed codecs a collection was created with (see `codecFor`), plus the
+ * storage options that change the stored value format (compression, large-value threshold,
+ * packed element type and chunk size, log segment size, secondary index declarations, Bloom
+ * filter geometry).
+ */
+export interface CollectionCodecSpecs {
+  key?: TypeRef;
+  value?: TypeRef;
+  compression?: CompressionCodec;
+  largeValues?: number;
+  element?: PackedElementType;
+  chunkSize?: number;
+  segmentSize?: number;
+  indexes?: Record<string, string>;
+  bits?: number;
+  hashes?: number;
+}
+
 export interface CollectionSnapshot {
   type: string;
   id: string;
+  codecs?: CollectionCodecSpecs;
 }
 
 type CollectionLoader = (snapshot: CollectionSnapshot) => any;
 
-const registry = new Map<string, CollectionLoader>();
+const registry = /* @__PURE__ */ new Map<string, CollectionLoader>();
 
 export function registerCollectionType(type: string, loader: CollectionLoader): void {
   registry.set(type, loader);
@@ -19,10 +44,107 @@ export function instantiateCollection(snapshot: CollectionSnapshot): any {
   return loader(snapshot);
 }
 
+/**
+ * Symbol under which SDK collections carry their interned handle. Handles are small integers,
+ * shared by every instance that points at the same collection id, so runtime bookkeeping (nested
+ * tracking, serialization) can index arrays instead of calling `toJSON()` and hex-encoding ids.
+ */
+export const COLLECTION_HANDLE: unique symbol = Symbol('calimero.collectionHandle');
+
+/**
+ * Symbol under which a collection instance carries its own codec specs. Kept per instance, not
+ * per handle: two instances opened on the same id may be created with different options.
+ */
+const COLLECTION_CODECS: unique symbol = Symbol('calimero.collectionCodecs');
+
+const handlesByKey = /* @__PURE__ */ new Map<string, number>();
+const handleTypes: string[] = [];
+const handleIdBytes: Uint8Array[] = [];
+const handleIdHex: Array<string | undefined> = [];
+
+function rawIdKey(type: string, id: Uint8Array): string {
+  let key = type + ':';
+  for (let i = 0; i < id.length; i += 1) {
+    key += String.fromCharCode(id[i]);
+  }
+  return key;
+}
+
+/**
+ * Interns `(type, id)` and brands `collection` with the resulting handle. Codec specs, when
+ * given, are recorded on the instance so its snapshots carry them.
+ */
+export function brandCollection(
+  collection: object,
+  type: string,
+  id: Uint8Array,
+  codecs?: CollectionCodecSpecs
+): number {
+  const key = rawIdKey(type, id);
+  let handle = handlesByKey.get(key);
+  if (handle === undefined) {
+    handle = handleTypes.length;
+    handlesByKey.set(key, handle);
+    handleTypes.push(type);
+    handleIdBytes.push(id);
+    handleIdHex.push(undefined);
+  }
+  Object.defineProperty(collection, COLLECTION_HANDLE, { value: handle });
+  if (codecs) {
+    Object.defineProperty(collection, COLLECTION_CODECS, { value: codecs });
+  }
+  return handle;
+}
+
+/**
+ * Returns the interned handle of a collection, or -1 when `value` is not one.
+ * Unbranded collections (custom types relying on `toJSON()` only) are interned on first use.
+ */
+export function collectionHandle(value: unknown): number {
+  if (!value || typeof value !== 'object') {
+    return -1;
+  }
+  const handle = (value as { [COLLECTION_HANDLE]?: number })[COLLECTION_HANDLE];
+  if (handle !== undefined) {
+    return handle;
+  }
+
+  const snapshot = snapshotFromJSON(value);
+  if (!snapshot) {
+    return -1;
+  }
+  const key = `${snapshot.type}:#${snapshot.id}`;
+  let interned = handlesByKey.get(key);
+  if (interned === undefined) {
+    interned = handleTypes.length;
+    handlesByKey.set(key, interned);
+    handleTypes.push(snapshot.type);
+    handleIdBytes.push(new Uint8Array(0));
+    handleIdHex.push(snapshot.id);
+  }
+  return interned;
+}
+
+export function collectionHandleType(handle: number): string {
+  return handleTypes[handle];
+}
+
+function handleSnapshot(handle: number, codecs?: CollectionCodecSpecs): CollectionSnapshot {
+  let id = handleIdHex[handle];
+  if (id === undefined) {
+    id = bytesToHex(handleIdBytes[handle]);
+    handleIdHex[handle] = id;
+  }
+  return codecs ? { type: handleTypes[handle], id, codecs } : { type: handleTypes[handle], id };
+}
+
 export function hasRegisteredCollection(value: unknown): boolean {
   if (!value || typeof value !== 'object') {
     return false;
   }
+  if ((value as { [COLLECTION_HANDLE]?: number })[COLLECTION_HANDLE] !== undefined) {
+    return true;
+  }
 
   const json = typeof (value as any).toJSON === 'function' ? (value as any).toJSON() : null;
   if (!json || typeof json !== 'object') {
@@ -37,7 +159,15 @@ export function snapshotCollection(value: any): CollectionSnapshot | null {
   if (!value || typeof value !== 'object') {
     return null;
   }
+  const handle = (value as { [COLLECTION_HANDLE]?: number })[COLLECTION_HANDLE];
+  if (handle !== undefined) {
+    const codecs = (value as { [COLLECTION_CODECS]?: CollectionCodecSpecs })[COLLECTION_CODECS];
+    return handleSnapshot(handle, codecs);
+  }
+  return snapshotFromJSON(value);
+}
 
+function snapshotFromJSON(value: any): CollectionSnapshot | null {
   const json = typeof value.toJSON === 'function' ? value.toJSON() : null;
   if (!json || typeof json !== 'object') {
     return null;
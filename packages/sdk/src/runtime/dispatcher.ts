@@ -1,7 +1,20 @@
-import { log, valueReturn, flushDelta, registerLen, readRegister, input, panic } from '../env/api';
+import {
+  logDebug,
+  logWarn,
+  logError,
+  valueReturn,
+  flushDelta,
+  registerLen,
+  readRegister,
+  input,
+  panic,
+} from '../env/api';
 import { StateManager } from './state-manager';
 import { runtimeLogicEntries } from './method-registry';
 import { getAbiManifest, getMethod } from '../abi/helpers';
+import { beginEventBatch, discardEventBatch, flushEventBatch } from '../events/emitter';
+import { beginXCallBatch, discardXCallBatch, flushXCallBatch } from './xcall-batch';
+import { beginInvocationContext, endInvocationContext } from './invocation-context';
 import type { TypeRef, AbiManifest, ScalarType, Variant } from '../abi/types';
 import './sync';
 
@@ -205,7 +218,7 @@ function readPayload(methodName?: string): unknown {
   input(REGISTER_ID);
   const len = Number(registerLen(REGISTER_ID));
   if (!Number.isFinite(len) || len <= 0) {
-    log(`[dispatcher] readPayload: no data for method ${methodName} (len=${len})`);
+    logDebug(() => `[dispatcher] readPayload: no data for method ${methodName} (len=${len})`);
     return undefined;
   }
 
@@ -220,7 +233,7 @@ function readPayload(methodName?: string): unknown {
     jsonValue = JSON.parse(jsonString);
   } catch (error) {
     const errorMsg = error instanceof Error ? error.message : String(error);
-    log(`[dispatcher] readPayload: failed to parse JSON for ${methodName}: ${errorMsg}`);
+    logWarn(() => `[dispatcher] readPayload: failed to parse JSON for ${methodName}: ${errorMsg}`);
     throw new Error(`Failed to parse JSON parameters: ${errorMsg}`);
   }
 
@@ -240,14 +253,14 @@ function readPayload(methodName?: string): unknown {
   }
 
   if (method.params.length === 0) {
-    log(`[dispatcher] readPayload: method ${methodName} has no parameters in ABI`);
+    logDebug(() => `[dispatcher] readPayload: method ${methodName} has no parameters in ABI`);
     // Even if ABI says no params, check if there's actual data
     // This handles cases where ABI is incomplete but host sends params
     if (buffer.length > 0) {
       try {
         const jsonString = new TextDecoder().decode(buffer);
         const jsonValue = JSON.parse(jsonString);
-        log(
+        logDebug(
           `[dispatcher] readPayload: found payload data despite no params in ABI, returning as-is`
         );
         return jsonValue;
@@ -285,8 +298,9 @@ function readPayload(methodName?: string): unknown {
         const keys = Object.keys(jsonObj);
         // If object is empty, return undefined (parameter not provided)
         if (keys.length === 0) {
-          log(
-            `[dispatcher] readPayload: empty object for ${methodName} scalar param, returning undefined`
+          logDebug(
+            () =>
+              `[dispatcher] readPayload: empty object for ${methodName} scalar param, returning undefined`
           );
           return undefined;
         }
@@ -294,8 +308,9 @@ function readPayload(methodName?: string): unknown {
         if (keys.length === 1 && keys[0] === paramName) {
           const scalarValue = jsonObj[paramName];
           const result = convertFromJsonCompatible(scalarValue, paramType, abi);
-          log(
-            `[dispatcher] readPayload: extracted ${methodName} single scalar param from object (key: ${paramName}, type: ${JSON.stringify(paramType)}, result type: ${typeof result})`
+          logDebug(
+            () =>
+              `[dispatcher] readPayload: extracted ${methodName} single scalar param from object (key: ${paramName}, type: ${JSON.stringify(paramType)}, result type: ${typeof result})`
           );
           return result;
         }
@@ -303,8 +318,9 @@ function readPayload(methodName?: string): unknown {
         if (keys.length === 1) {
           const scalarValue = jsonObj[keys[0]];
           const result = convertFromJsonCompatible(scalarValue, paramType, abi);
-          log(
-            `[dispatcher] readPayload: extracted ${methodName} single scalar param from object (key: ${keys[0]}, type: ${JSON.stringify(paramType)}, result type: ${typeof result})`
+          logDebug(
+            () =>
+              `[dispatcher] readPayload: extracted ${methodName} single scalar param from object (key: ${keys[0]}, type: ${JSON.stringify(paramType)}, result type: ${typeof result})`
           );
           return result;
         }
@@ -318,15 +334,17 @@ function readPayload(methodName?: string): unknown {
       ) {
         // Single object parameter - convert the entire object
         const result = convertFromJsonCompatible(jsonValue, paramType, abi);
-        log(
-          `[dispatcher] readPayload: converted ${methodName} single object param (type: ${JSON.stringify(paramType)}, result type: ${typeof result})`
+        logDebug(
+          () =>
+            `[dispatcher] readPayload: converted ${methodName} single object param (type: ${JSON.stringify(paramType)}, result type: ${typeof result})`
         );
         return result;
       } else {
         // Single scalar parameter
         const result = convertFromJsonCompatible(jsonValue, paramType, abi);
-        log(
-          `[dispatcher] readPayload: converted ${methodName} single scalar param (type: ${JSON.stringify(paramType)}, result type: ${typeof result})`
+        logDebug(
+          () =>
+            `[dispatcher] readPayload: converted ${methodName} single scalar param (type: ${JSON.stringify(paramType)}, result type: ${typeof result})`
         );
         return result;
       }
@@ -354,14 +372,16 @@ function readPayload(methodName?: string): unknown {
         // If it fails, fall through to individual parameter deserialization
         try {
           const result = convertFromJsonCompatible(jsonValue, firstParamType, abi);
-          log(
-            `[dispatcher] readPayload: treating entire JSON payload as first parameter (type: ${JSON.stringify(firstParamType)}, keys: ${jsonKeys.join(', ')})`
+          logDebug(
+            () =>
+              `[dispatcher] readPayload: treating entire JSON payload as first parameter (type: ${JSON.stringify(firstParamType)}, keys: ${jsonKeys.join(', ')})`
           );
           return result;
         } catch (error) {
           // If conversion fails, fall through to individual parameter deserialization
-          log(
-            `[dispatcher] readPayload: failed to convert as first parameter, falling back to individual params: ${error instanceof Error ? error.message : String(error)}`
+          logDebug(
+            () =>
+              `[dispatcher] readPayload: failed to convert as first parameter, falling back to individual params: ${error instanceof Error ? error.message : String(error)}`
           );
         }
       }
@@ -378,14 +398,15 @@ function readPayload(methodName?: string): unknown {
           result[param.name] = convertFromJsonCompatible(paramValue, param.type, abi);
         }
       }
-      log(
-        `[dispatcher] readPayload: converted ${methodName} params individually, result keys: ${Object.keys(result).join(', ')}, param names: ${method.params.map(p => p.name).join(', ')}, json keys: ${Object.keys(jsonObj).join(', ')}`
+      logDebug(
+        () =>
+          `[dispatcher] readPayload: converted ${methodName} params individually, result keys: ${Object.keys(result).join(', ')}, param names: ${method.params.map(p => p.name).join(', ')}, json keys: ${Object.keys(jsonObj).join(', ')}`
       );
       return result;
     }
   } catch (error) {
     const errorMsg = error instanceof Error ? error.message : String(error);
-    log(`[dispatcher] readPayload: failed to convert ${methodName}: ${errorMsg}`);
+    logWarn(() => `[dispatcher] readPayload: failed to convert ${methodName}: ${errorMsg}`);
     throw error;
   }
 }
@@ -417,8 +438,9 @@ function normalizeArgs(payload: unknown, paramNames: string[]): unknown[] {
       const keys = Object.keys(obj);
       if (keys.length === 1) {
         const value = obj[keys[0]];
-        log(
-          `[dispatcher] normalizeArgs: extracted single value from object (key: ${keys[0]}, value type: ${typeof value})`
+        logDebug(
+          () =>
+            `[dispatcher] normalizeArgs: extracted single value from object (key: ${keys[0]}, value type: ${typeof value})`
         );
         return [value];
       }
@@ -453,8 +475,9 @@ function normalizeArgs(payload: unknown, paramNames: string[]): unknown[] {
       }
       return undefined;
     });
-    log(
-      `[dispatcher] normalizeArgs: multiple params, payload keys: ${Object.keys(obj).join(', ')}, paramNames: ${paramNames.join(', ')}, args: ${JSON.stringify(args.map(a => (typeof a === 'object' && a !== null ? Object.keys(a as object).join(',') : String(a))))}`
+    logDebug(
+      () =>
+        `[dispatcher] normalizeArgs: multiple params, payload keys: ${Object.keys(obj).join(', ')}, paramNames: ${paramNames.join(', ')}, argTypes: ${args.map(describeArg).join(', ')}`
     );
     return args;
   }
@@ -475,42 +498,45 @@ function normalizeArgs(payload: unknown, paramNames: string[]): unknown[] {
   return [payload];
 }
 
+/**
+ * Short, allocation-light description of an argument for debug logs
+ * (never stringifies the value itself: it may be large or contain bigints)
+ */
+function describeArg(arg: unknown): string {
+  if (arg === null) return 'null';
+  if (Array.isArray(arg)) return `array(${arg.length})`;
+  if (arg instanceof Uint8Array) return `bytes(${arg.length})`;
+  if (typeof arg === 'object') return `object{${Object.keys(arg as object).join('|')}}`;
+  return typeof arg;
+}
+
 function handleError(method: string, error: unknown): never {
   const text = error instanceof Error ? `${error.message}\n${error.stack ?? ''}` : String(error);
   const message = `[dispatcher] ${method} failed: ${text}`;
-  log(message);
+  logError(message);
   panic(message);
 }
 
 /**
  * Gets effective parameter names, falling back to ABI if not provided from method registry
  */
-function getEffectiveParamNames(
-  methodName: string,
-  paramNames: string[],
-  enableLogging = false
-): string[] {
+function getEffectiveParamNames(methodName: string, paramNames: string[]): string[] {
   if (paramNames.length > 0) {
     return paramNames;
   }
 
   const abi = getAbiManifest();
-  if (enableLogging) {
-    log(`[dispatcher] ABI lookup for ${methodName}: hasAbi=${!!abi}`);
-  }
+  logDebug(() => `[dispatcher] ABI lookup for ${methodName}: hasAbi=${!!abi}`);
 
   if (abi) {
     const method = getMethod(abi, methodName);
-    if (enableLogging) {
-      log(
+    logDebug(
+      () =>
         `[dispatcher] Method lookup for ${methodName}: hasMethod=${!!method}, params=${method ? method.params.map(p => p.name).join(',') : 'none'}`
-      );
-    }
+    );
     if (method) {
       const extracted = method.params.map(p => p.name);
-      if (enableLogging) {
-        log(`[dispatcher] Extracted paramNames from ABI: ${JSON.stringify(extracted)}`);
-      }
+      logDebug(() => `[dispatcher] Extracted paramNames from ABI: ${extracted.join(', ')}`);
       return extracted;
     }
   }
@@ -528,13 +554,17 @@ function createLogicDispatcher(
   return function dispatch(): void {
     const payload = readPayload(methodName);
 
-    const effectiveParamNames = getEffectiveParamNames(methodName, paramNames, true);
+    const effectiveParamNames = getEffectiveParamNames(methodName, paramNames);
     const args = normalizeArgs(payload, effectiveParamNames);
-    log(
-      `[dispatcher] dispatch: method=${methodName}, paramNames=${JSON.stringify(effectiveParamNames)}, args length=${args.length}, args=${JSON.stringify(args)}`
+    logDebug(
+      () =>
+        `[dispatcher] dispatch: method=${methodName}, paramNames=${effectiveParamNames.join(',')}, args length=${args.length}, argTypes=${args.map(describeArg).join(',')}`
     );
 
     let logicInstance: any;
+    beginInvocationContext();
+    beginEventBatch();
+    beginXCallBatch();
     try {
       let state = StateManager.load();
 
@@ -554,6 +584,10 @@ function createLogicDispatcher(
 
       const result = logicInstance[methodName](...args);
 
+      // Hand this invocation's events and cross-context calls to the host in one batch each
+      flushEventBatch();
+      flushXCallBatch();
+
       if (isMutating) {
         // Flush CRDT delta changes to host storage
         // This generates the delta that includes collection changes
@@ -568,6 +602,9 @@ function createLogicDispatcher(
     } catch (error) {
       handleError(methodName, error);
     } finally {
+      discardEventBatch();
+      discardXCallBatch();
+      endInvocationContext();
       StateManager.setCurrent(null);
     }
   };
@@ -585,29 +622,36 @@ function createInitDispatcher(
     const effectiveParamNames = getEffectiveParamNames(methodName, paramNames);
     const args = normalizeArgs(payload, effectiveParamNames);
 
-    log(
-      `[dispatcher] initDispatch: method=${methodName}, paramNames=${JSON.stringify(effectiveParamNames)}, payload type=${typeof payload}, args length=${args.length}`
+    logDebug(
+      () =>
+        `[dispatcher] initDispatch: method=${methodName}, paramNames=${effectiveParamNames.join(',')}, payload type=${typeof payload}, args length=${args.length}`
     );
     // Only add payload as fallback if args is truly empty (not just containing null/undefined)
     // Check if args has any non-null/undefined values
     const hasValidArgs = args.length > 0 && args.some(arg => arg !== undefined && arg !== null);
     if (!hasValidArgs && payload !== undefined && payload !== null) {
       // If payload exists but normalizeArgs didn't handle it, use payload directly
-      log(`[dispatcher] initDispatch: payload exists but args empty, using payload as first arg`);
+      logDebug(
+        `[dispatcher] initDispatch: payload exists but args empty, using payload as first arg`
+      );
       // Replace args instead of pushing to avoid duplicating null values
       args.length = 0;
       args.push(payload);
     } else if (args.length > 0 && args[0] !== undefined && args[0] !== null) {
-      log(
-        `[dispatcher] initDispatch: first arg type=${typeof args[0]}, keys=${typeof args[0] === 'object' ? Object.keys(args[0]).join(',') : 'N/A'}`
+      logDebug(
+        () =>
+          `[dispatcher] initDispatch: first arg type=${typeof args[0]}, keys=${typeof args[0] === 'object' ? Object.keys(args[0]).join(',') : 'N/A'}`
       );
     } else if (args.length === 0) {
-      log(
+      logDebug(
         `[dispatcher] initDispatch: no payload or args, init method may fail if it expects parameters`
       );
     }
 
     let state: any;
+    beginInvocationContext();
+    beginEventBatch();
+    beginXCallBatch();
     try {
       const existing = StateManager.load();
       if (existing) {
@@ -626,10 +670,15 @@ function createInitDispatcher(
       }
 
       StateManager.save(state);
+      flushEventBatch();
+      flushXCallBatch();
       flushDelta();
     } catch (error) {
       handleError(methodName, error);
     } finally {
+      discardEventBatch();
+      discardXCallBatch();
+      endInvocationContext();
       StateManager.setCurrent(null);
     }
   };
@@ -639,7 +688,7 @@ function registerDispatchers(): void {
   const entries = runtimeLogicEntries();
   for (const entry of entries) {
     const logicCtor: any = entry.target;
-    const stateCtor: any = entry.stateClass ?? null;
+    const stateCtor: any = entry._calimeroStateClass ?? null;
 
     if (entry.init) {
       const initParams = entry.methods.get(entry.init) ?? [];
@@ -0,0 +1,129 @@
+/**
+ * Per-invocation context record
+ *
+ * Context id, executor id and the invocation timestamp do not change while a method runs, so
+ * the dispatcher opens a record for each call and the `env` accessors read from it. The record
+ * is fetched lazily on first use, through one fused `invocation_context` call when `builder.c`
+ * provides it (three host calls otherwise). Derived encodings are computed once per record.
+ * Outside a dispatch every accessor queries the host directly.
+ */
+
+import type { HostEnv } from '../env/bindings';
+
+declare const env: HostEnv;
+
+const REGISTER_ID = 0n;
+
+// [context_id: 32][executor_id: 32][time_now: u64 LE]
+const RECORD_SIZE = 72;
+
+export interface InvocationContext {
+  readonly contextId: Uint8Array;
+  readonly executorId: Uint8Array;
+  /** Nanoseconds, read once when the record is fetched */
+  readonly time: bigint;
+  /** Memoized encodings, filled on first request */
+  derived: Map<string, string>;
+}
+
+let active = false;
+let record: InvocationContext | null = null;
+let generation = 0;
+
+/**
+ * Opens the record for the current invocation. Called by the dispatcher.
+ */
+export function beginInvocationContext(): void {
+  active = true;
+  record = null;
+  generation += 1;
+}
+
+/**
+ * Closes the record; later accessors go back to the host.
+ */
+export function endInvocationContext(): void {
+  active = false;
+  record = null;
+}
+
+/**
+ * Identifies the current invocation for other per-invocation caches, or null outside a dispatch
+ */
+export function invocationGeneration(): number | null {
+  return active ? generation : null;
+}
+
+/**
+ * The current invocation's record, or null outside a dispatch
+ */
+export function currentInvocationContext(): InvocationContext | null {
+  if (!active) {
+    return null;
+  }
+  if (!record) {
+    record = fetchInvocationContext();
+  }
+  return record;
+}
+
+/**
+ * Returns `encode(record)` computed once per invocation, or null outside a dispatch.
+ */
+export function memoizedEncoding(
+  key: string,
+  encode: (ctx: InvocationContext) => string
+): string | null {
+  const ctx = currentInvocationContext();
+  if (!ctx) {
+    return null;
+  }
+  let value = ctx.derived.get(key);
+  if (value === undefined) {
+    value = encode(ctx);
+    ctx.derived.set(key, value);
+  }
+  return value;
+}
+
+export function fetchContextId(): Uint8Array {
+  env.context_id(REGISTER_ID);
+  return readRegister();
+}
+
+export function fetchExecutorId(): Uint8Array {
+  env.executor_id(REGISTER_ID);
+  return readRegister();
+}
+
+export function fetchTimeNow(): bigint {
+  const buf = new Uint8Array(8);
+  env.time_now(buf);
+  return new DataView(buf.buffer).getBigUint64(0, true);
+}
+
+function fetchInvocationContext(): InvocationContext {
+  if (typeof env.invocation_context === 'function') {
+    const buf = new Uint8Array(RECORD_SIZE);
+    env.invocation_context(buf);
+    return {
+      contextId: buf.subarray(0, 32),
+      executorId: buf.subarray(32, 64),
+      time: new DataView(buf.buffer).getBigUint64(64, true),
+      derived: new Map(),
+    };
+  }
+  return {
+    contextId: fetchContextId(),
+    executorId: fetchExecutorId(),
+    time: fetchTimeNow(),
+    derived: new Map(),
+  };
+}
+
+function readRegister(): Uint8Array {
+  const len = Number(env.register_len(REGISTER_ID));
+  const buf = new Uint8Array(len);
+  env.read_register(REGISTER_ID, buf);
+  return buf;
+}
@@ -0,0 +1,178 @@
+/**
+ * Large collection values
+ *
+ * Collections created with a `largeValues` threshold keep encoded values above it in a blob and
+ * store a small reference record in their place, so reads of other entries, `has` checks and
+ * deltas only carry the reference. New blobs are announced to the current context so peers can
+ * fetch them, and a fetched blob is checked against the reference's SHA256. A value whose content
+ * hash matches the entry's current reference (or a blob already written or read during the same
+ * invocation) reuses that blob instead of uploading it again.
+ *
+ * Every stored value of such a collection starts with a tag byte:
+ *   0x00 ++ value bytes                                           inline
+ *   0x01 ++ blob_id [u8; 32] ++ sha256 [u8; 32] ++ length (u32)    blob reference
+ */
+
+import { BlobReader, BlobWriter } from '../blobs/stream';
+import { blobAnnounceToContext, contextId } from '../env/api';
+import { sha256 } from '../utils/sha256';
+import { invocationGeneration } from './invocation-context';
+
+const INLINE_TAG = 0x00;
+const BLOB_TAG = 0x01;
+
+export const LARGE_VALUE_REF_SIZE = 1 + 32 + 32 + 4;
+
+// Content hash -> blob id for blobs seen during the current invocation; bounded, cleared when full
+const KNOWN_BLOBS_LIMIT = 256;
+
+interface KnownBlobs {
+  generation: number;
+  blobs: Map<string, Uint8Array>;
+}
+
+let knownBlobs: KnownBlobs | null = null;
+
+export interface LargeValuePolicy {
+  /** Encoded values longer than this many bytes are stored in a blob */
+  threshold: number;
+}
+
+export interface LargeValueRef {
+  blobId: Uint8Array;
+  hash: Uint8Array;
+  length: number;
+}
+
+export function validateLargeValueThreshold(threshold: number): number {
+  if (!Number.isInteger(threshold) || threshold < LARGE_VALUE_REF_SIZE) {
+    throw new RangeError(
+      `largeValues.threshold must be an integer of at least ${LARGE_VALUE_REF_SIZE} bytes`
+    );
+  }
+  return threshold;
+}
+
+function hashKey(hash: Uint8Array): string {
+  return String.fromCharCode.apply(null, hash as unknown as number[]);
+}
+
+// Outside a dispatch there is nothing to scope the cache to, so nothing is remembered
+function currentKnownBlobs(): Map<string, Uint8Array> | null {
+  const generation = invocationGeneration();
+  if (generation === null) {
+    return null;
+  }
+  if (!knownBlobs || knownBlobs.generation !== generation) {
+    knownBlobs = { generation, blobs: new Map() };
+  }
+  return knownBlobs.blobs;
+}
+
+function rememberBlob(hash: Uint8Array, blobId: Uint8Array): void {
+  const blobs = currentKnownBlobs();
+  if (!blobs) {
+    return;
+  }
+  if (blobs.size >= KNOWN_BLOBS_LIMIT) {
+    blobs.clear();
+  }
+  blobs.set(hashKey(hash), blobId);
+}
+
+/**
+ * Parses a stored value as a blob reference, or returns null for inline values.
+ */
+export function readLargeValueRef(stored: Uint8Array): LargeValueRef | null {
+  if (stored.length === 0 || stored[0] !== BLOB_TAG) {
+    return null;
+  }
+  if (stored.length !== LARGE_VALUE_REF_SIZE) {
+    throw new Error('Corrupted large value reference');
+  }
+  return {
+    blobId: stored.subarray(1, 33),
+    hash: stored.subarray(33, 65),
+    length: new DataView(stored.buffer, stored.byteOffset + 65, 4).getUint32(0, true),
+  };
+}
+
+function encodeRef(blobId: Uint8Array, hash: Uint8Array, length: number): Uint8Array {
+  const out = new Uint8Array(LARGE_VALUE_REF_SIZE);
+  out[0] = BLOB_TAG;
+  out.set(blobId, 1);
+  out.set(hash, 33);
+  new DataView(out.buffer).setUint32(65, length, true);
+  return out;
+}
+
+function sameBytes(a: Uint8Array, b: Uint8Array): boolean {
+  if (a.length !== b.length) {
+    return false;
+  }
+  for (let i = 0; i < a.length; i++) {
+    if (a[i] !== b[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * Turns an encoded value into the bytes to store: inline below the threshold, otherwise a
+ * reference to a blob holding it. `current` is the entry's stored bytes, if any, and is only
+ * read during the call.
+ */
+export function packLargeValue(
+  encoded: Uint8Array,
+  threshold: number,
+  current: Uint8Array | null = null
+): Uint8Array {
+  if (encoded.length <= threshold) {
+    const out = new Uint8Array(encoded.length + 1);
+    out[0] = INLINE_TAG;
+    out.set(encoded, 1);
+    return out;
+  }
+
+  const hash = sha256(encoded);
+  const previous = current ? readLargeValueRef(current) : null;
+  if (previous && previous.length === encoded.length && sameBytes(previous.hash, hash)) {
+    return current!.slice();
+  }
+
+  let blobId = currentKnownBlobs()?.get(hashKey(hash));
+  if (!blobId) {
+    const writer = BlobWriter.create();
+    writer.write(encoded);
+    blobId = writer.close();
+    if (!blobAnnounceToContext(blobId, contextId())) {
+      throw new Error('Failed to announce large value blob to the context');
+    }
+    rememberBlob(hash, blobId);
+  }
+  return encodeRef(blobId, hash, encoded.length);
+}
+
+/**
+ * Returns the encoded value behind stored bytes, fetching the blob for references.
+ */
+export function unpackLargeValue(stored: Uint8Array): Uint8Array {
+  const ref = readLargeValueRef(stored);
+  if (!ref) {
+    if (stored.length === 0 || stored[0] !== INLINE_TAG) {
+      throw new Error('Unknown large value tag');
+    }
+    return stored.subarray(1);
+  }
+
+  const value = BlobReader.open(ref.blobId).readAll();
+  if (value.length !== ref.length) {
+    throw new Error(`Large value blob has ${value.length} bytes, reference expects ${ref.length}`);
+  }
+  if (!sameBytes(sha256(value), ref.hash)) {
+    throw new Error('Large value blob does not match the SHA256 of its reference');
+  }
+  rememberBlob(ref.hash, ref.blobId.slice());
+  return value;
+}
@@ -0,0 +1,173 @@
+/**
+ * Context membership lookups
+ *
+ * Member additions and removals take effect after the current execution, so membership is
+ * fixed while a method runs and can be cached per invocation. Single checks go to the host and
+ * are remembered; once a method has checked a few distinct keys, the whole member list is read
+ * with one `context_members` call into a set keyed by the raw 32-byte keys. Bulk checks use the
+ * native `context_is_member_many` wrapper, which never materializes the member list.
+ */
+
+import type { HostEnv } from '../env/bindings';
+import { BorshReader } from '../borsh/decoder';
+import { invocationGeneration } from './invocation-context';
+
+declare const env: HostEnv;
+
+const REGISTER_ID = 0n;
+const KEY_SIZE = 32;
+
+// Distinct single-key checks per invocation before the full member list is loaded
+const MEMBER_SET_THRESHOLD = 4;
+
+interface MembershipCache {
+  generation: number;
+  checked: Map<string, boolean>;
+  members: Uint8Array[] | null;
+  memberSet: Set<string> | null;
+}
+
+let cache: MembershipCache | null = null;
+
+/**
+ * Packs a 32-byte key into a string usable as a Map/Set key (one char per byte)
+ */
+function keyOf(publicKey: Uint8Array): string {
+  return String.fromCharCode.apply(null, publicKey as unknown as number[]);
+}
+
+function currentCache(): MembershipCache | null {
+  const generation = invocationGeneration();
+  if (generation === null) {
+    return null;
+  }
+  if (!cache || cache.generation !== generation) {
+    cache = { generation, checked: new Map(), members: null, memberSet: null };
+  }
+  return cache;
+}
+
+/**
+ * Reads every member with one `context_members` call. Keys are views into one buffer.
+ */
+export function fetchMembers(): Uint8Array[] {
+  env.context_members(REGISTER_ID);
+  const len = Number(env.register_len(REGISTER_ID));
+  if (len === 0) {
+    return [];
+  }
+
+  // Read the serialized array of public keys
+  const buf = new Uint8Array(len);
+  env.read_register(REGISTER_ID, buf);
+
+  // Deserialize: Rust returns Vec<PublicKey> as Borsh-serialized
+  // Format: u32 length + [32 bytes] for each PublicKey (fixed-size array, no length prefix)
+  // `buf` is not reused, so the keys can stay views into it
+  const reader = new BorshReader(buf, { borrow: true });
+  const count = reader.readU32();
+  const members: Uint8Array[] = [];
+  for (let i = 0; i < count; i++) {
+    members.push(reader.readFixedArray(KEY_SIZE));
+  }
+  return members;
+}
+
+function loadMemberSet(state: MembershipCache): Set<string> {
+  if (!state.memberSet) {
+    state.members ??= fetchMembers();
+    state.memberSet = new Set(state.members.map(keyOf));
+  }
+  return state.memberSet;
+}
+
+/**
+ * Members of the current context; cached for the rest of the invocation inside a method.
+ * Callers get their own copies of the keys.
+ */
+export function cachedMembers(): Uint8Array[] {
+  const state = currentCache();
+  if (!state) {
+    return fetchMembers();
+  }
+  state.members ??= fetchMembers();
+  return state.members.map(key => key.slice());
+}
+
+/**
+ * Checks one (already validated) 32-byte key.
+ */
+export function isMember(publicKey: Uint8Array): boolean {
+  const state = currentCache();
+  if (!state) {
+    return Boolean(env.context_is_member(publicKey));
+  }
+
+  const key = keyOf(publicKey);
+  if (state.memberSet || state.members) {
+    return loadMemberSet(state).has(key);
+  }
+  const known = state.checked.get(key);
+  if (known !== undefined) {
+    return known;
+  }
+  if (state.checked.size >= MEMBER_SET_THRESHOLD) {
+    return loadMemberSet(state).has(key);
+  }
+
+  const result = Boolean(env.context_is_member(publicKey));
+  state.checked.set(key, result);
+  return result;
+}
+
+/**
+ * Checks many (already validated) 32-byte keys, answering from the cache where possible and
+ * asking the host about the rest in one native call.
+ */
+export function areMembers(publicKeys: Uint8Array[]): boolean[] {
+  const state = currentCache();
+  const results = new Array<boolean>(publicKeys.length);
+
+  if (state && (state.memberSet || state.members)) {
+    const members = loadMemberSet(state);
+    for (let i = 0; i < publicKeys.length; i++) {
+      results[i] = members.has(keyOf(publicKeys[i]));
+    }
+    return results;
+  }
+
+  // Collect the keys the cache cannot answer
+  const pending: number[] = [];
+  for (let i = 0; i < publicKeys.length; i++) {
+    const known = state?.checked.get(keyOf(publicKeys[i]));
+    if (known === undefined) {
+      pending.push(i);
+    } else {
+      results[i] = known;
+    }
+  }
+  if (pending.length === 0) {
+    return results;
+  }
+
+  if (typeof env.context_is_member_many === 'function') {
+    const packed = new Uint8Array(pending.length * KEY_SIZE);
+    pending.forEach((index, slot) => packed.set(publicKeys[index], slot * KEY_SIZE));
+    const flags = new Uint8Array(pending.length);
+    env.context_is_member_many(packed, flags);
+    pending.forEach((index, slot) => {
+      results[index] = flags[slot] !== 0;
+    });
+  } else {
+    for (const index of pending) {
+      results[index] = Boolean(env.context_is_member(publicKeys[index]));
+    }
+  }
+
+  if (state) {
+    for (const index of pending) {
+      state.checked.set(keyOf(publicKeys[index]), results[index]);
+    }
+  }
+  return results;
+}
@@ -3,9 +3,13 @@ const MERGEABLE_TYPE_SYMBOL = Symbol.for('__calimeroMergeableType');
 export interface MergeableDescriptor {
   type: string;
   merge?: (localValue: any, remoteValue: any) => any;
+  /** Declared field names, merged in this order by the default field-wise merge. */
+  fields?: string[];
+  /** Class name, used to look up the record type emitted into the ABI. */
+  className?: string;
 }
 
-const descriptors = new Map<string, MergeableDescriptor>();
+const descriptors = /* @__PURE__ */ new Map<string, MergeableDescriptor>();
 
 export function registerMergeableType(
   ctor: { prototype: object },
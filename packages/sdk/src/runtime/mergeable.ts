@@ -1,60 +1,192 @@
-import { serialize, deserialize } from '../utils/serialize';
+import { hasRegisteredCollection } from './collections';
+import { getAbiManifest } from '../abi/helpers';
 import {
   getMergeableDescriptor,
   getMergeableType,
   markMergeableInstance,
-  cloneMergeableValue,
   type MergeableDescriptor,
 } from './mergeable-registry';
 
+export interface MergeOptions {
+  /**
+   * The local value was freshly decoded for this merge and may be mutated in place.
+   */
+  ownsLocal?: boolean;
+}
+
+/**
+ * Per-type merge plan: the declared field list (from `@Mergeable({ fields })` or the record
+ * type the build emitted into the ABI) plus a lookup used to spot undeclared keys.
+ */
+interface FieldPlan {
+  fields: string[];
+  declared: Record<string, true>;
+}
+
+const fieldPlans = /* @__PURE__ */ new Map<string, FieldPlan>();
+
+function resolveFieldPlan(descriptor: MergeableDescriptor): FieldPlan {
+  let plan = fieldPlans.get(descriptor.type);
+  if (plan) {
+    return plan;
+  }
+
+  let fields = descriptor.fields;
+  if (!fields) {
+    const record = getAbiManifest()?.types?.[descriptor.className ?? descriptor.type];
+    fields = record?.kind === 'record' && record.fields ? record.fields.map(field => field.name) : [];
+  }
+
+  const declared: Record<string, true> = Object.create(null);
+  for (const field of fields) {
+    declared[field] = true;
+  }
+  plan = { fields, declared };
+  fieldPlans.set(descriptor.type, plan);
+  return plan;
+}
+
+/**
+ * Structural deep clone with the same result shape as a serialize/deserialize round trip
+ * (records become null-prototype objects keeping their mergeable type, dates become ISO
+ * strings, collections stay references to the same collection) without encoding bytes.
+ */
 function cloneForMerge<T>(value: T): T {
   if (value === null || typeof value !== 'object') {
     return value;
   }
-  try {
-    return deserialize<T>(serialize(value));
-  } catch {
-    return cloneMergeableValue(value);
+  if (value instanceof Uint8Array) {
+    return new Uint8Array(value) as unknown as T;
+  }
+  if (ArrayBuffer.isView(value)) {
+    return new Uint8Array(
+      value.buffer.slice(value.byteOffset, value.byteOffset + value.byteLength)
+    ) as unknown as T;
+  }
+  if (value instanceof Date) {
+    return value.toISOString() as unknown as T;
+  }
+  if (hasRegisteredCollection(value)) {
+    return value;
+  }
+  if (Array.isArray(value)) {
+    return value.map(item => cloneForMerge(item)) as unknown as T;
+  }
+  if (value instanceof Set) {
+    const set = new Set();
+    for (const item of value) {
+      set.add(cloneForMerge(item));
+    }
+    return set as unknown as T;
+  }
+  if (value instanceof Map) {
+    const map = new Map();
+    for (const [key, entry] of value) {
+      map.set(cloneForMerge(key), cloneForMerge(entry));
+    }
+    return map as unknown as T;
+  }
+
+  const clone: Record<string, unknown> = Object.create(null);
+  for (const key in value) {
+    if (Object.prototype.hasOwnProperty.call(value, key)) {
+      clone[key] = cloneForMerge((value as Record<string, unknown>)[key]);
+    }
+  }
+  const type = getMergeableType(value);
+  if (type) {
+    markMergeableInstance(clone, type);
   }
+  return clone as T;
 }
 
 function isObjectLike(value: unknown): value is Record<string, unknown> {
   return Boolean(value) && typeof value === 'object' && !Array.isArray(value);
 }
 
+function mergeField(localField: unknown, remoteField: unknown, ownsLocal: boolean): unknown {
+  const incoming = remoteField ?? localField;
+  if (getMergeableType(incoming)) {
+    return mergeMergeableValues(localField, incoming, { ownsLocal });
+  }
+  return remoteField !== undefined ? remoteField : localField;
+}
+
+function shallowCopy(value: Record<string, unknown>): Record<string, unknown> {
+  const copy: Record<string, unknown> = Object.create(null);
+  for (const key in value) {
+    if (Object.prototype.hasOwnProperty.call(value, key)) {
+      copy[key] = value[key];
+    }
+  }
+  return copy;
+}
+
+/**
+ * Field-wise merge: remote fields win, nested mergeable fields merge recursively. Walks the
+ * type's field plan, then any undeclared remote keys. Only fields whose value changes are
+ * written: in place when the local value is owned, otherwise into a copy made on the first
+ * change, so merging equal values allocates nothing and returns the local value.
+ */
 function mergeDefaultFields(
   descriptor: MergeableDescriptor,
   localValue: any,
-  remoteValue: any
+  remoteValue: any,
+  ownsLocal: boolean
 ): any {
   if (!isObjectLike(remoteValue)) {
     return remoteValue ?? localValue;
   }
+  if (!isObjectLike(localValue)) {
+    return remoteValue;
+  }
 
-  const result: Record<string, unknown> = Object.create(null);
-  const keys = new Set<string>([
-    ...Object.keys(isObjectLike(localValue) ? localValue : {}),
-    ...Object.keys(remoteValue),
-  ]);
+  const plan = resolveFieldPlan(descriptor);
+  const sameType = getMergeableType(localValue) === descriptor.type;
+  let target: Record<string, unknown> = localValue;
+  let writable = ownsLocal && sameType;
 
-  for (const key of keys) {
-    const localField = isObjectLike(localValue) ? localValue[key] : undefined;
-    const remoteField = remoteValue[key];
+  const fields = plan.fields;
+  for (let i = 0; i < fields.length; i += 1) {
+    const key = fields[i];
+    const next = mergeField(localValue[key], remoteValue[key], ownsLocal);
+    if (next !== target[key]) {
+      if (!writable) {
+        target = shallowCopy(localValue);
+        writable = true;
+      }
+      target[key] = next;
+    }
+  }
 
-    const mergeableType = getMergeableType(remoteField ?? localField);
-    if (mergeableType) {
-      result[key] = mergeMergeableValues(localField, remoteField ?? localField);
+  for (const key in remoteValue) {
+    if (plan.declared[key] === true || !Object.prototype.hasOwnProperty.call(remoteValue, key)) {
       continue;
     }
-
-    result[key] = remoteField !== undefined ? remoteField : localField;
+    const next = mergeField(localValue[key], remoteValue[key], ownsLocal);
+    if (next !== target[key]) {
+      if (!writable) {
+        target = shallowCopy(localValue);
+        writable = true;
+      }
+      target[key] = next;
+    }
   }
 
-  markMergeableInstance(result, descriptor.type);
-  return result;
+  if (target === localValue && !sameType) {
+    target = shallowCopy(localValue);
+  }
+  if (getMergeableType(target) !== descriptor.type) {
+    markMergeableInstance(target, descriptor.type);
+  }
+  return target;
 }
 
-export function mergeMergeableValues<T>(localValue: T, remoteValue: T): T {
+export function mergeMergeableValues<T>(
+  localValue: T,
+  remoteValue: T,
+  options: MergeOptions = {}
+): T {
   const mergeableType = getMergeableType(remoteValue) ?? getMergeableType(localValue);
 
   if (!mergeableType) {
@@ -67,12 +199,13 @@ export function mergeMergeableValues<T>(localValue: T, remoteValue: T): T {
   }
 
   if (descriptor.merge) {
-    const merged = descriptor.merge(cloneForMerge(localValue), cloneForMerge(remoteValue));
-    if (isObjectLike(merged)) {
+    const local = options.ownsLocal ? localValue : cloneForMerge(localValue);
+    const merged = descriptor.merge(local, cloneForMerge(remoteValue));
+    if (isObjectLike(merged) && getMergeableType(merged) !== mergeableType) {
       markMergeableInstance(merged, mergeableType);
     }
     return merged;
   }
 
-  return mergeDefaultFields(descriptor, localValue, remoteValue);
+  return mergeDefaultFields(descriptor, localValue, remoteValue, options.ownsLocal === true);
 }
@@ -10,7 +10,7 @@ interface MethodRegistryGlobal {
 
 export interface RuntimeLogicEntry {
   target: new (...args: any[]) => any;
-  stateClass: any;
+  _calimeroStateClass: any;
   init?: string;
   methods: Map<string, string[]>;
   mutating: Map<string, boolean>;
@@ -21,7 +21,7 @@ const registry: MethodRegistrySnapshot = {
   functions: [],
 };
 
-const runtimeLogic = new Map<new (...args: any[]) => any, RuntimeLogicEntry>();
+const runtimeLogic = /* @__PURE__ */ new Map<new (...args: any[]) => any, RuntimeLogicEntry>();
 
 const globalTarget: MethodRegistryGlobal | undefined =
   typeof globalThis !== 'undefined' ? (globalThis as MethodRegistryGlobal) : undefined;
@@ -72,15 +72,15 @@ function ensureRuntimeLogicEntry(
 ): RuntimeLogicEntry {
   const existing = runtimeLogic.get(target);
   if (existing) {
-    if (!existing.stateClass && stateClass) {
-      existing.stateClass = stateClass;
+    if (!existing._calimeroStateClass && stateClass) {
+      existing._calimeroStateClass = stateClass;
     }
     return existing;
   }
 
   const entry: RuntimeLogicEntry = {
     target,
-    stateClass,
+    _calimeroStateClass: stateClass,
     methods: new Map<string, string[]>(),
     mutating: new Map<string, boolean>(),
   };
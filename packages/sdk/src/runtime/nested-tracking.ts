@@ -5,70 +5,90 @@
  * to parent collections for proper synchronization.
  */
 
-import { hasRegisteredCollection, snapshotCollection } from './collections';
+import { collectionHandle, collectionHandleType, hasRegisteredCollection } from './collections';
 import { flushDelta, executorId } from '../env/api';
 
-interface CollectionTracker {
-  id: string;
-  type: string;
-  parents: Set<CollectionParent>;
-  children: Set<string>;
-}
-
 interface CollectionParent {
   collection: any;
   key: any;
+  handle: number;
 }
 
+function sameParentKey(a: any, b: any): boolean {
+  if (a === b) return true;
+  if (a instanceof Uint8Array && b instanceof Uint8Array) {
+    if (a.length !== b.length) return false;
+    for (let i = 0; i < a.length; i += 1) {
+      if (a[i] !== b[i]) return false;
+    }
+    return true;
+  }
+  const handle = collectionHandle(a);
+  return handle !== -1 && handle === collectionHandle(b);
+}
+
+/**
+ * Bookkeeping is indexed by the interned collection handle (see `brandCollection`): parent
+ * edges live in an array slot per handle and propagation uses per-handle dirty bits, so
+ * registering and notifying never serialize a collection or copy sets.
+ */
 class NestedCollectionTracker {
-  private trackers = new Map<string, CollectionTracker>();
-  private pendingUpdates = new Set<string>();
-  private updateScheduled = false;
+  private parents: Array<CollectionParent[] | undefined> = [];
+  private dirty = new Uint8Array(64);
+  private refreshed = new Uint8Array(64);
+  private _calimeroPendingUpdates: number[] = [];
+  private refreshedParents: number[] = [];
+  private _calimeroUpdateScheduled = false;
 
   /**
    * Register a collection and its nested relationships
    */
   registerCollection(collection: any, parentCollection?: any, parentKey?: any): void {
-    const snapshot = snapshotCollection(collection);
-    if (!snapshot) return;
-
-    let tracker = this.trackers.get(snapshot.id);
-    if (!tracker) {
-      tracker = {
-        id: snapshot.id,
-        type: snapshot.type,
-        parents: new Set(),
-        children: new Set(),
-      };
-      this.trackers.set(snapshot.id, tracker);
+    const handle = collectionHandle(collection);
+    if (handle === -1) return;
+    this.ensureCapacity(handle);
+
+    if (!parentCollection) return;
+    const parentHandle = collectionHandle(parentCollection);
+    if (parentHandle === -1) return;
+
+    let edges = this.parents[handle];
+    if (!edges) {
+      edges = [];
+      this.parents[handle] = edges;
     }
-
-    // Register parent relationship
-    if (parentCollection) {
-      const parentSnapshot = snapshotCollection(parentCollection);
-      if (parentSnapshot) {
-        tracker.parents.add({ collection: parentCollection, key: parentKey });
-
-        const parentTracker = this.trackers.get(parentSnapshot.id);
-        if (parentTracker) {
-          parentTracker.children.add(snapshot.id);
-        }
+    for (const edge of edges) {
+      if (edge.handle === parentHandle && sameParentKey(edge.key, parentKey)) {
+        // Re-registration under the same slot: keep the freshest parent instance
+        edge.collection = parentCollection;
+        return;
       }
     }
-
-    // Collection is now registered for tracking
+    edges.push({ collection: parentCollection, key: parentKey, handle: parentHandle });
   }
 
   /**
    * Notify that a collection has been modified
    */
   notifyCollectionModified(collection: any): void {
-    const snapshot = snapshotCollection(collection);
-    if (snapshot) {
-      this.markForUpdate(snapshot.id);
+    const handle = collectionHandle(collection);
+    if (handle !== -1) {
+      this._calimeroMarkForUpdate(handle);
     }
   }
 
+  private ensureCapacity(handle: number): void {
+    if (handle < this.dirty.length) return;
+    let size = this.dirty.length * 2;
+    while (size <= handle) size *= 2;
+    const dirty = new Uint8Array(size);
+    dirty.set(this.dirty);
+    this.dirty = dirty;
+    const refreshed = new Uint8Array(size);
+    refreshed.set(this.refreshed);
+    this.refreshed = refreshed;
+  }
+
   /**
    * Mark a collection for update and propagate changes synchronously.
    *
@@ -77,74 +97,58 @@ class NestedCollectionTracker {
    * returns and state is saved. This ensures changes are properly
    * propagated to parent collections before state persistence.
    */
-  private markForUpdate(collectionId: string): void {
-    this.pendingUpdates.add(collectionId);
+  private _calimeroMarkForUpdate(handle: number): void {
+    this.ensureCapacity(handle);
+    if (this.dirty[handle] === 0) {
+      this.dirty[handle] = 1;
+      this._calimeroPendingUpdates.push(handle);
+    }
 
-    // Propagate changes synchronously to ensure they're captured
-    // before state is saved. Using microtasks doesn't work reliably
-    // in QuickJS/WASM environment.
-    if (!this.updateScheduled) {
-      this.updateScheduled = true;
-      this.propagateUpdates();
-      this.updateScheduled = false;
+    // Cascading updates (forceParentUpdate re-marking parents) only set dirty
+    // bits; the outermost call walks them.
+    if (!this._calimeroUpdateScheduled) {
+      this._calimeroUpdateScheduled = true;
+      try {
+        this._calimeroPropagateUpdates();
+      } finally {
+        this._calimeroUpdateScheduled = false;
+      }
     }
   }
 
   /**
-   * Propagate updates to parent collections.
-   * Uses a loop to handle cascading updates (when forceParentUpdate adds new pending updates).
+   * Walk dirty collections up their parent chains. Each collection is visited and each
+   * parent refreshed at most once per notification; dirty bits are cleared afterwards.
    */
-  private propagateUpdates(): void {
-    const maxIterations = 100; // Prevent infinite loops
-    let iterations = 0;
-
-    while (this.pendingUpdates.size > 0 && iterations < maxIterations) {
-      iterations++;
-
-      // Get the current set of pending updates and clear it
-      const currentUpdates = new Set(this.pendingUpdates);
-      this.pendingUpdates.clear();
-
-      // Track collections processed in THIS iteration only
-      // This allows collections to be reprocessed in subsequent iterations
-      // if they're re-marked for update (e.g., via forceParentUpdate)
-      const processedThisIteration = new Set<string>();
-      // Track parents processed in THIS iteration only
-      // This allows parents to be reprocessed in subsequent iterations
-      // if they're re-marked for update (cascading updates)
-      const processedParentsThisIteration = new Set<string>();
-
-      for (const collectionId of currentUpdates) {
-        // Skip if we've already processed this collection in this iteration
-        if (processedThisIteration.has(collectionId)) continue;
-        processedThisIteration.add(collectionId);
-
-        const tracker = this.trackers.get(collectionId);
-        if (!tracker) continue;
-
-        // Notify all parent collections
-        for (const parent of tracker.parents) {
-          const parentSnapshot = snapshotCollection(parent.collection);
-          // Skip if already processed in this iteration (prevents duplicate processing)
-          // But allow reprocessing in next iteration if re-marked
-          if (!parentSnapshot || processedParentsThisIteration.has(parentSnapshot.id)) continue;
-
-          // Force parent to re-serialize by calling set with the same key/value
-          this.forceParentUpdate(parent.collection, parent.key, tracker.id);
-          processedParentsThisIteration.add(parentSnapshot.id);
-        }
+  private _calimeroPropagateUpdates(): void {
+    const pending = this._calimeroPendingUpdates;
+    for (let i = 0; i < pending.length; i += 1) {
+      const edges = this.parents[pending[i]];
+      if (!edges) continue;
+
+      for (const parent of edges) {
+        if (this.refreshed[parent.handle] === 1) continue;
+        this.refreshed[parent.handle] = 1;
+        this.refreshedParents.push(parent.handle);
+
+        // Force parent to re-serialize by calling set with the same key/value
+        this._calimeroForceParentUpdate(parent.collection, parent.key, parent.handle);
       }
     }
+
+    for (const handle of pending) this.dirty[handle] = 0;
+    for (const handle of this.refreshedParents) this.refreshed[handle] = 0;
+    pending.length = 0;
+    this.refreshedParents.length = 0;
   }
 
   /**
    * Force a parent collection to update by re-setting the nested collection
    */
-  private forceParentUpdate(parentCollection: any, key: any, _childId: string): void {
-    const parentSnapshot = snapshotCollection(parentCollection);
-    if (!parentSnapshot) return;
+  private _calimeroForceParentUpdate(parentCollection: any, key: any, parentHandle: number): void {
+    const parentType = collectionHandleType(parentHandle);
 
-    if (parentSnapshot.type === 'UnorderedMap' && parentCollection.get && parentCollection.set) {
+    if (parentType === 'UnorderedMap' && parentCollection.get && parentCollection.set) {
       const currentValue = parentCollection.get(key);
       if (currentValue) {
         // Temporarily unwrap to avoid infinite recursion
@@ -152,9 +156,9 @@ class NestedCollectionTracker {
         originalSet.call(parentCollection, key, currentValue);
 
         // Mark parent for update too
-        this.markForUpdate(parentSnapshot.id);
+        this._calimeroMarkForUpdate(parentHandle);
       }
-    } else if (parentSnapshot.type === 'UserStorage') {
+    } else if (parentType === 'UserStorage') {
       // UserStorage uses insert() for setting values for the current executor
       // For nested collections inside UserStorage, we need to re-insert to propagate changes
       // IMPORTANT: We can only update nested collections that belong to the current executor.
@@ -204,21 +208,21 @@ class NestedCollectionTracker {
           const originalInsert = Object.getPrototypeOf(parentCollection).insert;
           originalInsert.call(parentCollection, currentValue);
 
-          this.markForUpdate(parentSnapshot.id);
+          this._calimeroMarkForUpdate(parentHandle);
         }
       }
-    } else if (parentSnapshot.type === 'FrozenStorage') {
+    } else if (parentType === 'FrozenStorage') {
       // FrozenStorage is immutable, nested collections shouldn't change
       // Just mark for update to ensure consistency
-      this.markForUpdate(parentSnapshot.id);
-    } else if (parentSnapshot.type === 'Vector') {
+      this._calimeroMarkForUpdate(parentHandle);
+    } else if (parentType === 'Vector') {
       // For Vector, we can't modify individual elements in-place since it's append-only.
       // The nested collection change will still be tracked and propagated through
       // the normal CRDT synchronization mechanism, but we mark the parent for update
       // to ensure proper propagation timing.
-      this.markForUpdate(parentSnapshot.id);
+      this._calimeroMarkForUpdate(parentHandle);
     } else if (
-      parentSnapshot.type === 'UnorderedSet' &&
+      parentType === 'UnorderedSet' &&
       parentCollection.has &&
       parentCollection.add &&
       parentCollection.delete
@@ -233,7 +237,7 @@ class NestedCollectionTracker {
         originalAdd.call(parentCollection, key);
 
         // Mark parent for update too
-        this.markForUpdate(parentSnapshot.id);
+        this._calimeroMarkForUpdate(parentHandle);
       }
     }
   }
@@ -262,4 +266,4 @@ class NestedCollectionTracker {
 }
 
 // Global instance
-export const nestedTracker = new NestedCollectionTracker();
+export const nestedTracker = /* @__PURE__ */ new NestedCollectionTracker();
@@ -6,6 +6,7 @@ import { serializeWithAbi, deserializeWithAbi } from '../utils/abi-serialize';
 import { BorshWriter } from '../borsh/encoder';
 import { BorshReader } from '../borsh/decoder';
 import type { TypeRef } from '../abi/types';
+import { compressValue, decompressValue, type CompressionCodec } from '../utils/compression';
 
 interface PersistedStateDocument {
   className: string;
@@ -19,7 +20,11 @@ interface PersistedStateDocument {
 
 const ROOT_METADATA = Symbol.for('__calimeroRootMetadata');
 
-export function saveRootState(state: any): Uint8Array {
+// Root document format versions (first byte)
+const FORMAT_ABI = 1;
+const FORMAT_COMPRESSED = 2; // [2][compressValue(version 1 document)]
+
+export function saveRootState(state: any, compression: CompressionCodec = 'none'): Uint8Array {
   if (!state || typeof state !== 'object') {
     throw new Error('StateManager.save expects an object instance');
   }
@@ -38,7 +43,9 @@ export function saveRootState(state: any): Uint8Array {
 
     const collectionSnapshot = snapshotCollection(value);
     if (collectionSnapshot) {
-      env.log(`[root] snapshotting collection field '${key}' with id=${collectionSnapshot.id}`);
+      env.logDebug(
+        () => `[root] snapshotting collection field '${key}' with id=${collectionSnapshot.id}`
+      );
       doc.collections[key] = collectionSnapshot;
       continue;
     }
@@ -156,7 +163,7 @@ export function saveRootState(state: any): Uint8Array {
   // Store collections and metadata using legacy format (they're JS-specific)
   // Format: [version: u8=1][state: borsh][collections: legacy][metadata: legacy]
   const writer = new BorshWriter();
-  writer.writeU8(1); // Version 1 = ABI format
+  writer.writeU8(FORMAT_ABI); // Version 1 = ABI format
   writer.writeBytes(statePayload);
 
   // Append collections and metadata using legacy format
@@ -167,28 +174,41 @@ export function saveRootState(state: any): Uint8Array {
   });
   writer.writeBytes(collectionsAndMetadata);
 
-  const payload = writer.toBytes();
-  env.log('[root] writing state using ABI-aware serialization (Rust-compatible)');
-
-  env.log('[root] writing state document to host');
+  let payload = writer.finish();
+  if (compression !== 'none') {
+    const rawLength = payload.length;
+    const framed = compressValue(payload, compression);
+    const compressed = new Uint8Array(framed.length + 1);
+    compressed[0] = FORMAT_COMPRESSED;
+    compressed.set(framed, 1);
+    env.logDebug(() => `[root] compressed state document: ${rawLength} -> ${compressed.length}`);
+    payload = compressed;
+  }
+  env.logDebug('[root] writing state document to host (ABI-aware, Rust-compatible)');
   env.persistRootState(payload, metadata.createdAt, metadata.updatedAt);
   return payload;
 }
 
 export function loadRootState<T>(stateClass: { new (...args: any[]): T }): T | null {
-  const source = env.readRootState();
+  let source = env.readRootState();
   if (!source) {
-    env.log('[root] host returned no root state payload');
+    env.logDebug('[root] host returned no root state payload');
     return null;
   }
 
-  env.log('[root] host returned persisted state payload');
+  env.logDebug('[root] host returned persisted state payload');
+
+  // Compressed documents wrap a version 1 document; uncompressed ones are read as before
+  if (source[0] === FORMAT_COMPRESSED) {
+    source = decompressValue(source.subarray(1));
+  }
 
   // ABI-aware format is required
-  const reader = new BorshReader(source);
+  // The payload is ours and short-lived: decode its sections as views rather than copies
+  const reader = new BorshReader(source, { borrow: true });
   const formatVersion = reader.readU8();
 
-  if (formatVersion !== 1) {
+  if (formatVersion !== FORMAT_ABI) {
     throw new Error(`Unsupported state format version: ${formatVersion} (expected 1)`);
   }
 
@@ -230,7 +250,7 @@ export function loadRootState<T>(stateClass: { new (...args: any[]): T }): T | n
     },
   };
 
-  env.log('[root] loaded state using ABI-aware deserialization (Rust-compatible)');
+  env.logDebug('[root] loaded state using ABI-aware deserialization (Rust-compatible)');
 
   if (
     typeof doc.className !== 'string' ||
@@ -265,7 +285,7 @@ export function loadRootState<T>(stateClass: { new (...args: any[]): T }): T | n
     try {
       const collection = instantiateCollection(snapshot);
       target[key] = collection;
-      env.log(`[root] hydrated collection field '${key}' with id=${snapshot.id}`);
+      env.logDebug(() => `[root] hydrated collection field '${key}' with id=${snapshot.id}`);
     } catch (error) {
       throw new Error(`Failed to hydrate collection '${key}': ${String(error)}`);
     }
@@ -284,7 +304,7 @@ export function loadRootState<T>(stateClass: { new (...args: any[]): T }): T | n
     }
   }
 
-  env.log('[root] finished hydrating state instance');
+  env.logDebug('[root] finished hydrating state instance');
   return instance;
 }
 
@@ -6,38 +6,41 @@
 
 import * as env from '../env/api';
 import { saveRootState, loadRootState } from './root';
+import type { CompressionCodec } from '../utils/compression';
 
 export class StateManager {
-  private static currentState: any = null;
-  private static stateClass: any = null;
+  private static _calimeroCurrentState: any = null;
+  private static _calimeroStateClass: any = null;
+  private static compression: CompressionCodec = 'none';
 
   /**
-   * Sets the current state class
+   * Sets the current state class and how its root document is stored
    */
-  static setStateClass(stateClass: any): void {
-    this.stateClass = stateClass;
+  static setStateClass(stateClass: any, options: { compression?: CompressionCodec } = {}): void {
+    this._calimeroStateClass = stateClass;
+    this.compression = options.compression ?? 'none';
   }
 
   /**
    * Loads state from storage
    */
   static load(): any | null {
-    if (this.currentState) {
-      env.log('[state-manager] returning cached state instance');
-      return this.currentState;
+    if (this._calimeroCurrentState) {
+      env.logDebug('[state-manager] returning cached state instance');
+      return this._calimeroCurrentState;
     }
 
-    if (this.stateClass) {
+    if (this._calimeroStateClass) {
       try {
-        const state = loadRootState(this.stateClass);
+        const state = loadRootState(this._calimeroStateClass);
         if (state) {
-          env.log('[state-manager] restored state from persisted snapshot');
-          this.currentState = state;
+          env.logDebug('[state-manager] restored state from persisted snapshot');
+          this._calimeroCurrentState = state;
           return state;
         }
-        env.log('[state-manager] no persisted state snapshot available');
+        env.logDebug('[state-manager] no persisted state snapshot available');
       } catch (error) {
-        env.log(`Failed to hydrate state: ${error}`);
+        env.logError(() => `Failed to hydrate state: ${error}`);
       }
     }
     return null;
@@ -48,27 +51,27 @@ export class StateManager {
    */
   static save(state: any): void {
     try {
-      env.log('[state-manager] persisting state snapshot');
-      saveRootState(state);
+      env.logDebug('[state-manager] persisting state snapshot');
+      saveRootState(state, this.compression);
     } catch (error) {
-      env.log(`Failed to persist state: ${error}`);
+      env.logError(() => `Failed to persist state: ${error}`);
       throw error;
     }
 
-    this.currentState = state;
+    this._calimeroCurrentState = state;
   }
 
   /**
    * Gets the current state
    */
   static getCurrent(): any {
-    return this.currentState;
+    return this._calimeroCurrentState;
   }
 
   /**
    * Sets the current state
    */
   static setCurrent(state: any): void {
-    this.currentState = state;
+    this._calimeroCurrentState = state;
   }
 }
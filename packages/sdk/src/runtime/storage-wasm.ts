@@ -15,6 +15,7 @@ import {
   jsCrdtMapNew,
   jsCrdtMapGet,
   jsCrdtMapInsert,
+  jsCrdtMapMergeInsert,
   jsCrdtMapRemove,
   jsCrdtMapContains,
   jsCrdtMapIter,
@@ -53,7 +54,7 @@ import {
 
 const REGISTER_ID = 0n;
 const COLLECTION_ID_LENGTH = 32;
-const textDecoder = new TextDecoder();
+const textDecoder = /* @__PURE__ */ new TextDecoder();
 
 function readRegisterBytes(): Uint8Array {
   const length = Number(registerLen(REGISTER_ID));
@@ -140,6 +141,36 @@ export function mapInsert(
   return previous;
 }
 
+/**
+ * Read-merge-write on a map entry. `merge` is called exactly once with the stored bytes
+ * (or `null` when the key is absent) and returns the bytes to store; the stored bytes must
+ * not be retained past the callback. Returns the previous value like {@link mapInsert}.
+ */
+export function mapMergeInsert(
+  mapId: Uint8Array,
+  key: Uint8Array,
+  merge: (current: Uint8Array | null) => Uint8Array
+): Uint8Array | null {
+  ensureCollectionId(mapId, 'mapId');
+  ensureUint8Array(key, 'key');
+
+  const native = jsCrdtMapMergeInsert(mapId, key, merge, REGISTER_ID);
+  if (native === null) {
+    return mapInsert(mapId, key, merge(mapGet(mapId, key)));
+  }
+
+  const status = Number(native);
+  if (status < 0) {
+    decodeError('mapMergeInsert');
+  }
+
+  if (status === 0) {
+    return null;
+  }
+
+  return readRegisterBytes();
+}
+
 export function mapRemove(mapId: Uint8Array, key: Uint8Array): Uint8Array | null {
   ensureCollectionId(mapId, 'mapId');
   ensureUint8Array(key, 'key');
@@ -200,7 +231,8 @@ export function mapEntries(mapId: Uint8Array): Array<[Uint8Array, Uint8Array]> {
     if (keyEnd > payload.length) {
       throw new Error('[storage] mapIter payload truncated (key bytes)');
     }
-    const keyBytes = payload.slice(offset, keyEnd);
+    // The register copy is owned by this call, so entries can be views into it
+    const keyBytes = payload.subarray(offset, keyEnd);
     offset = keyEnd;
 
     if (offset + 4 > payload.length) {
@@ -212,7 +244,7 @@ export function mapEntries(mapId: Uint8Array): Array<[Uint8Array, Uint8Array]> {
     if (valueEnd > payload.length) {
       throw new Error('[storage] mapIter payload truncated (value bytes)');
     }
-    const valueBytes = payload.slice(offset, valueEnd);
+    const valueBytes = payload.subarray(offset, valueEnd);
     offset = valueEnd;
 
     entries.push([keyBytes, valueBytes]);
@@ -405,7 +437,7 @@ export function setValues(setId: Uint8Array): Uint8Array[] {
       throw new Error('[storage] setIter payload truncated (value bytes)');
     }
 
-    values.push(payload.slice(offset, end));
+    values.push(payload.subarray(offset, end));
     offset = end;
   }
 
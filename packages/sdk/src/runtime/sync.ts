@@ -1,7 +1,33 @@
-import { applyStorageDelta, input, registerLen, readRegister, log } from '../env/api';
+import {
+  applyStorageDelta,
+  flushDelta,
+  input,
+  registerLen,
+  readRegister,
+  logError,
+  logDebug,
+  valueReturnBytes,
+} from '../env/api';
+import { BorshReader } from '../borsh/decoder';
 
 const REGISTER_ID = 0n;
 
+const textEncoder = /* @__PURE__ */ new TextEncoder();
+
+export interface SyncBatchFailure {
+  index: number;
+  error: string;
+}
+
+export interface SyncBatchReport {
+  /** Number of deltas applied: always the first `applied` of the batch */
+  applied: number;
+  /** The delta that failed, if any; nothing after it was applied */
+  failed: SyncBatchFailure | null;
+  /** Indices of the deltas not applied: the failed one and every one after it */
+  notApplied: number[];
+}
+
 function readDeltaPayload(): Uint8Array {
   input(REGISTER_ID);
   const length = Number(registerLen(REGISTER_ID));
@@ -23,9 +49,75 @@ function handleSyncNext(): void {
 
     applyStorageDelta(payload);
   } catch (error) {
-    log(`[sync] __calimero_sync_next error=${String(error)}`);
+    logError(() => `[sync] __calimero_sync_next error=${String(error)}`);
     throw error;
   }
 }
 
+/**
+ * Splits a batch payload (Borsh `Vec<Vec<u8>>`: u32 count, then u32 length + bytes per delta)
+ * into views over the input buffer.
+ */
+export function decodeDeltaBatch(payload: Uint8Array): Uint8Array[] {
+  if (payload.length === 0) {
+    return [];
+  }
+  const reader = new BorshReader(payload, { borrow: true });
+  const count = reader.readU32();
+  const deltas: Uint8Array[] = new Array(count);
+  for (let i = 0; i < count; i += 1) {
+    deltas[i] = reader.readBytes();
+  }
+  if (reader.remaining() !== 0) {
+    throw new Error('[sync] delta batch has trailing bytes');
+  }
+  return deltas;
+}
+
+/**
+ * Applies the deltas of the batch in order within this single invocation, then flushes once.
+ * Deltas may depend on earlier ones, so application stops at the first delta that throws: it and
+ * every later delta are reported as not applied, for the host to resend.
+ *
+ * Only errors raised in JS are caught here. A host trap aborts the Wasm instance, and with it
+ * the whole invocation, before any report is returned.
+ */
+export function applyDeltaBatch(deltas: Uint8Array[]): SyncBatchReport {
+  const report: SyncBatchReport = { applied: 0, failed: null, notApplied: [] };
+  for (let index = 0; index < deltas.length; index += 1) {
+    try {
+      applyStorageDelta(deltas[index]);
+      report.applied += 1;
+    } catch (error) {
+      report.failed = { index, error: String(error) };
+      for (let rest = index; rest < deltas.length; rest += 1) {
+        report.notApplied.push(rest);
+      }
+      logError(
+        () => `[sync] delta ${index} failed, ${deltas.length - index} not applied: ${String(error)}`
+      );
+      break;
+    }
+  }
+
+  if (report.applied > 0) {
+    flushDelta();
+  }
+  return report;
+}
+
+function handleSyncBatch(): void {
+  let report: SyncBatchReport;
+  try {
+    report = applyDeltaBatch(decodeDeltaBatch(readDeltaPayload()));
+  } catch (error) {
+    logError(() => `[sync] __calimero_sync_batch error=${String(error)}`);
+    throw error;
+  }
+
+  logDebug(() => `[sync] batch applied=${report.applied} notApplied=${report.notApplied.length}`);
+  valueReturnBytes(textEncoder.encode(JSON.stringify(report)));
+}
+
 (globalThis as any).__calimero_sync_next = handleSyncNext;
+(globalThis as any).__calimero_sync_batch = handleSyncBatch;
@@ -0,0 +1,199 @@
+/**
+ * Cross-context call queue
+ *
+ * While a dispatched method runs, `xcall` / `xcallMany` only record the call. When the method
+ * returns, the dispatcher packs the queue and hands it to `builder.c` in one `xcall_batch` call.
+ * The host runs cross-context calls after the current execution anyway, so queueing does not
+ * change when they happen. Function names and params are deduplicated: a fan-out to N contexts
+ * carries one copy of each.
+ *
+ * Packed layout (Borsh):
+ *   functions: Vec<Vec<u8>>
+ *   params:    Vec<Vec<u8>>
+ *   calls:     Vec<(context_id: [u8; 32], function: u32, params: u32)>
+ */
+
+import type { HostEnv } from '../env/bindings';
+import { BorshWriter } from '../borsh/encoder';
+import { BorshReader } from '../borsh/decoder';
+import { bytesToHex } from '../utils/hex';
+
+declare const env: HostEnv;
+
+// Params up to this size are also deduplicated by content, not just by identity
+const CONTENT_DEDUP_LIMIT = 1024;
+
+const textEncoder = /* @__PURE__ */ new TextEncoder();
+
+interface XCallQueue {
+  functions: Uint8Array[];
+  functionIndex: Map<string, number>;
+  params: Uint8Array[];
+  paramsByRef: Map<Uint8Array, number>;
+  paramsByContent: Map<string, number>;
+  calls: Array<{ contextId: Uint8Array; fn: number; params: number }>;
+}
+
+let queue: XCallQueue | null = null;
+
+/**
+ * Starts queueing cross-context calls for the current invocation. Called by the dispatcher.
+ */
+export function beginXCallBatch(): void {
+  queue = {
+    functions: [],
+    functionIndex: new Map(),
+    params: [],
+    paramsByRef: new Map(),
+    paramsByContent: new Map(),
+    calls: [],
+  };
+}
+
+/**
+ * Records a call, or sends it straight to the host when no batch is open.
+ * `contextId` must already be validated as 32 bytes.
+ */
+export function enqueueXCall(
+  contextId: Uint8Array,
+  functionName: string,
+  params: Uint8Array
+): void {
+  enqueueXCalls([contextId], functionName, params);
+}
+
+/**
+ * Records the same call on every context of `contextIds`, or sends them straight to the host
+ * when no batch is open. The function name and params are interned once for the whole fan-out.
+ * Context ids must already be validated as 32 bytes.
+ */
+export function enqueueXCalls(
+  contextIds: Uint8Array[],
+  functionName: string,
+  params: Uint8Array
+): void {
+  if (!queue) {
+    const name = textEncoder.encode(functionName);
+    for (const contextId of contextIds) {
+      env.xcall(contextId, name, params);
+    }
+    return;
+  }
+
+  let fn = queue.functionIndex.get(functionName);
+  if (fn === undefined) {
+    fn = queue.functions.push(textEncoder.encode(functionName)) - 1;
+    queue.functionIndex.set(functionName, fn);
+  }
+  const paramsIndex = internParams(queue, params);
+
+  for (const contextId of contextIds) {
+    // Copy the context id: callers may reuse their buffer before the flush
+    queue.calls.push({ contextId: contextId.slice(), fn, params: paramsIndex });
+  }
+}
+
+/**
+ * Packs the queue into the `xcall_batch` layout.
+ */
+export function encodeXCallBatch(
+  functions: Uint8Array[],
+  params: Uint8Array[],
+  calls: Array<{ contextId: Uint8Array; fn: number; params: number }>
+): Uint8Array {
+  const size =
+    12 +
+    functions.reduce((sum, bytes) => sum + 4 + bytes.length, 0) +
+    params.reduce((sum, bytes) => sum + 4 + bytes.length, 0) +
+    calls.length * 40;
+  const writer = new BorshWriter(size);
+  writer.writeVec(functions, bytes => writer.writeBytes(bytes));
+  writer.writeVec(params, bytes => writer.writeBytes(bytes));
+  writer.writeVec(calls, call => {
+    writer.writeFixedArray(call.contextId);
+    writer.writeU32(call.fn);
+    writer.writeU32(call.params);
+  });
+  return writer.finish();
+}
+
+/**
+ * Hands every queued call to the host and stops queueing. Returns the number of calls sent.
+ */
+export function flushXCallBatch(): number {
+  const pending = queue;
+  queue = null;
+  if (!pending || pending.calls.length === 0) {
+    return 0;
+  }
+
+  const packed = encodeXCallBatch(pending.functions, pending.params, pending.calls);
+  if (typeof env.xcall_batch === 'function') {
+    env.xcall_batch(packed);
+  } else {
+    dispatchSequentially(packed);
+  }
+  return pending.calls.length;
+}
+
+/**
+ * Drops queued calls (the invocation failed) and stops queueing.
+ */
+export function discardXCallBatch(): void {
+  queue = null;
+}
+
+function internParams(pending: XCallQueue, params: Uint8Array): number {
+  // The same buffer object may have been refilled since it was queued, so confirm the bytes
+  const byRef = pending.paramsByRef.get(params);
+  if (byRef !== undefined && sameBytes(pending.params[byRef], params)) {
+    return byRef;
+  }
+
+  const key = params.length <= CONTENT_DEDUP_LIMIT ? bytesToHex(params) : null;
+  let index = key === null ? undefined : pending.paramsByContent.get(key);
+  if (index === undefined) {
+    // Copy: the caller may mutate its buffer before the flush
+    index = pending.params.push(params.slice()) - 1;
+    if (key !== null) {
+      pending.paramsByContent.set(key, index);
+    }
+  }
+  pending.paramsByRef.set(params, index);
+  return index;
+}
+
+function sameBytes(a: Uint8Array, b: Uint8Array): boolean {
+  if (a.length !== b.length) {
+    return false;
+  }
+  for (let i = 0; i < a.length; i++) {
+    if (a[i] !== b[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * Fallback for runtimes without `xcall_batch`: issues the calls one at a time, in order.
+ */
+function dispatchSequentially(packed: Uint8Array): void {
+  const reader = new BorshReader(packed, { borrow: true });
+  const readTable = (): Uint8Array[] => {
+    const entries: Uint8Array[] = [];
+    for (let i = reader.readU32(); i > 0; i--) {
+      entries.push(reader.readBytes());
+    }
+    return entries;
+  };
+  const functions = readTable();
+  const params = readTable();
+  const count = reader.readU32();
+  for (let i = 0; i < count; i++) {
+    const contextId = reader.readFixedArray(32);
+    const fn = reader.readU32();
+    const callParams = reader.readU32();
+    env.xcall(contextId, functions[fn], params[callParams]);
+  }
+}
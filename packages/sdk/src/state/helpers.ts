@@ -5,7 +5,12 @@
  */
 import { UnorderedMap } from '../collections/UnorderedMap';
 import { UnorderedSet } from '../collections/UnorderedSet';
+import { BloomSet } from '../collections/BloomSet';
 import { Vector } from '../collections/Vector';
+import { PackedVector } from '../collections/PackedVector';
+import { AppendLog } from '../collections/AppendLog';
+import { SortedMap } from '../collections/SortedMap';
+import { IndexedMap } from '../collections/IndexedMap';
 import { Counter } from '../collections/Counter';
 import { LwwRegister } from '../collections/LwwRegister';
 import { UserStorage } from '../collections/UserStorage';
@@ -13,7 +18,13 @@ import { FrozenStorage } from '../collections/FrozenStorage';
 
 import type { UnorderedMapOptions } from '../collections/UnorderedMap';
 import type { UnorderedSetOptions } from '../collections/UnorderedSet';
+import type { BloomSetOptions } from '../collections/BloomSet';
 import type { VectorOptions } from '../collections/Vector';
+import type { PackedVectorOptions, PackedElementType } from '../collections/PackedVector';
+import type { AppendLogOptions } from '../collections/AppendLog';
+import type { SortedMapOptions } from '../collections/SortedMap';
+import type { OrderedKey } from '../utils/ordered-key';
+import type { IndexedMapOptions } from '../collections/IndexedMap';
 import type { CounterOptions } from '../collections/Counter';
 import type { LwwRegisterOptions } from '../collections/LwwRegister';
 import type { UserStorageOptions } from '../collections/UserStorage';
@@ -27,10 +38,34 @@ export function createUnorderedSet<T>(options?: UnorderedSetOptions<T>): Unorder
   return new UnorderedSet<T>(options);
 }
 
+export function createBloomSet<T>(options?: BloomSetOptions): BloomSet<T> {
+  return new BloomSet<T>(options);
+}
+
+export function createSortedMap<K extends OrderedKey, V>(
+  options?: SortedMapOptions
+): SortedMap<K, V> {
+  return new SortedMap<K, V>(options);
+}
+
+export function createIndexedMap<K, V>(options: IndexedMapOptions): IndexedMap<K, V> {
+  return new IndexedMap<K, V>(options);
+}
+
 export function createVector<T>(options?: VectorOptions): Vector<T> {
   return new Vector<T>(options);
 }
 
+export function createPackedVector<E extends PackedElementType>(
+  options: PackedVectorOptions<E>
+): PackedVector<E> {
+  return new PackedVector<E>(options);
+}
+
+export function createAppendLog<T>(options?: AppendLogOptions): AppendLog<T> {
+  return new AppendLog<T>(options);
+}
+
 export function createCounter(
   options?: CounterOptions & { initialValue?: number | bigint }
 ): Counter {
@@ -1,7 +1,7 @@
 import { storageRead, storageWrite, storageRemove } from '../env/api';
 import { serialize, deserialize } from '../utils/serialize';
 
-const textEncoder = new TextEncoder();
+const textEncoder = /* @__PURE__ */ new TextEncoder();
 
 type KeyInput = string | Uint8Array;
 
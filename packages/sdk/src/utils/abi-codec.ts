@@ -0,0 +1,258 @@
+/**
+ * Typed collection codecs
+ *
+ * A codec encodes collection keys/values with plain ABI Borsh (`string` → u32 length + UTF-8,
+ * `u64` → 8 bytes LE, records field by field) instead of the SDK's self-describing value
+ * encoding. Codecs are compiled once per type: common scalars get dedicated encoders, everything
+ * else goes through the ABI-aware serializer so bytes stay identical to `serializeWithAbi`.
+ */
+
+import type { AbiManifest, ScalarType, TypeRef } from '../abi/types';
+import { getAbiManifest } from '../abi/helpers';
+import { serializeWithAbi, deserializeWithAbi } from './abi-serialize';
+
+export interface Codec<T = unknown> {
+  /** ABI type the codec encodes; persisted with the collection so reloads keep the codec. */
+  readonly spec: TypeRef;
+  encode(value: T): Uint8Array;
+  decode(bytes: Uint8Array): T;
+}
+
+/**
+ * Anything `codecFor` accepts: a ready codec, an ABI type reference, or a scalar type name.
+ */
+export type CodecSpec<T = unknown> = Codec<T> | TypeRef | ScalarType;
+
+const EMPTY_MANIFEST: AbiManifest = { schema_version: '', types: {}, methods: [], events: [] };
+
+const codecCache = /* @__PURE__ */ new Map<string, Codec<any>>();
+
+const U64_MAX = 0xffffffffffffffffn;
+
+const textEncoder = /* @__PURE__ */ new TextEncoder();
+const textDecoder = /* @__PURE__ */ new TextDecoder();
+
+function isCodec(spec: unknown): spec is Codec<unknown> {
+  return (
+    Boolean(spec) &&
+    typeof spec === 'object' &&
+    typeof (spec as Codec).encode === 'function' &&
+    typeof (spec as Codec).decode === 'function'
+  );
+}
+
+function scalarOf(typeRef: TypeRef): ScalarType | null {
+  if (typeRef.kind === 'scalar') {
+    return typeRef.scalar ?? null;
+  }
+  switch (typeRef.kind) {
+    case 'option':
+    case 'vector':
+    case 'list':
+    case 'map':
+    case 'set':
+    case 'reference':
+      return null;
+    default:
+      return typeRef.$ref ? null : typeRef.kind;
+  }
+}
+
+function expectLength(bytes: Uint8Array, length: number, type: string): void {
+  if (bytes.length !== length) {
+    throw new Error(`Invalid ${type} encoding: expected ${length} bytes, got ${bytes.length}`);
+  }
+}
+
+function viewOf(bytes: Uint8Array): DataView {
+  return new DataView(bytes.buffer, bytes.byteOffset, bytes.byteLength);
+}
+
+function prefixed(payload: Uint8Array): Uint8Array {
+  const out = new Uint8Array(4 + payload.length);
+  viewOf(out).setUint32(0, payload.length, true);
+  out.set(payload, 4);
+  return out;
+}
+
+function unprefixed(bytes: Uint8Array, type: string): Uint8Array {
+  if (bytes.length < 4) {
+    throw new Error(`Invalid ${type} encoding: missing length prefix`);
+  }
+  const length = viewOf(bytes).getUint32(0, true);
+  expectLength(bytes, 4 + length, type);
+  return bytes.subarray(4);
+}
+
+function compileScalar(typeRef: TypeRef, scalar: ScalarType): Codec<any> | null {
+  switch (scalar) {
+    case 'string':
+      return {
+        spec: typeRef,
+        encode(value: string) {
+          if (typeof value !== 'string') {
+            throw new Error(`Expected string, got ${typeof value}`);
+          }
+          return prefixed(textEncoder.encode(value));
+        },
+        decode: bytes => textDecoder.decode(unprefixed(bytes, 'string')),
+      };
+    case 'bytes':
+      return {
+        spec: typeRef,
+        encode(value: Uint8Array) {
+          if (!(value instanceof Uint8Array)) {
+            throw new Error(`Expected Uint8Array for bytes, got ${typeof value}`);
+          }
+          return prefixed(value);
+        },
+        decode: bytes => new Uint8Array(unprefixed(bytes, 'bytes')),
+      };
+    case 'bool':
+      return {
+        spec: typeRef,
+        encode(value: boolean) {
+          if (typeof value !== 'boolean') {
+            throw new Error(`Expected boolean, got ${typeof value}`);
+          }
+          return new Uint8Array([value ? 1 : 0]);
+        },
+        decode(bytes) {
+          expectLength(bytes, 1, 'bool');
+          return bytes[0] === 1;
+        },
+      };
+    case 'u32':
+      return {
+        spec: typeRef,
+        encode(value: number) {
+          if (typeof value !== 'number') {
+            throw new Error(`Expected number for u32, got ${typeof value}`);
+          }
+          if (!Number.isInteger(value) || value < 0 || value > 0xffffffff) {
+            throw new RangeError(`Value ${value} is out of range for u32`);
+          }
+          const out = new Uint8Array(4);
+          viewOf(out).setUint32(0, value, true);
+          return out;
+        },
+        decode(bytes) {
+          expectLength(bytes, 4, 'u32');
+          return viewOf(bytes).getUint32(0, true);
+        },
+      };
+    case 'u64':
+      return {
+        spec: typeRef,
+        encode(value: bigint | number) {
+          if (typeof value !== 'bigint' && typeof value !== 'number') {
+            throw new Error(`Expected bigint or number for u64, got ${typeof value}`);
+          }
+          if (typeof value === 'number' && !Number.isSafeInteger(value)) {
+            throw new RangeError(`Value ${value} is not a safe integer for u64; pass a bigint`);
+          }
+          const big = BigInt(value);
+          if (big < 0n || big > U64_MAX) {
+            throw new RangeError(`Value ${value} is out of range for u64`);
+          }
+          const out = new Uint8Array(8);
+          viewOf(out).setBigUint64(0, big, true);
+          return out;
+        },
+        decode(bytes) {
+          expectLength(bytes, 8, 'u64');
+          return viewOf(bytes).getBigUint64(0, true);
+        },
+      };
+    default:
+      return null;
+  }
+}
+
+function needsManifest(typeRef: TypeRef | undefined): boolean {
+  if (!typeRef) {
+    return false;
+  }
+  if (typeRef.kind === 'reference' || typeRef.$ref) {
+    return true;
+  }
+  return (
+    needsManifest(typeRef.inner) ||
+    needsManifest(typeRef.items) ||
+    needsManifest(typeRef.key) ||
+    needsManifest(typeRef.value)
+  );
+}
+
+function compile(typeRef: TypeRef, abi?: AbiManifest): Codec<any> {
+  const scalar = scalarOf(typeRef);
+  const specialized = scalar ? compileScalar(typeRef, scalar) : null;
+  if (specialized) {
+    return specialized;
+  }
+
+  // Scalars and containers of scalars never look anything up, so they work before (or
+  // without) an ABI manifest; references resolve against the manifest on each call.
+  const standalone = needsManifest(typeRef) ? undefined : EMPTY_MANIFEST;
+  return {
+    spec: typeRef,
+    encode: value => serializeWithAbi(value, typeRef, abi ?? standalone ?? getAbiManifest()!),
+    decode: bytes => deserializeWithAbi(bytes, typeRef, abi ?? standalone ?? getAbiManifest()!),
+  };
+}
+
+/**
+ * Returns the codec for `spec`, compiling and caching it on first use.
+ *
+ * @example
+ * codecFor('string');
+ * codecFor({ kind: 'list', items: { kind: 'u64' } });
+ * codecFor({ $ref: 'Profile' });
+ */
+export function codecFor<T = unknown>(spec: CodecSpec<T>, abi?: AbiManifest): Codec<T> {
+  if (isCodec(spec)) {
+    return spec as Codec<T>;
+  }
+  const typeRef: TypeRef = typeof spec === 'string' ? { kind: spec } : spec;
+  if (abi && needsManifest(typeRef)) {
+    return compile(typeRef, abi);
+  }
+
+  const cacheKey = JSON.stringify(typeRef);
+  let codec = codecCache.get(cacheKey);
+  if (!codec) {
+    codec = compile(typeRef);
+    codecCache.set(cacheKey, codec);
+  }
+  return codec;
+}
+
+/**
+ * Collection codec options derived from a state field declared in the ABI: map fields yield
+ * `keyCodec`/`valueCodec`, list/set fields (`Vector`, `UnorderedSet`) yield `valueCodec`.
+ *
+ * @example
+ * items = createUnorderedMap<string, bigint>(abiCollectionCodecs('AppState', 'items'));
+ */
+export function abiCollectionCodecs(
+  typeName: string,
+  fieldName: string,
+  abi?: AbiManifest
+): { keyCodec?: Codec<any>; valueCodec?: Codec<any> } {
+  const manifest = abi ?? getAbiManifest();
+  const record = manifest?.types?.[typeName];
+  const field = record?.kind === 'record' ? record.fields?.find(f => f.name === fieldName) : null;
+  if (!field) {
+    throw new Error(`ABI has no field '${fieldName}' on type '${typeName}'`);
+  }
+
+  const type = field.type;
+  if (type.kind === 'map' && type.key && type.value) {
+    return { keyCodec: codecFor(type.key, abi), valueCodec: codecFor(type.value, abi) };
+  }
+  const items = type.items ?? type.inner;
+  if ((type.kind === 'list' || type.kind === 'vector' || type.kind === 'set') && items) {
+    return { valueCodec: codecFor(items, abi) };
+  }
+  throw new Error(`ABI field '${typeName}.${fieldName}' is not a collection type`);
+}
@@ -21,7 +21,19 @@ export function serializeWithAbi(value: unknown, typeRef: TypeRef, abi?: AbiMani
 
   const writer = new BorshWriter();
   serializeValue(writer, value, typeRef, manifest);
-  return writer.toBytes();
+  return writer.finish();
+}
+
+/**
+ * Serializes a value according to an ABI TypeRef, appending to an existing writer
+ */
+export function serializeWithAbiInto(
+  writer: BorshWriter,
+  value: unknown,
+  typeRef: TypeRef,
+  abi: AbiManifest
+): void {
+  serializeValue(writer, value, typeRef, abi);
 }
 
 /**
@@ -216,10 +228,7 @@ function serializeScalar(writer: BorshWriter, value: unknown, scalar: ScalarType
       }
       const bigValue = typeof value === 'bigint' ? value : BigInt(value);
       // u128 is two u64s in Borsh: low 64 bits, then high 64 bits
-      const lowBits = bigValue & BigInt('0xffffffffffffffff');
-      const highBits = bigValue >> 64n;
-      writer.writeU64(lowBits);
-      writer.writeU64(highBits);
+      writer.writeU128(bigValue);
       break;
     }
 
@@ -249,11 +258,8 @@ function serializeScalar(writer: BorshWriter, value: unknown, scalar: ScalarType
       if (scalar === 'i64') {
         writer.writeU64(signedBigValue);
       } else {
-        // i128 is two u64s in Borsh: low 64 bits, then high 64 bits
-        const lowBits = signedBigValue & BigInt('0xffffffffffffffff');
-        const highBits = signedBigValue >> 64n;
-        writer.writeU64(lowBits);
-        writer.writeU64(highBits);
+        // i128 is two u64s in Borsh (two's complement): low 64 bits, then high 64 bits
+        writer.writeU128(signedBigValue);
       }
       break;
     }
@@ -113,10 +113,14 @@ function normalizeValue(input: any, seen: Map<any, any>): NormalizedValue {
 
   const collectionSnapshot = snapshotCollection(input);
   if (collectionSnapshot) {
-    return {
+    const normalized: Record<string, NormalizedValue> = {
       __calimeroCollection: collectionSnapshot.type,
       id: collectionSnapshot.id,
-    } as unknown as NormalizedValue;
+    };
+    if (collectionSnapshot.codecs) {
+      normalized.codecs = normalizeValue(collectionSnapshot.codecs, seen);
+    }
+    return normalized as unknown as NormalizedValue;
   }
 
   const mergeType = getMergeableType(input);
@@ -204,6 +208,7 @@ function reviveValue(input: NormalizedValue): any {
     return instantiateCollection({
       type: maybeCollection.__calimeroCollection,
       id: maybeCollection.id,
+      codecs: maybeCollection.codecs ? reviveValue(maybeCollection.codecs) : undefined,
     });
   }
 
@@ -358,6 +363,9 @@ function finalizeCollections(value: any): any {
   if (Array.isArray(value)) {
     return value.map(finalizeCollections);
   }
+  if (value instanceof Uint8Array) {
+    return value;
+  }
 
   if (value && typeof value === 'object') {
     if (value.__calimeroSet && Array.isArray(value.values)) {
@@ -394,11 +402,98 @@ function finalizeCollections(value: any): any {
   return value;
 }
 
+type FlatScalar = null | undefined | boolean | number | string | bigint | Uint8Array;
+
+function isFlatScalar(value: unknown): value is FlatScalar {
+  switch (typeof value) {
+    case 'undefined':
+    case 'boolean':
+    case 'number':
+    case 'string':
+    case 'bigint':
+      return true;
+    case 'object':
+      return value === null || value instanceof Uint8Array;
+    default:
+      return false;
+  }
+}
+
+function encodeFlatScalar(value: FlatScalar, writer: BorshWriter): void {
+  encodeNormalizedValue(value === undefined ? null : value, writer);
+}
+
+/**
+ * Plain object (no mergeable type, no `toJSON`) whose values are all flat scalars.
+ */
+function flatRecordKeys(value: object): string[] | null {
+  if (!isPlainObject(value) || typeof value.toJSON === 'function' || getMergeableType(value)) {
+    return null;
+  }
+  const keys = Object.keys(value);
+  for (const key of keys) {
+    if (!isFlatScalar(value[key])) {
+      return null;
+    }
+  }
+  return keys;
+}
+
+/**
+ * Encodes primitives, `Uint8Array`s and flat plain records straight into the writer,
+ * producing the same bytes as the normalize/encode path without the intermediate tree.
+ * Returns false without writing anything for other shapes.
+ */
+function encodeFlatValue(value: unknown, writer: BorshWriter): boolean {
+  if (isFlatScalar(value)) {
+    encodeFlatScalar(value, writer);
+    return true;
+  }
+  if (typeof value !== 'object') {
+    return false;
+  }
+
+  const keys = flatRecordKeys(value as object);
+  if (!keys) {
+    return false;
+  }
+  const record = value as Record<string, FlatScalar>;
+  let defined = 0;
+  for (const key of keys) {
+    if (record[key] !== undefined) {
+      defined += 1;
+    }
+  }
+  writer.writeU8(ValueKind.Object);
+  writer.writeU32(defined);
+  for (const key of keys) {
+    const entry = record[key];
+    if (entry === undefined) {
+      continue;
+    }
+    writer.writeString(key);
+    encodeFlatScalar(entry, writer);
+  }
+  return true;
+}
+
 export function serializeJsValue(value: any): Uint8Array {
+  const writer = new BorshWriter();
+  if (encodeFlatValue(value, writer)) {
+    return writer.finish();
+  }
+  encodeNormalizedValue(normalizeValue(value, new Map()), writer);
+  return writer.finish();
+}
+
+/**
+ * Reference encoder: always normalizes first. `serializeJsValue` must produce identical bytes.
+ */
+export function serializeJsValueGeneric(value: any): Uint8Array {
   const normalized = normalizeValue(value, new Map());
   const writer = new BorshWriter();
   encodeNormalizedValue(normalized, writer);
-  return writer.toBytes();
+  return writer.finish();
 }
 
 export function deserializeJsValue<T = unknown>(bytes: Uint8Array): T {
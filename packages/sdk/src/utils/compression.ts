@@ -0,0 +1,94 @@
+/**
+ * Value compression
+ *
+ * Framing shared by compressed collection values and the compressed root document:
+ *   0x00 ++ bytes                                  stored as is
+ *   0x01 ++ length (u32 LE) ++ LZ4 block           compressed, `length` bytes once expanded
+ *
+ * Inputs that are short or do not shrink are stored as is, so a compressed collection never
+ * grows by more than the tag byte. Compression runs in C through the `lz4_compress` /
+ * `lz4_decompress` wrappers in `builder.c`, with the TypeScript codec as a fallback.
+ */
+
+import type { HostEnv } from '../env/bindings';
+import { lz4Bound, lz4Compress, lz4Decompress } from './lz4';
+
+declare const env: HostEnv;
+
+export type CompressionCodec = 'none' | 'lz4';
+
+const RAW_TAG = 0x00;
+const LZ4_TAG = 0x01;
+const LZ4_HEADER_SIZE = 5;
+
+// Shorter inputs rarely shrink enough to pay for the header
+const MIN_COMPRESS_LENGTH = 32;
+
+export function validateCompressionCodec(codec: unknown): CompressionCodec {
+  if (codec !== 'none' && codec !== 'lz4') {
+    throw new RangeError(`Unsupported compression codec: ${String(codec)}`);
+  }
+  return codec;
+}
+
+function nativeCodec(): boolean {
+  return (
+    typeof env !== 'undefined' &&
+    typeof env.lz4_compress === 'function' &&
+    typeof env.lz4_decompress === 'function'
+  );
+}
+
+function storeRaw(bytes: Uint8Array): Uint8Array {
+  const out = new Uint8Array(bytes.length + 1);
+  out[0] = RAW_TAG;
+  out.set(bytes, 1);
+  return out;
+}
+
+/**
+ * Frames `bytes` for storage, compressing them with `codec` when that makes them smaller.
+ * The result may be a view into a larger buffer.
+ */
+export function compressValue(bytes: Uint8Array, codec: CompressionCodec): Uint8Array {
+  if (codec === 'none' || bytes.length < MIN_COMPRESS_LENGTH) {
+    return storeRaw(bytes);
+  }
+
+  const out = new Uint8Array(LZ4_HEADER_SIZE + lz4Bound(bytes.length));
+  const block = out.subarray(LZ4_HEADER_SIZE);
+  const size = nativeCodec() ? env.lz4_compress!(bytes, block) : lz4Compress(bytes, block);
+  if (size === 0 || LZ4_HEADER_SIZE + size >= bytes.length + 1) {
+    return storeRaw(bytes);
+  }
+
+  out[0] = LZ4_TAG;
+  new DataView(out.buffer).setUint32(1, bytes.length, true);
+  return out.subarray(0, LZ4_HEADER_SIZE + size);
+}
+
+/**
+ * Returns the bytes framed by {@link compressValue}. Raw frames are returned as views.
+ */
+export function decompressValue(framed: Uint8Array): Uint8Array {
+  if (framed.length === 0) {
+    throw new Error('Empty compressed value');
+  }
+  const tag = framed[0];
+  if (tag === RAW_TAG) {
+    return framed.subarray(1);
+  }
+  if (tag !== LZ4_TAG || framed.length < LZ4_HEADER_SIZE) {
+    throw new Error(`Unknown compression tag: ${tag}`);
+  }
+
+  const length = new DataView(framed.buffer, framed.byteOffset + 1, 4).getUint32(0, true);
+  const out = new Uint8Array(length);
+  const block = framed.subarray(LZ4_HEADER_SIZE);
+  if (nativeCodec()) {
+    env.lz4_decompress!(block, out);
+  } else {
+    lz4Decompress(block, out);
+  }
+  return out;
+}
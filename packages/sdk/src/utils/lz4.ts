@@ -0,0 +1,204 @@
+/**
+ * LZ4 block codec in TypeScript
+ *
+ * Same algorithm and output as `builder/lz4.h`. Used when the native `lz4_compress` /
+ * `lz4_decompress` wrappers are unavailable (tests, Node tooling, older builds), so compressed
+ * values can always be read back.
+ */
+
+const HASH_LOG = 12;
+const MIN_MATCH = 4;
+const MFLIMIT = 12;
+const LAST_LITERALS = 5;
+const MAX_OFFSET = 65535;
+
+let table: Uint32Array | null = null;
+
+/**
+ * Worst-case compressed size for `length` input bytes.
+ */
+export function lz4Bound(length: number): number {
+  return length + Math.floor(length / 255) + 16;
+}
+
+function read32(bytes: Uint8Array, pos: number): number {
+  return (
+    (bytes[pos] | (bytes[pos + 1] << 8) | (bytes[pos + 2] << 16) | (bytes[pos + 3] << 24)) >>> 0
+  );
+}
+
+function hash(sequence: number): number {
+  return Math.imul(sequence, 2654435761) >>> (32 - HASH_LOG);
+}
+
+function writeLength(dst: Uint8Array, op: number, length: number): number {
+  while (length >= 255) {
+    dst[op++] = 255;
+    length -= 255;
+  }
+  dst[op++] = length;
+  return op;
+}
+
+function writeSequence(
+  dst: Uint8Array,
+  op: number,
+  src: Uint8Array,
+  anchor: number,
+  literalLength: number,
+  offset: number,
+  matchLength: number
+): number {
+  let needed = 1 + literalLength + Math.floor(literalLength / 255) + 1;
+  if (matchLength) {
+    needed += 2 + Math.floor((matchLength - MIN_MATCH) / 255) + 1;
+  }
+  if (dst.length - op < needed) {
+    return -1;
+  }
+
+  const token = op++;
+  dst[token] = (literalLength >= 15 ? 15 : literalLength) << 4;
+  if (literalLength >= 15) {
+    op = writeLength(dst, op, literalLength - 15);
+  }
+  dst.set(src.subarray(anchor, anchor + literalLength), op);
+  op += literalLength;
+
+  if (matchLength) {
+    const extra = matchLength - MIN_MATCH;
+    dst[op++] = offset & 0xff;
+    dst[op++] = offset >> 8;
+    dst[token] |= extra >= 15 ? 15 : extra;
+    if (extra >= 15) {
+      op = writeLength(dst, op, extra - 15);
+    }
+  }
+  return op;
+}
+
+/**
+ * Compresses `src` into `dst`. Returns the compressed size, or 0 when `dst` is too small.
+ */
+export function lz4Compress(src: Uint8Array, dst: Uint8Array): number {
+  const end = src.length;
+  let op = 0;
+  let anchor = 0;
+
+  if (end > MFLIMIT) {
+    const matchLimit = end - MFLIMIT;
+    const matchEndLimit = end - LAST_LITERALS;
+    table ??= new Uint32Array(1 << HASH_LOG);
+    table.fill(0);
+
+    let ip = 0;
+    while (ip < matchLimit) {
+      const sequence = read32(src, ip);
+      const slot = hash(sequence);
+      const candidate = table[slot];
+      table[slot] = ip + 1;
+
+      if (
+        candidate === 0 ||
+        ip + 1 - candidate > MAX_OFFSET ||
+        read32(src, candidate - 1) !== sequence
+      ) {
+        ip++;
+        continue;
+      }
+
+      let ref = candidate - 1;
+      while (ip > anchor && ref > 0 && src[ip - 1] === src[ref - 1]) {
+        ip--;
+        ref--;
+      }
+      let matchLength = MIN_MATCH;
+      while (ip + matchLength < matchEndLimit && src[ip + matchLength] === src[ref + matchLength]) {
+        matchLength++;
+      }
+
+      op = writeSequence(dst, op, src, anchor, ip - anchor, ip - ref, matchLength);
+      if (op < 0) {
+        return 0;
+      }
+      ip += matchLength;
+      anchor = ip;
+    }
+  }
+
+  op = writeSequence(dst, op, src, anchor, end - anchor, 0, 0);
+  return op < 0 ? 0 : op;
+}
+
+/**
+ * Decompresses an LZ4 block into `dst`, which must be exactly the uncompressed size.
+ *
+ * @throws RangeError if the block is malformed or does not produce `dst.length` bytes
+ */
+export function lz4Decompress(src: Uint8Array, dst: Uint8Array): number {
+  const malformed = () => new RangeError('lz4Decompress: malformed or truncated block');
+  const readLength = (length: number): number => {
+    let byte: number;
+    do {
+      if (ip >= src.length) {
+        throw malformed();
+      }
+      byte = src[ip++];
+      length += byte;
+    } while (byte === 255);
+    return length;
+  };
+
+  let ip = 0;
+  let op = 0;
+  while (ip < src.length) {
+    const token = src[ip++];
+
+    let literalLength = token >> 4;
+    if (literalLength === 15) {
+      literalLength = readLength(literalLength);
+    }
+    if (src.length - ip < literalLength || dst.length - op < literalLength) {
+      throw malformed();
+    }
+    dst.set(src.subarray(ip, ip + literalLength), op);
+    op += literalLength;
+    ip += literalLength;
+    if (ip === src.length) {
+      break;
+    }
+
+    if (src.length - ip < 2) {
+      throw malformed();
+    }
+    const offset = src[ip] | (src[ip + 1] << 8);
+    ip += 2;
+    if (offset === 0 || offset > op) {
+      throw malformed();
+    }
+
+    let matchLength = token & 15;
+    if (matchLength === 15) {
+      matchLength = readLength(matchLength);
+    }
+    matchLength += MIN_MATCH;
+    if (dst.length - op < matchLength) {
+      throw malformed();
+    }
+
+    const ref = op - offset;
+    if (offset >= matchLength) {
+      dst.copyWithin(op, ref, ref + matchLength);
+    } else {
+      for (let i = 0; i < matchLength; i++) {
+        dst[op + i] = dst[ref + i];
+      }
+    }
+    op += matchLength;
+  }
+
+  if (op !== dst.length) {
+    throw malformed();
+  }
+  return op;
+}
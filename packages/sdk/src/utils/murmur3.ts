@@ -0,0 +1,109 @@
+/**
+ * MurmurHash3 x86_128 in TypeScript
+ *
+ * Same output as `builder/murmur3.h`. Used when the native `murmur3_128` wrapper is unavailable
+ * (tests, Node tooling, older builds), so BloomSet members hash to the same bits everywhere.
+ */
+
+import type { HostEnv } from '../env/bindings';
+
+declare const env: HostEnv;
+
+const C1 = 0x239b961b;
+const C2 = 0xab0e9789;
+const C3 = 0x38b34ae5;
+const C4 = 0xa1e38b93;
+
+function rotl(x: number, r: number): number {
+  return (x << r) | (x >>> (32 - r));
+}
+
+function fmix(h: number): number {
+  h ^= h >>> 16;
+  h = Math.imul(h, 0x85ebca6b);
+  h ^= h >>> 13;
+  h = Math.imul(h, 0xc2b2ae35);
+  h ^= h >>> 16;
+  return h;
+}
+
+function mixK(k: number, ca: number, r: number, cb: number): number {
+  return Math.imul(rotl(Math.imul(k, ca), r), cb);
+}
+
+function read32(bytes: Uint8Array, pos: number): number {
+  return bytes[pos] | (bytes[pos + 1] << 8) | (bytes[pos + 2] << 16) | (bytes[pos + 3] << 24);
+}
+
+/**
+ * Hashes `bytes` into four unsigned 32-bit words (h1..h4) in TypeScript.
+ */
+export function murmur3x86128(bytes: Uint8Array, seed = 0): Uint32Array {
+  let h1 = seed | 0;
+  let h2 = seed | 0;
+  let h3 = seed | 0;
+  let h4 = seed | 0;
+  const length = bytes.length;
+  const blocksEnd = length - (length & 15);
+
+  for (let i = 0; i < blocksEnd; i += 16) {
+    h1 ^= mixK(read32(bytes, i), C1, 15, C2);
+    h1 = (Math.imul(rotl(h1, 19) + h2, 5) + 0x561ccd1b) | 0;
+    h2 ^= mixK(read32(bytes, i + 4), C2, 16, C3);
+    h2 = (Math.imul(rotl(h2, 17) + h3, 5) + 0x0bcaa747) | 0;
+    h3 ^= mixK(read32(bytes, i + 8), C3, 17, C4);
+    h3 = (Math.imul(rotl(h3, 15) + h4, 5) + 0x96cd1c35) | 0;
+    h4 ^= mixK(read32(bytes, i + 12), C4, 18, C1);
+    h4 = (Math.imul(rotl(h4, 13) + h1, 5) + 0x32ac3b17) | 0;
+  }
+
+  // Tail: up to 15 bytes, packed little-endian into k1..k4
+  const k = [0, 0, 0, 0];
+  for (let i = length & 15; i > 0; i--) {
+    const index = i - 1;
+    k[index >> 2] ^= bytes[blocksEnd + index] << ((index & 3) * 8);
+  }
+  const rest = length & 15;
+  if (rest > 12) h4 ^= mixK(k[3], C4, 18, C1);
+  if (rest > 8) h3 ^= mixK(k[2], C3, 17, C4);
+  if (rest > 4) h2 ^= mixK(k[1], C2, 16, C3);
+  if (rest > 0) h1 ^= mixK(k[0], C1, 15, C2);
+
+  h1 ^= length;
+  h2 ^= length;
+  h3 ^= length;
+  h4 ^= length;
+  h1 = (h1 + h2 + h3 + h4) | 0;
+  h2 = (h2 + h1) | 0;
+  h3 = (h3 + h1) | 0;
+  h4 = (h4 + h1) | 0;
+  h1 = fmix(h1);
+  h2 = fmix(h2);
+  h3 = fmix(h3);
+  h4 = fmix(h4);
+  h1 = (h1 + h2 + h3 + h4) | 0;
+  h2 = (h2 + h1) | 0;
+  h3 = (h3 + h1) | 0;
+  h4 = (h4 + h1) | 0;
+
+  return Uint32Array.of(h1 >>> 0, h2 >>> 0, h3 >>> 0, h4 >>> 0);
+}
+
+/**
+ * Hashes `bytes` with seed 0, through the native `murmur3_128` wrapper when `builder.c`
+ * provides it.
+ */
+export function murmur3(bytes: Uint8Array): Uint32Array {
+  if (typeof env !== 'undefined' && typeof env.murmur3_128 === 'function') {
+    const out = new Uint8Array(16);
+    env.murmur3_128(bytes, out);
+    const view = new DataView(out.buffer);
+    return Uint32Array.of(
+      view.getUint32(0, true),
+      view.getUint32(4, true),
+      view.getUint32(8, true),
+      view.getUint32(12, true)
+    );
+  }
+  return murmur3x86128(bytes);
+}
@@ -0,0 +1,220 @@
+/**
+ * Order-preserving key encoding
+ *
+ * Encodes keys so that comparing the encodings byte by byte orders them like the keys:
+ *   number       0x10 ++ float64 BE, sign bit flipped (all bits flipped when negative)
+ *   bigint       0x11 ++ (value + 2^127) as u128 BE
+ *   string       0x20 ++ escaped UTF-8 ++ 0x00 0x01
+ *   Uint8Array   0x30 ++ escaped bytes ++ 0x00 0x01
+ *   tuple        0x40 ++ encoded elements ++ 0x00
+ * Escaping replaces 0x00 with 0x00 0xFF, so a terminated string sorts before its extensions.
+ * Kinds sort by tag (every number before every bigint, and so on); strings sort by code point.
+ */
+
+export type OrderedKey = number | bigint | string | Uint8Array | OrderedKey[];
+
+const TAG_NUMBER = 0x10;
+const TAG_BIGINT = 0x11;
+const TAG_STRING = 0x20;
+const TAG_BYTES = 0x30;
+const TAG_TUPLE = 0x40;
+
+const BIGINT_OFFSET = 1n << 127n;
+const MAX_BIGINT = (1n << 127n) - 1n;
+
+const textEncoder = /* @__PURE__ */ new TextEncoder();
+const textDecoder = /* @__PURE__ */ new TextDecoder();
+
+class KeyWriter {
+  bytes = new Uint8Array(32);
+  length = 0;
+
+  reserve(extra: number): void {
+    if (this.length + extra > this.bytes.length) {
+      const next = new Uint8Array(Math.max(this.bytes.length * 2, this.length + extra));
+      next.set(this.bytes.subarray(0, this.length));
+      this.bytes = next;
+    }
+  }
+
+  push(byte: number): void {
+    this.reserve(1);
+    this.bytes[this.length++] = byte;
+  }
+
+  escaped(data: Uint8Array): void {
+    this.reserve(data.length * 2);
+    for (let i = 0; i < data.length; i++) {
+      this.bytes[this.length++] = data[i];
+      if (data[i] === 0) {
+        this.bytes[this.length++] = 0xff;
+      }
+    }
+  }
+}
+
+function writeKey(writer: KeyWriter, key: OrderedKey, terminate: boolean): void {
+  if (typeof key === 'number') {
+    if (Number.isNaN(key)) {
+      throw new RangeError('Ordered keys cannot be NaN');
+    }
+    const view = new DataView(new ArrayBuffer(8));
+    view.setFloat64(0, key === 0 ? 0 : key);
+    const bits = new Uint8Array(view.buffer);
+    const negative = (bits[0] & 0x80) !== 0;
+    writer.push(TAG_NUMBER);
+    writer.reserve(8);
+    for (let i = 0; i < 8; i++) {
+      const flip = negative ? 0xff : i === 0 ? 0x80 : 0;
+      writer.bytes[writer.length++] = bits[i] ^ flip;
+    }
+  } else if (typeof key === 'bigint') {
+    if (key < -BIGINT_OFFSET || key > MAX_BIGINT) {
+      throw new RangeError('Ordered bigint keys must fit in 128 signed bits');
+    }
+    let value = key + BIGINT_OFFSET;
+    writer.push(TAG_BIGINT);
+    writer.reserve(16);
+    for (let i = 15; i >= 0; i--) {
+      writer.bytes[writer.length + i] = Number(value & 0xffn);
+      value >>= 8n;
+    }
+    writer.length += 16;
+  } else if (typeof key === 'string' || key instanceof Uint8Array) {
+    writer.push(typeof key === 'string' ? TAG_STRING : TAG_BYTES);
+    writer.escaped(typeof key === 'string' ? textEncoder.encode(key) : key);
+    if (terminate) {
+      writer.push(0x00);
+      writer.push(0x01);
+    }
+  } else if (Array.isArray(key)) {
+    writer.push(TAG_TUPLE);
+    for (const element of key) {
+      writeKey(writer, element, true);
+    }
+    if (terminate) {
+      writer.push(0x00);
+    }
+  } else {
+    throw new TypeError(`Unsupported ordered key: ${String(key)}`);
+  }
+}
+
+/**
+ * Encodes a key. Encodings compare byte-wise in key order.
+ */
+export function encodeOrderedKey(key: OrderedKey): Uint8Array {
+  const writer = new KeyWriter();
+  writeKey(writer, key, true);
+  return writer.bytes.slice(0, writer.length);
+}
+
+/**
+ * Encodes a prefix: every key whose encoding starts with the result is a string (or byte
+ * string) starting with `prefix`, or a tuple starting with the elements of `prefix`.
+ */
+export function encodeOrderedPrefix(prefix: string | Uint8Array | OrderedKey[]): Uint8Array {
+  const writer = new KeyWriter();
+  writeKey(writer, prefix, false);
+  return writer.bytes.slice(0, writer.length);
+}
+
+/**
+ * Smallest byte string greater than every string starting with `prefix`, or null if none.
+ */
+export function prefixUpperBound(prefix: Uint8Array): Uint8Array | null {
+  let end = prefix.length;
+  while (end > 0 && prefix[end - 1] === 0xff) {
+    end--;
+  }
+  if (end === 0) {
+    return null;
+  }
+  const bound = prefix.slice(0, end);
+  bound[end - 1]++;
+  return bound;
+}
+
+export function compareBytes(a: Uint8Array, b: Uint8Array): number {
+  const length = Math.min(a.length, b.length);
+  for (let i = 0; i < length; i++) {
+    if (a[i] !== b[i]) {
+      return a[i] - b[i];
+    }
+  }
+  return a.length - b.length;
+}
+
+function readEscaped(bytes: Uint8Array, pos: number): [Uint8Array, number] {
+  const out: number[] = [];
+  for (;;) {
+    if (pos >= bytes.length) {
+      throw new Error('Truncated ordered key');
+    }
+    const byte = bytes[pos++];
+    if (byte !== 0) {
+      out.push(byte);
+      continue;
+    }
+    const next = bytes[pos++];
+    if (next === 0x01) {
+      return [Uint8Array.from(out), pos];
+    }
+    if (next !== 0xff) {
+      throw new Error('Malformed ordered key');
+    }
+    out.push(0);
+  }
+}
+
+function readKey(bytes: Uint8Array, pos: number): [OrderedKey, number] {
+  const tag = bytes[pos++];
+  switch (tag) {
+    case TAG_NUMBER: {
+      const bits = bytes.slice(pos, pos + 8);
+      const negative = (bits[0] & 0x80) === 0;
+      for (let i = 0; i < 8; i++) {
+        bits[i] ^= negative ? 0xff : i === 0 ? 0x80 : 0;
+      }
+      return [new DataView(bits.buffer).getFloat64(0), pos + 8];
+    }
+    case TAG_BIGINT: {
+      let value = 0n;
+      for (let i = 0; i < 16; i++) {
+        value = (value << 8n) | BigInt(bytes[pos + i]);
+      }
+      return [value - BIGINT_OFFSET, pos + 16];
+    }
+    case TAG_STRING: {
+      const [data, next] = readEscaped(bytes, pos);
+      return [textDecoder.decode(data), next];
+    }
+    case TAG_BYTES:
+      return readEscaped(bytes, pos);
+    case TAG_TUPLE: {
+      const elements: OrderedKey[] = [];
+      while (bytes[pos] !== 0x00) {
+        if (pos >= bytes.length) {
+          throw new Error('Truncated ordered key');
+        }
+        const [element, next] = readKey(bytes, pos);
+        elements.push(element);
+        pos = next;
+      }
+      return [elements, pos + 1];
+    }
+    default:
+      throw new Error(`Unknown ordered key tag: ${tag}`);
+  }
+}
+
+/**
+ * Decodes a key produced by {@link encodeOrderedKey}.
+ */
+export function decodeOrderedKey(bytes: Uint8Array): OrderedKey {
+  const [key, end] = readKey(bytes, 0);
+  if (end !== bytes.length) {
+    throw new Error('Trailing bytes after ordered key');
+  }
+  return key;
+}
@@ -15,3 +15,18 @@ import { sha256 as nobleSha256 } from '@noble/hashes/sha256';
 export function sha256(data: Uint8Array): Uint8Array {
   return nobleSha256(data);
 }
+
+/**
+ * Incremental SHA256 state: feed chunks with `update`, then call `digest` once.
+ */
+export interface Sha256Hasher {
+  update(data: Uint8Array): Sha256Hasher;
+  digest(): Uint8Array;
+}
+
+/**
+ * Starts an incremental SHA256 hash, for data that arrives in chunks (e.g. blob streams).
+ */
+export function createSha256(): Sha256Hasher {
+  return nobleSha256.create();
+}
@@ -0,0 +1,87 @@
+#!/usr/bin/env node
+
+/**
+ * Blob streaming throughput benchmark: read and hash 1 MB–100 MB blobs through `BlobReader`.
+ *
+ * Invokes the blobs example's `checksumBlob` (examples/blobs), which streams a blob through
+ * pooled chunks and hashes it incrementally, against the in-process host's in-memory blob
+ * store. Reports MB/s per blob size and how many `blob_read` crossings each read took, and
+ * checks the returned SHA256 against Node's.
+ *
+ * Usage:
+ *   node scripts/bench/blob-throughput.mjs <service.wasm> \
+ *     [--sizes 1,10,100] [--iterations 3] [--verbose]
+ */
+
+import fs from 'fs';
+import path from 'path';
+import { createHash, randomFillSync } from 'crypto';
+import { invoke, summarize, formatMs } from './wasm-host.mjs';
+
+const BASE58_ALPHABET = '123456789ABCDEFGHJKLMNPQRSTUVWXYZabcdefghijkmnopqrstuvwxyz';
+const MB = 1024 * 1024;
+
+function parseArgs(argv) {
+  const options = { file: null, sizes: [1, 10, 100], iterations: 3, verbose: false };
+  for (let i = 0; i < argv.length; i++) {
+    const arg = argv[i];
+    if (arg === '--sizes') options.sizes = argv[++i].split(',').map(Number);
+    else if (arg === '--iterations') options.iterations = Number(argv[++i]);
+    else if (arg === '--verbose') options.verbose = true;
+    else options.file = arg;
+  }
+  return options;
+}
+
+function encodeBase58(bytes) {
+  let value = BigInt('0x' + Buffer.from(bytes).toString('hex'));
+  let out = '';
+  while (value > 0n) {
+    out = BASE58_ALPHABET[Number(value % 58n)] + out;
+    value /= 58n;
+  }
+  for (const byte of bytes) {
+    if (byte !== 0) break;
+    out = '1' + out;
+  }
+  return out;
+}
+
+const options = parseArgs(process.argv.slice(2));
+if (!options.file) {
+  console.error('Usage: node scripts/bench/blob-throughput.mjs <service.wasm> [options]');
+  process.exit(1);
+}
+
+const module = new WebAssembly.Module(fs.readFileSync(path.resolve(options.file)));
+console.log(`blob throughput: ${options.iterations} iterations per size`);
+
+for (const sizeMb of options.sizes) {
+  const blobId = randomFillSync(new Uint8Array(32));
+  const data = randomFillSync(Buffer.alloc(sizeMb * MB));
+  const blobs = new Map([[Buffer.from(blobId).toString('hex'), data]]);
+  const expected = createHash('sha256').update(data).digest('hex');
+  const input = new TextEncoder().encode(JSON.stringify({ blobId: encodeBase58(blobId) }));
+
+  // Warm-up run doubles as the correctness check
+  const warm = invoke(module, 'checksumBlob', { input, blobs, verbose: options.verbose });
+  const output = new TextDecoder().decode(warm.returned ?? new Uint8Array());
+  if (!output.includes(expected)) {
+    console.error(`  ${sizeMb} MB: unexpected result ${output}`);
+    process.exit(1);
+  }
+  const reads = warm.calls.get('blob_read') ?? 0;
+
+  const samples = [];
+  for (let i = 0; i < options.iterations; i++) {
+    const start = performance.now();
+    invoke(module, 'checksumBlob', { input, blobs });
+    samples.push(performance.now() - start);
+  }
+  const stats = summarize(samples);
+  const rate = sizeMb / (stats.mean / 1000);
+  console.log(
+    `  ${String(sizeMb).padStart(4)} MB: mean ${formatMs(stats.mean)} ` +
+      `(${rate.toFixed(1)} MB/s), ${reads} blob_read crossing(s)`
+  );
+}
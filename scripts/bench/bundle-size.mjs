@@ -0,0 +1,117 @@
+#!/usr/bin/env node
+
+/**
+ * Tracks bundle size, QuickJS bytecode size (code.h) and module load time for
+ * every example, in regular and release (`--release`) builds.
+ *
+ * Module load time is measured by calling the exported `calimero_preinit`
+ * initializer, which creates the runtime and evaluates the bundle without
+ * running a method.
+ *
+ * Usage:
+ *   node scripts/bench/bundle-size.mjs [example ...] [--json results.json] [--iterations 20]
+ *
+ * Requires the CLI to be built (`pnpm build`) and its toolchain installed.
+ */
+
+import { execFileSync } from 'child_process';
+import fs from 'fs';
+import os from 'os';
+import path from 'path';
+import { fileURLToPath } from 'url';
+import { createHost, summarize, formatMs } from './wasm-host.mjs';
+
+const repoRoot = path.resolve(path.dirname(fileURLToPath(import.meta.url)), '../..');
+const cli = path.join(repoRoot, 'packages/cli/bin/calimero-sdk.js');
+
+function parseArgs(argv) {
+  const options = { examples: [], json: null, iterations: 20 };
+  for (let i = 0; i < argv.length; i++) {
+    if (argv[i] === '--json') options.json = argv[++i];
+    else if (argv[i] === '--iterations') options.iterations = Number(argv[++i]);
+    else options.examples.push(argv[i]);
+  }
+  return options;
+}
+
+function listExamples() {
+  const dir = path.join(repoRoot, 'examples');
+  return fs
+    .readdirSync(dir)
+    .filter(name => fs.existsSync(path.join(dir, name, 'src/index.ts')))
+    .sort();
+}
+
+function build(example, mode, outDir) {
+  const source = path.join(repoRoot, 'examples', example, 'src/index.ts');
+  const output = path.join(outDir, example, mode, 'service.wasm');
+  const args = [cli, 'build', source, '-o', output];
+  if (mode === 'release') args.push('--release');
+  execFileSync(process.execPath, args, { cwd: path.join(repoRoot, 'examples', example), stdio: 'pipe' });
+  return path.dirname(output);
+}
+
+function codeSize(buildDir) {
+  const header = fs.readFileSync(path.join(buildDir, 'code.h'), 'utf-8');
+  const match = header.match(/code_size\s*=\s*(\d+)/);
+  return match ? Number(match[1]) : NaN;
+}
+
+function loadTime(wasmPath, iterations) {
+  const module = new WebAssembly.Module(fs.readFileSync(wasmPath));
+  const samples = [];
+  for (let i = 0; i <= iterations; i++) {
+    const host = createHost();
+    const instance = new WebAssembly.Instance(module, host.imports(module));
+    host.attach(instance);
+    const start = performance.now();
+    instance.exports.calimero_preinit();
+    if (i > 0) samples.push(performance.now() - start);
+  }
+  return summarize(samples);
+}
+
+const options = parseArgs(process.argv.slice(2));
+const examples = options.examples.length > 0 ? options.examples : listExamples();
+const outDir = fs.mkdtempSync(path.join(os.tmpdir(), 'calimero-bundle-size-'));
+const results = [];
+
+for (const example of examples) {
+  for (const mode of ['dev', 'release']) {
+    try {
+      const buildDir = build(example, mode, outDir);
+      const load = loadTime(path.join(buildDir, 'service.wasm'), options.iterations);
+      results.push({
+        example,
+        mode,
+        bundleBytes: fs.statSync(path.join(buildDir, 'bundle.js')).size,
+        bytecodeBytes: codeSize(buildDir),
+        wasmBytes: fs.statSync(path.join(buildDir, 'service.wasm')).size,
+        loadMsP50: load.p50,
+        loadMsMean: load.mean,
+      });
+    } catch (error) {
+      results.push({ example, mode, error: String(error.message ?? error).split('\n')[0] });
+    }
+  }
+}
+
+console.log('example'.padEnd(40), 'mode'.padEnd(8), 'bundle'.padStart(10), 'code.h'.padStart(10), 'load p50'.padStart(12));
+for (const r of results) {
+  if (r.error) {
+    console.log(r.example.padEnd(40), r.mode.padEnd(8), `error: ${r.error}`);
+    continue;
+  }
+  console.log(
+    r.example.padEnd(40),
+    r.mode.padEnd(8),
+    `${(r.bundleBytes / 1024).toFixed(1)} KB`.padStart(10),
+    `${(r.bytecodeBytes / 1024).toFixed(1)} KB`.padStart(10),
+    formatMs(r.loadMsP50).padStart(12)
+  );
+}
+
+if (options.json) {
+  fs.writeFileSync(options.json, JSON.stringify({ date: new Date().toISOString(), results }, null, 2));
+  console.log(`Results written to ${options.json}`);
+}
@@ -0,0 +1,71 @@
+#!/usr/bin/env node
+
+/**
+ * Cold-start benchmark: regular vs. pre-initialized (snapshotted) services.
+ *
+ * Every Calimero invocation instantiates the module and calls one export, so
+ * the cost measured here is instantiate + module evaluation + method call.
+ *
+ * Usage:
+ *   node scripts/bench/cold-start.mjs <service.wasm> [snapshot.wasm] \
+ *     [--method init] [--args '{}'] [--iterations 50] [--verbose]
+ *
+ * Produce the snapshot variant with `calimero-sdk build --snapshot`.
+ */
+
+import fs from 'fs';
+import path from 'path';
+import { invoke, summarize, formatMs } from './wasm-host.mjs';
+
+function parseArgs(argv) {
+  const options = { files: [], method: 'init', args: '{}', iterations: 50, verbose: false };
+  for (let i = 0; i < argv.length; i++) {
+    const arg = argv[i];
+    if (arg === '--method') options.method = argv[++i];
+    else if (arg === '--args') options.args = argv[++i];
+    else if (arg === '--iterations') options.iterations = Number(argv[++i]);
+    else if (arg === '--verbose') options.verbose = true;
+    else options.files.push(arg);
+  }
+  return options;
+}
+
+function bench(file, options) {
+  const bytes = fs.readFileSync(file);
+  const compileStart = performance.now();
+  const module = new WebAssembly.Module(bytes);
+  const compileMs = performance.now() - compileStart;
+  const input = new TextEncoder().encode(options.args);
+
+  // Warm-up (JIT tiers, allocator)
+  invoke(module, options.method, { input, verbose: options.verbose });
+
+  const samples = [];
+  for (let i = 0; i < options.iterations; i++) {
+    const start = performance.now();
+    invoke(module, options.method, { input });
+    samples.push(performance.now() - start);
+  }
+  return { file, size: bytes.length, compileMs, ...summarize(samples) };
+}
+
+const options = parseArgs(process.argv.slice(2));
+if (options.files.length === 0) {
+  console.error('Usage: node scripts/bench/cold-start.mjs <service.wasm> [snapshot.wasm] [options]');
+  process.exit(1);
+}
+
+const results = options.files.map(file => bench(path.resolve(file), options));
+console.log(`Cold start: ${options.method}(${options.args}), ${options.iterations} iterations`);
+for (const result of results) {
+  console.log(
+    `  ${path.basename(result.file)} (${(result.size / 1024).toFixed(1)} KB, ` +
+      `compile ${formatMs(result.compileMs)}): ` +
+      `mean ${formatMs(result.mean)}  p50 ${formatMs(result.p50)}  ` +
+      `p95 ${formatMs(result.p95)}  min ${formatMs(result.min)}`
+  );
+}
+if (results.length === 2) {
+  const [baseline, snapshot] = results;
+  console.log(`  speedup (p50): ${(baseline.p50 / snapshot.p50).toFixed(2)}x`);
+}
@@ -0,0 +1,152 @@
+#!/usr/bin/env node
+
+/**
+ * Compression benchmark for the LZ4 codec in `packages/cli/builder/lz4.h`.
+ *
+ * Compiles a small native harness around the header with the host C compiler and runs it on
+ * typical stored payloads: JSON records, Borsh-style records and random bytes. Reports the
+ * compression ratio and encode/decode throughput per payload, and checks every round trip.
+ *
+ * Usage:
+ *   node scripts/bench/compression.mjs [--size 256] [--iterations 20] [--cc cc]
+ *
+ * `--size` is the payload size in KB.
+ */
+
+import { execFileSync } from 'child_process';
+import { randomFillSync } from 'crypto';
+import fs from 'fs';
+import os from 'os';
+import path from 'path';
+import { fileURLToPath } from 'url';
+
+const repoRoot = path.resolve(path.dirname(fileURLToPath(import.meta.url)), '../..');
+const builderDir = path.join(repoRoot, 'packages/cli/builder');
+
+const HARNESS = `
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "lz4.h"
+
+static double now(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+int main(int argc, char **argv) {
+  FILE *file = fopen(argv[1], "rb");
+  int iterations = atoi(argv[2]);
+  fseek(file, 0, SEEK_END);
+  size_t len = (size_t)ftell(file);
+  fseek(file, 0, SEEK_SET);
+  uint8_t *src = malloc(len), *block = malloc(calimero_lz4_bound(len)), *out = malloc(len);
+  if (fread(src, 1, len, file) != len) return 1;
+
+  size_t size = 0;
+  double start = now();
+  for (int i = 0; i < iterations; i++) size = calimero_lz4_compress(src, len, block, calimero_lz4_bound(len));
+  double encode = (now() - start) / iterations;
+
+  int64_t written = 0;
+  start = now();
+  for (int i = 0; i < iterations; i++) written = calimero_lz4_decompress(block, size, out, len);
+  double decode = (now() - start) / iterations;
+
+  int ok = written == (int64_t)len && memcmp(src, out, len) == 0;
+  printf("%zu %zu %.9f %.9f %d\\n", len, size, encode, decode, ok);
+  return ok ? 0 : 1;
+}
+`;
+
+function parseArgs(argv) {
+  const options = { size: 256, iterations: 20, cc: process.env.CC || 'cc' };
+  for (let i = 0; i < argv.length; i++) {
+    if (argv[i] === '--size') options.size = Number(argv[++i]);
+    else if (argv[i] === '--iterations') options.iterations = Number(argv[++i]);
+    else if (argv[i] === '--cc') options.cc = argv[++i];
+  }
+  return options;
+}
+
+function jsonRecords(bytes) {
+  const rows = [];
+  let length = 2;
+  for (let i = 0; length < bytes; i++) {
+    const row = JSON.stringify({
+      id: `order-${i}`,
+      owner: `user-${(i * 7919) % 500}`,
+      status: ['pending', 'paid', 'shipped'][i % 3],
+      amount: (i * 37) % 10000,
+      items: [{ sku: `sku-${i % 40}`, quantity: 1 + (i % 4) }],
+    });
+    rows.push(row);
+    length += row.length + 1;
+  }
+  return Buffer.from(`[${rows.join(',')}]`).subarray(0, bytes);
+}
+
+function borshRecords(bytes) {
+  const out = Buffer.alloc(bytes);
+  let pos = 0;
+  for (let i = 0; pos + 64 <= bytes; i++) {
+    const name = `member-${i % 300}`;
+    out.writeUInt32LE(name.length, pos);
+    out.write(name, pos + 4);
+    pos += 4 + name.length;
+    out.writeBigUInt64LE(BigInt(1_700_000_000_000 + i * 1000), pos);
+    out.writeUInt32LE(i % 5, pos + 8);
+    pos += 12;
+    out.fill(i % 256, pos, pos + 32); // 32-byte identifier
+    pos += 32;
+  }
+  return out;
+}
+
+function randomBytes(bytes) {
+  return randomFillSync(Buffer.alloc(bytes));
+}
+
+function main() {
+  const options = parseArgs(process.argv.slice(2));
+  const tmp = fs.mkdtempSync(path.join(os.tmpdir(), 'calimero-lz4-'));
+  const source = path.join(tmp, 'harness.c');
+  const binary = path.join(tmp, 'harness');
+  fs.writeFileSync(source, HARNESS);
+  execFileSync(options.cc, ['-O2', '-I', builderDir, source, '-o', binary]);
+
+  const bytes = options.size * 1024;
+  const payloads = {
+    'json records': jsonRecords(bytes),
+    'borsh records': borshRecords(bytes),
+    'random bytes': randomBytes(bytes),
+  };
+
+  console.log(`LZ4 (builder/lz4.h), ${options.size} KB payloads, ${options.iterations} iterations`);
+  console.log('payload          ratio    compressed   encode MB/s   decode MB/s');
+  let failed = false;
+  for (const [name, payload] of Object.entries(payloads)) {
+    const input = path.join(tmp, 'payload.bin');
+    fs.writeFileSync(input, payload);
+    let output;
+    try {
+      output = execFileSync(binary, [input, String(options.iterations)], { encoding: 'utf8' });
+    } catch {
+      console.error(`${name}: round trip failed`);
+      failed = true;
+      continue;
+    }
+    const [len, size, encode, decode] = output.trim().split(' ').map(Number);
+    const mb = len / (1024 * 1024);
+    console.log(
+      `${name.padEnd(16)} ${(len / size).toFixed(2).padStart(5)}x ${String(size).padStart(12)}` +
+        ` ${(mb / encode).toFixed(0).padStart(13)} ${(mb / decode).toFixed(0).padStart(13)}`
+    );
+  }
+
+  fs.rmSync(tmp, { recursive: true, force: true });
+  if (failed) process.exit(1);
+}
+
+main();
@@ -0,0 +1,224 @@
+#!/usr/bin/env node
+
+/**
+ * Secondary index benchmark: `IndexedMap.findBy` vs. a full scan at 100k entries.
+ *
+ * Builds a small bench-only service (embedded below) holding file records in an `IndexedMap`
+ * indexed by MIME type, seeds it with `seedFiles` against the in-process host's in-memory CRDT
+ * store, then times `filesByMime` answered from the index and with `scan: true` (read every
+ * entry and filter), checking both return the same files. Reports the time per lookup and the
+ * `js_crdt_*` storage crossings each one took, plus the write cost of keeping the index up to
+ * date while seeding.
+ *
+ * With `--writers 2` (the default) the seed batches alternate between two executor ids, and the
+ * second writer then moves the first `--retag` files to another MIME type, leaving index keys in
+ * the first writer's partition whose entries no longer carry the term. The store then holds what
+ * a node holds after merging both writers' deltas, so lookups walk both index partitions and
+ * skip the moved hits. `--writers 1` measures a single writer.
+ *
+ * The service is built into examples/blobs/build/bench-indexed-map so it resolves the SDK from
+ * the blobs example's dependencies; pass a prebuilt `service.wasm` to skip the build.
+ *
+ * Usage:
+ *   node scripts/bench/indexed-map.mjs [service.wasm] \
+ *     [--entries 100000] [--batch 5000] [--mime-types 50] [--iterations 10] \
+ *     [--writers 2] [--retag 1000] [--verbose]
+ */
+
+import { execFileSync } from 'child_process';
+import fs from 'fs';
+import path from 'path';
+import { fileURLToPath } from 'url';
+import { createStore, invoke, summarize, formatMs } from './wasm-host.mjs';
+
+const repoRoot = path.resolve(path.dirname(fileURLToPath(import.meta.url)), '../..');
+const cli = path.join(repoRoot, 'packages/cli/bin/calimero-sdk.js');
+const benchDir = path.join(repoRoot, 'examples/blobs/build/bench-indexed-map');
+
+const SERVICE = `
+import { State, Logic, Init, View, createIndexedMap } from '@calimero-network/calimero-sdk-js';
+import type { IndexedMap } from '@calimero-network/calimero-sdk-js/collections';
+
+type FileRecord = { id: string; name: string; size: number; mimeType: string };
+
+@State
+export class BenchState {
+  files: IndexedMap<string, FileRecord> = createIndexedMap<string, FileRecord>({
+    indexes: { byMime: 'mimeType' },
+  });
+  fileCounter: number = 0;
+}
+
+@Logic(BenchState)
+export class BenchLogic extends BenchState {
+  @Init
+  static init(): BenchState {
+    return new BenchState();
+  }
+
+  seedFiles({ count, mimeTypes }: { count: number; mimeTypes: string[] }): string {
+    for (let i = 0; i < count; i++) {
+      const id = \`file-\${this.fileCounter++}\`;
+      const mimeType = mimeTypes[i % mimeTypes.length];
+      this.files.set(id, { id, name: \`\${id}.bin\`, size: i, mimeType });
+    }
+    return JSON.stringify({ fileCounter: this.fileCounter });
+  }
+
+  retagFiles({ count, mimeType }: { count: number; mimeType: string }): string {
+    for (let i = 0; i < count; i++) {
+      const id = \`file-\${i}\`;
+      const record = this.files.get(id);
+      if (record) this.files.set(id, { ...record, mimeType });
+    }
+    return JSON.stringify({ retagged: count });
+  }
+
+  @View()
+  filesByMime({ mimeType, scan = false }: { mimeType: string; scan?: boolean }): string {
+    const files = scan
+      ? this.files
+          .entries()
+          .map(([, record]) => record)
+          .filter(record => record.mimeType === mimeType)
+      : this.files.findEntriesBy('byMime', mimeType).map(([, record]) => record);
+    return JSON.stringify({ files });
+  }
+}
+`;
+
+const TSCONFIG = {
+  extends: '../../../../tsconfig.json',
+  compilerOptions: { rootDir: './src', moduleResolution: 'bundler', composite: false },
+  include: ['src/**/*'],
+};
+
+function buildService() {
+  fs.mkdirSync(path.join(benchDir, 'src'), { recursive: true });
+  fs.writeFileSync(path.join(benchDir, 'src/index.ts'), SERVICE);
+  fs.writeFileSync(path.join(benchDir, 'tsconfig.json'), JSON.stringify(TSCONFIG, null, 2));
+  const output = path.join(benchDir, 'service.wasm');
+  execFileSync(process.execPath, [cli, 'build', 'src/index.ts', '-o', output], {
+    cwd: benchDir,
+    stdio: 'pipe',
+  });
+  return output;
+}
+
+function parseArgs(argv) {
+  const options = {
+    file: null,
+    entries: 100000,
+    batch: 5000,
+    mimeTypes: 50,
+    iterations: 10,
+    writers: 2,
+    retag: 1000,
+    verbose: false,
+  };
+  for (let i = 0; i < argv.length; i++) {
+    const arg = argv[i];
+    if (arg === '--entries') options.entries = Number(argv[++i]);
+    else if (arg === '--batch') options.batch = Number(argv[++i]);
+    else if (arg === '--mime-types') options.mimeTypes = Number(argv[++i]);
+    else if (arg === '--iterations') options.iterations = Number(argv[++i]);
+    else if (arg === '--writers') options.writers = Number(argv[++i]);
+    else if (arg === '--retag') options.retag = Number(argv[++i]);
+    else if (arg === '--verbose') options.verbose = true;
+    else options.file = arg;
+  }
+  return options;
+}
+
+function mapCrossings(host) {
+  let total = 0;
+  for (const [name, count] of host.calls) {
+    if (name.startsWith('js_crdt_')) total += count;
+  }
+  return total;
+}
+
+const encode = value => new TextEncoder().encode(JSON.stringify(value));
+
+const options = parseArgs(process.argv.slice(2));
+const file = options.file ? path.resolve(options.file) : buildService();
+const module = new WebAssembly.Module(fs.readFileSync(file));
+const store = createStore();
+const mimeTypes = Array.from({ length: options.mimeTypes }, (_, i) => `application/x-type-${i}`);
+const executors = Array.from({ length: options.writers }, (_, i) => new Uint8Array(32).fill(i + 2));
+let rootState = null;
+
+console.log(
+  `indexed map: ${options.entries} entries, ${options.mimeTypes} MIME types, ` +
+    `${options.writers} writer(s), ${options.iterations} iterations per lookup`
+);
+
+let seeded = 0;
+let seedMs = 0;
+let seedCrossings = 0;
+for (let batch = 0; seeded < options.entries; batch++) {
+  const count = Math.min(options.batch, options.entries - seeded);
+  const start = performance.now();
+  const host = invoke(module, 'seedFiles', {
+    input: encode({ count, mimeTypes }),
+    store,
+    rootState,
+    executorId: executors[batch % executors.length],
+    verbose: options.verbose,
+  });
+  seedMs += performance.now() - start;
+  seedCrossings += mapCrossings(host);
+  rootState = host.rootState;
+  seeded += count;
+}
+console.log(
+  `  seed: ${formatMs(seedMs / seeded)} per entry, ` +
+    `${(seedCrossings / seeded).toFixed(1)} storage crossings per entry (entry + index)`
+);
+
+if (executors.length > 1 && options.retag > 0) {
+  // The first batch came from the first writer: moving its files from the second writer leaves
+  // their old index keys behind in the first writer's partition
+  const host = invoke(module, 'retagFiles', {
+    input: encode({ count: options.retag, mimeType: mimeTypes[1] }),
+    store,
+    rootState,
+    executorId: executors[1],
+  });
+  rootState = host.rootState;
+  console.log(`  retag: ${options.retag} files moved by the second writer`);
+}
+
+const results = {};
+for (const [label, scan] of [
+  ['index', false],
+  ['scan', true],
+]) {
+  const input = encode({ mimeType: mimeTypes[1], scan });
+  // Warm-up run doubles as the correctness check
+  const warm = invoke(module, 'filesByMime', { input, store, rootState });
+  let output = JSON.parse(new TextDecoder().decode(warm.returned ?? new Uint8Array()));
+  // String results come back JSON-encoded once more
+  if (typeof output === 'string') output = JSON.parse(output);
+  const files = output.files ?? [];
+  const crossings = mapCrossings(warm);
+
+  const samples = [];
+  for (let i = 0; i < options.iterations; i++) {
+    const start = performance.now();
+    invoke(module, 'filesByMime', { input, store, rootState });
+    samples.push(performance.now() - start);
+  }
+  const { mean, p50 } = summarize(samples);
+  results[label] = { mean, files: files.map(file => file.id).sort() };
+  console.log(
+    `  ${label}: ${files.length} files in ${formatMs(mean)} (p50 ${formatMs(p50)}), ` +
+      `${crossings} storage crossings`
+  );
+}
+
+if (JSON.stringify(results.index.files) !== JSON.stringify(results.scan.files)) {
+  console.error('  index and scan returned different files');
+  process.exit(1);
+}
+console.log(`  speedup: ${(results.scan.mean / results.index.mean).toFixed(1)}x`);
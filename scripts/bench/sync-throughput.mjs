@@ -0,0 +1,96 @@
+#!/usr/bin/env node
+
+/**
+ * Sync throughput benchmark: one delta per invocation vs. batched deltas.
+ *
+ * `__calimero_sync_next` applies a single storage delta per Wasm invocation;
+ * `__calimero_sync_batch` takes a Borsh `Vec<Vec<u8>>` of deltas and applies
+ * them in one runtime with a single flush. The in-process host stubs
+ * `apply_storage_delta`, so this measures the guest-side cost per delta
+ * (instantiate, runtime setup, decoding), not host storage work.
+ *
+ * Usage:
+ *   node scripts/bench/sync-throughput.mjs <service.wasm> \
+ *     [--deltas 2000] [--batch 500] [--delta-size 256] [--verbose]
+ */
+
+import fs from 'fs';
+import path from 'path';
+import { randomFillSync } from 'crypto';
+import { invoke } from './wasm-host.mjs';
+
+function parseArgs(argv) {
+  const options = { file: null, deltas: 2000, batch: 500, deltaSize: 256, verbose: false };
+  for (let i = 0; i < argv.length; i++) {
+    const arg = argv[i];
+    if (arg === '--deltas') options.deltas = Number(argv[++i]);
+    else if (arg === '--batch') options.batch = Number(argv[++i]);
+    else if (arg === '--delta-size') options.deltaSize = Number(argv[++i]);
+    else if (arg === '--verbose') options.verbose = true;
+    else options.file = arg;
+  }
+  return options;
+}
+
+function encodeBatch(deltas) {
+  const total = deltas.reduce((sum, delta) => sum + 4 + delta.length, 4);
+  const out = new Uint8Array(total);
+  const view = new DataView(out.buffer);
+  view.setUint32(0, deltas.length, true);
+  let offset = 4;
+  for (const delta of deltas) {
+    view.setUint32(offset, delta.length, true);
+    out.set(delta, offset + 4);
+    offset += 4 + delta.length;
+  }
+  return out;
+}
+
+function measure(label, count, run) {
+  const start = performance.now();
+  run();
+  const ms = performance.now() - start;
+  const rate = (count / ms) * 1000;
+  console.log(`  ${label}: ${count} deltas in ${ms.toFixed(1)} ms (${rate.toFixed(0)} deltas/s)`);
+  return rate;
+}
+
+const options = parseArgs(process.argv.slice(2));
+if (!options.file) {
+  console.error('Usage: node scripts/bench/sync-throughput.mjs <service.wasm> [options]');
+  process.exit(1);
+}
+
+const module = new WebAssembly.Module(fs.readFileSync(path.resolve(options.file)));
+const deltas = Array.from({ length: options.deltas }, () =>
+  randomFillSync(new Uint8Array(options.deltaSize))
+);
+
+// Warm-up (JIT tiers, allocator)
+invoke(module, '__calimero_sync_next', { input: deltas[0], verbose: options.verbose });
+invoke(module, '__calimero_sync_batch', { input: encodeBatch(deltas.slice(0, 2)) });
+
+console.log(
+  `Sync throughput: ${options.deltas} deltas of ${options.deltaSize} bytes, ` +
+    `batches of ${options.batch}`
+);
+const single = measure('__calimero_sync_next ', deltas.length, () => {
+  for (const delta of deltas) {
+    invoke(module, '__calimero_sync_next', { input: delta });
+  }
+});
+const batched = measure('__calimero_sync_batch', deltas.length, () => {
+  for (let i = 0; i < deltas.length; i += options.batch) {
+    const host = invoke(module, '__calimero_sync_batch', {
+      input: encodeBatch(deltas.slice(i, i + options.batch)),
+    });
+    const report = JSON.parse(new TextDecoder().decode(host.returned));
+    if (report.failed) {
+      console.warn(
+        `  batch at ${i}: delta ${report.failed.index} failed, ` +
+          `${report.notApplied.length} not applied`
+      );
+    }
+  }
+});
+console.log(`  speedup: ${(batched / single).toFixed(2)}x`);
@@ -0,0 +1,290 @@
+/**
+ * Minimal in-process Calimero host for benchmarking compiled services.
+ *
+ * Implements the host imports with in-memory registers and root state so a
+ * `service.wasm` can be instantiated and invoked from Node.js without a node.
+ * Storage-backed CRDT calls are stubbed (collections get fresh random ids and
+ * report success); the goal is to measure the QuickJS/runtime cost around a
+ * call, not storage semantics. Benchmarks that need collections to hold data
+ * pass `options.store` (see `createStore`), which backs maps and counters with
+ * in-memory tables shared by every invocation using the store. `options.executorId` (32 bytes)
+ * sets the identity returned by `executor_id`, so invocations sharing a store can stand in for
+ * several writers whose deltas have been merged.
+ */
+
+import { randomFillSync } from 'crypto';
+
+const U64_MAX = 0xffffffffffffffffn;
+
+/**
+ * In-memory CRDT map and counter tables. Maps are keyed by hex collection id and then by hex
+ * entry key; counters hold a single total.
+ */
+export function createStore() {
+  return { maps: new Map(), counters: new Map() };
+}
+
+export function createHost(options = {}) {
+  const registers = new Map();
+  const logs = [];
+  const calls = new Map(); // host import name -> number of crossings
+  let memory = null;
+  let rootState = null;
+  let returned = null;
+
+  const view = () => new DataView(memory.buffer);
+  const readBuffer = ptr => {
+    const v = view();
+    const dataPtr = Number(v.getBigUint64(Number(ptr), true));
+    const len = Number(v.getBigUint64(Number(ptr) + 8, true));
+    return new Uint8Array(memory.buffer, dataPtr, len);
+  };
+  const writeBuffer = (ptr, bytes) => {
+    const target = readBuffer(ptr);
+    target.set(bytes.subarray(0, target.length));
+  };
+  const setRegister = (id, bytes) => registers.set(BigInt(id), Uint8Array.from(bytes));
+  const decode = bytes => new TextDecoder().decode(bytes);
+  const hex = bytes => Buffer.from(bytes).toString('hex');
+
+  // Blob store: options.blobs maps hex blob ids to contents; fds index open handles
+  const blobs = options.blobs ?? new Map();
+  const blobHandles = new Map();
+  let nextBlobFd = 1n;
+
+  const env = {
+    log_utf8: ptr => {
+      const line = decode(readBuffer(ptr));
+      logs.push(line);
+      if (options.verbose) console.log(`  [guest] ${line}`);
+    },
+    panic_utf8: ptr => {
+      throw new Error(`guest panicked: ${decode(readBuffer(ptr))}`);
+    },
+    input: id => setRegister(id, options.input ?? new Uint8Array()),
+    register_len: id => {
+      const value = registers.get(BigInt(id));
+      return value ? BigInt(value.length) : U64_MAX;
+    },
+    read_register: (id, ptr) => {
+      const value = registers.get(BigInt(id));
+      if (!value) return 0;
+      writeBuffer(ptr, value);
+      return 1;
+    },
+    value_return: ptr => {
+      returned = Uint8Array.from(readBuffer(BigInt(ptr) + 8n));
+    },
+    read_root_state: id => {
+      if (!rootState) return 0;
+      setRegister(id, rootState);
+      return 1;
+    },
+    persist_root_state: ptr => {
+      rootState = Uint8Array.from(readBuffer(ptr));
+    },
+    time_now: ptr => {
+      const nanos = BigInt(Date.now()) * 1_000_000n;
+      const bytes = new Uint8Array(8);
+      new DataView(bytes.buffer).setBigUint64(0, nanos, true);
+      writeBuffer(ptr, bytes);
+    },
+    random_bytes: ptr => randomFillSync(readBuffer(ptr)),
+    context_id: id => setRegister(id, new Uint8Array(32).fill(1)),
+    executor_id: id => setRegister(id, options.executorId ?? new Uint8Array(32).fill(2)),
+    flush_delta: () => 0,
+    blob_create: () => {
+      blobHandles.set(nextBlobFd, { parts: [] });
+      return nextBlobFd++;
+    },
+    blob_open: ptr => {
+      const data = blobs.get(hex(readBuffer(ptr)));
+      if (!data) return 0n;
+      blobHandles.set(nextBlobFd, { data, offset: 0 });
+      return nextBlobFd++;
+    },
+    blob_read: (fd, ptr) => {
+      const handle = blobHandles.get(fd);
+      const target = readBuffer(ptr);
+      const chunk = handle.data.subarray(handle.offset, handle.offset + target.length);
+      target.set(chunk);
+      handle.offset += chunk.length;
+      return BigInt(chunk.length);
+    },
+    blob_write: (fd, ptr) => {
+      const data = readBuffer(ptr);
+      blobHandles.get(fd).parts.push(Uint8Array.from(data));
+      return BigInt(data.length);
+    },
+    blob_close: (fd, ptr) => {
+      const handle = blobHandles.get(fd);
+      blobHandles.delete(fd);
+      if (!handle) return 0;
+      if (handle.parts) {
+        const id = randomFillSync(new Uint8Array(32));
+        blobs.set(hex(id), Buffer.concat(handle.parts));
+        writeBuffer(ptr, id);
+      }
+      return 1;
+    },
+  };
+
+  const newCollection = id => {
+    setRegister(id, randomFillSync(new Uint8Array(32)));
+    return 0;
+  };
+
+  if (options.store) {
+    const { maps, counters } = options.store;
+    const entriesOf = ptr => maps.get(hex(readBuffer(ptr))) ?? new Map();
+    // Sets the register to the previous value (if any) and reports whether there was one
+    const previous = (id, value) => {
+      if (value === undefined) return 0;
+      setRegister(id, value);
+      return 1;
+    };
+
+    Object.assign(env, {
+      js_crdt_map_new: id => {
+        const mapId = randomFillSync(new Uint8Array(32));
+        maps.set(hex(mapId), new Map());
+        setRegister(id, mapId);
+        return 0;
+      },
+      js_crdt_map_get: (mapPtr, keyPtr, id) =>
+        previous(id, entriesOf(mapPtr).get(hex(readBuffer(keyPtr)))),
+      js_crdt_map_insert: (mapPtr, keyPtr, valuePtr, id) => {
+        const mapKey = hex(readBuffer(mapPtr));
+        const entries = maps.get(mapKey) ?? new Map();
+        maps.set(mapKey, entries);
+        const key = hex(readBuffer(keyPtr));
+        const old = entries.get(key);
+        entries.set(key, Uint8Array.from(readBuffer(valuePtr)));
+        return previous(id, old);
+      },
+      js_crdt_map_remove: (mapPtr, keyPtr, id) => {
+        const entries = entriesOf(mapPtr);
+        const key = hex(readBuffer(keyPtr));
+        const old = entries.get(key);
+        entries.delete(key);
+        return previous(id, old);
+      },
+      js_crdt_map_contains: (mapPtr, keyPtr) =>
+        entriesOf(mapPtr).has(hex(readBuffer(keyPtr))) ? 1 : 0,
+      js_crdt_map_iter: (mapPtr, id) => {
+        // u32 count, then (u32 key length ++ key ++ u32 value length ++ value) per entry
+        const parts = [new Uint8Array(4)];
+        let count = 0;
+        for (const [key, value] of entriesOf(mapPtr)) {
+          const keyBytes = Buffer.from(key, 'hex');
+          const header = new Uint8Array(4);
+          const valueHeader = new Uint8Array(4);
+          new DataView(header.buffer).setUint32(0, keyBytes.length, true);
+          new DataView(valueHeader.buffer).setUint32(0, value.length, true);
+          parts.push(header, keyBytes, valueHeader, value);
+          count++;
+        }
+        new DataView(parts[0].buffer).setUint32(0, count, true);
+        setRegister(id, Buffer.concat(parts));
+        return 1;
+      },
+      js_crdt_counter_new: id => {
+        const counterId = randomFillSync(new Uint8Array(32));
+        counters.set(hex(counterId), 0n);
+        setRegister(id, counterId);
+        return 0;
+      },
+      js_crdt_counter_increment: ptr => {
+        const key = hex(readBuffer(ptr));
+        counters.set(key, (counters.get(key) ?? 0n) + 1n);
+        return 1;
+      },
+      js_crdt_counter_value: (ptr, id) => {
+        const value = new Uint8Array(8);
+        new DataView(value.buffer).setBigUint64(0, counters.get(hex(readBuffer(ptr))) ?? 0n, true);
+        setRegister(id, value);
+        return 1;
+      },
+    });
+  }
+
+  function imports(module) {
+    const result = {};
+    for (const descriptor of WebAssembly.Module.imports(module)) {
+      const namespace = (result[descriptor.module] ??= {});
+      if (descriptor.module === 'wasi_snapshot_preview1') {
+        namespace[descriptor.name] =
+          descriptor.name === 'fd_write'
+            ? (_fd, iovs, iovsLen, nwritten) => {
+                const v = view();
+                let written = 0;
+                for (let i = 0; i < iovsLen; i++) written += v.getUint32(iovs + i * 8 + 4, true);
+                v.setUint32(nwritten, written, true);
+                return 0;
+              }
+            : () => 0;
+        continue;
+      }
+      let impl;
+      if (env[descriptor.name]) {
+        impl = env[descriptor.name];
+      } else if (/_new$/.test(descriptor.name)) {
+        impl = newCollection;
+      } else {
+        impl = () => 0;
+      }
+      const name = descriptor.name;
+      namespace[name] = (...args) => {
+        calls.set(name, (calls.get(name) ?? 0) + 1);
+        return impl(...args);
+      };
+    }
+    return result;
+  }
+
+  return {
+    logs,
+    calls,
+    imports,
+    attach(instance) {
+      memory = instance.exports.memory;
+    },
+    get returned() {
+      return returned;
+    },
+    setRootState(bytes) {
+      rootState = bytes;
+    },
+    get rootState() {
+      return rootState;
+    },
+  };
+}
+
+/**
+ * Instantiates `module` against a fresh host and invokes `method`.
+ * Returns the host so callers can inspect logs/return values.
+ */
+export function invoke(module, method, options = {}) {
+  const host = createHost(options);
+  if (options.rootState) host.setRootState(options.rootState);
+  const instance = new WebAssembly.Instance(module, host.imports(module));
+  host.attach(instance);
+  const fn = instance.exports[method];
+  if (typeof fn !== 'function') {
+    throw new Error(`Method "${method}" is not exported`);
+  }
+  fn();
+  return host;
+}
+
+export function summarize(samples) {
+  const sorted = [...samples].sort((a, b) => a - b);
+  const pick = q => sorted[Math.min(sorted.length - 1, Math.floor(q * sorted.length))];
+  const mean = sorted.reduce((sum, v) => sum + v, 0) / sorted.length;
+  return { mean, p50: pick(0.5), p95: pick(0.95), min: sorted[0] };
+}
+
+export function formatMs(value) {
+  return `${value.toFixed(3)} ms`;
+}
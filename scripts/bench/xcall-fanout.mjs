@@ -0,0 +1,92 @@
+#!/usr/bin/env node
+
+/**
+ * Cross-context fan-out benchmark: one invocation scheduling xcalls to 1 vs. 100 contexts.
+ *
+ * Invokes the xcall example's `pingMany` (examples/xcall) with N target contexts and reports
+ * the time per invocation and how many times the guest crossed into the host's `xcall` /
+ * `xcall_batch` imports. Pass a second build made with `calimero-sdk build --batch-xcalls`
+ * to compare per-call crossings with a single batched one. The in-process host stubs both
+ * imports, so this measures the guest-side cost of queueing, packing and crossing.
+ *
+ * Usage:
+ *   node scripts/bench/xcall-fanout.mjs <service.wasm> [batched.wasm] \
+ *     [--targets 1,100] [--iterations 50] [--verbose]
+ */
+
+import fs from 'fs';
+import path from 'path';
+import { randomFillSync } from 'crypto';
+import { invoke, summarize, formatMs } from './wasm-host.mjs';
+
+const BASE58_ALPHABET = '123456789ABCDEFGHJKLMNPQRSTUVWXYZabcdefghijkmnopqrstuvwxyz';
+
+function parseArgs(argv) {
+  const options = { files: [], targets: [1, 100], iterations: 50, verbose: false };
+  for (let i = 0; i < argv.length; i++) {
+    const arg = argv[i];
+    if (arg === '--targets') options.targets = argv[++i].split(',').map(Number);
+    else if (arg === '--iterations') options.iterations = Number(argv[++i]);
+    else if (arg === '--verbose') options.verbose = true;
+    else options.files.push(arg);
+  }
+  return options;
+}
+
+function encodeBase58(bytes) {
+  let value = BigInt('0x' + Buffer.from(bytes).toString('hex'));
+  let out = '';
+  while (value > 0n) {
+    out = BASE58_ALPHABET[Number(value % 58n)] + out;
+    value /= 58n;
+  }
+  for (const byte of bytes) {
+    if (byte !== 0) break;
+    out = '1' + out;
+  }
+  return out;
+}
+
+function pingManyInput(count) {
+  const targetContexts = Array.from({ length: count }, () =>
+    encodeBase58(randomFillSync(new Uint8Array(32)))
+  );
+  return new TextEncoder().encode(JSON.stringify({ targetContexts }));
+}
+
+function bench(file, options) {
+  const module = new WebAssembly.Module(fs.readFileSync(file));
+  console.log(`${path.basename(file)}:`);
+  for (const count of options.targets) {
+    const input = pingManyInput(count);
+
+    // Warm-up (JIT tiers, allocator)
+    const warm = invoke(module, 'pingMany', { input, verbose: options.verbose });
+    const crossings = (warm.calls.get('xcall') ?? 0) + (warm.calls.get('xcall_batch') ?? 0);
+
+    const samples = [];
+    for (let i = 0; i < options.iterations; i++) {
+      const start = performance.now();
+      invoke(module, 'pingMany', { input });
+      samples.push(performance.now() - start);
+    }
+    const stats = summarize(samples);
+    console.log(
+      `  ${String(count).padStart(4)} contexts: mean ${formatMs(stats.mean)}, ` +
+        `p50 ${formatMs(stats.p50)}, ${crossings} host crossing(s)`
+    );
+  }
+}
+
+const options = parseArgs(process.argv.slice(2));
+if (options.files.length === 0) {
+  console.error(
+    'Usage: node scripts/bench/xcall-fanout.mjs <service.wasm> [batched.wasm] [options]'
+  );
+  process.exit(1);
+}
+
+console.log(`xcall fan-out: ${options.iterations} iterations per target count`);
+for (const file of options.files) {
+  bench(path.resolve(file), options);
+}
@@ -0,0 +1,570 @@
+/**
+ * In-process replica host for the sync simulator
+ *
+ * Implements the host imports the SDK collections use (`js_crdt_map_*`, `js_crdt_counter_*`,
+ * `js_crdt_lww_*`, registers, clock) with real CRDT merge semantics instead of the
+ * single-node stubs in the SDK unit test setup:
+ *
+ * - UnorderedMap: per-key last-writer-wins on (Lamport time, node), removes are tombstones
+ * - UnorderedSet: a map from element to a presence marker, so membership is last-writer-wins
+ *   per element and `clear` tombstones the elements it saw
+ * - Vector: elements keyed by the (Lamport time, node) of their push, so concurrent pushes all
+ *   survive and every replica orders them the same way; `pop` tombstones the last live element
+ * - Counter: G-counter, one monotonically growing count per executor, merged by max
+ * - LwwRegister: last-writer-wins on (Lamport time, node)
+ *
+ * Local writes are recorded as operations; `takeDelta` encodes the pending operations into one
+ * Borsh delta of the simulator's own format, which other replicas merge with `applyDelta`. It is
+ * not the node's storage delta encoding, so its size is only a relative measure.
+ */
+
+import { BorshWriter } from '../../../packages/sdk/src/borsh/encoder';
+import { BorshReader } from '../../../packages/sdk/src/borsh/decoder';
+
+const ID_LENGTH = 32;
+
+enum OpKind {
+  MapPut = 0,
+  MapRemove = 1,
+  CounterSet = 2,
+  LwwSet = 3,
+}
+
+interface Stamp {
+  time: bigint;
+  node: string;
+}
+
+interface MapEntry extends Stamp {
+  key: Uint8Array;
+  value: Uint8Array | null;
+}
+
+interface LwwState extends Stamp {
+  value: Uint8Array | null;
+}
+
+type Op =
+  | { kind: OpKind.MapPut; id: Uint8Array; key: Uint8Array; value: Uint8Array; stamp: Stamp }
+  | { kind: OpKind.MapRemove; id: Uint8Array; key: Uint8Array; stamp: Stamp }
+  | { kind: OpKind.CounterSet; id: Uint8Array; node: string; count: bigint }
+  | { kind: OpKind.LwwSet; id: Uint8Array; value: Uint8Array | null; stamp: Stamp };
+
+function hex(bytes: Uint8Array): string {
+  let out = '';
+  for (let i = 0; i < bytes.length; i += 1) {
+    out += bytes[i].toString(16).padStart(2, '0');
+  }
+  return out;
+}
+
+function fromHex(value: string): Uint8Array {
+  const out = new Uint8Array(value.length / 2);
+  for (let i = 0; i < out.length; i += 1) {
+    out[i] = parseInt(value.slice(i * 2, i * 2 + 2), 16);
+  }
+  return out;
+}
+
+const PRESENT = Uint8Array.of(1);
+
+// Vector element key: push time (u64 BE) ++ node, so sorting by hex key sorts by push stamp
+function elementKey(stamp: Stamp): Uint8Array {
+  const key = new Uint8Array(8 + ID_LENGTH);
+  new DataView(key.buffer).setBigUint64(0, stamp.time, false);
+  key.set(fromHex(stamp.node), 8);
+  return key;
+}
+
+function encodeVec(values: Uint8Array[]): Uint8Array {
+  const writer = new BorshWriter();
+  writer.writeVec(values, value => writer.writeBytes(value));
+  return writer.toBytes();
+}
+
+function newer(candidate: Stamp, current: Stamp): boolean {
+  if (candidate.time !== current.time) {
+    return candidate.time > current.time;
+  }
+  return candidate.node > current.node;
+}
+
+export class ReplicaHost {
+  readonly executorId: Uint8Array;
+  readonly node: string;
+
+  private clock = 0n;
+  private nextCollection = 0;
+  private register: Uint8Array | null = null;
+  private pending: Op[] = [];
+
+  private readonly maps = new Map<string, Map<string, MapEntry>>();
+  private readonly counters = new Map<string, Map<string, bigint>>();
+  private readonly registers = new Map<string, LwwState>();
+
+  /** Host imports to install as the global `env` while this replica runs. */
+  readonly env: Record<string, (...args: any[]) => any>;
+
+  constructor(readonly index: number) {
+    this.executorId = new Uint8Array(ID_LENGTH).fill(index + 1);
+    this.node = hex(this.executorId);
+    this.env = this.createEnv();
+  }
+
+  /**
+   * Merges a delta produced by another replica's `flush_delta`.
+   */
+  applyDelta(delta: Uint8Array): void {
+    const reader = new BorshReader(delta);
+    const count = reader.readU32();
+    for (let i = 0; i < count; i += 1) {
+      this.mergeOp(this.readOp(reader));
+    }
+  }
+
+  /**
+   * Deterministic rendering of the replica state, equal across replicas once they converge.
+   */
+  digest(): string {
+    const parts: string[] = [];
+    for (const id of [...this.maps.keys()].sort()) {
+      const entries = this.maps.get(id)!;
+      for (const key of [...entries.keys()].sort()) {
+        const entry = entries.get(key)!;
+        const value = entry.value ? hex(entry.value) : '-';
+        parts.push(`m:${id}:${key}=${value}@${entry.time}/${entry.node}`);
+      }
+    }
+    for (const id of [...this.counters.keys()].sort()) {
+      const counts = this.counters.get(id)!;
+      for (const node of [...counts.keys()].sort()) {
+        parts.push(`c:${id}:${node}=${counts.get(node)}`);
+      }
+    }
+    for (const id of [...this.registers.keys()].sort()) {
+      const state = this.registers.get(id)!;
+      if (state.time === 0n) {
+        continue;
+      }
+      parts.push(`r:${id}=${state.value ? hex(state.value) : '-'}@${state.time}/${state.node}`);
+    }
+    return parts.join('\n');
+  }
+
+  /**
+   * Encodes and clears the operations recorded since the last flush, or null when there are none.
+   */
+  takeDelta(): Uint8Array | null {
+    if (this.pending.length === 0) {
+      return null;
+    }
+    const writer = new BorshWriter();
+    writer.writeVec(this.pending, op => this.writeOp(writer, op));
+    this.pending = [];
+    return writer.toBytes();
+  }
+
+  private tick(): Stamp {
+    this.clock += 1n;
+    return { time: this.clock, node: this.node };
+  }
+
+  private observe(time: bigint): void {
+    if (time > this.clock) {
+      this.clock = time;
+    }
+  }
+
+  private setRegister(value: Uint8Array | null): void {
+    this.register = value ? new Uint8Array(value) : null;
+  }
+
+  private writeU64Register(value: bigint): void {
+    const buffer = new Uint8Array(8);
+    new DataView(buffer.buffer).setBigUint64(0, value, true);
+    this.register = buffer;
+  }
+
+  private newCollectionId(): Uint8Array {
+    const id = new Uint8Array(ID_LENGTH);
+    const view = new DataView(id.buffer);
+    view.setUint32(0, this.index + 1, true);
+    view.setUint32(4, ++this.nextCollection, true);
+    return id;
+  }
+
+  // Replicas learn about collections created elsewhere through deltas or `fromId`
+  private mapStore(id: Uint8Array): Map<string, MapEntry> {
+    const key = hex(id);
+    let store = this.maps.get(key);
+    if (!store) {
+      store = new Map();
+      this.maps.set(key, store);
+    }
+    return store;
+  }
+
+  // Live entries of a map-backed collection, in key order
+  private liveEntries(id: Uint8Array): MapEntry[] {
+    const store = this.mapStore(id);
+    return [...store.keys()]
+      .sort()
+      .map(key => store.get(key)!)
+      .filter(entry => entry.value);
+  }
+
+  private put(id: Uint8Array, key: Uint8Array, value: Uint8Array): void {
+    this.local({
+      kind: OpKind.MapPut,
+      id: new Uint8Array(id),
+      key: new Uint8Array(key),
+      value: new Uint8Array(value),
+      stamp: this.tick(),
+    });
+  }
+
+  private tombstone(id: Uint8Array, key: Uint8Array): void {
+    this.local({
+      kind: OpKind.MapRemove,
+      id: new Uint8Array(id),
+      key: new Uint8Array(key),
+      stamp: this.tick(),
+    });
+  }
+
+  private counterStore(id: Uint8Array): Map<string, bigint> {
+    const key = hex(id);
+    let store = this.counters.get(key);
+    if (!store) {
+      store = new Map();
+      this.counters.set(key, store);
+    }
+    return store;
+  }
+
+  private lwwStore(id: Uint8Array): LwwState {
+    const key = hex(id);
+    let state = this.registers.get(key);
+    if (!state) {
+      state = { value: null, time: 0n, node: '' };
+      this.registers.set(key, state);
+    }
+    return state;
+  }
+
+  private mergeOp(op: Op): void {
+    switch (op.kind) {
+      case OpKind.MapPut:
+      case OpKind.MapRemove: {
+        this.observe(op.stamp.time);
+        const store = this.mapStore(op.id);
+        const key = hex(op.key);
+        const current = store.get(key);
+        if (!current || newer(op.stamp, current)) {
+          const value = op.kind === OpKind.MapPut ? op.value : null;
+          store.set(key, { key: op.key, value, ...op.stamp });
+        }
+        break;
+      }
+      case OpKind.CounterSet: {
+        const store = this.counterStore(op.id);
+        if ((store.get(op.node) ?? 0n) < op.count) {
+          store.set(op.node, op.count);
+        }
+        break;
+      }
+      case OpKind.LwwSet: {
+        this.observe(op.stamp.time);
+        const state = this.lwwStore(op.id);
+        if (newer(op.stamp, state)) {
+          this.registers.set(hex(op.id), { value: op.value, ...op.stamp });
+        }
+        break;
+      }
+    }
+  }
+
+  private writeStamp(writer: BorshWriter, stamp: Stamp): void {
+    writer.writeU64(stamp.time);
+    writer.writeFixedArray(fromHex(stamp.node));
+  }
+
+  private readStamp(reader: BorshReader): Stamp {
+    const time = reader.readU64();
+    return { time, node: hex(reader.readFixedArray(ID_LENGTH)) };
+  }
+
+  private writeOp(writer: BorshWriter, op: Op): void {
+    writer.writeU8(op.kind);
+    writer.writeFixedArray(op.id);
+    switch (op.kind) {
+      case OpKind.MapPut:
+        writer.writeBytes(op.key);
+        writer.writeBytes(op.value);
+        this.writeStamp(writer, op.stamp);
+        break;
+      case OpKind.MapRemove:
+        writer.writeBytes(op.key);
+        this.writeStamp(writer, op.stamp);
+        break;
+      case OpKind.CounterSet:
+        writer.writeFixedArray(fromHex(op.node));
+        writer.writeU64(op.count);
+        break;
+      case OpKind.LwwSet:
+        writer.writeOption(op.value, value => writer.writeBytes(value));
+        this.writeStamp(writer, op.stamp);
+        break;
+    }
+  }
+
+  private readOp(reader: BorshReader): Op {
+    const kind = reader.readU8() as OpKind;
+    const id = reader.readFixedArray(ID_LENGTH);
+    switch (kind) {
+      case OpKind.MapPut: {
+        const key = reader.readBytes();
+        const value = reader.readBytes();
+        return { kind, id, key, value, stamp: this.readStamp(reader) };
+      }
+      case OpKind.MapRemove: {
+        const key = reader.readBytes();
+        return { kind, id, key, stamp: this.readStamp(reader) };
+      }
+      case OpKind.CounterSet: {
+        const node = hex(reader.readFixedArray(ID_LENGTH));
+        return { kind, id, node, count: reader.readU64() };
+      }
+      case OpKind.LwwSet: {
+        const value = reader.readU8() === 1 ? reader.readBytes() : null;
+        return { kind, id, value, stamp: this.readStamp(reader) };
+      }
+      default:
+        throw new Error(`Unknown simulator op kind ${kind}`);
+    }
+  }
+
+  private local(op: Op): void {
+    this.mergeOp(op);
+    // Counter state is the executor's running total, so only the latest one needs to travel
+    if (op.kind === OpKind.CounterSet) {
+      const index = this.pending.findIndex(
+        pending => pending.kind === OpKind.CounterSet && hex(pending.id) === hex(op.id)
+      );
+      if (index >= 0) {
+        this.pending[index] = op;
+        return;
+      }
+    }
+    this.pending.push(op);
+  }
+
+  private createEnv(): Record<string, (...args: any[]) => any> {
+    return {
+      log_utf8: () => {},
+      log_append: () => {},
+      panic_utf8: (message: Uint8Array) => {
+        throw new Error(new TextDecoder().decode(message));
+      },
+      register_len: () => (this.register ? BigInt(this.register.length) : 0n),
+      read_register: (_id: bigint, buffer: Uint8Array) => {
+        if (!this.register) {
+          return false;
+        }
+        buffer.set(this.register);
+        return true;
+      },
+      value_return: (value: Uint8Array) => this.setRegister(value),
+      executor_id: () => this.setRegister(this.executorId),
+      context_id: () => this.setRegister(new Uint8Array(ID_LENGTH).fill(0xcc)),
+      time_now: (buffer: Uint8Array) => {
+        new DataView(buffer.buffer, buffer.byteOffset, 8).setBigUint64(0, this.clock, true);
+      },
+      flush_delta: () => (this.pending.length > 0 ? 1 : 0),
+      commit: () => {},
+      emit: () => {},
+      emit_with_handler: () => {},
+
+      js_crdt_map_new: () => {
+        const id = this.newCollectionId();
+        this.mapStore(id);
+        this.setRegister(id);
+        return 1;
+      },
+      js_crdt_map_get: (mapId: Uint8Array, key: Uint8Array) => {
+        const entry = this.mapStore(mapId).get(hex(key));
+        this.setRegister(entry?.value ?? null);
+        return entry?.value ? 1 : 0;
+      },
+      js_crdt_map_insert: (mapId: Uint8Array, key: Uint8Array, value: Uint8Array) => {
+        const previous = this.mapStore(mapId).get(hex(key))?.value ?? null;
+        this.put(mapId, key, value);
+        this.setRegister(previous);
+        return previous ? 1 : 0;
+      },
+      js_crdt_map_remove: (mapId: Uint8Array, key: Uint8Array) => {
+        const previous = this.mapStore(mapId).get(hex(key))?.value ?? null;
+        if (previous) {
+          this.tombstone(mapId, key);
+        }
+        this.setRegister(previous);
+        return previous ? 1 : 0;
+      },
+      js_crdt_map_contains: (mapId: Uint8Array, key: Uint8Array) =>
+        this.mapStore(mapId).get(hex(key))?.value ? 1 : 0,
+      js_crdt_map_iter: (mapId: Uint8Array) => {
+        const writer = new BorshWriter();
+        const live = [...this.mapStore(mapId).values()].filter(entry => entry.value);
+        writer.writeU32(live.length);
+        for (const entry of live) {
+          writer.writeBytes(entry.key);
+          writer.writeBytes(entry.value!);
+        }
+        this.setRegister(writer.toBytes());
+        return 1;
+      },
+
+      js_crdt_counter_new: () => {
+        const id = this.newCollectionId();
+        this.counterStore(id);
+        this.setRegister(id);
+        return 1;
+      },
+      js_crdt_counter_increment: (counterId: Uint8Array) => {
+        const count = (this.counterStore(counterId).get(this.node) ?? 0n) + 1n;
+        this.local({
+          kind: OpKind.CounterSet,
+          id: new Uint8Array(counterId),
+          node: this.node,
+          count,
+        });
+        return 1;
+      },
+      js_crdt_counter_value: (counterId: Uint8Array) => {
+        let total = 0n;
+        for (const count of this.counterStore(counterId).values()) {
+          total += count;
+        }
+        this.writeU64Register(total);
+        return 1;
+      },
+      js_crdt_counter_get_executor_count: (
+        counterId: Uint8Array,
+        _register: bigint,
+        executorId?: Uint8Array
+      ) => {
+        const node = executorId ? hex(executorId) : this.node;
+        this.writeU64Register(this.counterStore(counterId).get(node) ?? 0n);
+        return 1;
+      },
+
+      js_crdt_lww_new: () => {
+        const id = this.newCollectionId();
+        this.lwwStore(id);
+        this.setRegister(id);
+        return 1;
+      },
+      js_crdt_lww_set: (registerId: Uint8Array, value: Uint8Array | null) => {
+        this.local({
+          kind: OpKind.LwwSet,
+          id: new Uint8Array(registerId),
+          value: value ? new Uint8Array(value) : null,
+          stamp: this.tick(),
+        });
+        return 1;
+      },
+      js_crdt_lww_get: (registerId: Uint8Array) => {
+        const state = this.lwwStore(registerId);
+        this.setRegister(state.value);
+        return state.value ? 1 : 0;
+      },
+      js_crdt_lww_timestamp: (registerId: Uint8Array) => {
+        const state = this.lwwStore(registerId);
+        if (!state.value) {
+          this.setRegister(null);
+          return 0;
+        }
+        const buffer = new Uint8Array(24);
+        new DataView(buffer.buffer).setBigUint64(0, state.time, true);
+        buffer.set(fromHex(state.node).subarray(0, 16), 8);
+        this.setRegister(buffer);
+        return 1;
+      },
+
+      js_crdt_vector_new: () => {
+        const id = this.newCollectionId();
+        this.mapStore(id);
+        this.setRegister(id);
+        return 1;
+      },
+      js_crdt_vector_len: (vectorId: Uint8Array) => {
+        this.writeU64Register(BigInt(this.liveEntries(vectorId).length));
+        return 1;
+      },
+      js_crdt_vector_push: (vectorId: Uint8Array, value: Uint8Array) => {
+        const stamp = this.tick();
+        this.local({
+          kind: OpKind.MapPut,
+          id: new Uint8Array(vectorId),
+          key: elementKey(stamp),
+          value: new Uint8Array(value),
+          stamp,
+        });
+        return 1;
+      },
+      js_crdt_vector_get: (vectorId: Uint8Array, index: number) => {
+        const entry = this.liveEntries(vectorId)[index];
+        this.setRegister(entry?.value ?? null);
+        return entry ? 1 : 0;
+      },
+      js_crdt_vector_pop: (vectorId: Uint8Array) => {
+        const live = this.liveEntries(vectorId);
+        const last = live[live.length - 1];
+        if (!last) {
+          this.setRegister(null);
+          return 0;
+        }
+        this.tombstone(vectorId, last.key);
+        this.setRegister(last.value);
+        return 1;
+      },
+
+      js_crdt_set_new: () => {
+        const id = this.newCollectionId();
+        this.mapStore(id);
+        this.setRegister(id);
+        return 1;
+      },
+      js_crdt_set_insert: (setId: Uint8Array, value: Uint8Array) => {
+        if (this.mapStore(setId).get(hex(value))?.value) {
+          return 0;
+        }
+        this.put(setId, value, PRESENT);
+        return 1;
+      },
+      js_crdt_set_contains: (setId: Uint8Array, value: Uint8Array) =>
+        this.mapStore(setId).get(hex(value))?.value ? 1 : 0,
+      js_crdt_set_remove: (setId: Uint8Array, value: Uint8Array) => {
+        if (!this.mapStore(setId).get(hex(value))?.value) {
+          return 0;
+        }
+        this.tombstone(setId, value);
+        return 1;
+      },
+      js_crdt_set_len: (setId: Uint8Array) => {
+        this.writeU64Register(BigInt(this.liveEntries(setId).length));
+        return 1;
+      },
+      js_crdt_set_iter: (setId: Uint8Array) => {
+        this.setRegister(encodeVec(this.liveEntries(setId).map(entry => entry.key)));
+        return 1;
+      },
+      js_crdt_set_clear: (setId: Uint8Array) => {
+        for (const entry of this.liveEntries(setId)) {
+          this.tombstone(setId, entry.key);
+        }
+        return 1;
+      },
+    };
+  }
+}
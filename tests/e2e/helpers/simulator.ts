@@ -0,0 +1,184 @@
+/**
+ * Multi-replica sync simulator
+ *
+ * Runs N replicas of a contract in one process, each backed by its own `ReplicaHost`. An
+ * invocation installs the replica's host as the global `env`, runs the contract code, and
+ * broadcasts the delta the host collected to every other replica with a seeded random latency
+ * (in virtual ticks). After the workload, in-flight deltas are delivered until every replica
+ * holds the same state.
+ *
+ * Deltas use the replica host's own op encoding, not the node's storage delta format, so the
+ * byte metrics are synthetic: useful to compare workloads, not to predict network traffic.
+ */
+
+import { ReplicaHost } from './replica-host';
+
+export interface SimulatorOptions {
+  replicas: number;
+  /** Seed for latency and interleaving, so runs are reproducible. */
+  seed?: number;
+  /** Delivery latency per message, in ticks (one invocation runs per tick). */
+  latency?: { min: number; max: number };
+  /** `ordered` runs invocations as given, `shuffled` in a seeded random order. */
+  interleaving?: 'ordered' | 'shuffled';
+}
+
+export interface Invocation {
+  replica: number;
+  run: () => void;
+}
+
+export interface SimulationReport {
+  invocations: number;
+  deltas: number;
+  deliveries: number;
+  /** Size of the simulator's op-encoded deltas, not of the node's storage deltas. */
+  syntheticDeltaBytes: number;
+  syntheticBytesPerDelta: number;
+  maxSyntheticDeltaBytes: number;
+  /** Wall time spent merging remote deltas, all replicas. */
+  mergeMs: number;
+  mergeMsPerDelivery: number;
+  /** Ticks after the last invocation until all replicas agreed (-1 if they never did). */
+  convergenceTicks: number;
+  /** Wall time of that settling phase. */
+  convergenceMs: number;
+  converged: boolean;
+}
+
+interface InFlight {
+  deliverAt: number;
+  seq: number;
+  target: number;
+  delta: Uint8Array;
+}
+
+function createRandom(seed: number): () => number {
+  let state = seed >>> 0;
+  return () => {
+    state = (state + 0x6d2b79f5) >>> 0;
+    let t = state;
+    t = Math.imul(t ^ (t >>> 15), t | 1);
+    t ^= t + Math.imul(t ^ (t >>> 7), t | 61);
+    return ((t ^ (t >>> 14)) >>> 0) / 4294967296;
+  };
+}
+
+export class SyncSimulator {
+  readonly replicas: ReplicaHost[];
+
+  private readonly random: () => number;
+  private readonly latency: { min: number; max: number };
+  private readonly interleaving: 'ordered' | 'shuffled';
+  private inFlight: InFlight[] = [];
+  private now = 0;
+  private seq = 0;
+  private stats = { deltas: 0, deliveries: 0, bytes: 0, maxBytes: 0, mergeMs: 0 };
+
+  constructor(options: SimulatorOptions) {
+    this.replicas = Array.from({ length: options.replicas }, (_, index) => new ReplicaHost(index));
+    this.random = createRandom(options.seed ?? 1);
+    this.latency = options.latency ?? { min: 1, max: 1 };
+    this.interleaving = options.interleaving ?? 'ordered';
+  }
+
+  /**
+   * Runs `fn` as one invocation on `replica` and broadcasts the resulting delta.
+   */
+  invoke<T>(replica: number, fn: () => T): T {
+    const host = this.replicas[replica];
+    const globals = globalThis as any;
+    const previous = globals.env;
+    globals.env = host.env;
+    try {
+      return fn();
+    } finally {
+      globals.env = previous;
+      const delta = host.takeDelta();
+      if (delta) {
+        this.broadcast(replica, delta);
+      }
+    }
+  }
+
+  /**
+   * Runs the workload one invocation per tick, then delivers in-flight deltas until the
+   * replicas converge or nothing is left to deliver.
+   */
+  run(invocations: Invocation[]): SimulationReport {
+    const ordered = this.interleaving === 'shuffled' ? this.shuffle(invocations) : invocations;
+    for (const invocation of ordered) {
+      this.advance();
+      this.invoke(invocation.replica, invocation.run);
+    }
+
+    const settleStart = performance.now();
+    let ticks = 0;
+    while (!this.converged() && this.inFlight.length > 0) {
+      this.advance();
+      ticks += 1;
+    }
+    const convergenceMs = performance.now() - settleStart;
+    const converged = this.converged();
+
+    const { deltas, deliveries, bytes, maxBytes, mergeMs } = this.stats;
+    return {
+      invocations: invocations.length,
+      deltas,
+      deliveries,
+      syntheticDeltaBytes: bytes,
+      syntheticBytesPerDelta: deltas > 0 ? bytes / deltas : 0,
+      maxSyntheticDeltaBytes: maxBytes,
+      mergeMs,
+      mergeMsPerDelivery: deliveries > 0 ? mergeMs / deliveries : 0,
+      convergenceTicks: converged ? ticks : -1,
+      convergenceMs,
+      converged,
+    };
+  }
+
+  converged(): boolean {
+    const first = this.replicas[0].digest();
+    return this.replicas.every(replica => replica.digest() === first);
+  }
+
+  private broadcast(source: number, delta: Uint8Array): void {
+    this.stats.deltas += 1;
+    this.stats.bytes += delta.length;
+    this.stats.maxBytes = Math.max(this.stats.maxBytes, delta.length);
+    const { min, max } = this.latency;
+    for (let target = 0; target < this.replicas.length; target += 1) {
+      if (target === source) {
+        continue;
+      }
+      const delay = min + Math.floor(this.random() * (max - min + 1));
+      this.inFlight.push({ deliverAt: this.now + delay, seq: this.seq++, target, delta });
+    }
+  }
+
+  private advance(): void {
+    this.now += 1;
+    const due = this.inFlight
+      .filter(message => message.deliverAt <= this.now)
+      .sort((a, b) => a.deliverAt - b.deliverAt || a.seq - b.seq);
+    if (due.length === 0) {
+      return;
+    }
+    this.inFlight = this.inFlight.filter(message => message.deliverAt > this.now);
+    for (const message of due) {
+      const start = performance.now();
+      this.replicas[message.target].applyDelta(message.delta);
+      this.stats.mergeMs += performance.now() - start;
+      this.stats.deliveries += 1;
+    }
+  }
+
+  private shuffle<T>(items: T[]): T[] {
+    const out = [...items];
+    for (let i = out.length - 1; i > 0; i -= 1) {
+      const j = Math.floor(this.random() * (i + 1));
+      [out[i], out[j]] = [out[j], out[i]];
+    }
+    return out;
+  }
+}
@@ -0,0 +1,12 @@
+/** @type {import('jest').Config} */
+module.exports = {
+  preset: 'ts-jest',
+  testEnvironment: 'node',
+  roots: ['<rootDir>'],
+  testMatch: ['**/*.test.ts'],
+  testTimeout: 60000, // Node-backed scenarios may take longer
+  moduleNameMapper: {
+    '^@calimero-network/calimero-sdk-js$': '<rootDir>/../../packages/sdk/src/index.ts',
+    '^@calimero-network/calimero-sdk-js/(.*)$': '<rootDir>/../../packages/sdk/src/$1',
+  },
+};
@@ -1,20 +1,306 @@
 /**
- * E2E tests for multi-node synchronization
+ * Multi-replica sync convergence tests
+ *
+ * Runs on the in-process simulator (`helpers/simulator.ts`), no nodes required. Set
+ * SYNC_SIM_REPORT=1 to print synthetic delta size, merge time and convergence time per workload.
  */
 
-describe('Multi-Node Sync', () => {
-  it('should be implemented in Phase 4', () => {
-    // TODO: Test multi-node synchronization
-    expect(true).toBe(true);
-  });
+import { AppendLog } from '../../packages/sdk/src/collections/AppendLog';
+import { Counter } from '../../packages/sdk/src/collections/Counter';
+import { UnorderedMap } from '../../packages/sdk/src/collections/UnorderedMap';
+import { LwwRegister } from '../../packages/sdk/src/collections/LwwRegister';
+import { PackedVector } from '../../packages/sdk/src/collections/PackedVector';
+import { SortedMap } from '../../packages/sdk/src/collections/SortedMap';
+import { UnorderedSet } from '../../packages/sdk/src/collections/UnorderedSet';
+import { Vector } from '../../packages/sdk/src/collections/Vector';
+import { SyncSimulator, type Invocation, type SimulationReport } from './helpers/simulator';
+
+const REPLICAS = 4;
 
+function report(name: string, result: SimulationReport): void {
+  if (process.env.SYNC_SIM_REPORT) {
+    console.log(
+      `[sync-sim] ${name}: ${result.deltas} deltas, ` +
+        `${result.syntheticBytesPerDelta.toFixed(1)} synthetic B/delta ` +
+        `(max ${result.maxSyntheticDeltaBytes}), merge ${result.mergeMsPerDelivery.toFixed(3)} ms/delta, ` +
+        `converged in ${result.convergenceTicks} ticks (${result.convergenceMs.toFixed(2)} ms)`
+    );
+  }
+}
+
+describe('Multi-Node Sync', () => {
   it('should sync counter between nodes', () => {
-    // TODO: Test counter sync
-    expect(true).toBe(true);
+    const sim = new SyncSimulator({ replicas: REPLICAS, seed: 7, latency: { min: 1, max: 4 } });
+    const id = sim.invoke(0, () => new Counter().id());
+
+    const invocations: Invocation[] = [];
+    for (let replica = 0; replica < REPLICAS; replica += 1) {
+      for (let i = 0; i < 25; i += 1) {
+        invocations.push({ replica, run: () => new Counter({ id }).incrementBy(2) });
+      }
+    }
+    const result = sim.run(invocations);
+    report('counter', result);
+
+    expect(result.converged).toBe(true);
+    for (let replica = 0; replica < REPLICAS; replica += 1) {
+      expect(sim.invoke(replica, () => new Counter({ id }).value())).toBe(BigInt(REPLICAS * 50));
+    }
   });
 
   it('should handle concurrent updates', () => {
-    // TODO: Test concurrent updates
-    expect(true).toBe(true);
+    const sim = new SyncSimulator({
+      replicas: REPLICAS,
+      seed: 42,
+      latency: { min: 1, max: 8 },
+      interleaving: 'shuffled',
+    });
+    const id = sim.invoke(0, () => new UnorderedMap<string, number>().id());
+
+    const invocations: Invocation[] = [];
+    for (let replica = 0; replica < REPLICAS; replica += 1) {
+      for (let i = 0; i < 40; i += 1) {
+        const key = `k${i % 10}`;
+        invocations.push({
+          replica,
+          run: () => {
+            const map = UnorderedMap.fromId<string, number>(id);
+            if (i % 7 === 6) {
+              map.remove(key);
+            } else {
+              map.set(key, replica * 1000 + i);
+            }
+          },
+        });
+      }
+    }
+    const result = sim.run(invocations);
+    report('unordered-map', result);
+
+    expect(result.converged).toBe(true);
+    const views = sim.replicas.map((_, replica) =>
+      sim.invoke(replica, () =>
+        UnorderedMap.fromId<string, number>(id)
+          .entries()
+          .sort(([a], [b]) => a.localeCompare(b))
+      )
+    );
+    for (const view of views) {
+      expect(view).toEqual(views[0]);
+    }
+  });
+
+  it('should converge last-writer-wins registers', () => {
+    const sim = new SyncSimulator({
+      replicas: REPLICAS,
+      seed: 3,
+      latency: { min: 2, max: 6 },
+      interleaving: 'shuffled',
+    });
+    const id = sim.invoke(0, () => new LwwRegister<string>().id());
+
+    const invocations: Invocation[] = [];
+    for (let replica = 0; replica < REPLICAS; replica += 1) {
+      for (let i = 0; i < 10; i += 1) {
+        invocations.push({
+          replica,
+          run: () => new LwwRegister<string>({ id }).set(`r${replica}-${i}`),
+        });
+      }
+    }
+    const result = sim.run(invocations);
+    report('lww-register', result);
+
+    expect(result.converged).toBe(true);
+    const values = sim.replicas.map((_, replica) =>
+      sim.invoke(replica, () => new LwwRegister<string>({ id }).get())
+    );
+    expect(new Set(values).size).toBe(1);
+    expect(values[0]).not.toBeNull();
+  });
+
+  it('should keep concurrent vector pushes and converge set membership', () => {
+    const sim = new SyncSimulator({
+      replicas: REPLICAS,
+      seed: 11,
+      latency: { min: 1, max: 5 },
+      interleaving: 'shuffled',
+    });
+    const { vectorId, setId } = sim.invoke(0, () => ({
+      vectorId: new Vector<string>().id(),
+      setId: new UnorderedSet<string>().id(),
+    }));
+
+    const invocations: Invocation[] = [];
+    for (let replica = 0; replica < REPLICAS; replica += 1) {
+      for (let i = 0; i < 15; i += 1) {
+        invocations.push({
+          replica,
+          run: () => {
+            new Vector<string>({ id: vectorId }).push(`v${replica}-${i}`);
+            const set = new UnorderedSet<string>({ id: setId });
+            if (i % 4 === 3) {
+              set.delete(`s${i % 6}`);
+            } else {
+              set.add(`s${i % 6}`);
+            }
+          },
+        });
+      }
+    }
+    const result = sim.run(invocations);
+    report('vector-set', result);
+
+    expect(result.converged).toBe(true);
+    const views = sim.replicas.map((_, replica) =>
+      sim.invoke(replica, () => ({
+        vector: new Vector<string>({ id: vectorId }).toArray(),
+        set: new UnorderedSet<string>({ id: setId }).toArray().sort(),
+      }))
+    );
+    expect(views[0].vector).toHaveLength(REPLICAS * 15);
+    for (const view of views) {
+      expect(view).toEqual(views[0]);
+    }
+  });
+
+  it('should keep concurrent appends to an append log', () => {
+    const sim = new SyncSimulator({ replicas: 2, seed: 5, latency: { min: 3, max: 6 } });
+    const id = sim.invoke(0, () => new AppendLog<string>({ segmentSize: 4 }).id());
+    const open = () => new AppendLog<string>({ id, segmentSize: 4 });
+    sim.run([]);
+
+    // Both replicas append before seeing each other's entries
+    const invocations: Invocation[] = [];
+    for (let i = 0; i < 10; i += 1) {
+      for (let replica = 0; replica < 2; replica += 1) {
+        invocations.push({ replica, run: () => open().append(`r${replica}-${i}`) });
+      }
+    }
+    const result = sim.run(invocations);
+    report('append-log', result);
+
+    expect(result.converged).toBe(true);
+    const views = sim.replicas.map((_, replica) =>
+      sim.invoke(replica, () => {
+        const log = open();
+        const paged: string[] = [];
+        for (let page = log.latest(3); page.length > 0; ) {
+          paged.push(...page.map(entry => entry.value));
+          page = log.before(page[page.length - 1].index, 3);
+        }
+        return { len: log.len(), all: log.latest(100).map(entry => entry.value), paged };
+      })
+    );
+    expect(views[0].len).toBe(20);
+    expect(views[0].all).toHaveLength(20);
+    expect(views[0].paged).toEqual(views[0].all);
+    expect(views[1]).toEqual(views[0]);
+    for (let replica = 0; replica < 2; replica += 1) {
+      const own = views[0].all.filter(value => value.startsWith(`r${replica}-`)).reverse();
+      expect(own).toEqual(Array.from({ length: 10 }, (_, i) => `r${replica}-${i}`));
+    }
+  });
+
+  it('should keep concurrent pushes to a packed vector', () => {
+    const sim = new SyncSimulator({ replicas: 2, seed: 13, latency: { min: 3, max: 6 } });
+    const options = { element: 'u32' as const, chunkSize: 4 };
+    const id = sim.invoke(0, () => new PackedVector(options).id());
+    const open = () => new PackedVector({ id, ...options });
+    sim.run([]);
+
+    // Both replicas push into what would be the same partial chunk
+    const invocations: Invocation[] = [];
+    for (let i = 0; i < 10; i += 1) {
+      for (let replica = 0; replica < 2; replica += 1) {
+        invocations.push({ replica, run: () => open().push(replica * 100 + i) });
+      }
+    }
+    const result = sim.run(invocations);
+    report('packed-vector', result);
+
+    expect(result.converged).toBe(true);
+    const views = sim.replicas.map((_, replica) =>
+      sim.invoke(replica, () => ({ len: open().len(), values: Array.from(open().range()) }))
+    );
+    expect(views[0].len).toBe(20);
+    expect([...views[0].values].sort((a, b) => a - b)).toEqual(
+      Array.from({ length: 20 }, (_, i) => (i < 10 ? i : 100 + i - 10))
+    );
+    expect(views[1]).toEqual(views[0]);
+  });
+
+  it('should keep a sorted map indexed while two replicas write concurrently', () => {
+    const sim = new SyncSimulator({ replicas: 2, seed: 9, latency: { min: 3, max: 6 } });
+    const id = sim.invoke(0, () => new SortedMap<number, string>().id());
+    const open = () => new SortedMap<number, string>({ id });
+    sim.run([]);
+
+    // Each replica inserts its own keys before seeing the other's, and removes the other's keys
+    // once they have arrived
+    const invocations: Invocation[] = [];
+    for (let i = 0; i < 150; i += 1) {
+      for (let replica = 0; replica < 2; replica += 1) {
+        invocations.push({
+          replica,
+          run: () => {
+            const map = open();
+            map.set(i * 2 + replica, `r${replica}`);
+            if (i % 5 === 4) {
+              map.remove((i - 4) * 2 + 1 - replica);
+            }
+          },
+        });
+      }
+    }
+    const result = sim.run(invocations);
+    report('sorted-map', result);
+
+    expect(result.converged).toBe(true);
+    const expected = Array.from({ length: 300 }, (_, key) => key).filter(
+      key => !(Math.floor(key / 2) % 5 === 0 && Math.floor(key / 2) < 146)
+    );
+    const views = sim.replicas.map((_, replica) =>
+      sim.invoke(replica, () => {
+        const map = open();
+        return { keys: map.keys(), len: map.len(), range: map.rangeKeys(100, 110) };
+      })
+    );
+    expect(views[0].keys).toEqual(expected);
+    expect(views[0].len).toBe(expected.length);
+    expect(views[0].range).toEqual(expected.filter(key => key >= 100 && key < 110));
+    expect(views[1]).toEqual(views[0]);
+
+    // No write rewrote the index: every delta stays a few nodes wide
+    expect(result.maxSyntheticDeltaBytes).toBeLessThan(2048);
+
+    // A range still reads a path per writer plus its entries
+    const host = sim.replicas[0].env as any;
+    const get = host.js_crdt_map_get;
+    let reads = 0;
+    host.js_crdt_map_get = (...args: unknown[]) => {
+      reads += 1;
+      return get(...args);
+    };
+    const page = sim.invoke(0, () => open().range(200, 220));
+    host.js_crdt_map_get = get;
+    expect(page.map(([key]) => key)).toEqual(expected.filter(key => key >= 200 && key < 220));
+    expect(reads).toBeLessThanOrEqual(1 + 2 * 3 + 20);
+  });
+
+  it('reports synthetic delta sizes and merge cost', () => {
+    const sim = new SyncSimulator({ replicas: 2 });
+    const id = sim.invoke(0, () => new UnorderedMap<string, string>().id());
+    const result = sim.run([
+      { replica: 0, run: () => UnorderedMap.fromId<string, string>(id).set('a', 'x') },
+      { replica: 1, run: () => UnorderedMap.fromId<string, string>(id).set('b', 'y') },
+    ]);
+
+    // The map creation delta carries no operations, so only the two writes travel
+    expect(result.deltas).toBe(2);
+    expect(result.deliveries).toBe(2);
+    expect(result.syntheticBytesPerDelta).toBeGreaterThan(0);
+    expect(result.maxSyntheticDeltaBytes).toBeGreaterThanOrEqual(result.syntheticBytesPerDelta);
+    expect(result.convergenceTicks).toBeGreaterThanOrEqual(0);
   });
 });